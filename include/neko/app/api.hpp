@@ -34,8 +34,11 @@ namespace neko::api {
             minApiVersion,
             buildVersion,
             releaseDate,
-            deprecatedMessage;
+            deprecatedMessage,
+            etag,         // identifies the payload; sent back as `ifNoneMatch` to revalidate it
+            lastModified; // when the payload last changed; sent back as `ifModifiedSince`
         neko::int64 timestamp;
+        neko::int64 maxAgeSec = 0; // how long the payload may be cached, 0 = client default
         bool isDeprecated = false;
         bool empty() const noexcept {
             return apiVersion.empty() && minApiVersion.empty() && buildVersion.empty() && releaseDate.empty() && deprecatedMessage.empty();
@@ -190,14 +193,48 @@ namespace neko::api {
         std::string resourceVersion;
         bool isMandatory;
         Meta meta;
+        /**
+         * @brief A binary patch from an earlier version of one file to the version in this update.
+         */
+        struct Patch {
+            std::string fromVersion;  // resourceVersion the patch applies to; empty = any base with baseChecksum
+            std::string url;
+            std::string format;       // "zstd" (zstd --patch-from)
+            std::string baseChecksum; // hash of the file the patch applies to, same algorithm as the file
+            neko::uint64 size = 0;    // patch size in bytes, 0 = unknown
+            bool isAbsoluteUrl = false;
+        };
+        /**
+         * @brief A file described as content-defined chunks; chunks are fetched from `baseUrl + "/" + hash`.
+         */
+        struct ChunkManifest {
+            struct Chunk {
+                std::string hash;
+                neko::uint64 size = 0;
+            };
+            std::string algorithm = "gear-v1"; // chunker, see neko/core/chunkStore.hpp
+            std::string hashAlgorithm = "sha256";
+            neko::uint64 minSize = 0;
+            neko::uint64 avgSize = 0;
+            neko::uint64 maxSize = 0;
+            std::string baseUrl;
+            bool isAbsoluteUrl = false;
+            std::vector<Chunk> list; // in file order
+            bool empty() const noexcept {
+                return list.empty() || baseUrl.empty();
+            }
+        };
         struct File {
             std::string url;
             std::string fileName;
             std::string checksum;
             std::string hashAlgorithm;
-            bool suggestMultiThread;
-            bool isCoreFile;
-            bool isAbsoluteUrl;
+            bool suggestMultiThread = false;
+            bool isCoreFile = false;
+            bool isAbsoluteUrl = false;
+            std::vector<Patch> patches;
+            bool chunked = false; // downloadMeta.chunked: assemble from `chunks` when possible
+            ChunkManifest chunks;
             bool empty() const noexcept {
                 return url.empty() && fileName.empty() && checksum.empty();
             }
@@ -389,7 +426,10 @@ namespace neko::api {
             {"releaseDate", meta.releaseDate},
             {"deprecatedMessage", meta.deprecatedMessage},
             {"timestamp", meta.timestamp},
-            {"isDeprecated", meta.isDeprecated}};
+            {"isDeprecated", meta.isDeprecated},
+            {"etag", meta.etag},
+            {"lastModified", meta.lastModified},
+            {"maxAgeSec", meta.maxAgeSec}};
     }
     inline void from_json(const nlohmann::json &j, Meta &meta) {
         meta.apiVersion = j.value("apiVersion", "");
@@ -399,6 +439,9 @@ namespace neko::api {
         meta.deprecatedMessage = j.value("deprecatedMessage", "");
         meta.timestamp = j.value("timestamp", 0);
         meta.isDeprecated = j.value("isDeprecated", false);
+        meta.etag = j.value("etag", "");
+        meta.lastModified = j.value("lastModified", "");
+        meta.maxAgeSec = j.value("maxAgeSec", neko::int64(0));
     }
 
     // Preferences
@@ -600,6 +643,59 @@ namespace neko::api {
         from_json(j.at("meta"), maintenance.meta);
     }
 
+    // UpdateResponse::Patch
+    inline void to_json(nlohmann::json &j, const UpdateResponse::Patch &patch) {
+        j = nlohmann::json{
+            {"fromVersion", patch.fromVersion},
+            {"url", patch.url},
+            {"format", patch.format},
+            {"baseChecksum", patch.baseChecksum},
+            {"size", patch.size},
+            {"isAbsoluteUrl", patch.isAbsoluteUrl}};
+    }
+    inline void from_json(const nlohmann::json &j, UpdateResponse::Patch &patch) {
+        patch.fromVersion = j.value("fromVersion", "");
+        patch.url = j.value("url", "");
+        patch.format = j.value("format", "");
+        patch.baseChecksum = j.value("baseChecksum", "");
+        patch.size = j.value("size", neko::uint64(0));
+        patch.isAbsoluteUrl = j.value("isAbsoluteUrl", false);
+    }
+
+    // UpdateResponse::ChunkManifest
+    inline void to_json(nlohmann::json &j, const UpdateResponse::ChunkManifest::Chunk &chunk) {
+        j = nlohmann::json{
+            {"hash", chunk.hash},
+            {"size", chunk.size}};
+    }
+    inline void from_json(const nlohmann::json &j, UpdateResponse::ChunkManifest::Chunk &chunk) {
+        chunk.hash = j.value("hash", "");
+        chunk.size = j.value("size", neko::uint64(0));
+    }
+    inline void to_json(nlohmann::json &j, const UpdateResponse::ChunkManifest &manifest) {
+        j = nlohmann::json{
+            {"algorithm", manifest.algorithm},
+            {"hashAlgorithm", manifest.hashAlgorithm},
+            {"minSize", manifest.minSize},
+            {"avgSize", manifest.avgSize},
+            {"maxSize", manifest.maxSize},
+            {"baseUrl", manifest.baseUrl},
+            {"isAbsoluteUrl", manifest.isAbsoluteUrl},
+            {"list", manifest.list}};
+    }
+    inline void from_json(const nlohmann::json &j, UpdateResponse::ChunkManifest &manifest) {
+        manifest.algorithm = j.value("algorithm", "gear-v1");
+        manifest.hashAlgorithm = j.value("hashAlgorithm", "sha256");
+        manifest.minSize = j.value("minSize", neko::uint64(0));
+        manifest.avgSize = j.value("avgSize", neko::uint64(0));
+        manifest.maxSize = j.value("maxSize", neko::uint64(0));
+        manifest.baseUrl = j.value("baseUrl", "");
+        manifest.isAbsoluteUrl = j.value("isAbsoluteUrl", false);
+        if (j.contains("list") && j.at("list").is_array()) {
+            manifest.list = j.at("list").get<std::vector<UpdateResponse::ChunkManifest::Chunk>>();
+        }
+    }
+
     // UpdateResponse::File
     inline void to_json(nlohmann::json &j, const UpdateResponse::File &file) {
         j = nlohmann::json{
@@ -609,7 +705,10 @@ namespace neko::api {
             {"hashAlgorithm", file.hashAlgorithm},
             {"suggestMultiThread", file.suggestMultiThread},
             {"isCoreFile", file.isCoreFile},
-            {"isAbsoluteUrl", file.isAbsoluteUrl}};
+            {"isAbsoluteUrl", file.isAbsoluteUrl},
+            {"patches", file.patches},
+            {"chunked", file.chunked},
+            {"chunks", file.chunks}};
     }
     inline void from_json(const nlohmann::json &j, UpdateResponse::File &file) {
         file.url = j.value("url", "");
@@ -619,6 +718,13 @@ namespace neko::api {
         file.suggestMultiThread = j.value("suggestMultiThread", false);
         file.isCoreFile = j.value("isCoreFile", false);
         file.isAbsoluteUrl = j.value("isAbsoluteUrl", false);
+        if (j.contains("patches") && j.at("patches").is_array()) {
+            file.patches = j.at("patches").get<std::vector<UpdateResponse::Patch>>();
+        }
+        file.chunked = j.value("chunked", false);
+        if (j.contains("chunks") && j.at("chunks").is_object()) {
+            from_json(j.at("chunks"), file.chunks);
+        }
     }
 
     // UpdateResponse
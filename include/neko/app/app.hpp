@@ -1,6 +1,7 @@
 #pragma once
 
 #include <neko/schema/exception.hpp>
+#include <neko/log/nlog.hpp>
 
 #include "neko/event/eventTypes.hpp"
 
@@ -42,12 +43,25 @@ namespace neko::app {
     /**
      * @brief Gracefully shut down background subsystems.
      *
-     * Stops the event loop (idempotent) and then stops the thread pool so no
+     * Stops the event loop (idempotent) and then stops every executor so no
      * worker threads are running while statics are being torn down.
      */
     inline void shutdown() {
         bus::event::stopLoop();
-        bus::thread::stop(true);
+
+        // Queue-wait per scheduling class over the whole session.
+        for (auto executor : {bus::Executor::cpu, bus::Executor::io, bus::Executor::background}) {
+            for (auto taskClass : {bus::TaskClass::interactive, bus::TaskClass::normal, bus::TaskClass::bulk, bus::TaskClass::idle}) {
+                const auto stats = bus::thread::getTaskClassStats(executor, taskClass);
+                if (stats.dispatched == 0 && stats.expired == 0) {
+                    continue;
+                }
+                log::info("Scheduler {}/{}: dispatched={}, expired={}, wait avg={}ms max={}ms", {},
+                          bus::thread::toString(executor), bus::thread::toString(taskClass), stats.dispatched, stats.expired, stats.averageWaitMs, stats.maxWaitMs);
+            }
+        }
+
+        bus::thread::stopAll(true);
     }
 
 } // namespace neko::app
\ No newline at end of file
@@ -44,8 +44,7 @@ namespace neko::app {
      * @details Uses core::getConfigObj from resources.hpp to access configuration.
      */
     inline std::string getResourceVersion() {
-        neko::ClientConfig cfg = bus::config::getClientConfig();
-        return cfg.main.resourceVersion;
+        return bus::config::getSnapshot()->main.resourceVersion;
     }
 
     /**
@@ -53,8 +52,7 @@ namespace neko::app {
      * @return The device ID string. e.g "123e4567-e89b-12d3-a456-426614174000"
      */
     inline std::string getDeviceId() {
-        neko::ClientConfig cfg = bus::config::getClientConfig();
-        return cfg.main.deviceID;
+        return bus::config::getSnapshot()->main.deviceID;
     }
 
     /**
@@ -65,6 +63,14 @@ namespace neko::app {
         return lc::ClientConfigFileName.data();
     }
 
+    /**
+     * @brief Gets the folder for persistent caches.
+     * @return The cache folder path. e.g "<workPath>/cache"
+     */
+    inline std::string getCacheFolder() {
+        return system::workPath() + "/" + std::string(lc::CacheFolderName);
+    }
+
     /**
      * @brief Gets the build ID.
      * @return The build ID string. e.g "v0.0.1-20250710184724-githash"
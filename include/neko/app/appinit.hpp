@@ -19,21 +19,30 @@
 #include <filesystem>
 #include <chrono>
 #include <vector>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <algorithm>
+#include <iterator>
+#include <string>
 
 #include "neko/app/appinfo.hpp"
 #include "neko/app/clientConfig.hpp"
 #include "neko/app/lang.hpp"
 #include "neko/app/appSubscribe.hpp"
+#include "neko/app/hostProbe.hpp"
 
 #include "neko/core/coreSubscribe.hpp"
 #include "neko/core/crashReporter.hpp"
+#include "neko/core/update.hpp"
 
 #include "neko/minecraft/minecraftSubscribe.hpp"
 
 #include "neko/ui/uiSubscribe.hpp"
 
 #include "neko/bus/configBus.hpp"
+#include "neko/bus/eventBus.hpp"
 #include "neko/bus/threadBus.hpp"
 
 #include <sstream>
@@ -45,6 +54,10 @@ namespace neko::app::init {
     inline void registerQtMetaTypes() {
         qRegisterMetaType<std::string>("std::string");
         qRegisterMetaType<neko::ui::LoadingMsg>("neko::ui::LoadingMsg");
+        qRegisterMetaType<std::shared_ptr<const neko::ui::NoticeMsg>>();
+        qRegisterMetaType<std::shared_ptr<const neko::ui::InputMsg>>();
+        qRegisterMetaType<std::shared_ptr<const neko::ui::LoadingMsg>>();
+        qRegisterMetaType<std::shared_ptr<const neko::ConfigChange>>();
     }
 
     inline void initDeviceID() {
@@ -57,7 +70,7 @@ namespace neko::app::init {
             c.main.deviceID = util::uuid::uuidV4();
             log::info("Device ID not set, generating new one: " + c.main.deviceID);
         });
-        bus::config::save(app::getConfigFileName());
+        bus::config::saveAsync(app::getConfigFileName());
     }
 
     inline void initLog() {
@@ -167,21 +180,31 @@ namespace neko::app::init {
         log::setCurrentThreadName("Main Thread");
         log::info("Initializing thread pool with {} threads", {}, threadCount);
 
-        auto ids = bus::thread::getWorkerIds();
+        // Blocking I/O and background work get their own pools so bulk downloads never resize or starve the cpu pool.
+        bus::thread::setThreadCount(bus::Executor::io, bus::thread::defaultIoThreadCount);
+        bus::thread::setMaxQueueSize(bus::Executor::io, bus::thread::defaultIoMaxQueueSize);
+        bus::thread::setThreadCount(bus::Executor::background, bus::thread::defaultBackgroundThreadCount);
+        bus::thread::setMaxQueueSize(bus::Executor::background, bus::thread::defaultBackgroundMaxQueueSize);
+        log::info("Initializing io pool with {} threads, background pool with {} threads", {}, bus::thread::defaultIoThreadCount, bus::thread::defaultBackgroundThreadCount);
 
         // Set thread names for each worker thread
-        for (auto i : ids) {
-            std::string i_str = std::to_string(i);
-            std::string threadName = "Worker Thread " + i_str;
-            try {
-                bus::thread::submitToWorker(i, [threadName]() {
-                    log::setCurrentThreadName(threadName);
-                    log::info("Hello thread " + threadName);
-                });
-            } catch (const ex::OutOfRange &e) {
-                log::error("Not Found Worker Thread {}", {}, i_str);
+        auto nameWorkers = [](bus::Executor executor, const std::string &prefix) {
+            for (auto i : bus::thread::getWorkerIds(executor)) {
+                std::string i_str = std::to_string(i);
+                std::string threadName = prefix + i_str;
+                try {
+                    bus::thread::submitToWorker(executor, i, [threadName]() {
+                        log::setCurrentThreadName(threadName);
+                        log::info("Hello thread " + threadName);
+                    });
+                } catch (const ex::OutOfRange &e) {
+                    log::error("Not Found {} Thread {}", {}, bus::thread::toString(executor), i_str);
+                }
             }
-        }
+        };
+        nameWorkers(bus::Executor::cpu, "Worker Thread ");
+        nameWorkers(bus::Executor::io, "IO Thread ");
+        nameWorkers(bus::Executor::background, "Background Thread ");
     }
 
     inline void initSystem() {
@@ -267,21 +290,175 @@ namespace neko::app::init {
     };
 
     /**
-     * @brief Initialize the network and test available hosts.
+     * @brief Proxy setting as passed to the network config: "true" (system proxy), an address, or "" when invalid.
+     */
+    inline std::string resolveProxy(const ClientConfig &cfg) {
+        std::string proxy(cfg.net.proxy);
+        bool proxyAddressInvalid = util::logic::allTrue((proxy != ""), (proxy != "true"), !util::check::isProxyAddress(proxy));
+        if (proxyAddressInvalid)
+            proxy = "";
+        return proxy;
+    }
+
+    /**
+     * @brief Probe one host with a single ping request; the prober measures the round trip.
+     */
+    inline hosts::ProbeResult probeHost(const std::string &host) {
+        const auto &config = network::config::globalConfig;
+        neko::network::Network net;
+        network::RetryConfig retry{
+            .config = neko::network::RequestConfig{
+                .url = network::buildUrl(lc::api::testing, host),
+                .method = neko::network::RequestType::Get,
+                .userAgent = config.getUserAgent(),
+                .proxy = config.getProxy(),
+                .requestId = "Testing - " + host},
+            .maxRetries = 1,
+            .retryDelay = std::chrono::milliseconds{50},
+            .successCodes = {200}};
+
+        auto result = net.executeWithRetry(retry);
+        if (result.isSuccess()) {
+            return {.host = host, .healthy = true};
+        }
+        return {.host = host, .healthy = false, .error = "statusCode: " + std::to_string(result.statusCode) + ", " + result.errorMessage};
+    }
+
+    /**
+     * @brief Prober over `lc::NetworkHostList`, shared by startup, retries and periodic re-probing.
+     * Host health persists in `cache/host-health.json`.
+     */
+    inline hosts::HostProber &getHostProber() {
+        static hosts::HostProber prober(
+            std::vector<std::string>(std::begin(lc::NetworkHostList), std::end(lc::NetworkHostList)),
+            probeHost,
+            [](std::function<void()> task) {
+                (void)bus::thread::schedule(bus::Executor::io, {.taskClass = bus::TaskClass::interactive}, std::move(task));
+            },
+            app::getCacheFolder() + "/host-health.json");
+        return prober;
+    }
+
+    namespace detail {
+        /**
+         * @brief Whether the hosts in use came from the health cache and have not been confirmed by a full probe.
+         */
+        struct WarmStartState {
+            std::mutex mutex;
+            bool unverified = false;
+            std::optional<std::shared_future<bool>> fallback;
+        };
+
+        inline WarmStartState &getWarmStartState() {
+            static WarmStartState state;
+            return state;
+        }
+
+        /**
+         * @brief Serializes writes to the available hosts; every writer goes through setAvailableHosts().
+         */
+        inline std::mutex &getHostListMutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Replace the available hosts with a list built beforehand, in one step under the host-list lock.
+     * @note NetConfig only offers clear/push, so the swap is atomic among writers; the list is
+     *       complete before it is applied, keeping the window seen by readers to the swap itself.
+     */
+    inline void setAvailableHosts(const std::vector<std::string> &hosts) {
+        std::lock_guard lock(detail::getHostListMutex());
+        auto &config = network::config::globalConfig;
+        config.clearAvailableHost();
+        for (const auto &host : hosts) {
+            config.pushAvailableHost(host);
+        }
+    }
+
+    /**
+     * @brief Replace the available hosts with the current ranking, fastest first.
+     * @note An empty ranking (every probe failing, e.g. briefly offline) keeps the previous hosts.
+     */
+    inline void applyHostRanking() {
+        static std::mutex applyMutex;
+        std::lock_guard lock(applyMutex);
+        // Read under the lock so a late, older caller cannot overwrite a newer ranking.
+        const auto ranked = getHostProber().getRanking().getRanked();
+        if (ranked.empty()) {
+            return;
+        }
+        setAvailableHosts(ranked);
+    }
+
+    /**
+     * @brief Called when a real request fails after a warm start: drop the cached host it used and
+     * run the full probe once. Concurrent callers share that probe.
+     * @param failedHost The host the failed request was sent to; the hosts in use may have changed since.
+     * @param reason The error, recorded against the host.
+     * @return true if a full probe ran and found a host, so the failed request is worth retrying;
+     *         false after a cold start, once the background refresh has confirmed a host, or when
+     *         the fallback has already finished.
+     */
+    inline bool fallBackToFullProbe(const std::string &failedHost, const std::string &reason) {
+        auto &state = detail::getWarmStartState();
+        std::shared_ptr<std::promise<bool>> leader;
+        std::shared_future<bool> result;
+        {
+            std::lock_guard lock(state.mutex);
+            if (!state.fallback) {
+                if (!state.unverified) {
+                    return false;
+                }
+                leader = std::make_shared<std::promise<bool>>();
+                state.fallback = leader->get_future().share();
+            }
+            result = *state.fallback;
+        }
+
+        if (leader) {
+            auto &prober = getHostProber();
+            if (!failedHost.empty()) {
+                prober.markFailed(failedHost, reason);
+            }
+            const auto ranked = prober.probeAll();
+            applyHostRanking();
+            log::info("Full host probe after a failed warm start found {} hosts", {}, ranked.size());
+            {
+                // The hosts are now verified; later failures are real and are not retried.
+                std::lock_guard lock(state.mutex);
+                state.unverified = false;
+                state.fallback.reset();
+            }
+            leader->set_value(!ranked.empty());
+        }
+        return result.get();
+    }
+
+    /**
+     * @brief Stop background re-probing; called on shutdown before the executors stop.
+     */
+    inline void stopHostProbing() {
+        getHostProber().stop();
+    }
+
+    /**
+     * @brief Initialize the network and select hosts.
+     * @param allowWarmStart Use hosts that were healthy on the last launch right away and verify them
+     *        in the background; a full probe runs only if there are none or a real request fails.
      * @return A future that resolves to NetworkInitResult.
      */
-    inline auto initNetwork() {
+    inline auto initNetwork(bool allowWarmStart = true) {
 
         auto cfg = bus::config::getClientConfig();
+        getHostProber().getRanking().setListener(applyHostRanking);
 
-        auto init = [cfg](network::config::NetConfig &config) {
-            std::string proxy(cfg.net.proxy);
+        auto init = [cfg, allowWarmStart](network::config::NetConfig &config) {
+            std::string proxy = resolveProxy(cfg);
             bool
                 dev = cfg.dev.enable,
-                tls = cfg.dev.tls,
-                proxyAddressInvalid = util::logic::allTrue((proxy != ""), (proxy != "true"), !util::check::isProxyAddress(proxy));
-            if (proxyAddressInvalid)
-                proxy = "";
+                tls = cfg.dev.tls;
             std::stringstream userAgentStream;
             userAgentStream << "NekoLc/" << app::getVersion() << " ("
                             << system::getOsName() << "; Build " << app::getBuildId() << ")";
@@ -292,37 +469,43 @@ namespace neko::app::init {
             log::info("Network initialized with UserAgent: {}, Proxy: {}, Protocol: {}", {}, config.getUserAgent(), config.getProxy(), config.getProtocol());
 
             if (cfg.dev.enable && std::string(cfg.dev.server) != "auto" && util::check::isUrl(network::buildUrl("/path",cfg.dev.server)) ){
-                config.pushAvailableHost(std::string(cfg.dev.server));
+                setAvailableHosts({std::string(cfg.dev.server)});
                 log::info("Network::initialize() : Developer mode enabled, using custom server host: {}", {}, cfg.dev.server);
                 return;
             }
 
-            log::info("Network::initialize : Starting test hosts...");
-
-            for (auto it : lc::NetworkHostList) {
-                neko::network::Network net;
-                std::string url = network::buildUrl(lc::api::testing, it.data());
-
-                network::RetryConfig cfg{
-                    .config = neko::network::RequestConfig{
-                        .url = url,
-                        .method = neko::network::RequestType::Get,
-                        .userAgent = config.getUserAgent(),
-                        .proxy = config.getProxy(),
-                        .requestId = "Testing - " + std::string(it)},
-                    .maxRetries = 2,
-                    .retryDelay = std::chrono::milliseconds{50},
-                    .successCodes = {200}};
-
-                auto result = net.executeWithRetry(cfg);
+            auto &prober = getHostProber();
+            auto &warm = detail::getWarmStartState();
+            {
+                std::lock_guard lock(warm.mutex);
+                warm.unverified = false;
+                warm.fallback.reset();
+            }
 
-                if (result.isSuccess()) {
-                    neko::log::info("Network::initialize() : Testing host available, host: {} , statusCode: {}", {}, it, result.statusCode);
-                    config.pushAvailableHost(std::string(it));
-                    continue;
+            auto ranked = allowWarmStart ? prober.warmStart() : std::vector<std::string>{};
+            if (!ranked.empty()) {
+                {
+                    std::lock_guard lock(warm.mutex);
+                    warm.unverified = true;
                 }
+                applyHostRanking();
+                prober.refresh([]() {
+                    auto &confirmed = detail::getWarmStartState();
+                    std::lock_guard lock(confirmed.mutex);
+                    confirmed.unverified = false;
+                });
+                log::info("Network::initialize() : Warm start with cached host {}, verifying in the background", {}, ranked.front());
+            } else {
+                log::info("Network::initialize : Probing {} hosts...", {}, lc::NetworkHostListSize);
+                ranked = prober.probeAll();
+                applyHostRanking();
+            }
+            prober.startPeriodic();
 
-                neko::log::warn("Network::initialize() : Testing host failed, host: {}, statusCode: {}, errorMessage: {}", {}, it, std::to_string(result.statusCode), result.errorMessage);
+            if (ranked.empty()) {
+                log::warn("Network::initialize() : No host answered within the probe deadline");
+            } else {
+                log::info("Network::initialize() : Using host {} ({} answered so far)", {}, ranked.front(), ranked.size());
             }
         };
         
@@ -340,7 +523,11 @@ namespace neko::app::init {
         const auto host = netConfig.getAvailableHost();
         result.success = !host.empty();
         if (result.success) {
-            result.availableHosts.push_back(host);
+            // The ranking behind the available hosts, fastest first; a dev server is not ranked.
+            result.availableHosts = getHostProber().getRanking().getRanked();
+            if (std::find(result.availableHosts.begin(), result.availableHosts.end(), host) == result.availableHosts.end()) {
+                result.availableHosts.insert(result.availableHosts.begin(), host);
+            }
         } else {
             result.errorMessage = "No available hosts found. Please check your network or proxy settings.";
         }
@@ -355,8 +542,27 @@ namespace neko::app::init {
     inline auto retryNetworkInit() {
         log::info("Network retry requested, re-initializing...");
         // Clear existing available hosts before retry
-        network::config::globalConfig.clearAvailableHost();
-        return initNetwork();
+        setAvailableHosts({});
+        // The cached hosts just failed; probe them all (results still update the same health cache).
+        return initNetwork(false);
+    }
+
+    /**
+     * @brief Publish config changes on the bus and apply the fields owned by the app layer.
+     * @note Installed after the initial load, so startup does not announce every field of the file.
+     */
+    inline void initConfigNotifications() {
+        bus::config::setChangeListener([](const app::ConfigManager::Change &change) {
+            bus::event::publish(event::ConfigUpdatedEvent{change});
+        });
+
+        (void)bus::event::subscribe<event::ConfigUpdatedEvent>([](const event::ConfigUpdatedEvent &evt) {
+            if (evt.change->contains("net", "proxy")) {
+                const auto proxy = resolveProxy(*evt.change->current);
+                network::config::globalConfig.setProxy(proxy);
+                log::info("Proxy changed, network now uses: {}", {}, proxy);
+            }
+        });
     }
 
     /**
@@ -365,6 +571,7 @@ namespace neko::app::init {
      */
     inline auto initialize() {
         bus::config::load(app::getConfigFileName());
+        initConfigNotifications();
 
         // Mark this run as in-progress and remember if the last run ended uncleanly.
         previousRunUnclean = core::crash::markRunStart();
@@ -372,6 +579,9 @@ namespace neko::app::init {
         initLog();
         initThreads();
 
+        // A release rolled back at this start left the config naming it; the update check must see the restored one.
+        core::update::restoreRolledBackVersion();
+
         initDeviceID();
         initLanguage();
 
@@ -381,8 +591,12 @@ namespace neko::app::init {
 
         auto result = initNetwork();
 
-        // Upload logs if the previous run crashed before proceeding.
-        core::crash::uploadLogsIfNeeded(previousRunUnclean);
+        // Upload logs if the previous run crashed; nobody waits on it, so it runs at idle class off the startup path.
+        if (previousRunUnclean) {
+            (void)bus::thread::schedule(bus::Executor::background, {.taskClass = bus::TaskClass::idle}, []() {
+                core::crash::uploadLogsIfNeeded(true);
+            });
+        }
 
         app::subscribeToAppEvent();
         core::subscribeToCoreEvents();
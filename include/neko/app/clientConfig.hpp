@@ -6,9 +6,105 @@
 
 #include <neko/schema/types.hpp>
 #include <SimpleIni.h>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace neko {
+    /**
+     * @brief Identifies one configuration field by its INI section and key, e.g. {"style", "theme"}
+     */
+    struct ConfigKey {
+        neko::strview section;
+        neko::strview key;
+
+        constexpr bool operator==(const ConfigKey &) const = default;
+    };
+
+    /**
+     * @brief Every ClientConfig field as `X(section, member, "INI key", default)`.
+     * @details The INI reader, the INI writer and ClientConfig::forEachField (and with it diff() and the
+     *          published ConfigChange keys) all expand this one list, so a field added here is loaded,
+     *          saved and diffed alike. `section` is both the member struct and the INI section.
+     */
+#define NEKO_CLIENT_CONFIG_FIELDS(X)                                 \
+    X(main, lang, "language", "en")                                  \
+    X(main, backgroundType, "backgroundType", "image")               \
+    X(main, background, "background", "img/bg.png")                  \
+    X(main, windowSize, "windowSize", "")                            \
+    X(main, launcherMethod, "launcherMethod", "launchVisible")       \
+    X(main, resourceVersion, "resourceVersion", "")                  \
+    X(main, deviceID, "deviceID", "")                                \
+    X(style, theme, "theme", "dark")                                 \
+    X(style, blurEffect, "blurEffect", "animation")                  \
+    X(style, blurRadius, "blurRadius", 10)                           \
+    X(style, fontPointSize, "fontPointSize", 10)                     \
+    X(style, fontFamilies, "fontFamilies", "")                       \
+    X(style, animation, "animation", "ios")                          \
+    X(net, thread, "thread", 0)                                      \
+    X(net, proxy, "proxy", "true")                                   \
+    X(dev, enable, "enable", false)                                  \
+    X(dev, debug, "debug", false)                                    \
+    X(dev, showLogViewer, "showLogViewer", false)                    \
+    X(dev, showMusicControl, "showMusicControl", false)              \
+    X(dev, server, "server", "auto")                                 \
+    X(dev, tls, "tls", true)                                         \
+    X(other, tempFolder, "customTempDir", "")                        \
+    X(other, logRetentionDays, "logRetentionDays", 14)               \
+    X(other, maxLogFiles, "maxLogFiles", 20)                         \
+    X(other, lastRunUnclean, "lastRunUnclean", false)                \
+    X(other, immediateSave, "immediateSave", false)                  \
+    X(other, newsDismissUntil, "newsDismissUntil", 0)                \
+    X(other, newsDismissVersion, "newsDismissVersion", "")           \
+    X(other, bgmEnabled, "bgmEnabled", true)                         \
+    X(other, bgmVolume, "bgmVolume", 0.7)                            \
+    X(minecraft, minecraftFolder, "minecraftFolder", "./.minecraft") \
+    X(minecraft, javaPath, "javaPath", "")                           \
+    X(minecraft, downloadSource, "downloadSource", "Official")       \
+    X(minecraft, playerName, "playerName", "")                       \
+    X(minecraft, account, "account", "")                             \
+    X(minecraft, uuid, "uuid", "")                                   \
+    X(minecraft, accessToken, "accessToken", "")                     \
+    X(minecraft, targetVersion, "targetVersion", "")                 \
+    X(minecraft, maxMemoryLimit, "maxMemoryLimit", 2048)             \
+    X(minecraft, minMemoryLimit, "minMemoryLimit", 1024)             \
+    X(minecraft, needMemoryLimit, "needMemoryLimit", 1024)           \
+    X(minecraft, authlibName, "authlibName", "authlib-injector.jar") \
+    X(minecraft, authlibPrefetched, "authlibPrefetched", "")         \
+    X(minecraft, authlibSha256, "authlibSha256", "")                 \
+    X(minecraft, tolerantMode, "tolerantMode", false)                \
+    X(minecraft, customResolution, "customResolution", "")           \
+    X(minecraft, joinServerAddress, "joinServerAddress", "")         \
+    X(minecraft, joinServerPort, "joinServerPort", "25565")
+
+    namespace detail::clientConfig {
+        inline void readField(const CSimpleIniA &cfg, const char *section, const char *key, std::string &field, const char *fallback) {
+            field = cfg.GetValue(section, key, fallback);
+        }
+        inline void readField(const CSimpleIniA &cfg, const char *section, const char *key, long &field, long fallback) {
+            field = cfg.GetLongValue(section, key, fallback);
+        }
+        inline void readField(const CSimpleIniA &cfg, const char *section, const char *key, bool &field, bool fallback) {
+            field = cfg.GetBoolValue(section, key, fallback);
+        }
+        inline void readField(const CSimpleIniA &cfg, const char *section, const char *key, float &field, double fallback) {
+            field = static_cast<float>(cfg.GetDoubleValue(section, key, fallback));
+        }
+
+        inline void writeField(CSimpleIniA &cfg, const char *section, const char *key, const std::string &field) {
+            cfg.SetValue(section, key, field.c_str());
+        }
+        inline void writeField(CSimpleIniA &cfg, const char *section, const char *key, long field) {
+            cfg.SetLongValue(section, key, field);
+        }
+        inline void writeField(CSimpleIniA &cfg, const char *section, const char *key, bool field) {
+            cfg.SetBoolValue(section, key, field);
+        }
+        inline void writeField(CSimpleIniA &cfg, const char *section, const char *key, float field) {
+            cfg.SetDoubleValue(section, key, static_cast<double>(field));
+        }
+    } // namespace detail::clientConfig
+
     /**
      * @brief Configuration structure for the NekoLauncher client
      *
@@ -115,65 +211,9 @@ namespace neko {
          * @param cfg SimpleIni configuration object to load settings from
          */
         ClientConfig(const CSimpleIniA &cfg) noexcept {
-            main.lang = cfg.GetValue("main", "language", "en");
-            main.backgroundType = cfg.GetValue("main", "backgroundType", "image");
-            main.background = cfg.GetValue("main", "background", "img/bg.png");
-            main.windowSize = cfg.GetValue("main", "windowSize", "");
-            main.launcherMethod = cfg.GetValue("main", "launcherMethod", "launchVisible");
-            main.resourceVersion = cfg.GetValue("main", "resourceVersion", "");
-            main.deviceID = cfg.GetValue("main", "deviceID", "");
-
-            style.theme = cfg.GetValue("style", "theme", "dark");
-            style.blurEffect = cfg.GetValue("style", "blurEffect", "animation");
-            style.blurRadius = cfg.GetLongValue("style", "blurRadius", 10);
-            style.fontPointSize = cfg.GetLongValue("style", "fontPointSize", 10);
-            style.fontFamilies = cfg.GetValue("style", "fontFamilies", "");
-            style.animation = cfg.GetValue("style", "animation", "ios");
-
-            net.thread = cfg.GetLongValue("net", "thread", 0);
-            net.proxy = cfg.GetValue("net", "proxy", "true");
-
-            dev.enable = cfg.GetBoolValue("dev", "enable", false);
-            dev.debug = cfg.GetBoolValue("dev", "debug", false);
-            dev.showLogViewer = cfg.GetBoolValue("dev", "showLogViewer", false);
-            dev.showMusicControl = cfg.GetBoolValue("dev", "showMusicControl", false);
-            dev.server = cfg.GetValue("dev", "server", "auto");
-            dev.tls = cfg.GetBoolValue("dev", "tls", true);
-
-            other.tempFolder = cfg.GetValue("other", "customTempDir", "");
-            other.logRetentionDays = cfg.GetLongValue("other", "logRetentionDays", 14);
-            other.maxLogFiles = cfg.GetLongValue("other", "maxLogFiles", 20);
-            other.lastRunUnclean = cfg.GetBoolValue("other", "lastRunUnclean", false);
-            other.immediateSave = cfg.GetBoolValue("other", "immediateSave", false);
-            other.newsDismissUntil = cfg.GetLongValue("other", "newsDismissUntil", 0);
-            other.newsDismissVersion = cfg.GetValue("other", "newsDismissVersion", "");
-            other.bgmEnabled = cfg.GetBoolValue("other", "bgmEnabled", true);
-            other.bgmVolume = static_cast<float>(cfg.GetDoubleValue("other", "bgmVolume", 0.7));
-
-            minecraft.minecraftFolder = cfg.GetValue("minecraft", "minecraftFolder", "./.minecraft");
-            minecraft.javaPath = cfg.GetValue("minecraft", "javaPath", "");
-            minecraft.downloadSource = cfg.GetValue("minecraft", "downloadSource", "Official");
-
-            minecraft.playerName = cfg.GetValue("minecraft", "playerName", "");
-            minecraft.account = cfg.GetValue("minecraft", "account", "");
-            minecraft.uuid = cfg.GetValue("minecraft", "uuid", "");
-            minecraft.accessToken = cfg.GetValue("minecraft", "accessToken", "");
-
-            minecraft.targetVersion = cfg.GetValue("minecraft", "targetVersion", "");
-
-            minecraft.maxMemoryLimit = cfg.GetLongValue("minecraft", "maxMemoryLimit", 2048);
-            minecraft.minMemoryLimit = cfg.GetLongValue("minecraft", "minMemoryLimit", 1024);
-            minecraft.needMemoryLimit = cfg.GetLongValue("minecraft", "needMemoryLimit", 1024);
-
-            minecraft.authlibName = cfg.GetValue("minecraft", "authlibName", "authlib-injector.jar");
-            minecraft.authlibPrefetched = cfg.GetValue("minecraft", "authlibPrefetched", "");
-            minecraft.authlibSha256 = cfg.GetValue("minecraft", "authlibSha256", "");
-
-            minecraft.tolerantMode = cfg.GetBoolValue("minecraft", "tolerantMode", false);
-
-            minecraft.customResolution = cfg.GetValue("minecraft", "customResolution", "");
-            minecraft.joinServerAddress = cfg.GetValue("minecraft", "joinServerAddress", "");
-            minecraft.joinServerPort = cfg.GetValue("minecraft", "joinServerPort", "25565");
+#define NEKO_CLIENT_CONFIG_READ(section, member, key, fallback) detail::clientConfig::readField(cfg, #section, key, section.member, fallback);
+            NEKO_CLIENT_CONFIG_FIELDS(NEKO_CLIENT_CONFIG_READ)
+#undef NEKO_CLIENT_CONFIG_READ
         }
 
         /**
@@ -182,65 +222,66 @@ namespace neko {
          * @param cfg SimpleIni configuration object to save settings to
          */
         void setToConfig(CSimpleIniA &cfg) const noexcept {
-            cfg.SetValue("main", "language", main.lang.c_str());
-            cfg.SetValue("main", "backgroundType", main.backgroundType.c_str());
-            cfg.SetValue("main", "background", main.background.c_str());
-            cfg.SetValue("main", "windowSize", main.windowSize.c_str());
-            cfg.SetValue("main", "launcherMethod", main.launcherMethod.c_str());
-            cfg.SetValue("main", "resourceVersion", main.resourceVersion.c_str());
-            cfg.SetValue("main", "deviceID", main.deviceID.c_str());
-
-            cfg.SetValue("style", "theme", style.theme.c_str());
-            cfg.SetValue("style", "blurEffect", style.blurEffect.c_str());
-            cfg.SetLongValue("style", "blurRadius", style.blurRadius);
-            cfg.SetLongValue("style", "fontPointSize", style.fontPointSize);
-            cfg.SetValue("style", "fontFamilies", style.fontFamilies.c_str());
-            cfg.SetValue("style", "animation", style.animation.c_str());
-
-            cfg.SetLongValue("net", "thread", net.thread);
-            cfg.SetValue("net", "proxy", net.proxy.c_str());
-
-            cfg.SetBoolValue("dev", "enable", dev.enable);
-            cfg.SetBoolValue("dev", "debug", dev.debug);
-            cfg.SetBoolValue("dev", "showLogViewer", dev.showLogViewer);
-            cfg.SetBoolValue("dev", "showMusicControl", dev.showMusicControl);
-            cfg.SetValue("dev", "server", dev.server.c_str());
-            cfg.SetBoolValue("dev", "tls", dev.tls);
-
-            cfg.SetValue("other", "customTempDir", other.tempFolder.c_str());
-            cfg.SetLongValue("other", "logRetentionDays", other.logRetentionDays);
-            cfg.SetLongValue("other", "maxLogFiles", other.maxLogFiles);
-            cfg.SetBoolValue("other", "lastRunUnclean", other.lastRunUnclean);
-            cfg.SetBoolValue("other", "immediateSave", other.immediateSave);
-            cfg.SetLongValue("other", "newsDismissUntil", other.newsDismissUntil);
-            cfg.SetValue("other", "newsDismissVersion", other.newsDismissVersion.c_str());
-            cfg.SetBoolValue("other", "bgmEnabled", other.bgmEnabled);
-            cfg.SetDoubleValue("other", "bgmVolume", static_cast<double>(other.bgmVolume));
-
-            cfg.SetValue("minecraft", "minecraftFolder", minecraft.minecraftFolder.c_str());
-            cfg.SetValue("minecraft", "javaPath", minecraft.javaPath.c_str());
-            cfg.SetValue("minecraft", "downloadSource", minecraft.downloadSource.c_str());
-
-            cfg.SetValue("minecraft", "playerName", minecraft.playerName.c_str());
-            cfg.SetValue("minecraft", "account", minecraft.account.c_str());
-            cfg.SetValue("minecraft", "uuid", minecraft.uuid.c_str());
-            cfg.SetValue("minecraft", "accessToken", minecraft.accessToken.c_str());
-
-            cfg.SetValue("minecraft", "targetVersion", minecraft.targetVersion.c_str());
-
-            cfg.SetLongValue("minecraft", "maxMemoryLimit", minecraft.maxMemoryLimit);
-            cfg.SetLongValue("minecraft", "minMemoryLimit", minecraft.minMemoryLimit);
-            cfg.SetLongValue("minecraft", "needMemoryLimit", minecraft.needMemoryLimit);
-
-            cfg.SetValue("minecraft", "authlibName", minecraft.authlibName.c_str());
-            cfg.SetValue("minecraft", "authlibPrefetched", minecraft.authlibPrefetched.c_str());
-            cfg.SetValue("minecraft", "authlibSha256", minecraft.authlibSha256.c_str());
-
-            cfg.SetBoolValue("minecraft", "tolerantMode", minecraft.tolerantMode);
-
-            cfg.SetValue("minecraft", "customResolution", minecraft.customResolution.c_str());
-            cfg.SetValue("minecraft", "joinServerAddress", minecraft.joinServerAddress.c_str());
-            cfg.SetValue("minecraft", "joinServerPort", minecraft.joinServerPort.c_str());
+#define NEKO_CLIENT_CONFIG_WRITE(section, member, key, fallback) detail::clientConfig::writeField(cfg, #section, key, section.member);
+            NEKO_CLIENT_CONFIG_FIELDS(NEKO_CLIENT_CONFIG_WRITE)
+#undef NEKO_CLIENT_CONFIG_WRITE
+        }
+
+        /**
+         * @brief Calls `visitor(ConfigKey, lhsField, rhsField)` for every field of two configurations
+         */
+        template <typename Visitor>
+        static void forEachField(const ClientConfig &lhs, const ClientConfig &rhs, Visitor &&visitor) {
+#define NEKO_CLIENT_CONFIG_VISIT(section, member, key, fallback) visitor(ConfigKey{#section, key}, lhs.section.member, rhs.section.member);
+            NEKO_CLIENT_CONFIG_FIELDS(NEKO_CLIENT_CONFIG_VISIT)
+#undef NEKO_CLIENT_CONFIG_VISIT
+        }
+
+        /**
+         * @brief Fields whose value differs between this configuration and another one
+         */
+        std::vector<ConfigKey> diff(const ClientConfig &other) const {
+            std::vector<ConfigKey> changed;
+            forEachField(*this, other, [&changed](const ConfigKey &key, const auto &lhs, const auto &rhs) {
+                if (!(lhs == rhs)) {
+                    changed.push_back(key);
+                }
+            });
+            return changed;
         }
     };
-} // namespace neko
\ No newline at end of file
+
+    /**
+     * @brief One published configuration change: the snapshots before and after, and the fields that differ
+     */
+    struct ConfigChange {
+        neko::uint64 version = 0;
+        std::shared_ptr<const ClientConfig> previous;
+        std::shared_ptr<const ClientConfig> current;
+        std::vector<ConfigKey> keys;
+
+        bool empty() const noexcept {
+            return keys.empty();
+        }
+
+        bool contains(neko::strview section, neko::strview key) const noexcept {
+            for (const auto &k : keys) {
+                if (k.section == section && k.key == key) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool containsSection(neko::strview section) const noexcept {
+            for (const auto &k : keys) {
+                if (k.section == section) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+} // namespace neko
+
+#undef NEKO_CLIENT_CONFIG_FIELDS
@@ -2,50 +2,372 @@
 
 #include <SimpleIni.h>
 
+#include <neko/schema/types.hpp>
+
 #include "neko/app/clientConfig.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <string>
+#include <thread>
 
 #ifdef _DEBUG
 #    include <crtdbg.h>
 #endif
 
+#ifdef _WIN32
+#    include <fcntl.h>
+#    include <io.h>
+#    include <sys/stat.h>
+#else
+#    include <cerrno>
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
 namespace neko::app {
 
+    namespace detail::configFile {
+        /**
+         * @brief Write `data` to `path` (truncating it) and flush it to the device before returning.
+         */
+        inline bool writeDurably(const std::filesystem::path &path, const std::string &data) {
+#ifdef _WIN32
+            const int fd = ::_wopen(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+            if (fd < 0) {
+                return false;
+            }
+            bool ok = ::_write(fd, data.data(), static_cast<unsigned int>(data.size())) == static_cast<int>(data.size());
+            ok = ::_commit(fd) == 0 && ok;
+            ok = ::_close(fd) == 0 && ok;
+            return ok;
+#else
+            const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) {
+                return false;
+            }
+            bool ok = true;
+            for (std::size_t written = 0; ok && written < data.size();) {
+                const auto n = ::write(fd, data.data() + written, data.size() - written);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                ok = n > 0;
+                written += ok ? static_cast<std::size_t>(n) : 0;
+            }
+            ok = ::fsync(fd) == 0 && ok;
+            ok = ::close(fd) == 0 && ok;
+            return ok;
+#endif
+        }
+
+        /**
+         * @brief Flush a directory so a rename inside it survives a crash; Windows has no directory handle to sync.
+         */
+        inline void syncDirectory(const std::filesystem::path &dir) {
+#ifndef _WIN32
+            const int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (fd >= 0) {
+                (void)::fsync(fd);
+                (void)::close(fd);
+            }
+#else
+            (void)dir;
+#endif
+        }
+    } // namespace detail::configFile
+
     class ConfigManager {
+    public:
+        using Snapshot = std::shared_ptr<const neko::ClientConfig>;
+        using Change = std::shared_ptr<const neko::ConfigChange>;
+        using ChangeListener = std::function<void(const Change &)>;
+
     private:
+        // Guards the ini object; readers of the client config never take it.
         mutable std::shared_mutex mutex;
         CSimpleIniA ini;
 
+#if defined(__cpp_lib_atomic_shared_ptr)
+        std::atomic<Snapshot> snapshot{std::make_shared<const neko::ClientConfig>(ini)};
+
+        Snapshot loadSnapshot() const noexcept {
+            return snapshot.load(std::memory_order_acquire);
+        }
+        void storeSnapshot(Snapshot next) noexcept {
+            snapshot.store(std::move(next), std::memory_order_release);
+        }
+#else
+        Snapshot snapshot = std::make_shared<const neko::ClientConfig>(ini);
+
+        Snapshot loadSnapshot() const noexcept {
+            return std::atomic_load_explicit(&snapshot, std::memory_order_acquire);
+        }
+        void storeSnapshot(Snapshot next) noexcept {
+            std::atomic_store_explicit(&snapshot, std::move(next), std::memory_order_release);
+        }
+#endif
+        std::atomic<neko::uint64> version{0};
+
+        std::mutex listenerMutex;
+        ChangeListener changeListener;
+
+        // Caller holds the unique lock.
+        Change publish(Snapshot next) {
+            auto change = std::make_shared<neko::ConfigChange>();
+            change->previous = loadSnapshot();
+            change->keys = change->previous->diff(*next);
+            change->current = next;
+            storeSnapshot(std::move(next));
+            change->version = version.fetch_add(1, std::memory_order_acq_rel) + 1;
+            return change;
+        }
+
+        // Called without the config lock, so listeners may read or update the config.
+        void notify(const Change &change) {
+            if (change->empty()) {
+                return;
+            }
+            ChangeListener listener;
+            {
+                std::lock_guard lock(listenerMutex);
+                listener = changeListener;
+            }
+            if (listener) {
+                listener(change);
+            }
+        }
+
+        // Debounced writer: saveAsync() marks a file dirty, the writer thread persists it once the delay has passed.
+        std::mutex fileMutex; // serializes serialize+write so a later state is never overwritten by an earlier one
+        std::mutex writerMutex;
+        std::condition_variable writerCv;
+        std::optional<std::string> pendingFile;
+        std::chrono::steady_clock::time_point pendingDue;
+        bool writing = false;
+        bool writerStopping = false;
+        std::thread writer;
+        std::atomic<neko::int64> saveDelayMs{500};
+        std::atomic<bool> lastWriteOk{true};
+        std::atomic<neko::uint64> writeCount{0};
+
+        /**
+         * @brief Write to `<file>.tmp`, sync it, rename it over the target and sync the directory,
+         * so the file on disk is always complete, even after a power loss.
+         */
+        static bool writeAtomically(const std::string &filename, const std::string &data) {
+            namespace fs = std::filesystem;
+            const fs::path target(filename);
+            fs::path temp = target;
+            temp += ".tmp";
+
+            std::error_code ec;
+            if (!detail::configFile::writeDurably(temp, data)) {
+                fs::remove(temp, ec);
+                return false;
+            }
+            fs::rename(temp, target, ec);
+            if (ec) {
+                fs::remove(temp, ec);
+                return false;
+            }
+            detail::configFile::syncDirectory(target.parent_path());
+            return true;
+        }
+
+        bool writeNow(const std::string &filename) {
+            std::lock_guard fileLock(fileMutex);
+            std::string data;
+            {
+                std::shared_lock lock(mutex);
+                if (ini.Save(data) != SI_OK) {
+                    lastWriteOk.store(false, std::memory_order_release);
+                    return false;
+                }
+            }
+            const bool ok = writeAtomically(filename, data);
+            if (ok) {
+                writeCount.fetch_add(1, std::memory_order_acq_rel);
+            }
+            lastWriteOk.store(ok, std::memory_order_release);
+            return ok;
+        }
+
+        void writerLoop() {
+            std::unique_lock lock(writerMutex);
+            while (true) {
+                writerCv.wait(lock, [this] { return writerStopping || pendingFile.has_value(); });
+                if (writerStopping) {
+                    return; // the destructor flushes whatever is left
+                }
+                // Saves requested during the window join this write; the window is not extended,
+                // so a steady stream of updates still reaches the disk.
+                if (writerCv.wait_until(lock, pendingDue, [this] { return writerStopping || !pendingFile; })) {
+                    continue;
+                }
+                const std::string file = std::move(*pendingFile);
+                pendingFile.reset();
+                writing = true;
+                lock.unlock();
+                writeNow(file);
+                lock.lock();
+                writing = false;
+                writerCv.notify_all();
+            }
+        }
+
     public:
+        ConfigManager() = default;
+
+        ConfigManager(const ConfigManager &) = delete;
+        ConfigManager &operator=(const ConfigManager &) = delete;
+
+        ~ConfigManager() {
+            {
+                std::lock_guard lock(writerMutex);
+                writerStopping = true;
+            }
+            writerCv.notify_all();
+            if (writer.joinable()) {
+                writer.join();
+            }
+            flush();
+        }
+
         bool load(const std::string &filename) {
-            std::unique_lock lock(mutex);
-            return ini.LoadFile(filename.c_str()) == SI_OK;
+            Change change;
+            bool ok = false;
+            {
+                std::unique_lock lock(mutex);
+                ok = ini.LoadFile(filename.c_str()) == SI_OK;
+                change = publish(std::make_shared<const neko::ClientConfig>(ini));
+            }
+            notify(change);
+            return ok;
         }
 
+        /**
+         * @brief Write the configuration to disk now, replacing the file atomically
+         * @note Also satisfies a pending saveAsync() for the same file.
+         */
         bool save(const std::string &filename) {
-            std::shared_lock lock(mutex);
-            return ini.SaveFile(filename.c_str()) == SI_OK;
+            {
+                std::lock_guard lock(writerMutex);
+                if (pendingFile == filename) {
+                    pendingFile.reset();
+                }
+            }
+            writerCv.notify_all();
+            return writeNow(filename);
+        }
+
+        /**
+         * @brief Request a save without blocking the caller
+         *
+         * Requests within the save delay are coalesced into one write of the latest state,
+         * performed on a writer thread (temp file + rename). Use flush() where the file must be
+         * on disk before continuing, e.g. at shutdown or before handing control to another process.
+         */
+        void saveAsync(const std::string &filename) {
+            std::optional<std::string> previous;
+            bool writeInline = saveDelayMs.load(std::memory_order_relaxed) <= 0;
+            {
+                std::lock_guard lock(writerMutex);
+                writeInline = writeInline || writerStopping;
+                if (!writeInline) {
+                    if (!writer.joinable()) {
+                        writer = std::thread([this]() { writerLoop(); });
+                    }
+                    if (pendingFile && *pendingFile != filename) {
+                        previous.swap(pendingFile);
+                    }
+                    if (!pendingFile) {
+                        pendingDue = std::chrono::steady_clock::now() + std::chrono::milliseconds(saveDelayMs.load(std::memory_order_relaxed));
+                    }
+                    pendingFile = filename;
+                }
+            }
+            writerCv.notify_all();
+            if (previous) {
+                writeNow(*previous);
+            }
+            if (writeInline) {
+                writeNow(filename);
+            }
+        }
+
+        /**
+         * @brief Perform any pending save now and wait for an in-flight write to finish
+         * @return false if the last write failed
+         */
+        bool flush() {
+            std::optional<std::string> file;
+            {
+                std::unique_lock lock(writerMutex);
+                file.swap(pendingFile);
+                writerCv.notify_all();
+                writerCv.wait(lock, [this] { return !writing; });
+            }
+            if (file) {
+                return writeNow(*file);
+            }
+            return lastWriteOk.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Set how long saveAsync() waits to coalesce further saves; 0 writes inline
+         */
+        void setSaveDelay(std::chrono::milliseconds delay) {
+            saveDelayMs.store(delay.count(), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Number of successful writes to disk (sync and async)
+         */
+        neko::uint64 getWriteCount() const noexcept {
+            return writeCount.load(std::memory_order_acquire);
         }
 
         /**
          * @brief Atomic update of the client configuration
          * @param updaterFunc Function to update the client configuration. After assignment is completed, the value will be written back to ini object
+         * @note The updater edits a copy of the current snapshot; the result is written to the ini object
+         *       and published as the new snapshot. Snapshots already handed out are never modified.
+         * @return The change, listing only the fields the updater actually modified
          */
-        void updateClientConfig(std::function<void(neko::ClientConfig &)> updaterFunc) {
+        Change updateClientConfig(std::function<void(neko::ClientConfig &)> updaterFunc) {
 #ifdef _DEBUG
             _ASSERTE(_CrtCheckMemory());
 #endif
-            std::unique_lock lock(mutex);
-            neko::ClientConfig cfg(ini);
-            updaterFunc(cfg);
-            cfg.setToConfig(ini);
+            Change change;
+            {
+                std::unique_lock lock(mutex);
+                auto cfg = std::make_shared<neko::ClientConfig>(*loadSnapshot());
+                updaterFunc(*cfg);
+                cfg->setToConfig(ini);
+                change = publish(std::move(cfg));
+            }
+            notify(change);
 #ifdef _DEBUG
             _ASSERTE(_CrtCheckMemory());
 #endif
+            return change;
+        }
+
+        /**
+         * @brief Set the callback invoked after each load or update that changed at least one field
+         * @note Runs on the updating thread; with concurrent writers, use ConfigChange::version to drop stale changes.
+         */
+        void setChangeListener(ChangeListener listener) {
+            std::lock_guard lock(listenerMutex);
+            changeListener = std::move(listener);
         }
 
         /**
@@ -54,8 +376,23 @@ namespace neko::app {
          * @note This function returns a copy of the configuration, which may not be consistent with the latest state
          */
         neko::ClientConfig getClientConfig() const {
-            std::shared_lock lock(mutex);
-            return neko::ClientConfig(ini);
+            return *loadSnapshot();
+        }
+
+        /**
+         * @brief Get the current immutable configuration snapshot without copying it
+         * @return Shared snapshot; it stays valid and unchanged after later updates
+         */
+        Snapshot getSnapshot() const noexcept {
+            return loadSnapshot();
+        }
+
+        /**
+         * @brief Number of snapshots published so far (each load and update publishes one)
+         * @note Cheap way for callers caching derived state to detect a change.
+         */
+        neko::uint64 getVersion() const noexcept {
+            return version.load(std::memory_order_acquire);
         }
     };
 
@@ -0,0 +1,541 @@
+/**
+ * @see neko/app/appinit.hpp
+ * @file hostProbe.hpp
+ * @brief Concurrent host probing with latency ranking, periodic re-probing and a persisted health cache.
+ */
+
+#pragma once
+
+#include <neko/log/nlog.hpp>
+#include <neko/schema/types.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace neko::app::hosts {
+
+    /**
+     * @brief Outcome of probing one host.
+     */
+    struct ProbeResult {
+        std::string host;
+        bool healthy = false;
+        /**
+         * @brief Round-trip time measured by the prober around the probe call.
+         */
+        std::chrono::milliseconds rtt{0};
+        std::string error;
+    };
+
+    /**
+     * @brief What is remembered about a host across launches.
+     */
+    struct HostHealth {
+        std::string host;
+        /**
+         * @brief Unix time in ms of the last successful probe; 0 if it never answered.
+         */
+        neko::int64 lastSuccessMs = 0;
+        /**
+         * @brief Smoothed round-trip time; meaningful only if lastSuccessMs is set.
+         */
+        double rttMs = 0.0;
+        /**
+         * @brief Failed probes since the last success.
+         */
+        neko::uint32 failureStreak = 0;
+    };
+
+    /**
+     * @brief Healthy hosts ordered by smoothed round-trip time; ties keep the configured order.
+     *
+     * Each healthy probe folds its RTT into an exponential moving average (weight `Smoothing`),
+     * so one slow sample does not reorder hosts. A failed probe drops the host until it answers again.
+     * Health can be exported and restored, so a new launch starts from the last known ranking.
+     */
+    class HostRanking {
+    public:
+        /**
+         * @brief Called after a probe changed the ranked order.
+         */
+        using Listener = std::function<void()>;
+        using Clock = std::chrono::system_clock;
+        static constexpr double Smoothing = 0.3;
+
+    private:
+        struct Entry {
+            std::string host;
+            bool healthy = false;
+            bool measured = false;
+            double smoothedMs = 0.0;
+            Clock::time_point lastSuccess{};
+            neko::uint32 failureStreak = 0;
+        };
+
+        mutable std::mutex mutex;
+        std::vector<Entry> entries;
+        std::vector<std::string> ranked;
+        Listener listener;
+
+        // Caller holds the lock.
+        std::vector<std::string> rankLocked() const {
+            std::vector<const Entry *> healthy;
+            for (const auto &entry : entries) {
+                if (entry.healthy) {
+                    healthy.push_back(&entry);
+                }
+            }
+            std::stable_sort(healthy.begin(), healthy.end(), [](const Entry *a, const Entry *b) {
+                return a->smoothedMs < b->smoothedMs;
+            });
+            std::vector<std::string> result;
+            result.reserve(healthy.size());
+            for (const auto *entry : healthy) {
+                result.push_back(entry->host);
+            }
+            return result;
+        }
+
+        // Caller holds the lock. Returns the listener to call if the order changed.
+        Listener rerankLocked() {
+            auto next = rankLocked();
+            if (next == ranked) {
+                return {};
+            }
+            ranked = std::move(next);
+            return listener;
+        }
+
+    public:
+        explicit HostRanking(const std::vector<std::string> &hosts) {
+            entries.reserve(hosts.size());
+            for (const auto &host : hosts) {
+                entries.push_back(Entry{.host = host});
+            }
+        }
+
+        /**
+         * @brief Fold a probe result into the ranking. Results for unknown hosts are ignored.
+         */
+        void record(const ProbeResult &result) {
+            Listener notify;
+            {
+                std::lock_guard lock(mutex);
+                auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry &entry) { return entry.host == result.host; });
+                if (it == entries.end()) {
+                    return;
+                }
+                it->healthy = result.healthy;
+                if (result.healthy) {
+                    const auto sample = static_cast<double>(result.rtt.count());
+                    it->smoothedMs = it->measured ? (1.0 - Smoothing) * it->smoothedMs + Smoothing * sample : sample;
+                    it->measured = true;
+                    it->lastSuccess = Clock::now();
+                    it->failureStreak = 0;
+                } else {
+                    ++it->failureStreak;
+                }
+                notify = rerankLocked();
+            }
+            if (notify) {
+                notify();
+            }
+        }
+
+        /**
+         * @brief Seed the ranking from persisted health. A host counts as healthy if it answered
+         * within `maxAge` and has not failed since; it stays so until a probe says otherwise.
+         */
+        void restore(const std::vector<HostHealth> &health, std::chrono::milliseconds maxAge) {
+            Listener notify;
+            {
+                std::lock_guard lock(mutex);
+                const auto now = Clock::now();
+                for (const auto &saved : health) {
+                    auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry &entry) { return entry.host == saved.host; });
+                    if (it == entries.end() || saved.lastSuccessMs <= 0) {
+                        continue;
+                    }
+                    it->lastSuccess = Clock::time_point(std::chrono::milliseconds(saved.lastSuccessMs));
+                    it->smoothedMs = saved.rttMs;
+                    it->measured = true;
+                    it->failureStreak = saved.failureStreak;
+                    it->healthy = saved.failureStreak == 0 && now - it->lastSuccess <= maxAge;
+                }
+                notify = rerankLocked();
+            }
+            if (notify) {
+                notify();
+            }
+        }
+
+        /**
+         * @brief Health of every configured host, for persisting.
+         */
+        std::vector<HostHealth> getHealth() const {
+            std::lock_guard lock(mutex);
+            std::vector<HostHealth> result;
+            result.reserve(entries.size());
+            for (const auto &entry : entries) {
+                result.push_back(HostHealth{
+                    .host = entry.host,
+                    .lastSuccessMs = entry.measured ? std::chrono::duration_cast<std::chrono::milliseconds>(entry.lastSuccess.time_since_epoch()).count() : 0,
+                    .rttMs = entry.smoothedMs,
+                    .failureStreak = entry.failureStreak});
+            }
+            return result;
+        }
+
+        /**
+         * @brief Install the change listener. It runs on the probing thread and should read getRanked().
+         */
+        void setListener(Listener next) {
+            std::lock_guard lock(mutex);
+            listener = std::move(next);
+        }
+
+        std::vector<std::string> getRanked() const {
+            std::lock_guard lock(mutex);
+            return ranked;
+        }
+
+        /**
+         * @brief Smoothed RTT of a host that has answered at least once.
+         */
+        std::optional<std::chrono::milliseconds> getRtt(const std::string &host) const {
+            std::lock_guard lock(mutex);
+            for (const auto &entry : entries) {
+                if (entry.host == host && entry.measured) {
+                    return std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(entry.smoothedMs + 0.5));
+                }
+            }
+            return std::nullopt;
+        }
+    };
+
+    /**
+     * @brief Read persisted host health; an empty result if the file is missing or unreadable.
+     */
+    inline std::vector<HostHealth> loadHealth(const std::string &path) {
+        std::vector<HostHealth> result;
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            return result;
+        }
+        try {
+            const auto json = nlohmann::json::parse(file);
+            for (const auto &item : json.at("hosts")) {
+                result.push_back(HostHealth{
+                    .host = item.at("host").get<std::string>(),
+                    .lastSuccessMs = item.value("lastSuccessMs", neko::int64(0)),
+                    .rttMs = item.value("rttMs", 0.0),
+                    .failureStreak = item.value("failureStreak", neko::uint32(0))});
+            }
+        } catch (const nlohmann::json::exception &e) {
+            log::warn("Ignoring unreadable host health cache {}: {}", {}, path, e.what());
+            result.clear();
+        }
+        return result;
+    }
+
+    /**
+     * @brief Write host health to `<path>.tmp` and rename it over `path`.
+     * @return false if the cache folder is not writable.
+     */
+    inline bool saveHealth(const std::string &path, const std::vector<HostHealth> &health) {
+        nlohmann::json hosts = nlohmann::json::array();
+        for (const auto &item : health) {
+            hosts.push_back({{"host", item.host},
+                             {"lastSuccessMs", item.lastSuccessMs},
+                             {"rttMs", item.rttMs},
+                             {"failureStreak", item.failureStreak}});
+        }
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+        const std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::trunc);
+            if (!file.is_open() || !(file << nlohmann::json{{"hosts", hosts}}.dump())) {
+                return false;
+            }
+        }
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec) {
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+    struct HostProberOptions {
+        /**
+         * @brief How long probeAll() waits for a healthy host; slower probes keep running.
+         */
+        std::chrono::milliseconds deadline = std::chrono::seconds(3);
+        /**
+         * @brief Pause between background re-probe rounds.
+         */
+        std::chrono::milliseconds interval = std::chrono::minutes(2);
+        /**
+         * @brief How recent a persisted success must be for warmStart() to trust the host.
+         */
+        std::chrono::milliseconds maxHealthAge = std::chrono::hours(24);
+    };
+
+    /**
+     * @brief Probes every host concurrently and keeps a HostRanking up to date.
+     *
+     * probeAll() returns as soon as the first host answers (or the deadline passes); the other
+     * probes finish in the background and re-rank through the ranking's listener. A host whose
+     * probe is still running is not probed again; the new round waits on the running probe instead,
+     * so a hung host costs one task at most. With a cache file, health is saved after every probe
+     * and warmStart() restores it on the next launch.
+     */
+    class HostProber {
+    public:
+        using Clock = std::chrono::steady_clock;
+        /**
+         * @brief Performs one request against a host; sets `healthy` and `error`. Exceptions count as unhealthy.
+         */
+        using Probe = std::function<ProbeResult(const std::string &host)>;
+        /**
+         * @brief Runs a probe off the calling thread.
+         */
+        using Spawner = std::function<void(std::function<void()>)>;
+        using Options = HostProberOptions;
+
+    private:
+        struct Round {
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::size_t pending = 0;
+            bool healthySeen = false;
+            // Called once, on the probing thread, by the first healthy answer.
+            std::function<void()> onHealthy;
+
+            void complete(bool healthy) {
+                std::function<void()> notify;
+                {
+                    std::lock_guard lock(mutex);
+                    --pending;
+                    if (healthy && !healthySeen) {
+                        notify = std::move(onHealthy);
+                    }
+                    healthySeen = healthySeen || healthy;
+                }
+                cv.notify_all();
+                if (notify) {
+                    notify();
+                }
+            }
+        };
+
+        struct Shared {
+            std::vector<std::string> hosts;
+            Probe probe;
+            Spawner spawner;
+            std::string cacheFile;
+            HostRanking ranking;
+
+            std::mutex mutex;
+            // Rounds waiting on each running probe.
+            std::map<std::string, std::vector<std::shared_ptr<Round>>> inFlight;
+            std::mutex persistMutex;
+
+            Shared(std::vector<std::string> list, Probe probeFn, Spawner spawnFn, std::string file)
+                : hosts(std::move(list)), probe(std::move(probeFn)), spawner(std::move(spawnFn)), cacheFile(std::move(file)), ranking(hosts) {}
+        };
+
+        std::shared_ptr<Shared> shared;
+        Options options;
+
+        std::mutex periodicMutex;
+        std::condition_variable periodicCv;
+        bool stopping = false;
+        std::thread periodicThread;
+
+        static void persist(Shared &s) {
+            if (s.cacheFile.empty()) {
+                return;
+            }
+            std::lock_guard lock(s.persistMutex);
+            if (!saveHealth(s.cacheFile, s.ranking.getHealth())) {
+                log::warn("Cannot write host health cache {}", {}, s.cacheFile);
+            }
+        }
+
+        static void runProbe(const std::shared_ptr<Shared> &s, const std::string &host) {
+            ProbeResult result;
+            const auto begin = Clock::now();
+            try {
+                result = s->probe(host);
+            } catch (const std::exception &e) {
+                result.healthy = false;
+                result.error = e.what();
+            } catch (...) {
+                result.healthy = false;
+                result.error = "Unknown error";
+            }
+            result.host = host;
+            result.rtt = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - begin);
+
+            if (result.healthy) {
+                log::info("Host probe ok: {}, rtt {} ms", {}, host, result.rtt.count());
+            } else {
+                log::warn("Host probe failed: {}, after {} ms: {}", {}, host, result.rtt.count(), result.error);
+            }
+            s->ranking.record(result);
+            persist(*s);
+
+            std::vector<std::shared_ptr<Round>> waiting;
+            {
+                std::lock_guard lock(s->mutex);
+                auto it = s->inFlight.find(host);
+                if (it != s->inFlight.end()) {
+                    waiting = std::move(it->second);
+                    s->inFlight.erase(it);
+                }
+            }
+            for (const auto &round : waiting) {
+                round->complete(result.healthy);
+            }
+        }
+
+        // Start (or join) a probe of every host; returns the round tracking them.
+        std::shared_ptr<Round> startRound(std::function<void()> onHealthy = {}) {
+            auto round = std::make_shared<Round>();
+            round->onHealthy = std::move(onHealthy);
+            std::vector<std::string> started;
+            {
+                std::lock_guard lock(shared->mutex);
+                round->pending = shared->hosts.size();
+                for (const auto &host : shared->hosts) {
+                    auto [it, inserted] = shared->inFlight.try_emplace(host);
+                    it->second.push_back(round);
+                    if (inserted) {
+                        started.push_back(host);
+                    }
+                }
+            }
+
+            for (const auto &host : started) {
+                try {
+                    shared->spawner([s = shared, host]() { runProbe(s, host); });
+                } catch (...) {
+                    runProbe(shared, host);
+                }
+            }
+            return round;
+        }
+
+    public:
+        /**
+         * @param cacheFile Where host health is kept across launches; empty disables persistence.
+         */
+        HostProber(std::vector<std::string> hosts, Probe probe, Spawner spawner, std::string cacheFile = {}, Options options = {})
+            : shared(std::make_shared<Shared>(std::move(hosts), std::move(probe), std::move(spawner), std::move(cacheFile))), options(options) {}
+
+        ~HostProber() {
+            stop();
+        }
+
+        HostProber(const HostProber &) = delete;
+        HostProber &operator=(const HostProber &) = delete;
+
+        /**
+         * @brief Probe every host at once and wait for the first healthy answer or the deadline.
+         * @return The ranking at release; usually just the fastest host, later answers re-rank it.
+         */
+        std::vector<std::string> probeAll() {
+            auto round = startRound();
+            {
+                std::unique_lock lock(round->mutex);
+                round->cv.wait_for(lock, options.deadline, [&]() { return round->healthySeen || round->pending == 0; });
+            }
+            return shared->ranking.getRanked();
+        }
+
+        /**
+         * @brief Probe every host in the background without waiting.
+         * @param onHealthy Called once if a host answers, after the ranking has been updated.
+         */
+        void refresh(std::function<void()> onHealthy = {}) {
+            (void)startRound(std::move(onHealthy));
+        }
+
+        /**
+         * @brief Restore the persisted health of the last launch.
+         * @return Hosts that answered within `maxHealthAge` and have not failed since, fastest first;
+         *         empty if there is no usable cache and a full probe is needed.
+         */
+        std::vector<std::string> warmStart() {
+            if (!shared->cacheFile.empty()) {
+                shared->ranking.restore(loadHealth(shared->cacheFile), options.maxHealthAge);
+            }
+            return shared->ranking.getRanked();
+        }
+
+        /**
+         * @brief Count a failed real request against a host, dropping it from the ranking.
+         */
+        void markFailed(const std::string &host, const std::string &reason) {
+            log::warn("Host marked failed: {}: {}", {}, host, reason);
+            shared->ranking.record(ProbeResult{.host = host, .healthy = false, .error = reason});
+            persist(*shared);
+        }
+
+        /**
+         * @brief Re-probe every `interval` on a dedicated thread until stop(). No-op if already running.
+         */
+        void startPeriodic() {
+            std::lock_guard lock(periodicMutex);
+            if (periodicThread.joinable() || stopping) {
+                return;
+            }
+            periodicThread = std::thread([this]() {
+                std::unique_lock lock(periodicMutex);
+                while (!periodicCv.wait_for(lock, options.interval, [this]() { return stopping; })) {
+                    lock.unlock();
+                    (void)probeAll();
+                    lock.lock();
+                }
+            });
+        }
+
+        /**
+         * @brief Stop periodic re-probing and join its thread. Probes already spawned still finish.
+         */
+        void stop() {
+            {
+                std::lock_guard lock(periodicMutex);
+                stopping = true;
+            }
+            periodicCv.notify_all();
+            if (periodicThread.joinable() && periodicThread.get_id() != std::this_thread::get_id()) {
+                periodicThread.join();
+            }
+        }
+
+        HostRanking &getRanking() noexcept {
+            return shared->ranking;
+        }
+    };
+
+} // namespace neko::app::hosts
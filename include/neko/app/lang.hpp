@@ -6,16 +6,24 @@
 #include <neko/log/nlog.hpp>
 #include <neko/system/platform.hpp>
 
+#include "neko/app/languagePack.hpp"
 #include "neko/app/nekoLc.hpp"
+#include "neko/app/translationTable.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -44,6 +52,338 @@ namespace neko::lang {
         return langErrorRef();
     }
 
+    namespace detail {
+        struct LoadedTranslations {
+            neko::uint64 generation = 0;
+            TranslationTable table;
+        };
+
+        /**
+         * @brief Current translation table, published as an immutable snapshot.
+         * Readers do one atomic load; a rebuild happens only after the generation moves on
+         * (language change or explicit reload).
+         */
+        struct TranslationState {
+            using Snapshot = std::shared_ptr<const LoadedTranslations>;
+
+            std::mutex buildMutex;
+            std::atomic<neko::uint64> generation{1};
+            std::string folderOverride; // guarded by buildMutex
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+            std::atomic<Snapshot> snapshot;
+
+            Snapshot load() const noexcept {
+                return snapshot.load(std::memory_order_acquire);
+            }
+            void store(Snapshot next) noexcept {
+                snapshot.store(std::move(next), std::memory_order_release);
+            }
+#else
+            Snapshot snapshot;
+
+            Snapshot load() const noexcept {
+                return std::atomic_load_explicit(&snapshot, std::memory_order_acquire);
+            }
+            void store(Snapshot next) noexcept {
+                std::atomic_store_explicit(&snapshot, std::move(next), std::memory_order_release);
+            }
+#endif
+        };
+
+        inline TranslationState &translationState() {
+            static TranslationState state;
+            return state;
+        }
+
+        template <std::size_t... N>
+        consteval auto joinKeys(const std::array<Key, N> &...groups) {
+            std::array<Key, (N + ...)> all{};
+            std::size_t next = 0;
+            ((std::copy(groups.begin(), groups.end(), all.begin() + next), next += groups.size()), ...);
+            return all;
+        }
+
+        template <std::size_t N>
+        consteval bool isDense(const std::array<Key, N> &all) {
+            for (std::size_t i = 0; i < N; ++i) {
+                if (all[i].id != i) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    } // namespace detail
+
+    namespace keys {
+
+        /**
+         * @brief Keys of each category as `X(identifier, "name in the language file")`.
+         * @details Each list expands to the `keys::<category>::<identifier>` constants and to the
+         * `keys::all` registry, so appending an entry is all it takes to give a key its dense ID.
+         */
+#define NEKO_LANG_KEYS_SETTING(X)                       \
+    X(tabAccount, "tabAccount")                         \
+    X(tabMain, "tabMain")                               \
+    X(tabAdvanced, "tabAdvanced")                       \
+    X(groupMain, "groupMain")                           \
+    X(groupStyle, "groupStyle")                         \
+    X(groupNetwork, "groupNetwork")                     \
+    X(groupOther, "groupOther")                         \
+    X(groupMinecraft, "groupMinecraft")                 \
+    X(groupAdvanced, "groupAdvanced")                   \
+    X(language, "language")                             \
+    X(backgroundType, "backgroundType")                 \
+    X(backgroundTypeImage, "backgroundTypeImage")       \
+    X(backgroundTypeNone, "backgroundTypeNone")         \
+    X(background, "background")                         \
+    X(selectBackground, "selectBackground")             \
+    X(imageFileFilter, "imageFileFilter")               \
+    X(windowSize, "windowSize")                         \
+    X(launcherMethod, "launcherMethod")                 \
+    X(launcherVisible, "launcherVisible")               \
+    X(launcherExit, "launcherExit")                     \
+    X(launcherHideRestore, "launcherHideRestore")       \
+    X(themeLight, "themeLight")                         \
+    X(themeDark, "themeDark")                           \
+    X(themeSystem, "themeSystem")                       \
+    X(useSysWindowFrame, "useSysWindowFrame")           \
+    X(headBarKeepRight, "headBarKeepRight")             \
+    X(theme, "theme")                                   \
+    X(animationStyle, "animationStyle")                 \
+    X(animationNone, "animationNone")                   \
+    X(animationMinimal, "animationMinimal")             \
+    X(animationSmooth, "animationSmooth")               \
+    X(animationiOS, "animationiOS")                     \
+    X(animationBounce, "animationBounce")               \
+    X(blurEffect, "blurEffect")                         \
+    X(blurEffectPerformance, "blurEffectPerformance")   \
+    X(blurEffectQuality, "blurEffectQuality")           \
+    X(blurEffectAnimation, "blurEffectAnimation")       \
+    X(blurRadius, "blurRadius")                         \
+    X(fontSize, "fontSize")                             \
+    X(fontFamilies, "fontFamilies")                     \
+    X(threads, "threads")                               \
+    X(useSystemProxy, "useSystemProxy")                 \
+    X(proxyPlaceholder, "proxyPlaceholder")             \
+    X(immediateSave, "immediateSave")                   \
+    X(customTempDir, "customTempDir")                   \
+    X(selectTempDir, "selectTempDir")                   \
+    X(javaPath, "javaPath")                             \
+    X(browseJava, "browseJava")                         \
+    X(javaExecutableFilter, "javaExecutableFilter")     \
+    X(downloadSource, "downloadSource")                 \
+    X(downloadSourceOfficial, "downloadSourceOfficial") \
+    X(downloadSourceBmclapi, "downloadSourceBmclapi")   \
+    X(playerName, "playerName")                         \
+    X(customResolution, "customResolution")             \
+    X(joinServerAddress, "joinServerAddress")           \
+    X(joinServerPort, "joinServerPort")                 \
+    X(devEnable, "devEnable")                           \
+    X(devDebug, "devDebug")                             \
+    X(devShowLogViewer, "devShowLogViewer")             \
+    X(devShowMusicControl, "devShowMusicControl")       \
+    X(devTls, "devTls")                                 \
+    X(devServer, "devServer")                           \
+    X(useDefaultServer, "useDefaultServer")             \
+    X(devServerPlaceholder, "devServerPlaceholder")     \
+    X(notLoggedIn, "notLoggedIn")                       \
+    X(login, "login")                                   \
+    X(logout, "logout")                                 \
+    X(close, "close")
+
+#define NEKO_LANG_KEYS_LOADING(X)    \
+    X(starting, "starting...")       \
+    X(preparing, "preparing...")     \
+    X(downloading, "downloading...") \
+    X(extracting, "extracting...")   \
+    X(finalizing, "finalizing...")   \
+    X(cancelling, "cancelling...")
+
+#define NEKO_LANG_KEYS_LAUNCHER(X)                \
+    X(launchFailedTitle, "launchFailedTitle")     \
+    X(launchFailedMessage, "launchFailedMessage")
+
+#define NEKO_LANG_KEYS_ABOUT(X)     \
+    X(title, "title")               \
+    X(tagline, "tagline")           \
+    X(description, "description")   \
+    X(openRepo, "openRepo")         \
+    X(feedbackLogs, "feedbackLogs")
+
+#define NEKO_LANG_KEYS_INPUT(X)   \
+    X(title, "title")             \
+    X(message, "message")         \
+    X(placeholder, "placeholder") \
+    X(password, "password")
+
+#define NEKO_LANG_KEYS_MAINTENANCE(X)   \
+    X(title, "title")                   \
+    X(message, "message")               \
+    X(checkingStatus, "checkingStatus") \
+    X(parseIng, "parseIng")             \
+    X(downloadPoster, "downloadPoster")
+
+#define NEKO_LANG_KEYS_NEWS(X)                  \
+    X(title, "title")                           \
+    X(noNews, "noNews")                         \
+    X(loading, "loading")                       \
+    X(loadMore, "loadMore")                     \
+    X(readMore, "readMore")                     \
+    X(dismissNone, "dismissNone")               \
+    X(dismiss3Days, "dismiss3Days")             \
+    X(dismiss7Days, "dismiss7Days")             \
+    X(dismissUntilUpdate, "dismissUntilUpdate") \
+    X(continueBtn, "continue")
+
+#define NEKO_LANG_KEYS_UPDATE(X)                \
+    X(title, "title")                           \
+    X(startingUpdate, "startingUpdate")         \
+    X(checkingForUpdates, "checkingForUpdates") \
+    X(parsingUpdateData, "parsingUpdateData")   \
+    X(updateAvailable, "updateAvailable")       \
+    X(noUpdateAvailable, "noUpdateAvailable")   \
+    X(downloadingUpdate, "downloadingUpdate")   \
+    X(applyingUpdate, "applyingUpdate")         \
+    X(updateStages, "updateStages")
+
+#define NEKO_LANG_KEYS_BUTTON(X) \
+    X(open, "open")              \
+    X(close, "close")            \
+    X(ok, "ok")                  \
+    X(cancel, "cancel")          \
+    X(yes, "yes")                \
+    X(no, "no")                  \
+    X(start, "start")            \
+    X(menu, "menu")              \
+    X(maximize, "maximize")      \
+    X(minimize, "minimize")      \
+    X(restore, "restore")        \
+    X(apply, "apply")            \
+    X(quit, "quit")              \
+    X(retry, "retry")            \
+    X(input, "input")            \
+    X(edit, "edit")
+
+#define NEKO_LANG_KEYS_MINECRAFT(X)                   \
+    X(missingAccessToken, "missingAccessToken")       \
+    X(installStart, "installStart")                   \
+    X(fetchVersionList, "fetchVersionList")           \
+    X(fetchVersionInfo, "fetchVersionInfo")           \
+    X(checkingFiles, "checkingFiles")                 \
+    X(downloadingAssetIndex, "downloadingAssetIndex") \
+    X(downloadingLibrary, "downloadingLibrary")       \
+    X(downloadingClient, "downloadingClient")         \
+    X(downloadingAssets, "downloadingAssets")         \
+    X(savingVersion, "savingVersion")                 \
+    X(installing, "installing")                       \
+    X(completed, "completed")
+
+#define NEKO_LANG_KEYS_ERROR(X)                             \
+    X(invalidInput, "invalidInput")                         \
+    X(networkError, "networkError")                         \
+    X(networkInitFailed, "networkInitFailed")               \
+    X(networkInitFailedMessage, "networkInitFailedMessage") \
+    X(parseError, "parseError")                             \
+    X(updateFailed, "updateFailed")                         \
+    X(launchFailed, "launchFailed")                         \
+    X(seeLog, "seeLog")
+
+#define NEKO_LANG_KEYS_NETWORK(X)       \
+    X(retrying, "retrying")             \
+    X(testConnection, "testConnection") \
+    X(goToSettings, "goToSettings")     \
+    X(skip, "skip")
+
+#define NEKO_LANG_KEY_INDEX(identifier, name) identifier,
+#define NEKO_LANG_KEY_DEFINE(identifier, name) constexpr Key identifier{category, name, firstId + index::identifier};
+#define NEKO_LANG_KEY_ENTRY(identifier, name) identifier,
+#define NEKO_LANG_KEY_CATEGORY(name, first, list)                           \
+    constexpr neko::cstr category = name;                                   \
+    constexpr neko::uint32 firstId = first;                                 \
+    namespace index {                                                       \
+        enum : neko::uint32 { list(NEKO_LANG_KEY_INDEX) count };            \
+    }                                                                       \
+    list(NEKO_LANG_KEY_DEFINE)                                              \
+    constexpr std::array<Key, index::count> all{list(NEKO_LANG_KEY_ENTRY)}; \
+    constexpr neko::uint32 endId = firstId + index::count;
+
+        // Top-level entry of the language file (its display name), ID 0.
+        constexpr Key language{"", "language", 0};
+
+        namespace setting {
+            NEKO_LANG_KEY_CATEGORY("setting", 1, NEKO_LANG_KEYS_SETTING)
+        } // namespace setting
+
+        namespace loading {
+            NEKO_LANG_KEY_CATEGORY("loading", setting::endId, NEKO_LANG_KEYS_LOADING)
+        } // namespace loading
+
+        namespace launcher {
+            NEKO_LANG_KEY_CATEGORY("launcher", loading::endId, NEKO_LANG_KEYS_LAUNCHER)
+        } // namespace launcher
+
+        namespace about {
+            NEKO_LANG_KEY_CATEGORY("about", launcher::endId, NEKO_LANG_KEYS_ABOUT)
+        } // namespace about
+
+        namespace input {
+            NEKO_LANG_KEY_CATEGORY("input", about::endId, NEKO_LANG_KEYS_INPUT)
+        } // namespace input
+
+        namespace maintenance {
+            NEKO_LANG_KEY_CATEGORY("maintenance", input::endId, NEKO_LANG_KEYS_MAINTENANCE)
+        } // namespace maintenance
+
+        namespace news {
+            NEKO_LANG_KEY_CATEGORY("news", maintenance::endId, NEKO_LANG_KEYS_NEWS)
+        } // namespace news
+
+        namespace update {
+            NEKO_LANG_KEY_CATEGORY("update", news::endId, NEKO_LANG_KEYS_UPDATE)
+        } // namespace update
+
+        namespace button {
+            NEKO_LANG_KEY_CATEGORY("button", update::endId, NEKO_LANG_KEYS_BUTTON)
+        } // namespace button
+
+        namespace minecraft {
+            NEKO_LANG_KEY_CATEGORY("minecraft", button::endId, NEKO_LANG_KEYS_MINECRAFT)
+        } // namespace minecraft
+
+        namespace error {
+            NEKO_LANG_KEY_CATEGORY("error", minecraft::endId, NEKO_LANG_KEYS_ERROR)
+        } // namespace error
+
+        namespace network {
+            NEKO_LANG_KEY_CATEGORY("network", error::endId, NEKO_LANG_KEYS_NETWORK)
+        } // namespace network
+
+#undef NEKO_LANG_KEY_CATEGORY
+#undef NEKO_LANG_KEY_ENTRY
+#undef NEKO_LANG_KEY_DEFINE
+#undef NEKO_LANG_KEY_INDEX
+#undef NEKO_LANG_KEYS_SETTING
+#undef NEKO_LANG_KEYS_LOADING
+#undef NEKO_LANG_KEYS_LAUNCHER
+#undef NEKO_LANG_KEYS_ABOUT
+#undef NEKO_LANG_KEYS_INPUT
+#undef NEKO_LANG_KEYS_MAINTENANCE
+#undef NEKO_LANG_KEYS_NEWS
+#undef NEKO_LANG_KEYS_UPDATE
+#undef NEKO_LANG_KEYS_BUTTON
+#undef NEKO_LANG_KEYS_MINECRAFT
+#undef NEKO_LANG_KEYS_ERROR
+#undef NEKO_LANG_KEYS_NETWORK
+
+        /**
+         * @brief Every key in ID order; `all[id].id == id`.
+         */
+        inline constexpr auto all = detail::joinKeys(std::array<Key, 1>{language}, setting::all, loading::all, launcher::all, about::all, input::all, maintenance::all, news::all, update::all, button::all, minecraft::all, error::all, network::all);
+        static_assert(detail::isDense(all), "Translation key IDs must be dense and in registry order");
+
+    } // namespace keys
+
     /**
      * @brief Sets or gets the preferred language (file name without extension).
      */
@@ -53,7 +393,10 @@ namespace neko::lang {
 
         if (!langCode.empty()) {
             std::unique_lock lock(languageMutex);
-            preferredLanguage = langCode;
+            if (preferredLanguage != langCode) {
+                preferredLanguage = langCode;
+                detail::translationState().generation.fetch_add(1, std::memory_order_acq_rel);
+            }
         }
 
         std::shared_lock lock(languageMutex);
@@ -68,6 +411,110 @@ namespace neko::lang {
         return neko::system::workPath() + std::string("/") + lc::LanguageFolderName.data();
     }
 
+    namespace detail {
+        inline bool parseLanguageFile(const std::string &filePath, nlohmann::json &out, std::string &err) {
+            std::ifstream i(filePath);
+            if (!std::filesystem::exists(filePath) || !i.is_open()) {
+                err = "Language file does not exist or cannot be opened: " + filePath;
+                log::error("{}", {}, err);
+                return false;
+            }
+            try {
+                out = nlohmann::json::parse(i);
+            } catch (const nlohmann::json::parse_error &e) {
+                err = std::string("Failed to parse language file: ") + filePath + " | " + e.what();
+                log::error("{}", {}, err);
+                return false;
+            }
+            return true;
+        }
+
+        // One lock per pack path: getLanguages() and getTranslations() may compile the same pack at once.
+        inline std::mutex &packMutex(const std::string &packPath) {
+            static std::mutex mapMutex;
+            static std::map<std::string, std::mutex> mutexes;
+            std::lock_guard lock(mapMutex);
+            return mutexes[packPath];
+        }
+
+        /**
+         * @brief Compile `<code>.json` into its pack if the pack is missing or older than the JSON.
+         * @return The pack bytes when they were (re)built, so a read-only folder can still use them.
+         * @note Serialized per pack, so concurrent callers never share `<pack>.tmp`; a caller that waited
+         *       finds the pack up to date and does not compile it again.
+         */
+        inline std::optional<std::string> refreshPack(const std::string &langCode, const std::string &langFolder, std::string &err) {
+            const std::string sourcePath = pack::getSourcePath(langCode, langFolder);
+            const std::string packPath = pack::getPackPath(langCode, langFolder);
+            std::lock_guard lock(packMutex(packPath));
+            const auto source = pack::getSourceStamp(sourcePath);
+            if (!source) {
+                return std::nullopt; // a pack shipped without its JSON is used as is
+            }
+            if (auto info = pack::readInfo(packPath); info && info->source == *source) {
+                return std::nullopt;
+            }
+            nlohmann::json json;
+            if (!parseLanguageFile(sourcePath, json, err)) {
+                return std::nullopt;
+            }
+            auto bytes = pack::compile(json, *source);
+            if (pack::write(packPath, bytes)) {
+                log::info("Compiled language pack : {} ({} bytes)", {}, packPath, bytes.size());
+            } else {
+                log::warn("Cannot write language pack {}, using it from memory", {}, packPath);
+            }
+            return bytes;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Loads the translation table of a language from its compiled pack.
+     * @param langCode Language code to load; falls back to English if it cannot be loaded.
+     * @param langFolder Path to the directory containing language files.
+     * @return Table whose strings are read from the mapped pack; empty if nothing could be loaded.
+     *         getLanguageCode() names the language actually loaded ("en" after a fallback).
+     *
+     * @details `<code>.json` is compiled to `<code>.nlpack` on first use and whenever the JSON changes.
+     */
+    inline TranslationTable loadTranslationTable(const std::string &langCode = language(), const std::string &langFolder = getLanguageFolder()) {
+        auto tryLoad = [&](const std::string &code, std::string &err) -> std::optional<TranslationTable> {
+            auto rebuilt = detail::refreshPack(code, langFolder, err);
+            if (auto table = pack::open(pack::getPackPath(code, langFolder), code, keys::all)) {
+                return table;
+            }
+            if (rebuilt) {
+                // Folder not writable: serve the freshly compiled pack from memory.
+                if (auto table = pack::fromMemory(std::move(*rebuilt), code, keys::all)) {
+                    return table;
+                }
+            }
+            if (err.empty()) {
+                err = "Language pack does not exist or cannot be opened: " + pack::getPackPath(code, langFolder);
+                log::error("{}", {}, err);
+            }
+            return std::nullopt;
+        };
+
+        std::string err;
+        if (auto table = tryLoad(langCode, err)) {
+            log::info("Loaded language pack : {}", {}, pack::getPackPath(langCode, langFolder));
+            setLastLoadError("");
+            return std::move(*table);
+        }
+        if (langCode != "en") {
+            std::string fallbackErr;
+            if (auto table = tryLoad("en", fallbackErr)) {
+                log::warn("Loaded language pack : {} (fallback for {})", {}, pack::getPackPath("en", langFolder), langCode);
+                setLastLoadError(err + " | Falling back to en.json");
+                return std::move(*table);
+            }
+            err += " | Fallback en.json failed: " + fallbackErr;
+        }
+        setLastLoadError(err);
+        return TranslationTable::fromJson(nlohmann::json::object(), langCode, keys::all);
+    }
+
     /**
      * @brief Loads translation data from a language file.
      * @param lang Language code to load.
@@ -86,21 +533,7 @@ namespace neko::lang {
         static nlohmann::json cachedJson;
 
         auto tryLoadFile = [](const std::string &code, const std::string &folder, nlohmann::json &out, std::string &err) -> bool {
-            const std::string filePath = folder + "/" + code + ".json";
-            std::ifstream i(filePath);
-            if (!std::filesystem::exists(filePath) || !i.is_open()) {
-                err = "Language file does not exist or cannot be opened: " + filePath;
-                log::error("{}", {}, err);
-                return false;
-            }
-            try {
-                out = nlohmann::json::parse(i);
-            } catch (const nlohmann::json::parse_error &e) {
-                err = std::string("Failed to parse language file: ") + filePath + " | " + e.what();
-                log::error("{}", {}, err);
-                return false;
-            }
-            return true;
+            return detail::parseLanguageFile(pack::getSourcePath(code, folder), out, err);
         };
 
         {
@@ -146,6 +579,9 @@ namespace neko::lang {
      * @brief Retrieves a list of available languages.
      * @param langPath Path to the directory containing language files.
      * @return A vector of pairs, each containing the language code and its display name.
+     *
+     * @details Reads the display name from each language pack's header, compiling packs that are
+     * missing or older than their JSON; it does not touch the loadTranslations() cache.
      */
     inline std::vector<std::pair<std::string, std::string>> getLanguages(const std::string &langFolder = getLanguageFolder()) {
         std::vector<std::pair<std::string, std::string>> result;
@@ -154,45 +590,166 @@ namespace neko::lang {
             setLastLoadError("Language folder missing: " + langFolder);
             return result;
         }
+        std::vector<std::string> codes;
         for (const auto &it : std::filesystem::directory_iterator(langFolder)) {
-            if (it.is_regular_file() && util::string::matchExtensionName(it.path().string(), "json")) {
+            if (!it.is_regular_file()) {
+                continue;
+            }
+            if (util::string::matchExtensionName(it.path().string(), "json") || it.path().extension() == pack::Extension) {
                 std::string langCode = it.path().stem().string();
-                auto json = loadTranslations(langCode, langFolder);
-                if (json.contains("language")) {
-                    result.emplace_back(langCode, json["language"].get<std::string>());
-                } else {
-                    result.emplace_back(langCode, langCode);
+                if (std::find(codes.begin(), codes.end(), langCode) == codes.end()) {
+                    codes.push_back(std::move(langCode));
                 }
             }
         }
+        for (const auto &langCode : codes) {
+            // Only the pack header is read; a JSON is parsed once, when its pack is missing or stale.
+            std::string err;
+            std::optional<pack::Info> info;
+            if (auto rebuilt = detail::refreshPack(langCode, langFolder, err)) {
+                info = pack::parseInfo(*rebuilt);
+            } else {
+                info = pack::readInfo(pack::getPackPath(langCode, langFolder));
+            }
+            result.emplace_back(langCode, info && !info->displayName.empty() ? info->displayName : langCode);
+        }
         return result;
     }
 
+    /**
+     * @brief Gets the translation table of the current language.
+     * @return Shared immutable table; it stays valid after a language switch.
+     *
+     * @details Lock-free when the table is up to date; the first call after language() changes
+     * (or reloadTranslations()) maps the new language's pack through loadTranslationTable().
+     */
+    inline std::shared_ptr<const TranslationTable> getTranslations() {
+        auto &state = detail::translationState();
+        auto current = state.load();
+        if (current && current->generation == state.generation.load(std::memory_order_acquire)) {
+            return std::shared_ptr<const TranslationTable>(current, &current->table);
+        }
+
+        std::lock_guard lock(state.buildMutex);
+        // Read the generation before the language, so a concurrent switch forces another rebuild.
+        const neko::uint64 generation = state.generation.load(std::memory_order_acquire);
+        current = state.load();
+        if (current && current->generation == generation) {
+            return std::shared_ptr<const TranslationTable>(current, &current->table);
+        }
+
+        const std::string langCode = language();
+        const std::string langFolder = state.folderOverride.empty() ? getLanguageFolder() : state.folderOverride;
+        auto loaded = std::make_shared<const detail::LoadedTranslations>(
+            detail::LoadedTranslations{generation, loadTranslationTable(langCode, langFolder)});
+        state.store(loaded);
+        if (const auto &missing = loaded->table.getMissingKeys(); !missing.empty()) {
+            std::string names;
+            for (const auto &key : missing) {
+                names += names.empty() ? "" : ", ";
+                names += key.category[0] == '\0' ? std::string(key.name) : std::string(key.category) + "." + key.name;
+            }
+            log::warn("Language {} is missing {} of {} keys: {}", {}, std::string(loaded->table.getLanguageCode()), missing.size(), keys::all.size(), names);
+        }
+        log::debug("Translation table built for {}: {} entries, {} bytes", {}, langCode, loaded->table.size(), loaded->table.getPoolSize());
+        return std::shared_ptr<const TranslationTable>(loaded, &loaded->table);
+    }
+
+    /**
+     * @brief Drop the current translation table so the next lookup rebuilds it.
+     * @param langFolder Folder to load from from now on; empty keeps using getLanguageFolder().
+     */
+    inline void reloadTranslations(const std::string &langFolder = "") {
+        auto &state = detail::translationState();
+        std::lock_guard lock(state.buildMutex);
+        state.folderOverride = langFolder;
+        state.generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief A translated string that references the table it came from instead of copying the text.
+     */
+    class Translation {
+    private:
+        std::shared_ptr<const TranslationTable> table;
+        std::optional<std::string_view> text;
+        std::string fallback; // only set when the key is missing
+
+    public:
+        Translation(std::shared_ptr<const TranslationTable> table, std::optional<std::string_view> text, std::string_view fallbackText)
+            : table(std::move(table)), text(text), fallback(text ? std::string_view{} : fallbackText) {}
+
+        bool found() const noexcept {
+            return text.has_value();
+        }
+        std::string_view view() const noexcept {
+            return text ? *text : std::string_view(fallback);
+        }
+        std::string str() const {
+            return std::string(view());
+        }
+        operator std::string_view() const noexcept {
+            return view();
+        }
+    };
+
+    /**
+     * @brief Translates a key without copying the translated text.
+     * @return Handle viewing the current table; falls back to `fallback` if the key is missing.
+     */
+    inline Translation trView(std::string_view category, std::string_view key, std::string_view fallback = "Translation not found") {
+        auto table = getTranslations();
+        auto text = table->find(category, key);
+        return Translation(std::move(table), text, fallback);
+    }
+
+    /**
+     * @brief Translates a registered key through its ID.
+     * @param category Category the caller looks in; when it differs from the key's own category,
+     *        the key name is looked up in `category` by hash instead.
+     */
+    inline Translation trView(std::string_view category, const Key &key, std::string_view fallback = "Translation not found") {
+        auto table = getTranslations();
+        auto text = category == key.category ? table->find(key) : table->find(category, key.name);
+        return Translation(std::move(table), text, fallback);
+    }
+
     /**
      * @brief Translates a key within a specified category.
      * @param category The category or subject under which to look up the key.
      * @param key The translation key to look up.
      * @param fallback The fallback message if the key is not found.
-     * @param langFile The JSON object containing translations.
      * @return The translated string, or a fallback message if not found.
      *
-     * @details Falls back to English if the key is not found in the specified language.
-     * Uses nlog for warning about missing translations.
+     * @details Looks the key up in the current language's TranslationTable; the language file
+     * itself already falls back to English when it cannot be loaded.
      */
-    inline std::string tr(
-        const std::string &category,
-        const std::string &key,
-        const std::string &fallback = "Translation not found",
-        const nlohmann::json &langFile = loadTranslations()) {
-
-        auto check = [&category, &key, &fallback](const nlohmann::json &obj) -> std::string {
-            if (obj.empty() || obj.is_discarded() || !obj.contains(category) || !obj[category].contains(key)) {
-                return fallback;
-            }
-            return obj[category].value(key, fallback);
-        };
+    inline std::string tr(std::string_view category, std::string_view key, std::string_view fallback = "Translation not found") {
+        const auto table = getTranslations();
+        return std::string(table->find(category, key).value_or(fallback));
+    }
 
-        return check(langFile);
+    /**
+     * @brief Translates a registered key; a bounds-checked array access into the current table.
+     * @see trView(std::string_view, const Key &, std::string_view)
+     */
+    inline std::string tr(std::string_view category, const Key &key, std::string_view fallback = "Translation not found") {
+        const auto table = getTranslations();
+        const auto text = category == key.category ? table->find(key) : table->find(category, key.name);
+        return std::string(text.value_or(fallback));
+    }
+
+    /**
+     * @brief Translates a key using an explicit language document instead of the current table.
+     * @param langFile The JSON object containing translations.
+     */
+    inline std::string tr(std::string_view category, std::string_view key, std::string_view fallback, const nlohmann::json &langFile) {
+        const std::string categoryName(category);
+        const std::string keyName(key);
+        if (langFile.empty() || langFile.is_discarded() || !langFile.contains(categoryName) || !langFile[categoryName].is_object() || !langFile[categoryName].contains(keyName)) {
+            return std::string(fallback);
+        }
+        return langFile[categoryName].value(keyName, std::string(fallback));
     }
 
     /**
@@ -228,221 +785,8 @@ namespace neko::lang {
         return withPlaceholdersReplaced(input, replacements);
     };
 
-    namespace keys {
-
-        constexpr neko::cstr language = "language";
-
-        namespace setting {
-            constexpr neko::cstr
-                category = "setting",
-                tabAccount = "tabAccount",
-                tabMain = "tabMain",
-                tabAdvanced = "tabAdvanced",
-                groupMain = "groupMain",
-                groupStyle = "groupStyle",
-                groupNetwork = "groupNetwork",
-                groupOther = "groupOther",
-                groupMinecraft = "groupMinecraft",
-                groupAdvanced = "groupAdvanced",
-                language = "language",
-                backgroundType = "backgroundType",
-                backgroundTypeImage = "backgroundTypeImage",
-                backgroundTypeNone = "backgroundTypeNone",
-                background = "background",
-                selectBackground = "selectBackground",
-                imageFileFilter = "imageFileFilter",
-                windowSize = "windowSize",
-                launcherMethod = "launcherMethod",
-                launcherVisible = "launcherVisible",
-                launcherExit = "launcherExit",
-                launcherHideRestore = "launcherHideRestore",
-                themeLight = "themeLight",
-                themeDark = "themeDark",
-                themeSystem = "themeSystem",
-                useSysWindowFrame = "useSysWindowFrame",
-                headBarKeepRight = "headBarKeepRight",
-                theme = "theme",
-                animationStyle = "animationStyle",
-                animationNone = "animationNone",
-                animationMinimal = "animationMinimal",
-                animationSmooth = "animationSmooth",
-                animationiOS = "animationiOS",
-                animationBounce = "animationBounce",
-                blurEffect = "blurEffect",
-                blurEffectPerformance = "blurEffectPerformance",
-                blurEffectQuality = "blurEffectQuality",
-                blurEffectAnimation = "blurEffectAnimation",
-                blurRadius = "blurRadius",
-                fontSize = "fontSize",
-                fontFamilies = "fontFamilies",
-                threads = "threads",
-                useSystemProxy = "useSystemProxy",
-                proxyPlaceholder = "proxyPlaceholder",
-                immediateSave = "immediateSave",
-                customTempDir = "customTempDir",
-                selectTempDir = "selectTempDir",
-                javaPath = "javaPath",
-                browseJava = "browseJava",
-                javaExecutableFilter = "javaExecutableFilter",
-                downloadSource = "downloadSource",
-                downloadSourceOfficial = "downloadSourceOfficial",
-                downloadSourceBmclapi = "downloadSourceBmclapi",
-                playerName = "playerName",
-                customResolution = "customResolution",
-                joinServerAddress = "joinServerAddress",
-                joinServerPort = "joinServerPort",
-                devEnable = "devEnable",
-                devDebug = "devDebug",
-                devShowLogViewer = "devShowLogViewer",
-                devShowMusicControl = "devShowMusicControl",
-                devTls = "devTls",
-                devServer = "devServer",
-                useDefaultServer = "useDefaultServer",
-                devServerPlaceholder = "devServerPlaceholder",
-                notLoggedIn = "notLoggedIn",
-                login = "login",
-                logout = "logout",
-                close = "close";
-        } // namespace setting
-
-        namespace loading {
-            constexpr neko::cstr
-                category = "loading",
-                starting = "starting...",
-                preparing = "preparing...",
-                downloading = "downloading...",
-                extracting = "extracting...",
-                finalizing = "finalizing...";
-        } // namespace loading
-
-
-        namespace launcher {
-            constexpr neko::cstr
-                category = "launcher",
-                launchFailedTitle = "launchFailedTitle",
-                launchFailedMessage = "launchFailedMessage";
-        } // namespace launcher
-
-        namespace about {
-            constexpr neko::cstr
-                category = "about",
-                title = "title",
-                tagline = "tagline",
-                description = "description",
-                openRepo = "openRepo",
-                feedbackLogs = "feedbackLogs";
-        } // namespace about
-
-
-        namespace input {
-            constexpr neko::cstr
-                category = "input",
-                title = "title",
-                message = "message",
-                placeholder = "placeholder",
-                password = "password";
-        } // namespace input
-
-        namespace maintenance {
-            constexpr neko::cstr
-                category = "maintenance",
-                title = "title",
-                message = "message",
-                checkingStatus = "checkingStatus",
-                parseIng = "parseIng",
-                downloadPoster = "downloadPoster";
-        } // namespace maintenance
-
-        namespace news {
-            constexpr neko::cstr
-                category = "news",
-                title = "title",
-                noNews = "noNews",
-                loading = "loading",
-                loadMore = "loadMore",
-                readMore = "readMore",
-                dismissNone = "dismissNone",
-                dismiss3Days = "dismiss3Days",
-                dismiss7Days = "dismiss7Days",
-                dismissUntilUpdate = "dismissUntilUpdate",
-                continueBtn = "continue";
-        } // namespace news
-
-        namespace update {
-            constexpr neko::cstr
-                category = "update",
-                title = "title",
-                startingUpdate = "startingUpdate",
-                checkingForUpdates = "checkingForUpdates",
-                parsingUpdateData = "parsingUpdateData",
-                updateAvailable = "updateAvailable",
-                noUpdateAvailable = "noUpdateAvailable",
-                downloadingUpdate = "downloadingUpdate",
-                applyingUpdate = "applyingUpdate";
-            
-        } // namespace update
-
-        namespace button {
-            constexpr neko::cstr
-                category = "button",
-                open = "open",
-                close = "close",
-                ok = "ok",
-                cancel = "cancel",
-                yes = "yes",
-                no = "no",
-                start = "start",
-                menu = "menu",
-                maximize = "maximize",
-                minimize = "minimize",
-                restore = "restore",
-                apply = "apply",
-                quit = "quit",
-                retry = "retry",
-                input = "input",
-                edit = "edit";
-        } // namespace button
-
-        namespace minecraft {
-            constexpr neko::cstr
-                category = "minecraft",
-                missingAccessToken = "missingAccessToken",
-                installStart = "installStart",
-                fetchVersionList = "fetchVersionList",
-                fetchVersionInfo = "fetchVersionInfo",
-                downloadingAssetIndex = "downloadingAssetIndex",
-                downloadingLibrary = "downloadingLibrary",
-                downloadingClient = "downloadingClient",
-                downloadingAssets = "downloadingAssets",
-                savingVersion = "savingVersion",
-                installing = "installing",
-                completed = "completed";
-        } // namespace minecraft
-
-        namespace error {
-            constexpr neko::cstr
-                category = "error",
-                invalidInput = "invalidInput",
-                networkError = "networkError",
-                networkInitFailed = "networkInitFailed",
-                networkInitFailedMessage = "networkInitFailedMessage",
-                parseError = "parseError",
-                updateFailed = "updateFailed",
-                launchFailed = "launchFailed",
-                seeLog = "seeLog";
-        } // namespace error
-
-        namespace network {
-            constexpr neko::cstr
-                category = "network",
-                retrying = "retrying",
-                testConnection = "testConnection",
-                goToSettings = "goToSettings",
-                skip = "skip";
-        } // namespace network
-
-        
-
-    } // namespace keys
+    inline std::string trWithReplaced(std::string_view category, const Key &key, std::map<std::string, std::string> replacements) {
+        return withPlaceholdersReplaced(tr(category, key), replacements);
+    }
 
 } // namespace neko::lang
\ No newline at end of file
@@ -0,0 +1,281 @@
+/**
+ * @see neko/app/lang.hpp
+ * @file languagePack.hpp
+ * @brief Compiled binary language packs, memory-mapped at load.
+ */
+
+#pragma once
+
+#include <neko/schema/types.hpp>
+
+#include "neko/app/translationTable.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+/**
+ * @namespace neko::lang::pack
+ * @brief `<code>.nlpack` files compiled from `<code>.json`.
+ *
+ * Layout: Header | display name | Record[keyCount] | string pool. The header records the size and
+ * modification time of the JSON it was compiled from, so a stale pack is detected without parsing.
+ * Packs are a local cache in native byte order; a pack from another byte order is rejected and rebuilt.
+ */
+namespace neko::lang::pack {
+
+    constexpr neko::strview Extension = ".nlpack";
+    constexpr std::array<char, 4> Magic = {'N', 'K', 'L', 'P'};
+    constexpr neko::uint32 FormatVersion = 1;
+    constexpr neko::uint32 ByteOrderMark = 0x01020304;
+
+    struct Header {
+        std::array<char, 4> magic = Magic;
+        neko::uint32 version = FormatVersion;
+        neko::uint32 byteOrder = ByteOrderMark;
+        neko::uint32 keyCount = 0;
+        neko::uint64 sourceSize = 0;
+        neko::int64 sourceTime = 0;
+        neko::uint32 nameLength = 0;
+        neko::uint32 recordsOffset = 0;
+        neko::uint32 poolOffset = 0;
+        neko::uint32 poolSize = 0;
+    };
+    static_assert(sizeof(Header) == 48, "Language pack header layout changed");
+    static_assert(sizeof(TranslationTable::Record) == 24, "Language pack record layout changed");
+
+    /**
+     * @brief Identity of the JSON file a pack was compiled from.
+     */
+    struct SourceStamp {
+        neko::uint64 size = 0;
+        neko::int64 time = 0;
+
+        bool operator==(const SourceStamp &) const = default;
+    };
+
+    /**
+     * @brief What getLanguages() needs, read from the header alone.
+     */
+    struct Info {
+        std::string displayName;
+        neko::uint32 keyCount = 0;
+        SourceStamp source;
+    };
+
+    inline std::string getPackPath(const std::string &langCode, const std::string &langFolder) {
+        return langFolder + "/" + langCode + std::string(Extension);
+    }
+
+    inline std::string getSourcePath(const std::string &langCode, const std::string &langFolder) {
+        return langFolder + "/" + langCode + ".json";
+    }
+
+    /**
+     * @return Size and modification time of a file, or nullopt if it does not exist.
+     */
+    inline std::optional<SourceStamp> getSourceStamp(const std::string &path) {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(path, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        const auto time = std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        return SourceStamp{static_cast<neko::uint64>(size), static_cast<neko::int64>(time.time_since_epoch().count())};
+    }
+
+    /**
+     * @brief Validate a header against the bytes available after it.
+     * @param fileSize Total pack size, or 0 to skip the bounds checks (header-only reads).
+     */
+    inline bool isValidHeader(const Header &header, std::size_t fileSize = 0) {
+        if (header.magic != Magic || header.version != FormatVersion || header.byteOrder != ByteOrderMark) {
+            return false;
+        }
+        if (fileSize == 0) {
+            return true;
+        }
+        const neko::uint64 recordsEnd = neko::uint64(header.recordsOffset) + neko::uint64(header.keyCount) * sizeof(TranslationTable::Record);
+        return sizeof(Header) + neko::uint64(header.nameLength) <= header.recordsOffset && recordsEnd <= header.poolOffset && neko::uint64(header.poolOffset) + header.poolSize <= fileSize;
+    }
+
+    /**
+     * @brief Serialize a table into pack bytes.
+     * @param displayName The language's own name (the "language" entry of its file).
+     */
+    inline std::string build(const TranslationTable &table, std::string_view displayName, SourceStamp source) {
+        const auto records = table.getRecords();
+        const auto pool = table.getPool();
+
+        Header header;
+        header.keyCount = static_cast<neko::uint32>(records.size());
+        header.sourceSize = source.size;
+        header.sourceTime = source.time;
+        header.nameLength = static_cast<neko::uint32>(displayName.size());
+        header.recordsOffset = static_cast<neko::uint32>(sizeof(Header) + displayName.size());
+        header.poolOffset = static_cast<neko::uint32>(header.recordsOffset + records.size() * sizeof(TranslationTable::Record));
+        header.poolSize = static_cast<neko::uint32>(pool.size());
+
+        std::string bytes(header.poolOffset + pool.size(), '\0');
+        std::memcpy(bytes.data(), &header, sizeof(Header));
+        std::memcpy(bytes.data() + sizeof(Header), displayName.data(), displayName.size());
+        if (!records.empty()) {
+            std::memcpy(bytes.data() + header.recordsOffset, records.data(), records.size() * sizeof(TranslationTable::Record));
+        }
+        std::memcpy(bytes.data() + header.poolOffset, pool.data(), pool.size());
+        return bytes;
+    }
+
+    /**
+     * @brief Compile a parsed language file into pack bytes.
+     */
+    inline std::string compile(const nlohmann::json &json, SourceStamp source) {
+        const auto table = TranslationTable::fromJson(json);
+        return build(table, table.find("", "language").value_or(""), source);
+    }
+
+    /**
+     * @brief Read only the header and display name of pack bytes.
+     */
+    inline std::optional<Info> parseInfo(std::string_view bytes) {
+        Header header;
+        if (bytes.size() < sizeof(Header)) {
+            return std::nullopt;
+        }
+        std::memcpy(&header, bytes.data(), sizeof(Header));
+        if (!isValidHeader(header) || bytes.size() < sizeof(Header) + header.nameLength) {
+            return std::nullopt;
+        }
+        return Info{
+            .displayName = std::string(bytes.substr(sizeof(Header), header.nameLength)),
+            .keyCount = header.keyCount,
+            .source = {header.sourceSize, header.sourceTime}};
+    }
+
+    /**
+     * @brief Read a pack's header and display name from disk without touching the rest of the file.
+     */
+    inline std::optional<Info> readInfo(const std::string &packPath) {
+        std::ifstream file(packPath, std::ios::binary);
+        if (!file.is_open()) {
+            return std::nullopt;
+        }
+        std::string bytes(sizeof(Header), '\0');
+        if (!file.read(bytes.data(), sizeof(Header))) {
+            return std::nullopt;
+        }
+        Header header;
+        std::memcpy(&header, bytes.data(), sizeof(Header));
+        if (!isValidHeader(header)) {
+            return std::nullopt;
+        }
+        bytes.resize(sizeof(Header) + header.nameLength);
+        if (!file.read(bytes.data() + sizeof(Header), header.nameLength)) {
+            return std::nullopt;
+        }
+        return parseInfo(bytes);
+    }
+
+    /**
+     * @brief Write pack bytes to `<packPath>.tmp` and rename it over the pack.
+     * @return false if the folder is not writable; the caller keeps working from the JSON.
+     */
+    inline bool write(const std::string &packPath, std::string_view bytes) {
+        const std::string tempPath = packPath + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open() || !file.write(bytes.data(), static_cast<std::streamsize>(bytes.size())) || !file.flush()) {
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tempPath, packPath, ec);
+        if (ec) {
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Read-only mapping of a whole pack file.
+     */
+    class MappedPack {
+    private:
+        boost::interprocess::file_mapping mapping;
+        boost::interprocess::mapped_region region;
+
+    public:
+        explicit MappedPack(const std::string &path)
+            : mapping(path.c_str(), boost::interprocess::read_only),
+              region(mapping, boost::interprocess::read_only) {}
+
+        std::string_view bytes() const noexcept {
+            return {static_cast<const char *>(region.get_address()), region.get_size()};
+        }
+    };
+
+    /**
+     * @brief Build a table whose strings are read in place from pack bytes.
+     * @param storage Owner of `bytes`; the table keeps it alive.
+     * @return nullopt if the bytes are not a valid pack.
+     */
+    inline std::optional<TranslationTable> load(std::shared_ptr<const void> storage, std::string_view bytes, std::string languageCode = {}, std::span<const Key> registry = {}) {
+        Header header;
+        if (bytes.size() < sizeof(Header)) {
+            return std::nullopt;
+        }
+        std::memcpy(&header, bytes.data(), sizeof(Header));
+        if (!isValidHeader(header, bytes.size())) {
+            return std::nullopt;
+        }
+        // Records are copied out so they need no alignment; strings stay where they are.
+        std::vector<TranslationTable::Record> records(header.keyCount);
+        if (!records.empty()) {
+            std::memcpy(records.data(), bytes.data() + header.recordsOffset, records.size() * sizeof(TranslationTable::Record));
+        }
+        const auto pool = bytes.substr(header.poolOffset, header.poolSize);
+        return TranslationTable::fromRecords(std::move(storage), pool, records, std::move(languageCode), registry);
+    }
+
+    /**
+     * @brief Map a pack file and build a table over the mapping.
+     * @return nullopt if the file is missing, unreadable or malformed.
+     */
+    inline std::optional<TranslationTable> open(const std::string &packPath, std::string languageCode = {}, std::span<const Key> registry = {}) {
+        std::shared_ptr<const MappedPack> mapped;
+        try {
+            mapped = std::make_shared<const MappedPack>(packPath);
+        } catch (const boost::interprocess::interprocess_exception &) {
+            return std::nullopt;
+        }
+        const auto bytes = mapped->bytes();
+        return load(std::move(mapped), bytes, std::move(languageCode), registry);
+    }
+
+    /**
+     * @brief Build a table over pack bytes held in memory (e.g. when the pack could not be written).
+     */
+    inline std::optional<TranslationTable> fromMemory(std::string bytes, std::string languageCode = {}, std::span<const Key> registry = {}) {
+        auto owned = std::make_shared<const std::string>(std::move(bytes));
+        const std::string_view view = *owned;
+        return load(std::move(owned), view, std::move(languageCode), registry);
+    }
+
+} // namespace neko::lang::pack
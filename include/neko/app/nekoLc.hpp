@@ -34,6 +34,9 @@ namespace neko::lc {
 
     constexpr neko::strview LanguageFolderName = "langs";
 
+    // Persistent caches (remote config, ...), relative to the working directory
+    constexpr neko::strview CacheFolderName = "cache";
+
     /***************/
     /*** Network ***/
     /***************/
@@ -0,0 +1,301 @@
+/**
+ * @see neko/app/lang.hpp
+ * @file translationTable.hpp
+ * @brief Immutable flat lookup table for translations.
+ */
+
+#pragma once
+
+#include <neko/schema/types.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace neko::lang {
+
+    /**
+     * @brief Compile-time handle of a translation key: its category, its name in the language file
+     * and a dense ID assigned by the `lang::keys` registry.
+     * @details A key built without an ID keeps `invalidId` and is looked up by category and name.
+     */
+    struct Key {
+        static constexpr neko::uint32 invalidId = std::numeric_limits<neko::uint32>::max();
+
+        neko::cstr category = "";
+        neko::cstr name = "";
+        neko::uint32 id = invalidId;
+
+        constexpr operator neko::cstr() const noexcept {
+            return name;
+        }
+    };
+
+    /**
+     * @brief Read-only `(category, key) -> text` table built once per loaded language.
+     *
+     * All strings live in one interned pool (each distinct string stored once) and entries are
+     * found through an open-addressing index, so a lookup hashes two string views and allocates nothing.
+     * Top-level string values of the language file (e.g. "language") are stored under the empty category.
+     */
+    class TranslationTable {
+    public:
+        struct Span {
+            neko::uint32 offset = 0;
+            neko::uint32 length = 0;
+        };
+        /**
+         * @brief One translation as offsets into the string pool; the on-disk form used by language packs.
+         */
+        struct Record {
+            Span category;
+            Span key;
+            Span value;
+        };
+
+    private:
+        struct Entry {
+            neko::uint64 hash = 0;
+            Span category;
+            Span key;
+            Span value;
+        };
+
+        std::string languageCode;
+        // Owns the bytes `pool` views: an interned std::string or a mapped language pack.
+        std::shared_ptr<const void> storage;
+        std::string_view pool;
+        std::vector<Entry> entries;
+        // Entry index + 1 per slot, 0 = empty; size is a power of two, at most half full.
+        std::vector<neko::uint32> slots;
+        // Entry index + 1 per registered key ID, 0 = missing from the language file.
+        std::vector<neko::uint32> resolved;
+        std::vector<Key> missingKeys;
+
+        static neko::uint64 hashOf(std::string_view category, std::string_view key) noexcept {
+            const neko::uint64 h1 = std::hash<std::string_view>{}(category);
+            const neko::uint64 h2 = std::hash<std::string_view>{}(key);
+            return h1 ^ (h2 + 0x9e3779b97f4a7c15ULL + (h1 << 6) + (h1 >> 2));
+        }
+
+        std::string_view view(Span span) const noexcept {
+            return pool.substr(span.offset, span.length);
+        }
+
+        bool contains(Span span) const noexcept {
+            return span.offset <= pool.size() && span.length <= pool.size() - span.offset;
+        }
+
+        class Builder {
+        private:
+            TranslationTable &table;
+            std::string &pool;
+            std::unordered_map<std::string, Span> interned;
+
+        public:
+            Builder(TranslationTable &table, std::string &pool) : table(table), pool(pool) {}
+
+            Span intern(const std::string &text) {
+                if (auto it = interned.find(text); it != interned.end()) {
+                    return it->second;
+                }
+                Span span{static_cast<neko::uint32>(pool.size()), static_cast<neko::uint32>(text.size())};
+                pool.append(text);
+                interned.emplace(text, span);
+                return span;
+            }
+
+            void add(const std::string &category, const std::string &key, const std::string &value) {
+                table.entries.push_back(Entry{
+                    .category = intern(category),
+                    .key = intern(key),
+                    .value = intern(value)});
+            }
+        };
+
+        void buildIndex() {
+            for (auto &entry : entries) {
+                entry.hash = hashOf(view(entry.category), view(entry.key));
+            }
+            std::size_t capacity = 16;
+            while (capacity < entries.size() * 2) {
+                capacity <<= 1;
+            }
+            slots.assign(capacity, 0);
+            const std::size_t mask = capacity - 1;
+            for (std::size_t i = 0; i < entries.size(); ++i) {
+                std::size_t slot = static_cast<std::size_t>(entries[i].hash) & mask;
+                while (slots[slot] != 0) {
+                    slot = (slot + 1) & mask;
+                }
+                slots[slot] = static_cast<neko::uint32>(i + 1);
+            }
+        }
+
+        std::optional<neko::uint32> indexOf(std::string_view category, std::string_view key) const noexcept {
+            if (entries.empty()) {
+                return std::nullopt;
+            }
+            const neko::uint64 hash = hashOf(category, key);
+            const std::size_t mask = slots.size() - 1;
+            for (std::size_t slot = static_cast<std::size_t>(hash) & mask; slots[slot] != 0; slot = (slot + 1) & mask) {
+                const Entry &entry = entries[slots[slot] - 1];
+                if (entry.hash == hash && view(entry.key) == key && view(entry.category) == category) {
+                    return slots[slot] - 1;
+                }
+            }
+            return std::nullopt;
+        }
+
+        void resolve(std::span<const Key> registry) {
+            resolved.assign(registry.size(), 0);
+            for (std::size_t id = 0; id < registry.size(); ++id) {
+                if (auto index = indexOf(registry[id].category, registry[id].name)) {
+                    resolved[id] = *index + 1;
+                } else {
+                    missingKeys.push_back(registry[id]);
+                }
+            }
+        }
+
+    public:
+        TranslationTable() = default;
+
+        /**
+         * @brief Build a table from a parsed language file.
+         * @param json Object of categories (objects of string values) and top-level strings; other values are ignored.
+         * @param languageCode Language the table was loaded for.
+         * @param registry Known keys in ID order (`lang::keys::all`); each is resolved to its entry once,
+         *        so find(Key) is an array access. Keys the file lacks are listed by getMissingKeys().
+         */
+        static TranslationTable fromJson(const nlohmann::json &json, std::string languageCode = {}, std::span<const Key> registry = {}) {
+            TranslationTable table;
+            table.languageCode = std::move(languageCode);
+            auto pool = std::make_shared<std::string>();
+            if (json.is_object()) {
+                Builder builder(table, *pool);
+                for (const auto &[category, items] : json.items()) {
+                    if (items.is_string()) {
+                        builder.add("", category, items.get<std::string>());
+                        continue;
+                    }
+                    if (!items.is_object()) {
+                        continue;
+                    }
+                    for (const auto &[key, value] : items.items()) {
+                        if (value.is_string()) {
+                            builder.add(category, key, value.get<std::string>());
+                        }
+                    }
+                }
+                pool->shrink_to_fit();
+            }
+            table.pool = *pool;
+            table.storage = std::move(pool);
+            table.buildIndex();
+            table.resolve(registry);
+            return table;
+        }
+
+        /**
+         * @brief Build a table over an existing string pool without copying it.
+         * @param storage Keeps the bytes behind `pool` alive for the table's lifetime (e.g. a file mapping).
+         * @param records Translations as pool offsets; records reaching outside the pool are skipped.
+         */
+        static TranslationTable fromRecords(std::shared_ptr<const void> storage, std::string_view pool, std::span<const Record> records,
+                                            std::string languageCode = {}, std::span<const Key> registry = {}) {
+            TranslationTable table;
+            table.languageCode = std::move(languageCode);
+            table.storage = std::move(storage);
+            table.pool = pool;
+            table.entries.reserve(records.size());
+            for (const auto &record : records) {
+                if (table.contains(record.category) && table.contains(record.key) && table.contains(record.value)) {
+                    table.entries.push_back(Entry{.category = record.category, .key = record.key, .value = record.value});
+                }
+            }
+            table.buildIndex();
+            table.resolve(registry);
+            return table;
+        }
+
+        /**
+         * @brief Every translation as pool offsets, in load order; see fromRecords().
+         */
+        std::vector<Record> getRecords() const {
+            std::vector<Record> records;
+            records.reserve(entries.size());
+            for (const auto &entry : entries) {
+                records.push_back(Record{entry.category, entry.key, entry.value});
+            }
+            return records;
+        }
+
+        /**
+         * @brief The interned string pool all records point into.
+         */
+        std::string_view getPool() const noexcept {
+            return pool;
+        }
+
+        /**
+         * @brief Look up a translation.
+         * @return View into the table's pool, valid as long as the table lives; nullopt if missing.
+         */
+        std::optional<std::string_view> find(std::string_view category, std::string_view key) const noexcept {
+            if (auto index = indexOf(category, key)) {
+                return view(entries[*index].value);
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Look up a registered key by its ID.
+         * @details Keys outside the registry the table was resolved against fall back to the hash lookup.
+         */
+        std::optional<std::string_view> find(const Key &key) const noexcept {
+            if (key.id >= resolved.size()) {
+                return find(key.category, key.name);
+            }
+            if (const neko::uint32 index = resolved[key.id]; index != 0) {
+                return view(entries[index - 1].value);
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Registered keys that the language file does not define, in ID order.
+         */
+        const std::vector<Key> &getMissingKeys() const noexcept {
+            return missingKeys;
+        }
+
+        std::string_view getLanguageCode() const noexcept {
+            return languageCode;
+        }
+
+        std::size_t size() const noexcept {
+            return entries.size();
+        }
+
+        bool empty() const noexcept {
+            return entries.empty();
+        }
+
+        /**
+         * @brief Bytes held by the interned string pool.
+         */
+        std::size_t getPoolSize() const noexcept {
+            return pool.size();
+        }
+    };
+
+} // namespace neko::lang
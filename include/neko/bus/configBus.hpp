@@ -19,12 +19,44 @@ namespace neko::bus::config {
         return bus::getConfigObj().save(filename);
     }
 
-    inline void updateClientConfig(std::function<void(neko::ClientConfig &)> updaterFunc) {
-        bus::getConfigObj().updateClientConfig(std::move(updaterFunc));
+    /**
+     * @brief Coalesced, off-thread save; see ConfigManager::saveAsync.
+     */
+    inline void saveAsync(const std::string &filename) {
+        bus::getConfigObj().saveAsync(filename);
+    }
+
+    /**
+     * @brief Write any pending saveAsync() now and wait for it.
+     */
+    inline bool flush() {
+        return bus::getConfigObj().flush();
+    }
+
+    /**
+     * @return The fields that changed; subscribers receive the same change as a ConfigUpdatedEvent.
+     */
+    inline app::ConfigManager::Change updateClientConfig(std::function<void(neko::ClientConfig &)> updaterFunc) {
+        return bus::getConfigObj().updateClientConfig(std::move(updaterFunc));
     }
 
     inline neko::ClientConfig getClientConfig() {
         return bus::getConfigObj().getClientConfig();
     }
 
+    /**
+     * @brief Shared read-only snapshot of the client config; prefer this over getClientConfig() for reads.
+     */
+    inline app::ConfigManager::Snapshot getSnapshot() {
+        return bus::getConfigObj().getSnapshot();
+    }
+
+    inline void setChangeListener(app::ConfigManager::ChangeListener listener) {
+        bus::getConfigObj().setChangeListener(std::move(listener));
+    }
+
+    inline neko::uint64 getVersion() {
+        return bus::getConfigObj().getVersion();
+    }
+
 } // namespace neko::bus::config
\ No newline at end of file
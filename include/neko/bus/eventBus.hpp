@@ -52,6 +52,25 @@ namespace neko::bus::event {
         return bus::getEventLoop().publishAfter<T>(ms, std::forward<T>(eventData));
     }
 
+    // === Coalesced Publish ===
+
+    /**
+     * @brief Publish a state-like event, replacing any pending one of the same type and key.
+     * @note Delivery is capped by setCoalesceRate (default 30 Hz); only the latest value is delivered.
+     */
+    template <typename T>
+    inline void publishCoalesced(T eventData, const std::string &key = {}) {
+        bus::getEventCoalescer().publish<T>(std::move(eventData), key);
+    }
+
+    inline void flushCoalesced() {
+        bus::getEventCoalescer().flush();
+    }
+
+    inline void setCoalesceRate(neko::uint32 hz) {
+        bus::getEventCoalescer().setRate(hz);
+    }
+
     template <typename T>
     inline bool addFilter(neko::event::HandlerId handlerId, std::unique_ptr<neko::event::EventFilter<T>> filter) {
         return bus::getEventLoop().addFilter<T>(handlerId, std::move(filter));
@@ -0,0 +1,136 @@
+/**
+ * @see neko/bus/eventBus.hpp
+ * @file eventCoalescer.hpp
+ * @brief Latest-value-wins coalescing for high-frequency state events.
+ */
+
+#pragma once
+
+#include <neko/schema/types.hpp>
+#include <neko/event/event.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace neko::bus {
+
+    /**
+     * @brief Coalesces state-like events (progress, status text) before they reach the event loop.
+     *
+     * Each (event type, key) slot holds at most one pending value; publishing again replaces it.
+     * Pending slots are delivered together, in first-published order, at most once per interval.
+     */
+    class EventCoalescer {
+    private:
+        using Clock = std::chrono::steady_clock;
+        using Slot = std::pair<std::type_index, std::string>;
+
+        event::EventLoop &loop;
+
+        std::mutex mutex;
+        std::map<Slot, neko::uint64> index;
+        std::vector<std::pair<Slot, std::function<void()>>> pending;
+        Clock::time_point lastFlush{};
+        // Bumped by every flush; a scheduled flush from an earlier generation was overtaken and does nothing.
+        neko::uint64 generation = 0;
+
+        // Minimum delay between two deliveries, 0 disables coalescing.
+        std::atomic<neko::uint64> intervalMs{1000 / 30};
+
+        // Deliver and clear the pending slots; with `expected`, only if no flush has happened since it was scheduled.
+        void deliverPending(std::optional<neko::uint64> expected) {
+            std::vector<std::pair<Slot, std::function<void()>>> ready;
+            {
+                std::lock_guard lock(mutex);
+                if (expected && *expected != generation) {
+                    return;
+                }
+                ++generation;
+                ready.swap(pending);
+                index.clear();
+                lastFlush = Clock::now();
+            }
+            for (auto &[slot, deliver] : ready) {
+                deliver();
+            }
+        }
+
+    public:
+        explicit EventCoalescer(event::EventLoop &loop) : loop(loop) {}
+
+        /**
+         * @brief Queue an event, replacing any pending event of the same type and key.
+         * @param eventData The latest state to deliver.
+         * @param key Optional key to keep several independent slots for one event type.
+         */
+        template <typename T>
+        void publish(T eventData, const std::string &key = {}) {
+            if (intervalMs.load(std::memory_order_relaxed) == 0) {
+                loop.publish<T>(std::move(eventData));
+                return;
+            }
+
+            auto deliver = [&loop = loop, data = std::move(eventData)]() {
+                loop.publish<T>(data);
+            };
+
+            bool needSchedule = false;
+            neko::uint64 delayMs = 0;
+            neko::uint64 scheduledGeneration = 0;
+            {
+                std::lock_guard lock(mutex);
+                Slot slot{std::type_index(typeid(T)), key};
+                if (auto it = index.find(slot); it != index.end()) {
+                    pending[it->second].second = std::move(deliver);
+                    return;
+                }
+
+                // A flush is scheduled whenever pending is non-empty.
+                needSchedule = pending.empty();
+                index.emplace(slot, pending.size());
+                pending.emplace_back(std::move(slot), std::move(deliver));
+
+                if (needSchedule) {
+                    scheduledGeneration = generation;
+                    const auto interval = std::chrono::milliseconds(intervalMs.load(std::memory_order_relaxed));
+                    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - lastFlush);
+                    delayMs = elapsed < interval ? static_cast<neko::uint64>((interval - elapsed).count()) : 0;
+                }
+            }
+
+            if (needSchedule) {
+                loop.scheduleTask(delayMs, [this, scheduledGeneration]() { deliverPending(scheduledGeneration); });
+            }
+        }
+
+        /**
+         * @brief Deliver all pending events now.
+         * @note Call before publishing a final, non-coalesced state so a stale value cannot overwrite it.
+         */
+        void flush() {
+            deliverPending(std::nullopt);
+        }
+
+        /**
+         * @brief Set the maximum delivery rate.
+         * @param hz Deliveries per second; 0 publishes every event immediately.
+         */
+        void setRate(neko::uint32 hz) {
+            intervalMs.store(hz > 0 ? 1000 / hz : 0, std::memory_order_relaxed);
+        }
+
+        neko::uint64 getPendingCount() {
+            std::lock_guard lock(mutex);
+            return pending.size();
+        }
+    };
+
+} // namespace neko::bus
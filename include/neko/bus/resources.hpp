@@ -9,9 +9,24 @@
 #include <neko/thread/threadPool.hpp>
 
 #include "neko/app/configManager.hpp"
+#include "neko/bus/eventCoalescer.hpp"
+#include "neko/bus/taskScheduler.hpp"
 
 namespace neko::bus {
 
+    /**
+     * @brief Named executors backing the thread bus.
+     *
+     * - cpu: bounded pool for short, CPU-bound work (hashing, parsing, UI-adjacent tasks); also hosts the event loop.
+     * - io: larger pool for blocking network and disk work (downloads, installs, remote requests).
+     * - background: small low-priority pool for work nobody is waiting on (log uploads, prefetching).
+     */
+    enum class Executor {
+        cpu,
+        io,
+        background
+    };
+
     /**
      * @brief Central access point for global resources in the Neko framework.
      * 
@@ -29,6 +44,49 @@ namespace neko::bus {
             return instance;
         }
 
+        /**
+         * @brief Gets the thread pool backing a named executor.
+         * @param executor The executor to look up; Executor::cpu is the global thread pool.
+         * @return Reference to the executor's thread pool object.
+         */
+        static thread::ThreadPool& getThreadPool(Executor executor) {
+            switch (executor) {
+                case Executor::io: {
+                    static thread::ThreadPool instance;
+                    return instance;
+                }
+                case Executor::background: {
+                    static thread::ThreadPool instance;
+                    return instance;
+                }
+                case Executor::cpu:
+                default:
+                    return getThreadPool();
+            }
+        }
+
+        /**
+         * @brief Gets the priority-class scheduler in front of a named executor.
+         * @return Reference to the executor's task scheduler.
+         */
+        static TaskScheduler& getTaskScheduler(Executor executor) {
+            switch (executor) {
+                case Executor::io: {
+                    static TaskScheduler instance(getThreadPool(Executor::io));
+                    return instance;
+                }
+                case Executor::background: {
+                    static TaskScheduler instance(getThreadPool(Executor::background));
+                    return instance;
+                }
+                case Executor::cpu:
+                default: {
+                    static TaskScheduler instance(getThreadPool());
+                    return instance;
+                }
+            }
+        }
+
         /**
          * @brief Gets the global configuration object.
          * @return Reference to the global SimpleIni configuration object.
@@ -46,6 +104,15 @@ namespace neko::bus {
             static event::EventLoop instance;
             return instance;
         }
+
+        /**
+         * @brief Gets the global event coalescer bound to the global event loop.
+         * @return Reference to the global event coalescer object.
+         */
+        static EventCoalescer& getEventCoalescer() {
+            static EventCoalescer instance(getEventLoop());
+            return instance;
+        }
     };
 
     /**
@@ -58,6 +125,22 @@ namespace neko::bus {
         return Resources::getThreadPool();
     }
 
+    /**
+     * @brief Gets the thread pool backing a named executor.
+     * @return Reference to the executor's thread pool object.
+     */
+    inline thread::ThreadPool& getThreadPool(Executor executor) {
+        return Resources::getThreadPool(executor);
+    }
+
+    /**
+     * @brief Gets the priority-class scheduler in front of a named executor.
+     * @return Reference to the executor's task scheduler.
+     */
+    inline TaskScheduler& getTaskScheduler(Executor executor) {
+        return Resources::getTaskScheduler(executor);
+    }
+
     /**
      * @brief Gets the global configuration object.
      * @return Reference to the global SimpleIni configuration object.
@@ -76,4 +159,12 @@ namespace neko::bus {
         return Resources::getEventLoop();
     }
 
+    /**
+     * @brief Gets the global event coalescer instance.
+     * @return Reference to the global event coalescer object.
+     */
+    inline EventCoalescer& getEventCoalescer() {
+        return Resources::getEventCoalescer();
+    }
+
 } // namespace neko::bus
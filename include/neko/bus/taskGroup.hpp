@@ -0,0 +1,281 @@
+/**
+ * @see neko/bus/threadBus.hpp
+ * @file taskGroup.hpp
+ * @brief Structured task groups with a shared cancellation token.
+ */
+
+#pragma once
+
+#include <neko/schema/exception.hpp>
+#include <neko/schema/types.hpp>
+
+#include "neko/bus/threadBus.hpp"
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace neko::bus::thread {
+
+    /**
+     * @brief Copyable cancellation flag; every copy observes the same state.
+     *
+     * Long-running tasks poll isCancelled() between units of work (before a transfer,
+     * between retries, before hashing) so a cancel releases threads and bandwidth quickly.
+     */
+    class CancellationToken {
+    private:
+        struct State {
+            std::atomic<bool> cancelled{false};
+            mutable std::mutex mutex;
+            std::string reason;
+        };
+        std::shared_ptr<State> state = std::make_shared<State>();
+
+    public:
+        bool isCancelled() const noexcept {
+            return state->cancelled.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Request cancellation; the first reason wins.
+         * @return true if this call cancelled the token, false if it was already cancelled.
+         */
+        bool cancel(const std::string &reason = "Cancelled") {
+            std::lock_guard lock(state->mutex);
+            if (state->cancelled.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            state->reason = reason;
+            state->cancelled.store(true, std::memory_order_release);
+            return true;
+        }
+
+        std::string getReason() const {
+            std::lock_guard lock(state->mutex);
+            return state->reason;
+        }
+
+        /**
+         * @throws ex::Runtime if the token has been cancelled.
+         */
+        void throwIfCancelled() const {
+            if (isCancelled()) {
+                throw ex::Runtime("Cancelled: " + getReason());
+            }
+        }
+    };
+
+    /**
+     * @brief A set of tasks on one executor that is waited for and cancelled as a unit.
+     *
+     * - spawn() submits a task; tasks not yet started when the group is cancelled are skipped.
+     * - With fail-fast (default), the first task that throws cancels the token for all others.
+     * - The destructor waits for every task, cancelling first if the scope is being unwound
+     *   by an exception, so tasks may safely reference the enclosing stack frame.
+     */
+    class TaskGroup {
+    private:
+        Executor executor;
+        CancellationToken token;
+        TaskClass taskClass;
+        bool failFast;
+
+        std::mutex mutex;
+        std::vector<std::function<void()>> waiters;
+        std::optional<std::string> firstError;
+        std::exception_ptr firstException;
+
+        void recordFailure(const std::string &msg) {
+            {
+                std::lock_guard lock(mutex);
+                if (!firstError) {
+                    firstError = msg;
+                    firstException = std::current_exception();
+                }
+            }
+            if (failFast) {
+                token.cancel(msg);
+            }
+        }
+
+    public:
+        explicit TaskGroup(Executor executor = Executor::cpu, CancellationToken token = {}, TaskClass taskClass = TaskClass::normal, bool failFast = true)
+            : executor(executor), token(std::move(token)), taskClass(taskClass), failFast(failFast) {}
+
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+        ~TaskGroup() {
+            if (std::uncaught_exceptions() > 0) {
+                token.cancel("Scope exited with an exception");
+            }
+            waitAll();
+        }
+
+        /**
+         * @brief Submit a task to the group's executor.
+         * @param function Callable taking no arguments or a `const CancellationToken &`.
+         * @return Shared future of the callable's result. A task skipped due to cancellation
+         *         completes with ex::Runtime and is not counted as a failure.
+         */
+        template <typename F>
+        auto spawn(F &&function) {
+            using Fn = std::decay_t<F>;
+            constexpr bool takesToken = std::is_invocable_v<Fn &, const CancellationToken &>;
+            using Result = typename std::conditional_t<takesToken, std::invoke_result<Fn &, const CancellationToken &>, std::invoke_result<Fn &>>::type;
+
+            auto future = schedule(executor, {.taskClass = taskClass}, [this, token = token, function = std::forward<F>(function)]() mutable -> Result {
+                              token.throwIfCancelled();
+                              try {
+                                  if constexpr (takesToken) {
+                                      return std::invoke(function, std::as_const(token));
+                                  } else {
+                                      return std::invoke(function);
+                                  }
+                              } catch (const std::exception &e) {
+                                  // Unwinding because of an earlier cancel is not a failure of its own.
+                                  if (!token.isCancelled()) {
+                                      recordFailure(e.what());
+                                  }
+                                  throw;
+                              } catch (...) {
+                                  if (!token.isCancelled()) {
+                                      recordFailure("Unknown error");
+                                  }
+                                  throw;
+                              }
+                          }).share();
+
+            std::lock_guard lock(mutex);
+            waiters.push_back([future]() { future.wait(); });
+            return future;
+        }
+
+        /**
+         * @brief Block until every spawned task (including ones spawned while waiting) has finished.
+         */
+        void waitAll() {
+            for (std::size_t i = 0;; ++i) {
+                std::function<void()> waiter;
+                {
+                    std::lock_guard lock(mutex);
+                    if (i >= waiters.size()) {
+                        break;
+                    }
+                    waiter = waiters[i];
+                }
+                waiter();
+            }
+        }
+
+        /**
+         * @brief Cancel the group's token; queued tasks are skipped and running ones observe it.
+         */
+        void cancelAll(const std::string &reason = "Cancelled") {
+            token.cancel(reason);
+        }
+
+        bool isCancelled() const noexcept {
+            return token.isCancelled();
+        }
+        bool hasFailed() {
+            std::lock_guard lock(mutex);
+            return firstError.has_value();
+        }
+        std::optional<std::string> getFirstError() {
+            std::lock_guard lock(mutex);
+            return firstError;
+        }
+        /**
+         * @brief Rethrow the first task failure with its original type, if any.
+         */
+        void rethrowIfFailed() {
+            std::exception_ptr ex;
+            {
+                std::lock_guard lock(mutex);
+                ex = firstException;
+            }
+            if (ex) {
+                std::rethrow_exception(ex);
+            }
+        }
+        const CancellationToken &getToken() const noexcept {
+            return token;
+        }
+    };
+
+    namespace detail {
+        struct ForegroundState {
+            std::mutex mutex;
+            std::optional<CancellationToken> token;
+            neko::uint32 depth = 0;
+        };
+
+        inline ForegroundState &getForegroundState() {
+            static ForegroundState state;
+            return state;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Scope of the user-visible operation (install, update, launch preparation) that the
+     * loading page's Cancel button targets. Nested scopes share the outermost token.
+     */
+    class ForegroundOperation {
+    private:
+        CancellationToken token;
+
+    public:
+        ForegroundOperation() {
+            auto &state = detail::getForegroundState();
+            std::lock_guard lock(state.mutex);
+            if (state.depth++ == 0 || !state.token) {
+                state.token = CancellationToken{};
+            }
+            token = *state.token;
+        }
+        ~ForegroundOperation() {
+            auto &state = detail::getForegroundState();
+            std::lock_guard lock(state.mutex);
+            if (--state.depth == 0) {
+                state.token.reset();
+            }
+        }
+
+        ForegroundOperation(const ForegroundOperation &) = delete;
+        ForegroundOperation &operator=(const ForegroundOperation &) = delete;
+
+        const CancellationToken &getToken() const noexcept {
+            return token;
+        }
+    };
+
+    /**
+     * @brief Token of the running foreground operation, or a fresh unshared token if there is none.
+     */
+    inline CancellationToken getForegroundToken() {
+        auto &state = detail::getForegroundState();
+        std::lock_guard lock(state.mutex);
+        return state.token.value_or(CancellationToken{});
+    }
+
+    /**
+     * @brief Cancel the running foreground operation, if any.
+     * @return true if an operation was running and is now cancelled.
+     */
+    inline bool cancelForeground(const std::string &reason) {
+        auto &state = detail::getForegroundState();
+        std::lock_guard lock(state.mutex);
+        return state.token && state.token->cancel(reason);
+    }
+
+} // namespace neko::bus::thread
@@ -0,0 +1,336 @@
+/**
+ * @see neko/bus/threadBus.hpp
+ * @file taskScheduler.hpp
+ * @brief Priority-class, deadline-aware dispatch on top of a thread pool.
+ */
+
+#pragma once
+
+#include <neko/schema/exception.hpp>
+#include <neko/schema/types.hpp>
+#include <neko/thread/threadPool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace neko::bus {
+
+    /**
+     * @brief Scheduling class of a task, most urgent first.
+     *
+     * - interactive: the user is waiting on it (launch, auth, settings actions, network retry).
+     * - normal: default.
+     * - bulk: large batches (install/update downloads, hashing).
+     * - idle: only when nothing else is queued (crash log upload, prewarming).
+     */
+    enum class TaskClass {
+        interactive,
+        normal,
+        bulk,
+        idle
+    };
+
+    struct ScheduleOptions {
+        TaskClass taskClass = TaskClass::normal;
+        /**
+         * @brief Tasks still queued at this point are dropped; their future reports ex::Runtime.
+         */
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+    };
+
+    /**
+     * @brief Queue-wait metrics of one task class on one executor.
+     */
+    struct TaskClassStats {
+        neko::uint64 queued = 0;
+        neko::uint64 dispatched = 0;
+        neko::uint64 expired = 0;
+        double averageWaitMs = 0.0;
+        double maxWaitMs = 0.0;
+    };
+
+    /**
+     * @brief Picks which queued task a pool worker runs next.
+     *
+     * Tasks wait in one FIFO per class; for each task one "pump" is submitted to the pool, and the
+     * pump runs whichever task is most urgent when a worker becomes free. The pool itself stays FIFO.
+     * Aging: a class that has not been served for N aging steps is treated N classes more urgent,
+     * so a steady stream of interactive work cannot starve bulk or idle tasks.
+     * A standby worker, started on first use, takes more urgent work handed over by yieldToMoreUrgent().
+     */
+    class TaskScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+        static constexpr std::size_t classCount = 4;
+
+    private:
+        struct Entry {
+            neko::uint64 seq = 0;
+            Clock::time_point enqueued;
+            std::optional<Clock::time_point> deadline;
+            std::function<void()> run;
+            std::function<void()> expire;
+        };
+
+        struct ClassMetrics {
+            neko::uint64 dispatched = 0;
+            neko::uint64 expired = 0;
+            double totalWaitMs = 0.0;
+            double maxWaitMs = 0.0;
+            Clock::time_point lastServed = Clock::now();
+        };
+
+        thread::ThreadPool &pool;
+
+        mutable std::mutex mutex;
+        std::array<std::deque<Entry>, classCount> queues;
+        std::array<ClassMetrics, classCount> metrics;
+        neko::uint64 nextSeq = 0;
+        std::atomic<neko::int64> agingStepMs{500};
+
+        // Scheduler and class of the task running on this thread, for yieldToMoreUrgent().
+        static inline thread_local TaskScheduler *current = nullptr;
+        static inline thread_local TaskClass currentClass = TaskClass::normal;
+
+        std::mutex standbyMutex;
+        std::condition_variable standbyCv;
+        std::thread standby;
+        std::optional<TaskClass> standbyWanted; // run queued work more urgent than this class
+        bool stopping = false;
+
+        // Caller holds the lock. Returns the entry to run and whether its deadline already passed.
+        std::optional<std::pair<Entry, bool>> popLocked(std::size_t cls, Clock::time_point now) {
+            Entry entry = std::move(queues[cls].front());
+            queues[cls].pop_front();
+
+            auto &m = metrics[cls];
+            m.lastServed = now;
+            if (entry.deadline && now > *entry.deadline) {
+                ++m.expired;
+                return std::make_pair(std::move(entry), true);
+            }
+            const double waitMs = std::chrono::duration<double, std::milli>(now - entry.enqueued).count();
+            ++m.dispatched;
+            m.totalWaitMs += waitMs;
+            m.maxWaitMs = std::max(m.maxWaitMs, waitMs);
+            return std::make_pair(std::move(entry), false);
+        }
+
+        void execute(std::pair<Entry, bool> &next, TaskClass cls) {
+            auto &[entry, expired] = next;
+            if (expired) {
+                entry.expire();
+                return;
+            }
+            auto *previous = current;
+            const auto previousClass = currentClass;
+            current = this;
+            currentClass = cls;
+            entry.run();
+            current = previous;
+            currentClass = previousClass;
+        }
+
+        // Standby body: run the work handed over by yielding tasks until none is left, then wait again.
+        void standbyLoop() {
+            std::unique_lock lock(standbyMutex);
+            while (true) {
+                standbyCv.wait(lock, [this] { return stopping || standbyWanted.has_value(); });
+                if (stopping) {
+                    return;
+                }
+                const auto below = *standbyWanted;
+                standbyWanted.reset();
+                lock.unlock();
+                std::size_t cls = 0;
+                while (auto next = popNext(cls, below)) {
+                    execute(*next, static_cast<TaskClass>(cls));
+                }
+                lock.lock();
+            }
+        }
+
+        bool hasQueuedMoreUrgentThan(TaskClass taskClass) const {
+            std::lock_guard lock(mutex);
+            for (std::size_t c = 0; c < static_cast<std::size_t>(taskClass); ++c) {
+                if (!queues[c].empty()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Pump body: run the most urgent queued task, if any is left.
+        void runOne() {
+            std::size_t cls = 0;
+            if (auto next = popNext(cls)) {
+                execute(*next, static_cast<TaskClass>(cls));
+            }
+        }
+
+        std::optional<std::pair<Entry, bool>> popNext(std::size_t &cls, std::optional<TaskClass> moreUrgentThan = std::nullopt) {
+            const auto now = Clock::now();
+            const auto step = std::max<neko::int64>(1, agingStepMs.load(std::memory_order_relaxed));
+
+            std::lock_guard lock(mutex);
+            std::optional<std::size_t> best;
+            neko::int64 bestRank = 0;
+            for (std::size_t c = 0; c < classCount; ++c) {
+                if (moreUrgentThan && c >= static_cast<std::size_t>(*moreUrgentThan)) {
+                    break;
+                }
+                if (queues[c].empty()) {
+                    continue;
+                }
+                // Starvation is measured from the later of "last served" and "front enqueued",
+                // so a class that is continuously served gets no boost however long its queue is.
+                const auto since = std::max(metrics[c].lastServed, queues[c].front().enqueued);
+                const auto starvedMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - since).count();
+                const neko::int64 rank = static_cast<neko::int64>(c) - starvedMs / step;
+                if (!best || rank < bestRank) {
+                    best = c;
+                    bestRank = rank;
+                }
+            }
+            if (!best) {
+                return std::nullopt;
+            }
+            cls = *best;
+            return popLocked(cls, now);
+        }
+
+    public:
+        explicit TaskScheduler(thread::ThreadPool &pool) : pool(pool) {}
+
+        TaskScheduler(const TaskScheduler &) = delete;
+        TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+        ~TaskScheduler() {
+            {
+                std::lock_guard lock(standbyMutex);
+                stopping = true;
+            }
+            standbyCv.notify_all();
+            if (standby.joinable()) {
+                standby.join();
+            }
+        }
+
+        /**
+         * @brief Queue a task in its class and submit a pump for it.
+         * @param onExpired Called when the task is dropped at its deadline.
+         * @return Future of the task's result.
+         * @throws Whatever the pool throws when its queue is full; the task is not queued then.
+         */
+        template <typename F>
+        auto submit(ScheduleOptions options, F &&function, std::function<void()> onExpired = {}) {
+            using Fn = std::decay_t<F>;
+            using Result = std::invoke_result_t<Fn &>;
+
+            auto promise = std::make_shared<std::promise<Result>>();
+            auto fn = std::make_shared<Fn>(std::forward<F>(function));
+            auto future = promise->get_future();
+
+            Entry entry{
+                .enqueued = Clock::now(),
+                .deadline = options.deadline,
+                .run = [promise, fn]() {
+                    try {
+                        if constexpr (std::is_void_v<Result>) {
+                            std::invoke(*fn);
+                            promise->set_value();
+                        } else {
+                            promise->set_value(std::invoke(*fn));
+                        }
+                    } catch (...) {
+                        promise->set_exception(std::current_exception());
+                    }
+                },
+                .expire = [promise, onExpired = std::move(onExpired)]() {
+                    if (onExpired) {
+                        onExpired();
+                    }
+                    promise->set_exception(std::make_exception_ptr(ex::Runtime("Task deadline exceeded before it started")));
+                }};
+
+            const auto cls = static_cast<std::size_t>(options.taskClass);
+            neko::uint64 seq = 0;
+            {
+                std::lock_guard lock(mutex);
+                seq = entry.seq = nextSeq++;
+                queues[cls].push_back(std::move(entry));
+            }
+
+            try {
+                (void)pool.submit([this]() { runOne(); });
+            } catch (...) {
+                std::lock_guard lock(mutex);
+                auto &queue = queues[cls];
+                queue.erase(std::remove_if(queue.begin(), queue.end(), [seq](const Entry &e) { return e.seq == seq; }), queue.end());
+                throw;
+            }
+            return future;
+        }
+
+        /**
+         * @brief Let a long-running task give way between units of work.
+         *
+         * If the calling thread runs a task of this scheduler and a strictly more urgent class has
+         * queued work, that work is handed to the standby worker. The caller never runs it and
+         * returns at once, so a long interactive task cannot stall it.
+         * @return true if work was handed over.
+         */
+        bool yieldToMoreUrgent() {
+            if (current != this || currentClass == TaskClass::interactive || !hasQueuedMoreUrgentThan(currentClass)) {
+                return false;
+            }
+            std::lock_guard lock(standbyMutex);
+            if (stopping) {
+                return false;
+            }
+            if (!standby.joinable()) {
+                standby = std::thread([this]() { standbyLoop(); });
+            }
+            standbyWanted = standbyWanted ? std::max(*standbyWanted, currentClass) : currentClass;
+            standbyCv.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief Scheduler running the current thread's task, or nullptr outside a scheduled task.
+         */
+        static TaskScheduler *getCurrent() noexcept {
+            return current;
+        }
+
+        TaskClassStats getStats(TaskClass taskClass) const {
+            const auto cls = static_cast<std::size_t>(taskClass);
+            std::lock_guard lock(mutex);
+            const auto &m = metrics[cls];
+            return TaskClassStats{
+                .queued = queues[cls].size(),
+                .dispatched = m.dispatched,
+                .expired = m.expired,
+                .averageWaitMs = m.dispatched > 0 ? m.totalWaitMs / static_cast<double>(m.dispatched) : 0.0,
+                .maxWaitMs = m.maxWaitMs};
+        }
+
+        void setAgingStep(std::chrono::milliseconds step) {
+            agingStepMs.store(step.count(), std::memory_order_relaxed);
+        }
+    };
+
+} // namespace neko::bus
@@ -11,17 +11,127 @@
 
 #include "neko/bus/resources.hpp"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <utility>
+#include <vector>
+
 /**
  * @namespace neko::bus::thread
  */
 namespace neko::bus::thread {
 
+    using bus::Executor;
+    using bus::ScheduleOptions;
+    using bus::TaskClass;
+    using bus::TaskClassStats;
+
+    // Sizes applied at startup (see app::init::initThreads); the cpu pool follows the client config.
+    inline constexpr neko::uint64 defaultIoThreadCount = 64;
+    inline constexpr neko::uint64 defaultIoMaxQueueSize = 65536;
+    inline constexpr neko::uint64 defaultBackgroundThreadCount = 2;
+    inline constexpr neko::uint64 defaultBackgroundMaxQueueSize = 1024;
+
+    /**
+     * @brief Point-in-time metrics of one executor.
+     * @note submitted/completed/rejected/expired are cumulative and only count tasks submitted through this bus.
+     */
+    struct ExecutorStats {
+        neko::uint64 threadCount = 0;
+        neko::uint64 pendingTasks = 0;
+        neko::uint64 maxQueueSize = 0;
+        double queueUtilization = 0.0;
+        double threadUtilization = 0.0;
+        neko::uint64 submitted = 0;
+        neko::uint64 completed = 0;
+        neko::uint64 rejected = 0;
+        neko::uint64 expired = 0; ///< dropped at their deadline before they started
+    };
+
+    namespace detail {
+        struct ExecutorCounters {
+            std::atomic<neko::uint64> submitted{0};
+            std::atomic<neko::uint64> completed{0};
+            std::atomic<neko::uint64> rejected{0};
+            std::atomic<neko::uint64> expired{0};
+        };
+
+        inline ExecutorCounters &getCounters(Executor executor) {
+            static std::array<ExecutorCounters, 3> counters;
+            return counters[static_cast<std::size_t>(executor)];
+        }
+
+        // Wraps a task so its completion (normal or by exception) is counted.
+        auto countCompletion(ExecutorCounters &counters, auto &&function, auto &&...args) {
+            return [&counters, function = std::forward<decltype(function)>(function), ... args = std::forward<decltype(args)>(args)]() mutable -> decltype(auto) {
+                struct Done {
+                    ExecutorCounters &counters;
+                    ~Done() { counters.completed.fetch_add(1, std::memory_order_relaxed); }
+                } done{counters};
+                return std::invoke(std::move(function), std::move(args)...);
+            };
+        }
+
+        auto submitCounted(Executor executor, auto &&submitFn) {
+            auto &counters = getCounters(executor);
+            counters.submitted.fetch_add(1, std::memory_order_relaxed);
+            try {
+                return submitFn(counters);
+            } catch (...) {
+                counters.submitted.fetch_sub(1, std::memory_order_relaxed);
+                counters.rejected.fetch_add(1, std::memory_order_relaxed);
+                throw;
+            }
+        }
+    } // namespace detail
+
     // === Submit task ===
+
+    inline TaskClass toTaskClass(neko::Priority priority) {
+        switch (priority) {
+            case neko::Priority::Critical:
+                return TaskClass::interactive;
+            case neko::Priority::Low:
+                return TaskClass::bulk;
+            default:
+                return TaskClass::normal;
+        }
+    }
+
+    /**
+     * @brief Submit a task to a named executor with a scheduling class and optional deadline.
+     * @throws Whatever the underlying pool throws when its queue is full or it is stopped; counted as rejected.
+     */
+    auto schedule(Executor executor, ScheduleOptions options, auto &&function, auto &&...args) {
+        return detail::submitCounted(executor, [&](detail::ExecutorCounters &counters) {
+            return bus::getTaskScheduler(executor).submit(
+                options, detail::countCompletion(counters, std::forward<decltype(function)>(function), std::forward<decltype(args)>(args)...),
+                [&counters]() { counters.expired.fetch_add(1, std::memory_order_relaxed); });
+        });
+    }
+    auto submitTo(Executor executor, auto &&function, auto &&...args) {
+        return schedule(executor, {}, std::forward<decltype(function)>(function), std::forward<decltype(args)>(args)...);
+    }
+    auto submitToWithPriority(Executor executor, neko::Priority priority, auto &&function, auto &&...args) {
+        return schedule(executor, {.taskClass = toTaskClass(priority)}, std::forward<decltype(function)>(function), std::forward<decltype(args)>(args)...);
+    }
+
+    // CPU-bound, short tasks.
     auto submit(auto &&function, auto &&...args) {
-        return bus::getThreadPool().submit(std::forward<decltype(function)>(function), std::forward<decltype(args)>(args)...);
+        return submitTo(Executor::cpu, std::forward<decltype(function)>(function), std::forward<decltype(args)>(args)...);
     }
     auto submitWithPriority(neko::Priority priority, auto &&function, auto &&...args) {
-        return bus::getThreadPool().submitWithPriority(priority, std::forward<decltype(function)>(function), std::forward<decltype(args)>(args)...);
+        return submitToWithPriority(Executor::cpu, priority, std::forward<decltype(function)>(function), std::forward<decltype(args)>(args)...);
+    }
+    // Blocking network / disk work.
+    auto submitIo(auto &&function, auto &&...args) {
+        return submitTo(Executor::io, std::forward<decltype(function)>(function), std::forward<decltype(args)>(args)...);
+    }
+    // Low-priority work nobody waits on.
+    auto submitBackground(auto &&function, auto &&...args) {
+        return submitTo(Executor::background, std::forward<decltype(function)>(function), std::forward<decltype(args)>(args)...);
     }
     auto submitToWorker(neko::uint64 workerId, auto &&function, auto &&...args) {
         return bus::getThreadPool().submitToWorker(workerId, std::forward<decltype(function)>(function), std::forward<decltype(args)>(args)...);
@@ -70,4 +180,86 @@ namespace neko::bus::thread {
         bus::getThreadPool().setMaxQueueSize(maxSize);
     }
 
+    // === Named executors ===
+    inline ExecutorStats getExecutorStats(Executor executor) {
+        auto &pool = bus::getThreadPool(executor);
+        const auto &counters = detail::getCounters(executor);
+        return ExecutorStats{
+            .threadCount = pool.getThreadCount(),
+            .pendingTasks = pool.getPendingTaskCount(),
+            .maxQueueSize = pool.getMaxQueueSize(),
+            .queueUtilization = pool.getQueueUtilization(),
+            .threadUtilization = pool.getThreadUtilization(),
+            .submitted = counters.submitted.load(std::memory_order_relaxed),
+            .completed = counters.completed.load(std::memory_order_relaxed),
+            .rejected = counters.rejected.load(std::memory_order_relaxed),
+            .expired = counters.expired.load(std::memory_order_relaxed)};
+    }
+    inline std::vector<neko::uint64> getWorkerIds(Executor executor) {
+        return bus::getThreadPool(executor).getWorkerIds();
+    }
+    inline void setThreadCount(Executor executor, neko::uint64 newThreadCount) {
+        bus::getThreadPool(executor).setThreadCount(newThreadCount);
+    }
+    inline void setMaxQueueSize(Executor executor, neko::uint64 maxSize) {
+        bus::getThreadPool(executor).setMaxQueueSize(maxSize);
+    }
+    auto submitToWorker(Executor executor, neko::uint64 workerId, auto &&function, auto &&...args) {
+        return bus::getThreadPool(executor).submitToWorker(workerId, std::forward<decltype(function)>(function), std::forward<decltype(args)>(args)...);
+    }
+
+    /**
+     * @brief Stop every executor, least important first; the cpu pool (hosting the event loop) goes last.
+     */
+    inline void stopAll(bool waitForCompletion = true) {
+        bus::getThreadPool(Executor::background).stop(waitForCompletion);
+        bus::getThreadPool(Executor::io).stop(waitForCompletion);
+        bus::getThreadPool(Executor::cpu).stop(waitForCompletion);
+    }
+
+    // === Scheduling ===
+
+    /**
+     * @brief Call between units of work in long bulk/idle tasks; hands queued work of a more urgent class to the standby worker.
+     * @return true if work was handed over.
+     */
+    inline bool yieldPoint() {
+        if (auto *scheduler = TaskScheduler::getCurrent()) {
+            return scheduler->yieldToMoreUrgent();
+        }
+        return false;
+    }
+    inline TaskClassStats getTaskClassStats(Executor executor, TaskClass taskClass) {
+        return bus::getTaskScheduler(executor).getStats(taskClass);
+    }
+    inline void setAgingStep(Executor executor, std::chrono::milliseconds step) {
+        bus::getTaskScheduler(executor).setAgingStep(step);
+    }
+
+    inline const char *toString(TaskClass taskClass) {
+        switch (taskClass) {
+            case TaskClass::interactive:
+                return "interactive";
+            case TaskClass::bulk:
+                return "bulk";
+            case TaskClass::idle:
+                return "idle";
+            case TaskClass::normal:
+            default:
+                return "normal";
+        }
+    }
+
+    inline const char *toString(Executor executor) {
+        switch (executor) {
+            case Executor::io:
+                return "io";
+            case Executor::background:
+                return "background";
+            case Executor::cpu:
+            default:
+                return "cpu";
+        }
+    }
+
 } // namespace neko::bus::thread
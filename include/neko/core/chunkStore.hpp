@@ -0,0 +1,418 @@
+/**
+ * @see neko/core/update.hpp
+ * @file chunkStore.hpp
+ * @brief Content-defined chunking and a local chunk store for chunked resource updates.
+ */
+
+#pragma once
+
+#include <neko/log/nlog.hpp>
+#include <neko/schema/exception.hpp>
+#include <neko/schema/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace neko::core::chunk {
+
+    /**
+     * @brief Name of the chunker below; manifests made with anything else cannot be seeded locally.
+     */
+    inline constexpr std::string_view GearV1 = "gear-v1";
+
+    struct ChunkParams {
+        neko::uint64 minSize = 16 * 1024;
+        neko::uint64 avgSize = 64 * 1024;
+        neko::uint64 maxSize = 256 * 1024;
+    };
+
+    /**
+     * @brief One chunk of a local file.
+     */
+    struct Chunk {
+        neko::uint64 offset = 0;
+        neko::uint64 size = 0;
+        std::string hash;
+    };
+
+    /**
+     * @brief One chunk of a file as listed by a manifest, in file order.
+     */
+    struct ChunkRef {
+        std::string hash;
+        neko::uint64 size = 0;
+    };
+
+    /**
+     * @brief Hashes chunk bytes; must match the manifest's chunk hash algorithm.
+     */
+    using Hasher = std::function<std::string(std::string_view data)>;
+
+    namespace detail {
+        constexpr neko::uint64 splitMix64(neko::uint64 &state) {
+            neko::uint64 z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        // The gear table is part of the chunk format: splitmix64 from seed 0.
+        constexpr std::array<neko::uint64, 256> makeGearTable() {
+            std::array<neko::uint64, 256> table{};
+            neko::uint64 state = 0;
+            for (auto &value : table) {
+                value = splitMix64(state);
+            }
+            return table;
+        }
+
+        inline constexpr auto GearTable = makeGearTable();
+
+        constexpr neko::uint32 log2(neko::uint64 value) {
+            neko::uint32 bits = 0;
+            while (value > 1) {
+                value >>= 1;
+                ++bits;
+            }
+            return bits;
+        }
+
+        // Mask over the top `bits` bits; the top of a gear hash depends on the last 64 bytes.
+        constexpr neko::uint64 topMask(neko::uint32 bits) {
+            return bits == 0 ? 0 : ~0ull << (64 - bits);
+        }
+    } // namespace detail
+
+    /**
+     * @brief Content-defined chunk boundaries (gear rolling hash with FastCDC-style normalization).
+     *
+     * Cuts depend only on nearby content, so inserting or moving data inside a file changes the
+     * chunks around the edit and leaves the rest identical.
+     */
+    class Chunker {
+    private:
+        ChunkParams params;
+        neko::uint64 maskSmall = 0;
+        neko::uint64 maskLarge = 0;
+
+    public:
+        /**
+         * @throws ex::ArgumentError unless 2 <= min <= avg <= max
+         */
+        explicit Chunker(ChunkParams params = {})
+            : params(params) {
+            if (params.minSize < 2 || params.minSize > params.avgSize || params.avgSize > params.maxSize) {
+                throw ex::ArgumentError("Chunk sizes must satisfy 2 <= min <= avg <= max");
+            }
+            // Harder to cut before the average size, easier after it.
+            maskSmall = detail::topMask(detail::log2(params.avgSize) + 1);
+            maskLarge = detail::topMask(detail::log2(params.avgSize) - 1);
+        }
+
+        /**
+         * @brief Length of the next chunk at the start of `data`.
+         * @param final Whether `data` reaches the end of the file; otherwise it must hold at least maxSize bytes.
+         */
+        neko::uint64 cut(std::string_view data, bool final) const {
+            const neko::uint64 size = data.size();
+            if (size <= params.minSize) {
+                return final ? size : std::min(size, params.minSize);
+            }
+            const neko::uint64 end = std::min(size, params.maxSize);
+            const neko::uint64 normal = std::min(end, params.avgSize);
+            neko::uint64 hash = 0;
+            neko::uint64 i = params.minSize;
+            for (; i < normal; ++i) {
+                hash = (hash << 1) + detail::GearTable[static_cast<unsigned char>(data[i])];
+                if ((hash & maskSmall) == 0) {
+                    return i + 1;
+                }
+            }
+            for (; i < end; ++i) {
+                hash = (hash << 1) + detail::GearTable[static_cast<unsigned char>(data[i])];
+                if ((hash & maskLarge) == 0) {
+                    return i + 1;
+                }
+            }
+            return end;
+        }
+
+        /**
+         * @brief Chunk a whole file.
+         * @throws ex::FileError if the file cannot be read
+         */
+        std::vector<Chunk> chunkFile(const std::string &path, const Hasher &hasher) const {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open()) {
+                throw ex::FileError("Cannot open file to chunk: " + path);
+            }
+            std::vector<Chunk> chunks;
+            std::string buffer;
+            neko::uint64 offset = 0;
+            bool eof = false;
+            const auto window = static_cast<std::size_t>(params.maxSize * 4);
+            while (true) {
+                if (!eof && buffer.size() < params.maxSize) {
+                    const auto kept = buffer.size();
+                    buffer.resize(window);
+                    file.read(buffer.data() + kept, static_cast<std::streamsize>(window - kept));
+                    buffer.resize(kept + static_cast<std::size_t>(file.gcount()));
+                    eof = !file;
+                }
+                if (buffer.empty()) {
+                    break;
+                }
+                const auto length = cut(buffer, eof);
+                const std::string_view bytes(buffer.data(), static_cast<std::size_t>(length));
+                chunks.push_back({offset, length, hasher(bytes)});
+                offset += length;
+                buffer.erase(0, static_cast<std::size_t>(length));
+            }
+            return chunks;
+        }
+    };
+
+    /**
+     * @brief Chunks on disk, by hash, plus an index of chunks found in local files.
+     *
+     * - Downloaded chunks are written to `<folder>/<hash[0..2]>/<hash>` after their hash is checked,
+     *   so an interrupted update keeps every chunk it finished.
+     * - seed() indexes the chunks of an existing file without copying them; reading such a chunk
+     *   re-checks its hash, since the file may have changed since.
+     * - Safe to use from several threads.
+     */
+    class ChunkStore {
+    private:
+        struct SeedChunk {
+            std::string path;
+            neko::uint64 offset = 0;
+            neko::uint64 size = 0;
+        };
+
+        std::string folder;
+        Hasher hasher;
+
+        mutable std::mutex mutex;
+        std::map<std::string, SeedChunk> seeds;
+        std::set<std::string> seededFiles;
+        neko::uint64 nextDownload = 0;
+
+        // Hashes come from the manifest and become file names, so only lowercase hex digits are accepted:
+        // the hasher's output is lowercase, and an uppercase hash would never match a chunk on disk.
+        static bool isValidHash(const std::string &hash) {
+            return hash.size() >= 4 && std::all_of(hash.begin(), hash.end(), [](char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'); });
+        }
+
+        /**
+         * @throws ex::ArgumentError if `hash` is not a valid chunk hash
+         */
+        std::string pathOf(const std::string &hash) const {
+            if (!isValidHash(hash)) {
+                throw ex::ArgumentError("Invalid chunk hash: " + hash);
+            }
+            return folder + "/" + hash.substr(0, 2) + "/" + hash;
+        }
+
+        static void requireValidHashes(const std::vector<ChunkRef> &chunks) {
+            for (const auto &chunk : chunks) {
+                if (!isValidHash(chunk.hash)) {
+                    throw ex::ArgumentError("Invalid chunk hash: " + chunk.hash);
+                }
+            }
+        }
+
+        std::optional<std::string> readStored(const std::string &hash) const {
+            std::ifstream file(pathOf(hash), std::ios::binary);
+            if (!file.is_open()) {
+                return std::nullopt;
+            }
+            std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            if (hasher(data) != hash) {
+                std::error_code ec;
+                std::filesystem::remove(pathOf(hash), ec);
+                return std::nullopt;
+            }
+            return data;
+        }
+
+        std::optional<std::string> readSeed(const std::string &hash) {
+            SeedChunk seed;
+            {
+                std::lock_guard lock(mutex);
+                auto it = seeds.find(hash);
+                if (it == seeds.end()) {
+                    return std::nullopt;
+                }
+                seed = it->second;
+            }
+            std::ifstream file(seed.path, std::ios::binary);
+            std::string data(static_cast<std::size_t>(seed.size), '\0');
+            if (file.is_open() && file.seekg(static_cast<std::streamoff>(seed.offset)) &&
+                file.read(data.data(), static_cast<std::streamsize>(seed.size)) && hasher(data) == hash) {
+                return data;
+            }
+            std::lock_guard lock(mutex);
+            seeds.erase(hash);
+            return std::nullopt;
+        }
+
+    public:
+        ChunkStore(std::string folder, Hasher hasher)
+            : folder(std::move(folder)), hasher(std::move(hasher)) {}
+
+        ChunkStore(const ChunkStore &) = delete;
+        ChunkStore &operator=(const ChunkStore &) = delete;
+
+        /**
+         * @brief Index the chunks of an existing file; each file is read at most once per store.
+         * @return Number of chunks indexed (0 if the file is missing or was seeded before).
+         */
+        std::size_t seed(const std::string &path, const ChunkParams &params) {
+            {
+                std::lock_guard lock(mutex);
+                if (!seededFiles.insert(path).second) {
+                    return 0;
+                }
+            }
+            std::error_code ec;
+            if (!std::filesystem::is_regular_file(path, ec)) {
+                return 0;
+            }
+            const auto chunks = Chunker(params).chunkFile(path, hasher);
+            std::lock_guard lock(mutex);
+            for (const auto &chunk : chunks) {
+                seeds.try_emplace(chunk.hash, SeedChunk{path, chunk.offset, chunk.size});
+            }
+            return chunks.size();
+        }
+
+        /**
+         * @throws ex::ArgumentError if `hash` is not a valid chunk hash
+         */
+        bool contains(const std::string &hash) const {
+            std::error_code ec;
+            if (std::filesystem::is_regular_file(pathOf(hash), ec)) {
+                return true;
+            }
+            std::lock_guard lock(mutex);
+            return seeds.contains(hash);
+        }
+
+        /**
+         * @brief The listed chunks not available locally, each once, in first-use order.
+         * @throws ex::ArgumentError if any hash is not a valid chunk hash
+         */
+        std::vector<ChunkRef> missing(const std::vector<ChunkRef> &chunks) const {
+            requireValidHashes(chunks);
+            std::vector<ChunkRef> result;
+            std::set<std::string> seen;
+            for (const auto &chunk : chunks) {
+                if (seen.insert(chunk.hash).second && !contains(chunk.hash)) {
+                    result.push_back(chunk);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Move a downloaded chunk into the store after checking its hash.
+         * @return false (and the file removed) if the content does not match the hash.
+         */
+        bool adopt(const std::string &hash, const std::string &downloadedPath) {
+            std::error_code ec;
+            if (!isValidHash(hash)) {
+                std::filesystem::remove(downloadedPath, ec);
+                return false;
+            }
+            std::ifstream file(downloadedPath, std::ios::binary);
+            std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            file.close();
+            if (hasher(data) != hash) {
+                log::warn("Chunk hash mismatch for {}", {}, hash);
+                std::filesystem::remove(downloadedPath, ec);
+                return false;
+            }
+            std::filesystem::create_directories(std::filesystem::path(pathOf(hash)).parent_path(), ec);
+            std::filesystem::rename(downloadedPath, pathOf(hash), ec);
+            if (ec) {
+                std::filesystem::remove(downloadedPath, ec);
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief A fresh temporary path inside the store for downloading `hash`; pass it to adopt().
+         * @throws ex::ArgumentError if `hash` is not a valid chunk hash
+         */
+        std::string downloadPath(const std::string &hash) {
+            if (!isValidHash(hash)) {
+                throw ex::ArgumentError("Invalid chunk hash: " + hash);
+            }
+            std::error_code ec;
+            std::filesystem::create_directories(folder, ec);
+            std::lock_guard lock(mutex);
+            return folder + "/" + hash + ".part-" + std::to_string(nextDownload++);
+        }
+
+        /**
+         * @brief Write the listed chunks, in order, to `outPath`.
+         * @throws ex::FileError if a chunk is unavailable or the output cannot be written; `outPath` is removed
+         * @throws ex::ArgumentError if any hash is not a valid chunk hash; nothing is written
+         */
+        void assemble(const std::vector<ChunkRef> &chunks, const std::string &outPath) {
+            requireValidHashes(chunks);
+            std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) {
+                throw ex::FileError("Cannot create assembled file " + outPath);
+            }
+            auto fail = [&](const std::string &reason) {
+                out.close();
+                std::error_code ec;
+                std::filesystem::remove(outPath, ec);
+                throw ex::FileError(reason);
+            };
+            for (const auto &chunk : chunks) {
+                auto data = readStored(chunk.hash);
+                if (!data) {
+                    data = readSeed(chunk.hash);
+                }
+                if (!data) {
+                    fail("Chunk unavailable: " + chunk.hash);
+                }
+                if (!out.write(data->data(), static_cast<std::streamsize>(data->size()))) {
+                    fail("Cannot write assembled file " + outPath);
+                }
+            }
+            out.flush();
+            if (!out) {
+                fail("Cannot write assembled file " + outPath);
+            }
+        }
+
+        /**
+         * @brief Delete every downloaded chunk (after an update completed; its files now seed the next one).
+         */
+        void clear() {
+            std::error_code ec;
+            std::filesystem::remove_all(folder, ec);
+            std::lock_guard lock(mutex);
+            seeds.clear();
+            seededFiles.clear();
+        }
+    };
+
+} // namespace neko::core::chunk
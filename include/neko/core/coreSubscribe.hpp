@@ -4,24 +4,22 @@
 
 #include "neko/bus/eventBus.hpp"
 #include "neko/bus/threadBus.hpp"
+#include "neko/bus/taskGroup.hpp"
 #include "neko/event/eventTypes.hpp"
 #include "neko/core/launcher.hpp"
-#include "neko/core/launcherProcess.hpp"
 
 namespace neko::core {
 
     inline void subscribeToCoreEvents() {
 
-        (void)bus::event::subscribe<event::RestartRequestEvent>([](const event::RestartRequestEvent &evt) {
-            log::info("RestartRequestEvent received: Reason: {}, Command: {}", {}, evt.reason, evt.command);
-            launcherNewProcess(evt.command);
-            app::quit();
+        (void)bus::event::subscribe<event::CancelOperationEvent>([](const event::CancelOperationEvent &evt) {
+            const bool cancelled = bus::thread::cancelForeground(evt.reason.empty() ? "Cancelled" : evt.reason);
+            log::info("CancelOperationEvent received: reason={}, cancelled={}", {}, evt.reason, cancelled ? "true" : "false");
         });
-
         (void)bus::event::subscribe<event::MaintenanceEvent>([](const event::MaintenanceEvent &evt) {
-            log::warn("MaintenanceEvent received: Title: {}, Message: {}", {}, evt.title, evt.message);
-            // Forward to UI so a notice dialog is shown alongside logging
-            bus::event::publish(event::ShowNoticeEvent{evt});
+            log::warn("MaintenanceEvent received: Title: {}, Message: {}", {}, evt.notice->title, evt.notice->message);
+            // Forward to UI so a notice dialog is shown alongside logging; the payload is shared, not copied
+            bus::event::publish(event::ShowNoticeEvent{evt.notice});
         });
         (void)bus::event::subscribe<event::ConfigLoadedEvent>([](const event::ConfigLoadedEvent &evt) {
             log::info("ConfigLoadedEvent: path={}, success={}", {}, evt.path, evt.success);
@@ -30,13 +28,18 @@ namespace neko::core {
             log::info("ConfigSavedEvent: path={}, success={}", {}, evt.path, evt.success);
         });
         (void)bus::event::subscribe<event::ConfigUpdatedEvent>([](const event::ConfigUpdatedEvent &evt) {
-            log::debug("ConfigUpdatedEvent: lang={}, backgroundType={}", {}, evt.config.main.lang, evt.config.main.backgroundType);
+            std::string keys;
+            for (const auto &key : evt.change->keys) {
+                keys.append(keys.empty() ? "" : ", ").append(key.section).append(".").append(key.key);
+            }
+            log::debug("ConfigUpdatedEvent: version={}, changed=[{}]", {}, evt.change->version, keys);
         });
         (void)bus::event::subscribe<event::UpdateAvailableEvent>([](const event::UpdateAvailableEvent &evt) {
-            log::info("UpdateAvailableEvent received: {} -> {}", {}, evt.title, evt.resourceVersion);
+            log::info("UpdateAvailableEvent received: {} -> {}", {}, evt.update->title, evt.update->resourceVersion);
         });
-        (void)bus::event::subscribe<event::UpdateCompleteEvent>([](const event::UpdateCompleteEvent &) {
-            log::info("UpdateCompleteEvent received: Application has been updated successfully.");
+        (void)bus::event::subscribe<event::UpdateCompleteEvent>([](const event::UpdateCompleteEvent &evt) {
+            log::info("UpdateCompleteEvent received: Application has been updated successfully ({} files unchanged, {} bytes downloaded, {} bytes saved).", {},
+                      std::to_string(evt.unchangedFiles), std::to_string(evt.bytesFetched), std::to_string(evt.bytesSaved));
             // Trigger UI text refresh so version/resource labels update immediately.
             bus::event::publish(event::RefreshTextEvent{});
         });
@@ -0,0 +1,57 @@
+/**
+ * @see neko/core/update.hpp
+ * @file deltaPatch.hpp
+ * @brief Binary patches that turn an installed resource file into its updated version.
+ */
+
+#pragma once
+
+#include <neko/schema/exception.hpp>
+#include <neko/schema/types.hpp>
+
+#include "neko/app/api.hpp"
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace neko::core::delta {
+
+    enum class Format {
+        /**
+         * @brief A zstd frame compressed with the base file as its prefix (`zstd --patch-from=<base>`).
+         */
+        zstd,
+        unsupported
+    };
+
+    Format parseFormat(std::string_view format) noexcept;
+
+    /**
+     * @brief Pick the patch that applies to the installed copy of a file.
+     *
+     * Candidates must be in a supported format and either name `localVersion` as their `fromVersion`
+     * or leave it empty. The first candidate whose `baseChecksum` equals the hash of the installed
+     * file wins; the file is hashed at most once.
+     * @param localHash Hashes the installed file with the given algorithm; an empty result (missing
+     * file) rules out every patch.
+     * @return nullopt if the file has to be downloaded whole.
+     */
+    std::optional<api::UpdateResponse::Patch> selectPatch(
+        const api::UpdateResponse::File &file,
+        const std::string &localVersion,
+        const std::function<std::string(const std::string &algorithm)> &localHash);
+
+    /**
+     * @brief Apply a patch to `basePath`, streaming the result to `outPath`.
+     *
+     * The base file is memory-mapped; the patch is read and the output written in fixed-size blocks.
+     * `outPath` is removed if applying fails.
+     * @throws ex::FileError if a file cannot be read or written
+     * @throws ex::Parse if the patch is malformed or does not match the base
+     * @throws ex::ArgumentError if the format is unsupported
+     */
+    void applyPatch(Format format, const std::string &basePath, const std::string &patchPath, const std::string &outPath);
+
+} // namespace neko::core::delta
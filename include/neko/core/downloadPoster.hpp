@@ -6,29 +6,62 @@
 
 #include <neko/system/platform.hpp>
 #include <neko/function/utilities.hpp>
+#include <neko/log/nlog.hpp>
 
+#include "neko/app/appinfo.hpp"
+#include "neko/bus/threadBus.hpp"
+#include "neko/core/imageCache.hpp"
+
+#include <filesystem>
 #include <optional>
 #include <string>
+#include <system_error>
 
 namespace neko::core {
-    
+
+    /**
+     * @brief The process-wide image cache under app::getCacheFolder() + "/images".
+     */
+    inline ImageCache &getImageCache() {
+        static ImageCache cache(
+            app::getCacheFolder() + "/images",
+            [](const std::string &url, const std::string &path) {
+                network::Network net;
+                network::RequestConfig reqConfig{
+                    .url = url,
+                    .method = network::RequestType::DownloadFile,
+                    .requestId = "download-poster-" + util::random::generateRandomString(6),
+                    .fileName = path};
+                return net.execute(reqConfig).isSuccess();
+            },
+            [](std::function<void()> task) {
+                (void)bus::thread::submitIo(std::move(task));
+            });
+        return cache;
+    }
+
+    /**
+     * @brief Remove `poster_*.png` files left in the temp folder by launchers before the image cache.
+     */
+    inline void removeLegacyPosters() noexcept {
+        std::error_code ec;
+        for (const auto &item : std::filesystem::directory_iterator(system::tempFolder(), ec)) {
+            const auto name = item.path().filename().string();
+            if (name.starts_with("poster_") && name.ends_with(".png")) {
+                std::filesystem::remove(item.path(), ec);
+            }
+        }
+    }
+
     // if successful, return file name
-    inline std::optional<std::string> downloadPoster(const std::string &url) noexcept {
-        
+    // `validator` changes when the image behind the URL changes (e.g. the etag of the response naming it).
+    inline std::optional<std::string> downloadPoster(const std::string &url, const std::string &validator = {}) noexcept {
+
         if (!url.empty() && util::check::isUrl(url)) {
-            network::Network net;
-            auto fileName = system::tempFolder() + "/poster_" + util::random::generateRandomString(12) + ".png";
-            network::RequestConfig reqConfig{
-                .url = url,
-                .method = network::RequestType::DownloadFile,
-                .requestId = "download-poster-" + util::random::generateRandomString(6),
-                .fileName = fileName
-            };
-
-            auto res = net.execute(reqConfig);
-
-            if (res.isSuccess()) {
-                return fileName;
+            try {
+                return getImageCache().get(url, validator);
+            } catch (const std::exception &e) {
+                log::warn("Failed to get poster {}: {}", {}, url, e.what());
             }
         }
         return std::nullopt;
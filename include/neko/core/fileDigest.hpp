@@ -0,0 +1,28 @@
+/**
+ * @see neko/core/update.hpp
+ * @file fileDigest.hpp
+ * @brief File digests computed block by block, so a cancelled update stops hashing between blocks.
+ */
+
+#pragma once
+
+#include <neko/schema/exception.hpp>
+#include <neko/schema/types.hpp>
+
+#include <functional>
+#include <string>
+
+namespace neko::core::digest {
+
+    /**
+     * @brief Lowercase hex digest of a file, read in `blockSize` blocks.
+     * @param algorithm Digest name as used by update manifests ("sha256", "sha1", "md5", ...), case-insensitive.
+     * @param isCancelled Polled between blocks; returning true stops hashing with ex::Runtime.
+     * @throws ex::ArgumentError if the algorithm is unknown
+     * @throws ex::FileError if the file cannot be read
+     * @throws ex::Runtime if `isCancelled` returned true
+     */
+    std::string digestFile(const std::string &path, const std::string &algorithm,
+                           const std::function<bool()> &isCancelled = {}, neko::uint64 blockSize = 1024 * 1024);
+
+} // namespace neko::core::digest
@@ -0,0 +1,450 @@
+/**
+ * @see neko/core/downloadPoster.hpp
+ * @file imageCache.hpp
+ * @brief Content-addressed on-disk cache for posters and other remote images.
+ */
+
+#pragma once
+
+#include <neko/function/hash.hpp>
+#include <neko/function/utilities.hpp>
+#include <neko/log/nlog.hpp>
+#include <neko/schema/types.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace neko::core {
+
+    struct ImageCacheOptions {
+        /**
+         * @brief Total size of stored images; least recently used entries are evicted beyond it.
+         */
+        neko::uint64 maxBytes = 64ull * 1024 * 1024;
+        /**
+         * @brief How long an entry is used without downloading it again.
+         */
+        std::chrono::milliseconds maxAge = std::chrono::hours(24 * 7);
+    };
+
+    /**
+     * @brief Remote images stored once per content hash under a folder.
+     *
+     * - An entry is keyed by URL plus an optional validator (e.g. the etag of the API response that
+     *   named the URL); a changed validator downloads the image again and replaces the old version.
+     * - Downloads go to a temporary file, are hashed (SHA-256) and renamed to `<hash>.<ext>`. URLs with
+     *   the same content share one file.
+     * - A fresh entry's path is returned without any request. Concurrent requests for one key share
+     *   one download. If a stale entry cannot be downloaded again, its old file is still returned.
+     * - `index.json` records the entries and their last use, rewritten when a download stores or evicts
+     *   entries (not on every hit); the least recently used ones are dropped (and files no entry
+     *   references deleted) past `maxBytes`.
+     */
+    class ImageCache {
+    public:
+        using Clock = std::chrono::system_clock;
+        /**
+         * @brief Downloads `url` to `path`; returns false (or throws) on failure.
+         */
+        using Downloader = std::function<bool(const std::string &url, const std::string &path)>;
+        /**
+         * @brief Runs an asynchronous download off the calling thread.
+         */
+        using Spawner = std::function<void(std::function<void()>)>;
+        using Options = ImageCacheOptions;
+
+    private:
+        struct Entry {
+            std::string url;
+            std::string validator;
+            std::string fileName;
+            neko::uint64 bytes = 0;
+            neko::int64 storedAtMs = 0;
+            neko::int64 lastUsedMs = 0;
+        };
+
+        std::string folder;
+        Downloader downloader;
+        Spawner spawner;
+        Options options;
+
+        std::mutex mutex;
+        bool loaded = false;
+        // Key -> entry.
+        std::map<std::string, Entry> entries;
+        std::map<std::string, std::shared_future<std::optional<std::string>>> inFlight;
+
+        static neko::int64 nowMs() {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now().time_since_epoch()).count();
+        }
+
+        static std::string makeKey(const std::string &url, const std::string &validator) {
+            return url + "\n" + validator;
+        }
+
+        // Extension from the URL path, so viewers that go by the name still work.
+        static std::string extensionOf(const std::string &url) {
+            auto end = url.find_first_of("?#");
+            const auto path = url.substr(0, end);
+            const auto dot = path.find_last_of('.');
+            const auto slash = path.find_last_of('/');
+            if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+                return ".png";
+            }
+            auto ext = path.substr(dot);
+            if (ext.size() < 2 || ext.size() > 6 || !std::all_of(ext.begin() + 1, ext.end(), [](unsigned char c) { return std::isalnum(c); })) {
+                return ".png";
+            }
+            std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return ext;
+        }
+
+        std::string pathOf(const std::string &fileName) const {
+            return folder + "/" + fileName;
+        }
+
+        std::string indexPath() const {
+            return folder + "/index.json";
+        }
+
+        // Caller holds the lock.
+        void loadLocked() {
+            if (loaded) {
+                return;
+            }
+            loaded = true;
+            std::ifstream file(indexPath());
+            if (!file.is_open()) {
+                return;
+            }
+            try {
+                const auto json = nlohmann::json::parse(file);
+                for (const auto &item : json.at("entries")) {
+                    Entry entry{
+                        .url = item.at("url").get<std::string>(),
+                        .validator = item.value("validator", ""),
+                        .fileName = item.at("fileName").get<std::string>(),
+                        .bytes = item.value("bytes", neko::uint64(0)),
+                        .storedAtMs = item.value("storedAtMs", neko::int64(0)),
+                        .lastUsedMs = item.value("lastUsedMs", neko::int64(0))};
+                    std::error_code ec;
+                    if (!std::filesystem::is_regular_file(pathOf(entry.fileName), ec)) {
+                        continue;
+                    }
+                    entries[makeKey(entry.url, entry.validator)] = std::move(entry);
+                }
+            } catch (const nlohmann::json::exception &e) {
+                log::warn("Ignoring unreadable image cache index: {}", {}, e.what());
+                entries.clear();
+            }
+        }
+
+        // Caller holds the lock.
+        void saveLocked() const {
+            nlohmann::json list = nlohmann::json::array();
+            for (const auto &[key, entry] : entries) {
+                list.push_back({{"url", entry.url},
+                                {"validator", entry.validator},
+                                {"fileName", entry.fileName},
+                                {"bytes", entry.bytes},
+                                {"storedAtMs", entry.storedAtMs},
+                                {"lastUsedMs", entry.lastUsedMs}});
+            }
+            std::error_code ec;
+            std::filesystem::create_directories(folder, ec);
+            const auto tempPath = indexPath() + ".tmp";
+            {
+                std::ofstream file(tempPath, std::ios::trunc);
+                if (!file.is_open() || !(file << nlohmann::json{{"entries", list}}.dump())) {
+                    log::warn("Cannot write image cache index {}", {}, tempPath);
+                    return;
+                }
+            }
+            std::filesystem::rename(tempPath, indexPath(), ec);
+            if (ec) {
+                std::filesystem::remove(tempPath, ec);
+                log::warn("Cannot replace image cache index: {}", {}, ec.message());
+            }
+        }
+
+        // Caller holds the lock. Sum of distinct files.
+        neko::uint64 totalBytesLocked() const {
+            std::map<std::string, neko::uint64> files;
+            for (const auto &[key, entry] : entries) {
+                files[entry.fileName] = entry.bytes;
+            }
+            neko::uint64 total = 0;
+            for (const auto &[name, bytes] : files) {
+                total += bytes;
+            }
+            return total;
+        }
+
+        // Caller holds the lock. Deletes the file once no entry references it.
+        void releaseFileLocked(const std::string &fileName) {
+            for (const auto &[key, entry] : entries) {
+                if (entry.fileName == fileName) {
+                    return;
+                }
+            }
+            std::error_code ec;
+            std::filesystem::remove(pathOf(fileName), ec);
+        }
+
+        // Caller holds the lock. `keep` survives.
+        void evictLocked(const std::string &keep) {
+            while (entries.size() > 1 && totalBytesLocked() > options.maxBytes) {
+                auto victim = entries.end();
+                for (auto it = entries.begin(); it != entries.end(); ++it) {
+                    if (it->first != keep && (victim == entries.end() || it->second.lastUsedMs < victim->second.lastUsedMs)) {
+                        victim = it;
+                    }
+                }
+                if (victim == entries.end()) {
+                    return;
+                }
+                const auto fileName = victim->second.fileName;
+                log::debug("Evicted cached image {}", {}, victim->second.url);
+                entries.erase(victim);
+                releaseFileLocked(fileName);
+            }
+        }
+
+        // Downloads and stores one image; returns its path, or the previous one if the download failed.
+        std::optional<std::string> download(const std::string &key, const std::string &url, const std::string &validator, std::optional<std::string> previous) {
+            std::error_code ec;
+            std::filesystem::create_directories(folder, ec);
+            const auto partPath = pathOf("download-" + util::random::generateRandomString(12) + ".part");
+
+            bool ok = false;
+            try {
+                ok = downloader(url, partPath) && std::filesystem::is_regular_file(partPath, ec);
+            } catch (const std::exception &e) {
+                log::warn("Image download failed for {}: {}", {}, url, e.what());
+            }
+            if (!ok) {
+                std::filesystem::remove(partPath, ec);
+                if (previous) {
+                    log::warn("Using the stored copy of {}", {}, url);
+                }
+                return previous;
+            }
+
+            const auto hash = util::hash::digestFile(partPath, util::hash::Algorithm::sha256);
+            const auto fileName = hash + extensionOf(url);
+            const auto bytes = static_cast<neko::uint64>(std::filesystem::file_size(partPath, ec));
+
+            std::lock_guard lock(mutex);
+            if (std::filesystem::exists(pathOf(fileName), ec)) {
+                // Same content already stored under another key or an earlier download.
+                std::filesystem::remove(partPath, ec);
+            } else {
+                std::filesystem::rename(partPath, pathOf(fileName), ec);
+                if (ec) {
+                    std::filesystem::remove(partPath, ec);
+                    log::warn("Cannot store cached image {}: {}", {}, fileName, ec.message());
+                    return previous;
+                }
+            }
+
+            // Older versions of this URL (any validator) are replaced.
+            std::vector<std::string> oldFiles;
+            for (auto it = entries.begin(); it != entries.end();) {
+                if (it->second.url == url) {
+                    oldFiles.push_back(it->second.fileName);
+                    it = entries.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            const auto now = nowMs();
+            entries[key] = Entry{.url = url, .validator = validator, .fileName = fileName, .bytes = bytes, .storedAtMs = now, .lastUsedMs = now};
+            for (const auto &oldFile : oldFiles) {
+                releaseFileLocked(oldFile);
+            }
+            evictLocked(key);
+            saveLocked();
+            return pathOf(fileName);
+        }
+
+        enum class Lookup {
+            fresh,
+            stale,
+            missing
+        };
+
+        // Caller holds the lock. The new lastUsedMs is written with the next download's index save.
+        Lookup lookupLocked(const std::string &key, std::string &path) {
+            loadLocked();
+            auto it = entries.find(key);
+            if (it == entries.end()) {
+                return Lookup::missing;
+            }
+            path = pathOf(it->second.fileName);
+            it->second.lastUsedMs = nowMs();
+            return it->second.lastUsedMs - it->second.storedAtMs < options.maxAge.count() ? Lookup::fresh : Lookup::stale;
+        }
+
+        void finish(const std::string &key) {
+            std::lock_guard lock(mutex);
+            inFlight.erase(key);
+        }
+
+        // Runs the download a caller became leader for; waiters always get a value and the key is always released.
+        void lead(const std::shared_ptr<std::promise<std::optional<std::string>>> &leader, const std::string &key,
+                  const std::string &url, const std::string &validator, const std::optional<std::string> &previous) {
+            std::optional<std::string> result = previous;
+            try {
+                result = download(key, url, validator, previous);
+            } catch (const std::exception &e) {
+                log::warn("Cannot store cached image for {}: {}", {}, url, e.what());
+            } catch (...) {
+                log::warn("Cannot store cached image for {}", {}, url);
+            }
+            leader->set_value(std::move(result));
+            finish(key);
+        }
+
+    public:
+        ImageCache(std::string folder, Downloader downloader, Spawner spawner, Options options = {})
+            : folder(std::move(folder)), downloader(std::move(downloader)), spawner(std::move(spawner)), options(std::move(options)) {}
+
+        ~ImageCache() {
+            wait();
+        }
+
+        ImageCache(const ImageCache &) = delete;
+        ImageCache &operator=(const ImageCache &) = delete;
+
+        /**
+         * @brief The stored path if the entry is fresh; never downloads.
+         */
+        std::optional<std::string> peek(const std::string &url, const std::string &validator = {}) {
+            std::lock_guard lock(mutex);
+            std::string path;
+            if (lookupLocked(makeKey(url, validator), path) == Lookup::fresh) {
+                return path;
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief The image path, downloading it on this thread if it is missing or stale.
+         * @return nullopt if it could not be downloaded and nothing is stored.
+         */
+        std::optional<std::string> get(const std::string &url, const std::string &validator = {}) {
+            const auto key = makeKey(url, validator);
+            std::shared_future<std::optional<std::string>> pending;
+            std::shared_ptr<std::promise<std::optional<std::string>>> leader;
+            std::optional<std::string> previous;
+            {
+                std::lock_guard lock(mutex);
+                std::string path;
+                const auto state = lookupLocked(key, path);
+                if (state == Lookup::fresh) {
+                    return path;
+                }
+                if (state == Lookup::stale) {
+                    previous = path;
+                }
+                if (auto it = inFlight.find(key); it != inFlight.end()) {
+                    pending = it->second;
+                } else {
+                    leader = std::make_shared<std::promise<std::optional<std::string>>>();
+                    pending = leader->get_future().share();
+                    inFlight[key] = pending;
+                }
+            }
+            if (leader) {
+                lead(leader, key, url, validator, previous);
+            }
+            return pending.get();
+        }
+
+        /**
+         * @brief Like get(), but the download runs through the spawner.
+         * @return A ready future when the entry is fresh.
+         */
+        std::shared_future<std::optional<std::string>> fetch(const std::string &url, const std::string &validator = {}) {
+            const auto key = makeKey(url, validator);
+            std::shared_ptr<std::promise<std::optional<std::string>>> leader;
+            std::shared_future<std::optional<std::string>> pending;
+            std::optional<std::string> previous;
+            {
+                std::lock_guard lock(mutex);
+                std::string path;
+                const auto state = lookupLocked(key, path);
+                if (state == Lookup::fresh) {
+                    std::promise<std::optional<std::string>> ready;
+                    ready.set_value(path);
+                    return ready.get_future().share();
+                }
+                if (state == Lookup::stale) {
+                    previous = path;
+                }
+                if (auto it = inFlight.find(key); it != inFlight.end()) {
+                    return it->second;
+                }
+                leader = std::make_shared<std::promise<std::optional<std::string>>>();
+                pending = leader->get_future().share();
+                inFlight[key] = pending;
+            }
+
+            auto task = [this, key, url, validator, previous, leader]() {
+                lead(leader, key, url, validator, previous);
+            };
+            try {
+                spawner(task);
+            } catch (...) {
+                task();
+            }
+            return pending;
+        }
+
+        /**
+         * @brief Wait for every running download.
+         */
+        void wait() {
+            for (;;) {
+                std::shared_future<std::optional<std::string>> flight;
+                {
+                    std::lock_guard lock(mutex);
+                    if (inFlight.empty()) {
+                        return;
+                    }
+                    flight = inFlight.begin()->second;
+                }
+                flight.wait();
+            }
+        }
+
+        neko::uint64 getTotalBytes() {
+            std::lock_guard lock(mutex);
+            loadLocked();
+            return totalBytesLocked();
+        }
+
+        std::size_t getEntryCount() {
+            std::lock_guard lock(mutex);
+            loadLocked();
+            return entries.size();
+        }
+    };
+
+} // namespace neko::core
@@ -0,0 +1,229 @@
+/**
+ * @see neko/core/update.hpp
+ * @file integrityIndex.hpp
+ * @brief Cached digests of local files, keyed by path, size and modification time.
+ */
+
+#pragma once
+
+#include <neko/log/nlog.hpp>
+#include <neko/schema/types.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace neko::core {
+
+    /**
+     * @brief Digests of local files, reused while a file's size and modification time are unchanged.
+     *
+     * - digest() stats the file and returns the recorded digest when size, mtime and algorithm match;
+     *   otherwise it hashes the file (outside the lock) and records the result.
+     * - A file modified less than `racyWindow` before it was hashed is not recorded, since a later write
+     *   within the same timestamp tick would go unnoticed (2 s covers FAT's granularity).
+     * - save() writes the index atomically and drops entries whose file is gone; it does nothing if
+     *   no entry changed.
+     * - Safe to use from several threads.
+     */
+    class IntegrityIndex {
+    public:
+        /**
+         * @brief Hashes the file at `path` with the named algorithm.
+         */
+        using Hasher = std::function<std::string(const std::string &path, const std::string &algorithm)>;
+
+    private:
+        struct Entry {
+            neko::uint64 size = 0;
+            neko::int64 mtimeNs = 0;
+            std::string algorithm;
+            std::string digest;
+        };
+
+        struct Stat {
+            neko::uint64 size = 0;
+            std::filesystem::file_time_type mtime;
+        };
+
+        std::string indexPath;
+        Hasher hasher;
+        std::chrono::nanoseconds racyWindow;
+
+        std::mutex mutex;
+        bool loaded = false;
+        bool dirty = false;
+        std::map<std::string, Entry> entries;
+        neko::uint64 hashedCount = 0;
+        neko::uint64 reusedCount = 0;
+
+        static std::string keyOf(const std::string &path) {
+            return std::filesystem::path(path).lexically_normal().generic_string();
+        }
+
+        static std::optional<Stat> statFile(const std::string &path) {
+            std::error_code ec;
+            if (!std::filesystem::is_regular_file(path, ec)) {
+                return std::nullopt;
+            }
+            Stat stat;
+            stat.size = std::filesystem::file_size(path, ec);
+            if (ec) {
+                return std::nullopt;
+            }
+            stat.mtime = std::filesystem::last_write_time(path, ec);
+            if (ec) {
+                return std::nullopt;
+            }
+            return stat;
+        }
+
+        static neko::int64 toNs(std::filesystem::file_time_type time) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        }
+
+        // Caller holds the lock.
+        void loadLocked() {
+            if (loaded) {
+                return;
+            }
+            loaded = true;
+            std::ifstream file(indexPath);
+            if (!file.is_open()) {
+                return;
+            }
+            try {
+                const auto json = nlohmann::json::parse(file);
+                for (const auto &item : json.at("entries")) {
+                    entries[item.at("path").get<std::string>()] = Entry{
+                        .size = item.at("size").get<neko::uint64>(),
+                        .mtimeNs = item.at("mtimeNs").get<neko::int64>(),
+                        .algorithm = item.at("algorithm").get<std::string>(),
+                        .digest = item.at("digest").get<std::string>()};
+                }
+            } catch (const nlohmann::json::exception &e) {
+                log::warn("Ignoring unreadable integrity index: {}", {}, e.what());
+                entries.clear();
+            }
+        }
+
+    public:
+        explicit IntegrityIndex(std::string indexPath, Hasher hasher, std::chrono::nanoseconds racyWindow = std::chrono::seconds(2))
+            : indexPath(std::move(indexPath)), hasher(std::move(hasher)), racyWindow(racyWindow) {}
+
+        IntegrityIndex(const IntegrityIndex &) = delete;
+        IntegrityIndex &operator=(const IntegrityIndex &) = delete;
+
+        /**
+         * @brief Digest of the file at `path`, hashing it only if it changed since it was last hashed.
+         * @return nullopt if the file does not exist or cannot be hashed.
+         */
+        std::optional<std::string> digest(const std::string &path, const std::string &algorithm) {
+            const auto stat = statFile(path);
+            if (!stat) {
+                return std::nullopt;
+            }
+            const auto key = keyOf(path);
+            const auto mtimeNs = toNs(stat->mtime);
+            {
+                std::lock_guard lock(mutex);
+                loadLocked();
+                auto it = entries.find(key);
+                if (it != entries.end() && it->second.size == stat->size && it->second.mtimeNs == mtimeNs && it->second.algorithm == algorithm) {
+                    ++reusedCount;
+                    return it->second.digest;
+                }
+            }
+
+            std::string digest;
+            try {
+                digest = hasher(path, algorithm);
+            } catch (const std::exception &e) {
+                log::warn("Cannot hash {}: {}", {}, path, e.what());
+                return std::nullopt;
+            }
+            if (digest.empty()) {
+                return std::nullopt;
+            }
+
+            // Only record what was hashed from a file that has settled and did not change meanwhile.
+            const auto after = statFile(path);
+            const bool settled = after && after->size == stat->size && after->mtime == stat->mtime &&
+                                 std::filesystem::file_time_type::clock::now() - stat->mtime >= racyWindow;
+            std::lock_guard lock(mutex);
+            ++hashedCount;
+            if (settled) {
+                entries[key] = Entry{.size = stat->size, .mtimeNs = mtimeNs, .algorithm = algorithm, .digest = digest};
+                dirty = true;
+            }
+            return digest;
+        }
+
+        /**
+         * @brief Write the index if it changed.
+         */
+        void save() {
+            std::lock_guard lock(mutex);
+            if (!dirty) {
+                return;
+            }
+            nlohmann::json list = nlohmann::json::array();
+            for (auto it = entries.begin(); it != entries.end();) {
+                std::error_code ec;
+                if (!std::filesystem::exists(it->first, ec)) {
+                    it = entries.erase(it);
+                    continue;
+                }
+                list.push_back({{"path", it->first},
+                                {"size", it->second.size},
+                                {"mtimeNs", it->second.mtimeNs},
+                                {"algorithm", it->second.algorithm},
+                                {"digest", it->second.digest}});
+                ++it;
+            }
+            std::error_code ec;
+            std::filesystem::create_directories(std::filesystem::path(indexPath).parent_path(), ec);
+            const auto tempPath = indexPath + ".tmp";
+            {
+                std::ofstream file(tempPath, std::ios::trunc);
+                if (!file.is_open() || !(file << nlohmann::json{{"entries", list}}.dump())) {
+                    log::warn("Cannot write integrity index {}", {}, tempPath);
+                    return;
+                }
+            }
+            std::filesystem::rename(tempPath, indexPath, ec);
+            if (ec) {
+                std::filesystem::remove(tempPath, ec);
+                log::warn("Cannot replace integrity index: {}", {}, ec.message());
+                return;
+            }
+            dirty = false;
+        }
+
+        /**
+         * @brief Files hashed so far by this instance.
+         */
+        neko::uint64 getHashedCount() {
+            std::lock_guard lock(mutex);
+            return hashedCount;
+        }
+
+        /**
+         * @brief Digests returned from the index without hashing.
+         */
+        neko::uint64 getReusedCount() {
+            std::lock_guard lock(mutex);
+            return reusedCount;
+        }
+    };
+
+} // namespace neko::core
@@ -2,26 +2,35 @@
 
 #include "neko/app/api.hpp"
 
+#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
 
 namespace neko::core {
 
+    /**
+     * @brief Receives the first news page again when a background revalidation changed it.
+     */
+    using NewsChangedListener = std::function<void(std::optional<api::NewsResponse>)>;
+
     /**
      * @brief Fetches news from the news API.
      * @param config The launcher configuration containing retry settings.
      * @param limit Maximum number of news items to fetch (default 10).
      * @param categories Optional category filter.
      * @param lastId Optional ID for pagination.
+     * @param onChanged Called if the first page was served from the response cache and turned out to have changed.
      * @return Optional NewsResponse if news is available, nullopt if no news (204).
      * @throws ex::NetworkError if the network request fails.
      * @throws ex::Parse if the response cannot be parsed.
+     * @note The first page (no lastId) goes through the response cache and may be served stale while it revalidates.
      */
     std::optional<api::NewsResponse> fetchNews(
         const api::LauncherConfigResponse &config,
         neko::int32 limit = 10,
         const std::vector<std::string> &categories = {},
-        const std::string &lastId = "");
+        const std::string &lastId = "",
+        NewsChangedListener onChanged = {});
 
 } // namespace neko::core
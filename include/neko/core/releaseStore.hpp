@@ -0,0 +1,370 @@
+/**
+ * @see neko/core/update.hpp
+ * @file releaseStore.hpp
+ * @brief Versioned staging of core files, switched in at start and rolled back if the new release fails.
+ */
+
+#pragma once
+
+#include <neko/log/nlog.hpp>
+#include <neko/schema/exception.hpp>
+#include <neko/schema/types.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <set>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace neko::core {
+
+    /**
+     * @brief Core files of an update, staged while the launcher runs and switched in at the next start.
+     *
+     * Layout under `<installDir>/.versions`, on the same volume as the installed files so every move
+     * is a rename:
+     * - `<version>/files/...` — the staged release, by path relative to the install directory;
+     * - `<version>/previous/...` — the installed files it replaced, kept until the release is confirmed;
+     * - `state.json` — journal of the switch, always replaced atomically.
+     *
+     * The journal goes `staged` → `switching` → `trial` → `none`. A start that finds `switching` (the
+     * previous start died mid-switch) or a `trial` release that already had its trial launches without
+     * confirm() puts the previous files back and remembers the version as rejected. The journal also
+     * keeps the resource version installed before the release, so a rollback can hand it back through
+     * takeRestoreVersion().
+     * @note Not thread-safe; used from one thread at a time (the update task, then main at start).
+     */
+    class ReleaseStore {
+    public:
+        enum class Phase {
+            none,
+            staged,
+            switching,
+            trial
+        };
+
+        /**
+         * @brief What onStartup() did to the installed files.
+         */
+        enum class StartAction {
+            none,
+            switched,  ///< the staged release is installed; restart to run it
+            rolledBack ///< the previous release is back; restart to run it
+        };
+
+        struct State {
+            Phase phase = Phase::none;
+            std::string version;
+            std::vector<std::string> files;
+            neko::uint32 launches = 0;
+            std::string rejected;
+            std::string previousVersion;               ///< resource version installed before `version`
+            std::optional<std::string> restoreVersion; ///< set by a rollback until takeRestoreVersion()
+        };
+
+    private:
+        std::filesystem::path installDir;
+        std::filesystem::path root;
+        neko::uint32 trialLaunches;
+
+        static constexpr const char *phaseName(Phase phase) {
+            switch (phase) {
+                case Phase::staged:
+                    return "staged";
+                case Phase::switching:
+                    return "switching";
+                case Phase::trial:
+                    return "trial";
+                default:
+                    return "none";
+            }
+        }
+
+        static Phase phaseOf(const std::string &name) {
+            for (auto phase : {Phase::staged, Phase::switching, Phase::trial}) {
+                if (name == phaseName(phase)) {
+                    return phase;
+                }
+            }
+            return Phase::none;
+        }
+
+        std::filesystem::path statePath() const {
+            return root / "state.json";
+        }
+
+        std::filesystem::path stagedPath(const std::string &version, const std::string &file) const {
+            return root / version / "files" / file;
+        }
+
+        std::filesystem::path previousPath(const std::string &version, const std::string &file) const {
+            return root / version / "previous" / file;
+        }
+
+        /**
+         * @throws ex::FileError if the journal cannot be replaced.
+         */
+        void writeState(const State &state) const {
+            nlohmann::json json{
+                {"phase", phaseName(state.phase)},
+                {"version", state.version},
+                {"files", state.files},
+                {"launches", state.launches},
+                {"rejected", state.rejected},
+                {"previousVersion", state.previousVersion}};
+            if (state.restoreVersion.has_value()) {
+                json["restoreVersion"] = *state.restoreVersion;
+            }
+            std::error_code ec;
+            std::filesystem::create_directories(root, ec);
+            const auto tempPath = statePath().string() + ".tmp";
+            {
+                std::ofstream file(tempPath, std::ios::trunc);
+                if (!file.is_open() || !(file << json.dump()) || !file.flush()) {
+                    throw ex::FileError("Cannot write release state: " + tempPath);
+                }
+            }
+            std::filesystem::rename(tempPath, statePath(), ec);
+            if (ec) {
+                std::filesystem::remove(tempPath, ec);
+                throw ex::FileError("Cannot replace release state: " + statePath().string());
+            }
+        }
+
+        // Move a file, copying when the source is on another volume (e.g. the temp folder).
+        static void moveFile(const std::filesystem::path &from, const std::filesystem::path &to) {
+            std::filesystem::create_directories(to.parent_path());
+            std::error_code ec;
+            std::filesystem::rename(from, to, ec);
+            if (!ec) {
+                return;
+            }
+            std::filesystem::copy_file(from, to, std::filesystem::copy_options::overwrite_existing);
+            std::filesystem::remove(from, ec);
+        }
+
+        // Put the previous files back; files the release added are removed, files never switched are left alone.
+        void rollBack(State state) {
+            for (auto it = state.files.rbegin(); it != state.files.rend(); ++it) {
+                const auto live = installDir / *it;
+                const auto previous = previousPath(state.version, *it);
+                std::error_code ec;
+                if (std::filesystem::exists(previous, ec)) {
+                    std::filesystem::rename(previous, live, ec);
+                } else if (!std::filesystem::exists(stagedPath(state.version, *it), ec)) {
+                    std::filesystem::remove(live, ec);
+                }
+                if (ec) {
+                    log::error("Cannot restore {}: {}", {}, live.string(), ec.message());
+                }
+            }
+            std::error_code ec;
+            std::filesystem::remove_all(root / state.version, ec);
+            log::warn("Rolled back release {}", {}, state.version);
+            writeState({.phase = Phase::none, .rejected = state.version, .restoreVersion = state.previousVersion});
+        }
+
+    public:
+        explicit ReleaseStore(const std::string &installDir, neko::uint32 trialLaunches = 1)
+            : installDir(installDir), root(std::filesystem::path(installDir) / ".versions"), trialLaunches(std::max<neko::uint32>(trialLaunches, 1)) {}
+
+        /**
+         * @brief Directory name for a resource version: unsafe characters become '_', empty becomes a timestamp.
+         */
+        static std::string versionName(const std::string &version) {
+            std::string name;
+            for (unsigned char c : version) {
+                name += (std::isalnum(c) != 0 || c == '.' || c == '-' || c == '_') ? static_cast<char>(c) : '_';
+            }
+            if (name.empty() || name.find_first_not_of('.') == std::string::npos) {
+                name = std::to_string(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+            }
+            return name;
+        }
+
+        /**
+         * @brief The journal; a missing or unreadable one reads as Phase::none.
+         */
+        State getState() const {
+            std::ifstream file(statePath());
+            if (!file.is_open()) {
+                return {};
+            }
+            try {
+                const auto json = nlohmann::json::parse(file);
+                State state{
+                    .phase = phaseOf(json.value("phase", "")),
+                    .version = json.value("version", ""),
+                    .files = json.value("files", std::vector<std::string>{}),
+                    .launches = json.value("launches", neko::uint32(0)),
+                    .rejected = json.value("rejected", ""),
+                    .previousVersion = json.value("previousVersion", "")};
+                if (json.contains("restoreVersion")) {
+                    state.restoreVersion = json.at("restoreVersion").get<std::string>();
+                }
+                return state;
+            } catch (const nlohmann::json::exception &e) {
+                log::warn("Ignoring unreadable release state: {}", {}, e.what());
+                return {};
+            }
+        }
+
+        /**
+         * @brief Whether `version` was rolled back before; staging it again would fail the same way.
+         */
+        bool isRejected(const std::string &version) const {
+            return !version.empty() && getState().rejected == versionName(version);
+        }
+
+        /**
+         * @brief Move files into a new staged release, replacing a release staged earlier but not switched yet.
+         * @param files Source path and path relative to the install directory; a later entry for the same path wins.
+         * @param previousVersion The resource version installed now; a rollback of this release restores it.
+         * @throws ex::ArgumentError if a relative path is absolute or leaves the install directory
+         * @throws ex::Runtime if a switched release has not been confirmed yet
+         * @throws std::filesystem::filesystem_error if a file cannot be moved
+         */
+        void stage(const std::string &version, const std::vector<std::pair<std::string, std::string>> &files, const std::string &previousVersion = {}) {
+            auto state = getState();
+            if (state.phase == Phase::switching || state.phase == Phase::trial) {
+                throw ex::Runtime("Release " + state.version + " is not confirmed yet");
+            }
+            const auto name = versionName(version);
+            std::vector<std::string> relatives;
+            std::set<std::string> seen;
+            for (const auto &[source, relative] : files) {
+                const auto normal = std::filesystem::path(relative).lexically_normal();
+                if (normal.empty() || normal.is_absolute() || normal.has_root_name() || *normal.begin() == "..") {
+                    throw ex::ArgumentError("Unsafe release path: " + relative);
+                }
+                if (seen.insert(normal.generic_string()).second) {
+                    relatives.push_back(normal.generic_string());
+                }
+            }
+
+            // The journal drops the old staged release first, so a failure below never leaves it half replaced.
+            if (state.phase == Phase::staged) {
+                writeState({.phase = Phase::none, .rejected = state.rejected});
+                std::error_code ec;
+                std::filesystem::remove_all(root / state.version, ec);
+            }
+            std::error_code ec;
+            std::filesystem::remove_all(root / name, ec);
+            try {
+                for (const auto &[source, relative] : files) {
+                    moveFile(source, stagedPath(name, std::filesystem::path(relative).lexically_normal().generic_string()));
+                }
+            } catch (...) {
+                std::filesystem::remove_all(root / name, ec);
+                throw;
+            }
+            writeState({.phase = Phase::staged, .version = name, .files = relatives, .rejected = state.rejected, .previousVersion = previousVersion});
+            log::info("Staged release {} ({} files)", {}, name, std::to_string(relatives.size()));
+        }
+
+        /**
+         * @brief Called first thing at start: switch to a staged release, or back from one that failed its trial.
+         *
+         * Each installed file is renamed into `previous/` and the staged one renamed into its place; a
+         * switch that fails halfway is undone at once. A release on trial gets `trialLaunches` starts to
+         * call confirm().
+         * @throws ex::FileError if the journal cannot be written
+         */
+        StartAction onStartup() {
+            auto state = getState();
+            switch (state.phase) {
+                case Phase::none:
+                    return StartAction::none;
+
+                case Phase::switching:
+                    log::warn("Previous start stopped while switching to release {}", {}, state.version);
+                    rollBack(state);
+                    return StartAction::rolledBack;
+
+                case Phase::trial:
+                    if (state.launches >= trialLaunches) {
+                        log::warn("Release {} did not confirm a healthy start", {}, state.version);
+                        rollBack(state);
+                        return StartAction::rolledBack;
+                    }
+                    ++state.launches;
+                    writeState(state);
+                    return StartAction::none;
+
+                case Phase::staged:
+                    break;
+            }
+
+            for (const auto &file : state.files) {
+                std::error_code ec;
+                if (!std::filesystem::is_regular_file(stagedPath(state.version, file), ec)) {
+                    log::warn("Discarding release {}: staged file {} is missing", {}, state.version, file);
+                    writeState({.phase = Phase::none, .rejected = state.rejected});
+                    std::filesystem::remove_all(root / state.version, ec);
+                    return StartAction::none;
+                }
+            }
+
+            state.phase = Phase::switching;
+            writeState(state);
+            try {
+                for (const auto &file : state.files) {
+                    const auto live = installDir / file;
+                    if (std::filesystem::exists(live)) {
+                        std::filesystem::create_directories(previousPath(state.version, file).parent_path());
+                        std::filesystem::rename(live, previousPath(state.version, file));
+                    }
+                    std::filesystem::create_directories(live.parent_path());
+                    std::filesystem::rename(stagedPath(state.version, file), live);
+                }
+            } catch (const std::filesystem::filesystem_error &e) {
+                log::error("Cannot switch to release {}: {}", {}, state.version, e.what());
+                rollBack(state);
+                return StartAction::none;
+            }
+            state.phase = Phase::trial;
+            state.launches = 0;
+            writeState(state);
+            log::info("Switched to release {}", {}, state.version);
+            return StartAction::switched;
+        }
+
+        /**
+         * @brief The running release started fine: keep it and drop the files it replaced.
+         */
+        void confirm() {
+            auto state = getState();
+            if (state.phase != Phase::trial) {
+                return;
+            }
+            writeState({.phase = Phase::none, .rejected = state.rejected});
+            std::error_code ec;
+            std::filesystem::remove_all(root / state.version, ec);
+            log::info("Confirmed release {}", {}, state.version);
+        }
+
+        /**
+         * @brief The resource version to put back after a rollback, once; later calls return nullopt.
+         * @throws ex::FileError if the journal cannot be written
+         */
+        std::optional<std::string> takeRestoreVersion() {
+            auto state = getState();
+            if (!state.restoreVersion.has_value()) {
+                return std::nullopt;
+            }
+            auto version = std::move(state.restoreVersion);
+            state.restoreVersion.reset();
+            writeState(state);
+            return version;
+        }
+    };
+
+} // namespace neko::core
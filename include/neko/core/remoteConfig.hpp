@@ -1,13 +1,21 @@
 #pragma once
 
 #include "neko/app/api.hpp"
+#include "neko/core/remoteConfigCache.hpp"
 
 namespace neko::core {
 
+    /**
+     * @brief The process-wide remote launcher config cache, persisted under app::getCacheFolder().
+     */
+    RemoteConfigCache &getRemoteConfigCache();
+
     /**
      * @brief Fetches the remote launcher configuration from the launcher config API.
-     * @throws ex::NetworkError if the network request fails
-     * @throws ex::Parse if the response cannot be parsed
+     * @details Served by getRemoteConfigCache(): a fresh cached config costs no request, concurrent
+     * callers share one request, and the config from the last run is used while it is revalidated.
+     * @throws ex::NetworkError if the network request fails and no config is cached
+     * @throws ex::Parse if the response cannot be parsed and no config is cached
      */
     api::LauncherConfigResponse getRemoteLauncherConfig();
 } // namespace neko::core
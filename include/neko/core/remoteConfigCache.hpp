@@ -0,0 +1,332 @@
+/**
+ * @see neko/core/remoteConfig.hpp
+ * @file remoteConfigCache.hpp
+ * @brief Single-flight, TTL-bound cache of the remote launcher config, persisted to disk.
+ */
+
+#pragma once
+
+#include <neko/log/nlog.hpp>
+#include <neko/schema/exception.hpp>
+#include <neko/schema/types.hpp>
+
+#include "neko/app/api.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace neko::core {
+
+    /**
+     * @brief Outcome of one revalidation request.
+     */
+    struct RemoteConfigFetch {
+        /**
+         * @brief The server confirmed the cached config (its ETag still matches); `config` is unset.
+         */
+        bool notModified = false;
+        api::LauncherConfigResponse config{};
+        std::string etag;
+        /**
+         * @brief Freshness lifetime from the response; zero uses the cache's default.
+         */
+        std::chrono::milliseconds maxAge{0};
+    };
+
+    struct RemoteConfigCacheOptions {
+        std::chrono::milliseconds defaultMaxAge = std::chrono::minutes(5);
+        std::chrono::milliseconds maxMaxAge = std::chrono::hours(24);
+        /**
+         * @brief How long past expiry a config may still be served while revalidating.
+         */
+        std::chrono::milliseconds maxStale = std::chrono::hours(24 * 7);
+    };
+
+    /**
+     * @brief Caches the remote launcher config for the process and across restarts.
+     *
+     * - A config younger than its max-age is returned without a request.
+     * - Concurrent callers that need a fetch share one request (single flight).
+     * - An expired config that is not older than the stale limit, including one loaded from disk at
+     *   startup, is returned at once while a revalidation (with its ETag) runs in the background.
+     * - If a blocking fetch fails, the last good config is returned when there is one.
+     */
+    class RemoteConfigCache {
+    public:
+        using Clock = std::chrono::system_clock;
+        /**
+         * @brief Performs the request; receives the cached ETag (empty if none).
+         * @throws Whatever the request throws; the error reaches callers waiting on the fetch.
+         */
+        using Fetcher = std::function<RemoteConfigFetch(const std::string &etag)>;
+        /**
+         * @brief Runs a revalidation off the calling thread.
+         */
+        using Spawner = std::function<void(std::function<void()>)>;
+
+        using Options = RemoteConfigCacheOptions;
+
+    private:
+        struct Entry {
+            api::LauncherConfigResponse config;
+            std::string etag;
+            Clock::time_point fetchedAt;
+            std::chrono::milliseconds maxAge{0};
+
+            Clock::time_point expiresAt() const {
+                return fetchedAt + maxAge;
+            }
+        };
+        using Snapshot = std::shared_ptr<const Entry>;
+
+        Fetcher fetcher;
+        Spawner spawner;
+        std::string cacheFile;
+        Options options;
+
+        std::mutex mutex;
+        Snapshot entry;
+        bool diskLoaded = false;
+        std::shared_ptr<std::promise<Snapshot>> inFlight;
+        std::shared_future<Snapshot> inFlightResult;
+        neko::uint64 fetchCount = 0;
+
+        // Caller holds the lock.
+        void loadFromDiskLocked() {
+            if (diskLoaded) {
+                return;
+            }
+            diskLoaded = true;
+            if (cacheFile.empty()) {
+                return;
+            }
+            std::ifstream file(cacheFile);
+            if (!file.is_open()) {
+                return;
+            }
+            try {
+                const auto json = nlohmann::json::parse(file);
+                auto loaded = std::make_shared<Entry>();
+                loaded->config = json.at("config").get<api::LauncherConfigResponse>();
+                loaded->etag = json.value("etag", "");
+                loaded->fetchedAt = Clock::time_point(std::chrono::milliseconds(json.value("fetchedAtMs", neko::int64(0))));
+                loaded->maxAge = std::chrono::milliseconds(json.value("maxAgeMs", neko::int64(0)));
+                entry = std::move(loaded);
+                log::info("Loaded cached remote launcher config from {}", {}, cacheFile);
+            } catch (const nlohmann::json::exception &e) {
+                log::warn("Ignoring unreadable remote config cache {}: {}", {}, cacheFile, e.what());
+            }
+        }
+
+        void persist(const Entry &next) const {
+            if (cacheFile.empty()) {
+                return;
+            }
+            const nlohmann::json json{
+                {"config", next.config},
+                {"etag", next.etag},
+                {"fetchedAtMs", std::chrono::duration_cast<std::chrono::milliseconds>(next.fetchedAt.time_since_epoch()).count()},
+                {"maxAgeMs", next.maxAge.count()}};
+            std::error_code ec;
+            std::filesystem::create_directories(std::filesystem::path(cacheFile).parent_path(), ec);
+            const std::string tempFile = cacheFile + ".tmp";
+            {
+                std::ofstream file(tempFile, std::ios::trunc);
+                if (!file.is_open() || !(file << json.dump())) {
+                    log::warn("Cannot write remote config cache {}", {}, tempFile);
+                    return;
+                }
+            }
+            std::filesystem::rename(tempFile, cacheFile, ec);
+            if (ec) {
+                log::warn("Cannot replace remote config cache {}: {}", {}, cacheFile, ec.message());
+                std::filesystem::remove(tempFile, ec);
+            }
+        }
+
+        // Caller holds the lock. Returns true if this call started the flight.
+        bool beginFlightLocked() {
+            if (inFlight) {
+                return false;
+            }
+            inFlight = std::make_shared<std::promise<Snapshot>>();
+            inFlightResult = inFlight->get_future().share();
+            return true;
+        }
+
+        // Runs the flight started by beginFlightLocked() and completes every waiter.
+        void runFlight() {
+            Snapshot previous;
+            std::shared_ptr<std::promise<Snapshot>> promise;
+            {
+                std::lock_guard lock(mutex);
+                previous = entry;
+                promise = inFlight;
+                ++fetchCount;
+            }
+
+            try {
+                auto result = fetcher(previous ? previous->etag : std::string{});
+                if (result.notModified && !previous) {
+                    throw ex::Runtime("Remote launcher config reported not modified without a cached copy");
+                }
+                auto next = std::make_shared<Entry>();
+                if (result.notModified) {
+                    next->config = previous->config;
+                    next->etag = previous->etag;
+                } else {
+                    next->config = std::move(result.config);
+                    next->etag = std::move(result.etag);
+                }
+                next->fetchedAt = Clock::now();
+                next->maxAge = result.maxAge > std::chrono::milliseconds::zero() ? std::min(result.maxAge, options.maxMaxAge) : options.defaultMaxAge;
+                persist(*next);
+
+                Snapshot published = std::move(next);
+                {
+                    std::lock_guard lock(mutex);
+                    entry = published;
+                    inFlight.reset();
+                }
+                promise->set_value(std::move(published));
+            } catch (...) {
+                {
+                    std::lock_guard lock(mutex);
+                    inFlight.reset();
+                }
+                promise->set_exception(std::current_exception());
+            }
+        }
+
+    public:
+        /**
+         * @param cacheFile Where the last good config is kept; empty disables persistence.
+         */
+        RemoteConfigCache(Fetcher fetcher, Spawner spawner, std::string cacheFile = {}, Options options = {})
+            : fetcher(std::move(fetcher)), spawner(std::move(spawner)), cacheFile(std::move(cacheFile)), options(options) {}
+
+        RemoteConfigCache(const RemoteConfigCache &) = delete;
+        RemoteConfigCache &operator=(const RemoteConfigCache &) = delete;
+
+        /**
+         * @brief The current launcher config, fetching or revalidating as needed.
+         * @throws Whatever the fetcher throws, when no usable config is cached.
+         */
+        api::LauncherConfigResponse get() {
+            std::shared_future<Snapshot> pending;
+            Snapshot fallback;
+            bool leader = false;
+            bool background = false;
+            {
+                std::lock_guard lock(mutex);
+                loadFromDiskLocked();
+                const auto now = Clock::now();
+                if (entry && now < entry->expiresAt()) {
+                    return entry->config;
+                }
+                if (entry && now < entry->expiresAt() + options.maxStale) {
+                    background = beginFlightLocked();
+                    fallback = entry;
+                } else {
+                    leader = beginFlightLocked();
+                    pending = inFlightResult;
+                    fallback = entry;
+                }
+            }
+
+            if (background) {
+                try {
+                    spawner([this]() { runFlight(); });
+                } catch (...) {
+                    runFlight();
+                }
+            }
+            if (!pending.valid()) {
+                return fallback->config;
+            }
+
+            if (leader) {
+                runFlight();
+            }
+            try {
+                return pending.get()->config;
+            } catch (const std::exception &e) {
+                if (!fallback) {
+                    throw;
+                }
+                log::warn("Remote launcher config fetch failed, using the last good config: {}", {}, e.what());
+                return fallback->config;
+            }
+        }
+
+        /**
+         * @brief Start a background revalidation unless one is running.
+         */
+        void refresh() {
+            bool started = false;
+            {
+                std::lock_guard lock(mutex);
+                loadFromDiskLocked();
+                started = beginFlightLocked();
+            }
+            if (started) {
+                spawner([this]() { runFlight(); });
+            }
+        }
+
+        /**
+         * @brief Wait for a running fetch or revalidation, if any.
+         */
+        void wait() {
+            std::shared_future<Snapshot> pending;
+            {
+                std::lock_guard lock(mutex);
+                if (!inFlight) {
+                    return;
+                }
+                pending = inFlightResult;
+            }
+            pending.wait();
+        }
+
+        /**
+         * @brief Mark the cached config expired so the next get() revalidates it.
+         */
+        void invalidate() {
+            std::lock_guard lock(mutex);
+            if (entry) {
+                auto expired = std::make_shared<Entry>(*entry);
+                expired->maxAge = std::chrono::milliseconds::zero();
+                entry = std::move(expired);
+            }
+        }
+
+        std::optional<std::string> getEtag() {
+            std::lock_guard lock(mutex);
+            loadFromDiskLocked();
+            return entry ? std::optional<std::string>(entry->etag) : std::nullopt;
+        }
+
+        /**
+         * @brief Number of requests issued, for diagnostics and tests.
+         */
+        neko::uint64 getFetchCount() {
+            std::lock_guard lock(mutex);
+            return fetchCount;
+        }
+    };
+
+} // namespace neko::core
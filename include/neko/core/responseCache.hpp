@@ -0,0 +1,553 @@
+/**
+ * @see neko/core/news.hpp
+ * @see neko/core/maintenance.hpp
+ * @file responseCache.hpp
+ * @brief On-disk API response cache with conditional revalidation, stale-while-revalidate and LRU eviction.
+ */
+
+#pragma once
+
+#include <neko/log/nlog.hpp>
+#include <neko/schema/exception.hpp>
+#include <neko/schema/types.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace neko::core {
+
+    /**
+     * @brief Identity of a cacheable request.
+     */
+    struct CacheRequest {
+        std::string method;
+        /**
+         * @brief Request URL; launcher API requests use their API path, so a change of host keeps the entry.
+         */
+        std::string url;
+        /**
+         * @brief Request body; JSON bodies are canonicalized before keying (see ResponseCache::canonicalize).
+         */
+        std::string body;
+    };
+
+    /**
+     * @brief A response as served to the caller, from the network or from disk.
+     */
+    struct CachedResponse {
+        neko::int32 statusCode = 0;
+        std::string body;
+        std::string etag;
+        std::string lastModified;
+        bool fromCache = false;
+        /**
+         * @brief Served past its max-age while a revalidation runs (or after it failed).
+         */
+        bool stale = false;
+    };
+
+    /**
+     * @brief Outcome of one (possibly conditional) request made by a Fetcher.
+     */
+    struct Revalidation {
+        /**
+         * @brief The server confirmed the cached validators; the other fields except maxAge are ignored.
+         */
+        bool notModified = false;
+        neko::int32 statusCode = 200;
+        std::string body;
+        std::string etag;
+        std::string lastModified;
+        /**
+         * @brief Freshness lifetime from the response; zero uses the policy's default.
+         */
+        std::chrono::milliseconds maxAge{0};
+    };
+
+    /**
+     * @brief Per-request freshness rules.
+     */
+    struct CachePolicy {
+        std::chrono::milliseconds defaultMaxAge = std::chrono::minutes(5);
+        std::chrono::milliseconds maxMaxAge = std::chrono::hours(24);
+        /**
+         * @brief How long past expiry an entry is served at once while it revalidates in the background.
+         */
+        std::chrono::milliseconds staleWhileRevalidate = std::chrono::hours(24 * 7);
+        /**
+         * @brief How long past expiry an entry may stand in for a failed request; zero never serves one.
+         */
+        std::chrono::milliseconds staleIfError = std::chrono::milliseconds::max();
+    };
+
+    struct ResponseCacheOptions {
+        /**
+         * @brief Total size of stored entries; least recently used entries are evicted beyond it.
+         */
+        neko::uint64 maxBytes = 8ull * 1024 * 1024;
+        /**
+         * @brief JSON object keys dropped from request bodies before keying (e.g. request timestamps).
+         */
+        std::vector<std::string> volatileKeys = {"timestamp"};
+    };
+
+    /**
+     * @brief Stores API responses as one JSON file per request under a folder.
+     *
+     * - Keyed by method, URL (API path) and canonical body; the file name is a hash of the key, and the
+     *   key is stored in the file so a collision reads as a miss.
+     * - A fresh entry is returned without a request. An expired one inside the stale window is returned
+     *   at once and revalidated in the background (one request per key); the listener passed to get()
+     *   hears about a changed body. Otherwise the caller waits for the request, and a failure falls
+     *   back to the stored entry if it is inside the policy's staleIfError window.
+     * - Fetchers receive the stored ETag / Last-Modified to make the request conditional.
+     * - File modification time is the LRU clock; it is bumped on every hit.
+     */
+    class ResponseCache {
+    public:
+        using Clock = std::chrono::system_clock;
+        /**
+         * @brief Performs the request; receives the stored validators (empty if none).
+         * @throws Whatever the request throws; waiting callers fall back to a stored entry.
+         */
+        using Fetcher = std::function<Revalidation(const std::string &etag, const std::string &lastModified)>;
+        /**
+         * @brief Hears about a body that changed in a background revalidation.
+         */
+        using Listener = std::function<void(const CachedResponse &)>;
+        /**
+         * @brief Runs a background revalidation off the calling thread.
+         */
+        using Spawner = std::function<void(std::function<void()>)>;
+        using Options = ResponseCacheOptions;
+
+    private:
+        struct Entry {
+            std::string key;
+            neko::int32 statusCode = 0;
+            std::string body;
+            std::string etag;
+            std::string lastModified;
+            Clock::time_point storedAt;
+            std::chrono::milliseconds maxAge{0};
+
+            Clock::time_point expiresAt() const {
+                return storedAt + maxAge;
+            }
+        };
+
+        struct IndexItem {
+            neko::uint64 bytes = 0;
+            std::filesystem::file_time_type lastUsed;
+        };
+
+        std::string folder;
+        Spawner spawner;
+        Options options;
+
+        std::mutex mutex;
+        bool scanned = false;
+        // File name -> size and last use.
+        std::map<std::string, IndexItem> index;
+        neko::uint64 totalBytes = 0;
+        std::map<std::string, std::shared_future<std::optional<Entry>>> inFlight;
+
+        static neko::uint64 fnv1a(std::string_view text) {
+            neko::uint64 hash = 1469598103934665603ull;
+            for (const unsigned char c : text) {
+                hash ^= c;
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        static void stripKeys(nlohmann::json &json, const std::vector<std::string> &keys) {
+            if (json.is_object()) {
+                for (const auto &key : keys) {
+                    json.erase(key);
+                }
+                for (auto &[name, value] : json.items()) {
+                    stripKeys(value, keys);
+                }
+            } else if (json.is_array()) {
+                for (auto &value : json) {
+                    stripKeys(value, keys);
+                }
+            }
+        }
+
+        std::string pathOf(const std::string &fileName) const {
+            return folder + "/" + fileName;
+        }
+
+        // Caller holds the lock.
+        void scanLocked() {
+            if (scanned) {
+                return;
+            }
+            scanned = true;
+            std::error_code ec;
+            for (const auto &item : std::filesystem::directory_iterator(folder, ec)) {
+                if (!item.is_regular_file(ec) || item.path().extension() != ".json") {
+                    continue;
+                }
+                const auto bytes = static_cast<neko::uint64>(item.file_size(ec));
+                index[item.path().filename().string()] = IndexItem{bytes, item.last_write_time(ec)};
+                totalBytes += bytes;
+            }
+        }
+
+        // Caller holds the lock. Drops least recently used files until the total fits; `keep` survives.
+        void evictLocked(const std::string &keep) {
+            while (totalBytes > options.maxBytes && index.size() > 1) {
+                auto victim = index.end();
+                for (auto it = index.begin(); it != index.end(); ++it) {
+                    if (it->first != keep && (victim == index.end() || it->second.lastUsed < victim->second.lastUsed)) {
+                        victim = it;
+                    }
+                }
+                if (victim == index.end()) {
+                    return;
+                }
+                std::error_code ec;
+                std::filesystem::remove(pathOf(victim->first), ec);
+                totalBytes -= std::min(totalBytes, victim->second.bytes);
+                log::debug("Evicted cached response {}", {}, victim->first);
+                index.erase(victim);
+            }
+        }
+
+        // Reads and checks an entry; a missing, unreadable or foreign file is a miss.
+        std::optional<Entry> readEntry(const std::string &fileName, const std::string &key) const {
+            std::ifstream file(pathOf(fileName));
+            if (!file.is_open()) {
+                return std::nullopt;
+            }
+            try {
+                const auto json = nlohmann::json::parse(file);
+                Entry entry;
+                entry.key = json.at("key").get<std::string>();
+                if (entry.key != key) {
+                    return std::nullopt;
+                }
+                entry.statusCode = json.value("statusCode", 200);
+                entry.body = json.value("body", "");
+                entry.etag = json.value("etag", "");
+                entry.lastModified = json.value("lastModified", "");
+                entry.storedAt = Clock::time_point(std::chrono::milliseconds(json.value("storedAtMs", neko::int64(0))));
+                entry.maxAge = std::chrono::milliseconds(json.value("maxAgeMs", neko::int64(0)));
+                return entry;
+            } catch (const nlohmann::json::exception &e) {
+                log::warn("Ignoring unreadable cached response {}: {}", {}, fileName, e.what());
+                return std::nullopt;
+            }
+        }
+
+        void writeEntry(const std::string &fileName, const Entry &entry) {
+            const nlohmann::json json{
+                {"key", entry.key},
+                {"statusCode", entry.statusCode},
+                {"body", entry.body},
+                {"etag", entry.etag},
+                {"lastModified", entry.lastModified},
+                {"storedAtMs", std::chrono::duration_cast<std::chrono::milliseconds>(entry.storedAt.time_since_epoch()).count()},
+                {"maxAgeMs", entry.maxAge.count()}};
+            const auto text = json.dump();
+
+            std::error_code ec;
+            std::filesystem::create_directories(folder, ec);
+            const auto path = pathOf(fileName);
+            const auto tempPath = path + ".tmp";
+            {
+                std::ofstream file(tempPath, std::ios::trunc);
+                if (!file.is_open() || !(file << text)) {
+                    log::warn("Cannot write cached response {}", {}, tempPath);
+                    return;
+                }
+            }
+            std::filesystem::rename(tempPath, path, ec);
+            if (ec) {
+                std::filesystem::remove(tempPath, ec);
+                log::warn("Cannot replace cached response {}: {}", {}, path, ec.message());
+                return;
+            }
+
+            std::lock_guard lock(mutex);
+            scanLocked();
+            auto &item = index[fileName];
+            totalBytes -= std::min(totalBytes, item.bytes);
+            item.bytes = text.size();
+            item.lastUsed = std::filesystem::last_write_time(path, ec);
+            totalBytes += item.bytes;
+            evictLocked(fileName);
+        }
+
+        void touch(const std::string &fileName) {
+            std::error_code ec;
+            const auto now = std::filesystem::file_time_type::clock::now();
+            std::filesystem::last_write_time(pathOf(fileName), now, ec);
+            std::lock_guard lock(mutex);
+            if (auto it = index.find(fileName); it != index.end()) {
+                it->second.lastUsed = now;
+            }
+        }
+
+        static CachedResponse toResponse(const Entry &entry, bool fromCache, bool stale) {
+            return CachedResponse{
+                .statusCode = entry.statusCode,
+                .body = entry.body,
+                .etag = entry.etag,
+                .lastModified = entry.lastModified,
+                .fromCache = fromCache,
+                .stale = stale};
+        }
+
+        // Runs the request for `key` and stores the result.
+        Entry revalidate(const std::string &key, const std::string &fileName, std::optional<Entry> previous, const Fetcher &fetcher, const CachePolicy &policy) {
+            auto result = fetcher(previous ? previous->etag : std::string{}, previous ? previous->lastModified : std::string{});
+            if (result.notModified && !previous) {
+                throw ex::Runtime("Response reported not modified without a cached copy");
+            }
+            Entry entry;
+            entry.key = key;
+            if (result.notModified) {
+                entry.statusCode = previous->statusCode;
+                entry.body = std::move(previous->body);
+                entry.etag = std::move(previous->etag);
+                entry.lastModified = std::move(previous->lastModified);
+            } else {
+                entry.statusCode = result.statusCode;
+                entry.body = std::move(result.body);
+                entry.etag = std::move(result.etag);
+                entry.lastModified = std::move(result.lastModified);
+            }
+            entry.storedAt = Clock::now();
+            entry.maxAge = result.maxAge > std::chrono::milliseconds::zero() ? std::min(result.maxAge, policy.maxMaxAge) : policy.defaultMaxAge;
+            writeEntry(fileName, entry);
+            return entry;
+        }
+
+        void finish(const std::string &key) {
+            std::lock_guard lock(mutex);
+            inFlight.erase(key);
+        }
+
+    public:
+        ResponseCache(std::string folder, Spawner spawner, Options options = {})
+            : folder(std::move(folder)), spawner(std::move(spawner)), options(std::move(options)) {}
+
+        ~ResponseCache() {
+            wait();
+        }
+
+        ResponseCache(const ResponseCache &) = delete;
+        ResponseCache &operator=(const ResponseCache &) = delete;
+
+        /**
+         * @brief JSON bodies re-serialized with sorted keys and without `volatileKeys`; other bodies as is.
+         */
+        static std::string canonicalize(std::string_view body, const std::vector<std::string> &volatileKeys) {
+            if (body.empty()) {
+                return {};
+            }
+            try {
+                auto json = nlohmann::json::parse(body);
+                stripKeys(json, volatileKeys);
+                return json.dump();
+            } catch (const nlohmann::json::exception &) {
+                return std::string(body);
+            }
+        }
+
+        std::string makeKey(const CacheRequest &request) const {
+            return request.method + " " + request.url + "\n" + canonicalize(request.body, options.volatileKeys);
+        }
+
+        static std::string makeFileName(const std::string &key) {
+            char name[17];
+            std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(fnv1a(key)));
+            return std::string(name) + ".json";
+        }
+
+        /**
+         * @brief The response for a request, from disk when fresh enough, otherwise from the fetcher.
+         * @param onChanged Called from the background revalidation if it stored a different body.
+         * @throws Whatever the fetcher throws, when nothing is stored for the request.
+         */
+        CachedResponse get(const CacheRequest &request, Fetcher fetcher, Listener onChanged = {}, CachePolicy policy = {}) {
+            const auto key = makeKey(request);
+            const auto fileName = makeFileName(key);
+
+            std::shared_future<std::optional<Entry>> pending;
+            std::shared_ptr<std::promise<std::optional<Entry>>> leader;
+            bool background = false;
+            std::optional<Entry> stored;
+            {
+                std::lock_guard lock(mutex);
+                scanLocked();
+                if (index.contains(fileName)) {
+                    stored = readEntry(fileName, key);
+                }
+                const auto now = Clock::now();
+                if (stored && now < stored->expiresAt()) {
+                    // Fresh: no request.
+                } else if (auto it = inFlight.find(key); it != inFlight.end()) {
+                    pending = it->second;
+                } else {
+                    leader = std::make_shared<std::promise<std::optional<Entry>>>();
+                    inFlight[key] = leader->get_future().share();
+                    background = stored && now < stored->expiresAt() + policy.staleWhileRevalidate;
+                    if (!background) {
+                        pending = inFlight[key];
+                    }
+                }
+            }
+
+            if (stored && !leader && !pending.valid()) {
+                touch(fileName);
+                return toResponse(*stored, true, false);
+            }
+
+            if (background) {
+                auto task = [this, key, fileName, stored, fetcher = std::move(fetcher), onChanged = std::move(onChanged), policy, leader]() {
+                    try {
+                        auto next = revalidate(key, fileName, stored, fetcher, policy);
+                        if (onChanged && next.body != stored->body) {
+                            onChanged(toResponse(next, false, false));
+                        }
+                        leader->set_value(std::move(next));
+                    } catch (const std::exception &e) {
+                        log::warn("Background revalidation failed for {}: {}", {}, fileName, e.what());
+                        leader->set_exception(std::current_exception());
+                    }
+                    finish(key);
+                };
+                try {
+                    spawner(task);
+                } catch (...) {
+                    task();
+                }
+                touch(fileName);
+                return toResponse(*stored, true, true);
+            }
+
+            if (leader) {
+                try {
+                    leader->set_value(revalidate(key, fileName, stored, fetcher, policy));
+                } catch (...) {
+                    leader->set_exception(std::current_exception());
+                }
+                finish(key);
+            } else if (stored) {
+                // Another caller is revalidating a stale entry; don't wait for it.
+                touch(fileName);
+                return toResponse(*stored, true, true);
+            }
+
+            try {
+                return toResponse(*pending.get(), false, false);
+            } catch (const std::exception &e) {
+                if (!stored || std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - stored->expiresAt()) >= policy.staleIfError) {
+                    throw;
+                }
+                log::warn("Request failed, serving the stored response for {}: {}", {}, request.url, e.what());
+                return toResponse(*stored, true, true);
+            }
+        }
+
+        /**
+         * @brief The stored response for a request without any network activity.
+         */
+        std::optional<CachedResponse> peek(const CacheRequest &request) {
+            const auto key = makeKey(request);
+            const auto fileName = makeFileName(key);
+            std::lock_guard lock(mutex);
+            scanLocked();
+            if (!index.contains(fileName)) {
+                return std::nullopt;
+            }
+            auto stored = readEntry(fileName, key);
+            if (!stored) {
+                return std::nullopt;
+            }
+            return toResponse(*stored, true, Clock::now() >= stored->expiresAt());
+        }
+
+        /**
+         * @brief Wait for every running revalidation.
+         */
+        void wait() {
+            for (;;) {
+                std::shared_future<std::optional<Entry>> flight;
+                {
+                    std::lock_guard lock(mutex);
+                    if (inFlight.empty()) {
+                        return;
+                    }
+                    flight = inFlight.begin()->second;
+                }
+                flight.wait();
+            }
+        }
+
+        neko::uint64 getTotalBytes() {
+            std::lock_guard lock(mutex);
+            scanLocked();
+            return totalBytes;
+        }
+
+        std::size_t getEntryCount() {
+            std::lock_guard lock(mutex);
+            scanLocked();
+            return index.size();
+        }
+    };
+
+    /**
+     * @brief The process-wide cache under app::getCacheFolder() + "/http", revalidating on the io executor.
+     */
+    ResponseCache &getResponseCache();
+
+    /**
+     * @brief POST a launcher API request through getResponseCache().
+     *
+     * The validators of a stored response (`meta.etag`, `meta.lastModified`) are sent back as
+     * `ifNoneMatch` / `ifModifiedSince` in `request[section]`; a 304 keeps the stored body.
+     * @param apiPath API path, e.g. lc::api::news; the host is resolved when the request is made and is not part of the key.
+     * @param section The request object, e.g. "newsRequest".
+     * @return The response; statusCode 204 means no content.
+     * @throws ex::NetworkError if the request fails and nothing is stored for it
+     */
+    CachedResponse postApiCached(
+        const std::string &apiPath,
+        const nlohmann::json &request,
+        const std::string &section,
+        neko::int32 maxRetries,
+        std::chrono::seconds retryDelay,
+        ResponseCache::Listener onChanged = {},
+        CachePolicy policy = {});
+
+    /**
+     * @brief GET a document through getResponseCache(); freshness comes from the policy only.
+     * @throws ex::NetworkError if the request fails and nothing is stored for it
+     */
+    CachedResponse getCached(const std::string &url, const std::string &requestId, CachePolicy policy = {});
+
+} // namespace neko::core
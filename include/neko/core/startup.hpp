@@ -0,0 +1,22 @@
+/**
+ * @see neko/core/startupGraph.hpp
+ * @file startup.hpp
+ * @brief Post-network startup: maintenance, update, news and auth prefetch as one dependency graph.
+ */
+
+#pragma once
+
+namespace neko::core::startup {
+
+    /**
+     * @brief Start the post-network startup steps on the io executor and return immediately.
+     *
+     * Maintenance check, update check, news and the authlib metadata prefetch run concurrently once
+     * the remote config is available. The update is applied once both checks are done, and the page
+     * switch (news or home) waits only for the update and the news.
+     * @note Publishes the same events as the sequential flow it replaces (loading status, maintenance,
+     *       update, news, page changes).
+     */
+    void runPostNetworkTasks();
+
+} // namespace neko::core::startup
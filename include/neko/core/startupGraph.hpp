@@ -0,0 +1,305 @@
+/**
+ * @see neko/core/startup.hpp
+ * @file startupGraph.hpp
+ * @brief Dependency graph of startup steps; each step starts as soon as its inputs are done.
+ */
+
+#pragma once
+
+#include <neko/log/nlog.hpp>
+#include <neko/schema/exception.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace neko::core {
+
+    /**
+     * @brief A set of named steps with "runs after" edges, executed on a spawner.
+     *
+     * - Steps without unfinished dependencies run concurrently.
+     * - A step whose dependency failed or was skipped is skipped, unless it was added with
+     *   `Policy::afterCompletion` (e.g. a step that picks the page to show either way).
+     * - The graph's state is shared with the running steps, so the object may be destroyed
+     *   after run() without waiting.
+     */
+    class StartupGraph {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Task = std::function<void()>;
+        /**
+         * @brief Runs a ready step off the calling thread.
+         */
+        using Spawner = std::function<void(std::function<void()>)>;
+
+        enum class Policy {
+            requireSuccess,
+            afterCompletion
+        };
+
+        enum class State {
+            pending,
+            running,
+            succeeded,
+            failed,
+            skipped
+        };
+
+    private:
+        struct Node {
+            std::string name;
+            std::vector<std::string> after;
+            Task task;
+            Policy policy = Policy::requireSuccess;
+
+            std::vector<std::size_t> dependents;
+            std::size_t remaining = 0;
+            bool dependencyFailed = false;
+            State state = State::pending;
+            std::string error;
+            Clock::duration duration{};
+        };
+
+        struct Shared {
+            Spawner spawner;
+            std::mutex mutex;
+            std::condition_variable finishedCv;
+            std::vector<Node> nodes;
+            std::size_t finished = 0;
+            bool started = false;
+            Clock::time_point startedAt;
+        };
+
+        std::shared_ptr<Shared> shared;
+
+        // Caller holds the lock. Marks a node finished and collects dependents that became ready;
+        // skipped dependents are finished here as well.
+        static void finishLocked(Shared &s, std::size_t index, State state, std::vector<std::size_t> &ready) {
+            std::vector<std::size_t> stack{index};
+            s.nodes[index].state = state;
+            while (!stack.empty()) {
+                const auto current = stack.back();
+                stack.pop_back();
+                ++s.finished;
+                const bool ok = s.nodes[current].state == State::succeeded;
+                for (const auto dependentIndex : s.nodes[current].dependents) {
+                    auto &dependent = s.nodes[dependentIndex];
+                    dependent.dependencyFailed = dependent.dependencyFailed || !ok;
+                    if (--dependent.remaining != 0) {
+                        continue;
+                    }
+                    if (dependent.dependencyFailed && dependent.policy == Policy::requireSuccess) {
+                        dependent.state = State::skipped;
+                        log::info("Startup step {} skipped: a dependency did not succeed", {}, dependent.name);
+                        stack.push_back(dependentIndex);
+                    } else {
+                        ready.push_back(dependentIndex);
+                    }
+                }
+            }
+            if (s.finished == s.nodes.size()) {
+                s.finishedCv.notify_all();
+            }
+        }
+
+        static void spawnAll(const std::shared_ptr<Shared> &s, const std::vector<std::size_t> &ready) {
+            for (const auto index : ready) {
+                try {
+                    s->spawner([s, index]() { runNode(s, index); });
+                } catch (...) {
+                    runNode(s, index);
+                }
+            }
+        }
+
+        static void runNode(const std::shared_ptr<Shared> &s, std::size_t index) {
+            Task task;
+            {
+                std::lock_guard lock(s->mutex);
+                s->nodes[index].state = State::running;
+                task = s->nodes[index].task;
+            }
+
+            const auto begin = Clock::now();
+            State state = State::succeeded;
+            std::string error;
+            try {
+                task();
+            } catch (const std::exception &e) {
+                state = State::failed;
+                error = e.what();
+            } catch (...) {
+                state = State::failed;
+                error = "Unknown error";
+            }
+            const auto end = Clock::now();
+
+            std::vector<std::size_t> ready;
+            {
+                std::lock_guard lock(s->mutex);
+                auto &node = s->nodes[index];
+                node.error = std::move(error);
+                node.duration = end - begin;
+                const auto sinceStart = std::chrono::duration_cast<std::chrono::milliseconds>(end - s->startedAt).count();
+                const auto took = std::chrono::duration_cast<std::chrono::milliseconds>(node.duration).count();
+                if (state == State::succeeded) {
+                    log::info("Startup step {} finished in {} ms (at +{} ms)", {}, node.name, took, sinceStart);
+                } else {
+                    log::warn("Startup step {} failed after {} ms: {}", {}, node.name, took, node.error);
+                }
+                finishLocked(*s, index, state, ready);
+            }
+            spawnAll(s, ready);
+        }
+
+        std::optional<std::size_t> indexOf(const std::string &name) const {
+            for (std::size_t i = 0; i < shared->nodes.size(); ++i) {
+                if (shared->nodes[i].name == name) {
+                    return i;
+                }
+            }
+            return std::nullopt;
+        }
+
+    public:
+        explicit StartupGraph(Spawner spawner)
+            : shared(std::make_shared<Shared>()) {
+            shared->spawner = std::move(spawner);
+        }
+
+        StartupGraph(const StartupGraph &) = delete;
+        StartupGraph &operator=(const StartupGraph &) = delete;
+
+        /**
+         * @brief Add a step. Dependencies may be added later, but before run().
+         * @throws ex::ArgumentError if the name is taken or the graph is already running.
+         */
+        StartupGraph &add(std::string name, std::vector<std::string> after, Task task, Policy policy = Policy::requireSuccess) {
+            std::lock_guard lock(shared->mutex);
+            if (shared->started) {
+                throw ex::ArgumentError("Cannot add startup step " + name + " to a running graph");
+            }
+            if (indexOf(name)) {
+                throw ex::ArgumentError("Duplicate startup step: " + name);
+            }
+            shared->nodes.push_back(Node{.name = std::move(name), .after = std::move(after), .task = std::move(task), .policy = policy});
+            return *this;
+        }
+
+        /**
+         * @brief Resolve the edges and start every step without dependencies. Returns immediately.
+         * @throws ex::ArgumentError on an unknown dependency or a cycle; nothing is started then.
+         */
+        void run() {
+            std::vector<std::size_t> ready;
+            {
+                std::lock_guard lock(shared->mutex);
+                if (shared->started) {
+                    throw ex::ArgumentError("Startup graph is already running");
+                }
+                auto &nodes = shared->nodes;
+                for (const auto &node : nodes) {
+                    for (const auto &dependency : node.after) {
+                        if (!indexOf(dependency)) {
+                            throw ex::ArgumentError("Startup step " + node.name + " depends on unknown step " + dependency);
+                        }
+                    }
+                }
+                for (std::size_t i = 0; i < nodes.size(); ++i) {
+                    nodes[i].dependents.clear();
+                }
+                for (std::size_t i = 0; i < nodes.size(); ++i) {
+                    for (const auto &dependency : nodes[i].after) {
+                        nodes[*indexOf(dependency)].dependents.push_back(i);
+                    }
+                    nodes[i].remaining = nodes[i].after.size();
+                }
+
+                // Kahn's algorithm over a copy of the counters: every step must become reachable.
+                std::vector<std::size_t> remaining(nodes.size());
+                std::vector<std::size_t> order;
+                for (std::size_t i = 0; i < nodes.size(); ++i) {
+                    remaining[i] = nodes[i].remaining;
+                    if (remaining[i] == 0) {
+                        order.push_back(i);
+                    }
+                }
+                for (std::size_t i = 0; i < order.size(); ++i) {
+                    for (const auto dependent : nodes[order[i]].dependents) {
+                        if (--remaining[dependent] == 0) {
+                            order.push_back(dependent);
+                        }
+                    }
+                }
+                if (order.size() != nodes.size()) {
+                    throw ex::ArgumentError("Startup graph has a dependency cycle");
+                }
+
+                for (std::size_t i = 0; i < nodes.size(); ++i) {
+                    if (nodes[i].remaining == 0) {
+                        ready.push_back(i);
+                    }
+                }
+                shared->started = true;
+                shared->startedAt = Clock::now();
+                if (nodes.empty()) {
+                    shared->finishedCv.notify_all();
+                }
+            }
+            spawnAll(shared, ready);
+        }
+
+        /**
+         * @brief Block until every step has finished or been skipped.
+         */
+        void wait() {
+            std::unique_lock lock(shared->mutex);
+            shared->finishedCv.wait(lock, [this]() { return shared->started && shared->finished == shared->nodes.size(); });
+        }
+
+        /**
+         * @brief State of a step, or nullopt for an unknown name.
+         */
+        std::optional<State> getState(const std::string &name) const {
+            std::lock_guard lock(shared->mutex);
+            const auto index = indexOf(name);
+            return index ? std::optional<State>(shared->nodes[*index].state) : std::nullopt;
+        }
+
+        /**
+         * @brief The exception message of a failed step; empty otherwise.
+         */
+        std::string getError(const std::string &name) const {
+            std::lock_guard lock(shared->mutex);
+            const auto index = indexOf(name);
+            return index ? shared->nodes[*index].error : std::string{};
+        }
+
+        /**
+         * @brief How long a finished step ran; zero if it has not run.
+         */
+        Clock::duration getDuration(const std::string &name) const {
+            std::lock_guard lock(shared->mutex);
+            const auto index = indexOf(name);
+            return index ? shared->nodes[*index].duration : Clock::duration{};
+        }
+
+        /**
+         * @brief Time since run(), for logging how long startup took to reach a step.
+         */
+        Clock::duration getElapsed() const {
+            std::lock_guard lock(shared->mutex);
+            return shared->started ? Clock::now() - shared->startedAt : Clock::duration{};
+        }
+    };
+
+} // namespace neko::core
@@ -0,0 +1,64 @@
+/**
+ * @see neko/core/update.hpp
+ * @file unzip.hpp
+ * @brief Parallel zip extraction for update archives.
+ */
+
+#pragma once
+
+#include <neko/schema/exception.hpp>
+#include <neko/schema/types.hpp>
+
+#include <functional>
+#include <string>
+
+namespace neko::core::unzip {
+
+    struct ExtractOptions {
+        /**
+         * @brief Tasks on the cpu executor; 0 = its thread count. Never more than the number of entries.
+         */
+        neko::uint32 threads = 0;
+        bool overwrite = true;
+        /**
+         * @brief Uncompressed bytes written so far and in total; called from worker threads.
+         */
+        std::function<void(neko::uint64 doneBytes, neko::uint64 totalBytes)> onProgress;
+        /**
+         * @brief Polled between blocks; returning true stops extraction with ex::Runtime.
+         */
+        std::function<bool()> isCancelled;
+    };
+
+    struct ExtractResult {
+        neko::uint64 entries = 0;
+        neko::uint64 bytes = 0;
+    };
+
+    /**
+     * @brief Whether extract() can handle the archive.
+     *
+     * True for zip (and zip64) archives whose entries are all unencrypted, stored or deflated,
+     * regular files or directories. Anything else (other methods, encryption, symlinks) should go
+     * through archive::zip::extract instead.
+     */
+    bool isSupported(const std::string &archivePath) noexcept;
+
+    /**
+     * @brief Extract a zip archive into `destDir`, inflating entries in parallel on the cpu executor.
+     *
+     * The archive is memory-mapped; each task keeps one inflate stream and one output buffer for
+     * all the entries it extracts, largest entries first. Every entry's CRC-32 is checked. Unix
+     * permission bits stored in the archive are applied, so executables stay executable.
+     * Entries that would land outside `destDir`, or twice on the same path, are rejected before
+     * anything is written.
+     * @note Blocks until the cpu tasks finish; call it from an io task or a plain thread, not a cpu task.
+     * @throws ex::FileError if the archive cannot be read or an output cannot be written
+     * @throws ex::Parse if the archive is malformed or an entry fails its CRC check
+     * @throws ex::ArgumentError if the archive is not supported (see isSupported), has an unsafe path
+     *         or a duplicate entry
+     * @throws ex::Runtime if `options.isCancelled` returned true
+     */
+    ExtractResult extract(const std::string &archivePath, const std::string &destDir, const ExtractOptions &options = {});
+
+} // namespace neko::core::unzip
@@ -39,9 +39,28 @@ namespace neko::core::update {
     void update(api::UpdateResponse data);
 
     /**
-     * @brief Perform the auto-update process.
-     * @note This function publishes events to the event bus and may quit the application if maintenance mode is active.
+     * @brief Parse a payload returned by checkUpdate() and apply it.
+     * @param payload The JSON payload returned by checkUpdate().
+     * @throws ex::Exception if the payload is empty after parsing, or anything update() throws.
      */
-    void autoUpdate();
+    void applyUpdate(const std::string &payload);
+
+    /**
+     * @brief Switch to the core files staged by update(), or back from a release that failed its trial start.
+     * @return true if installed files changed; this process still runs the old ones, so restart and exit.
+     * @note Call first thing in main(), before the main window is created.
+     */
+    bool switchStagedRelease();
+
+    /**
+     * @brief After a rollback, put back the resource version that was installed before the rejected release.
+     * @note Call once the client config is loaded and before the update check.
+     */
+    void restoreRolledBackVersion();
+
+    /**
+     * @brief Mark this start healthy, keeping a release on trial; without it the next start rolls back.
+     */
+    void confirmStartup();
 
 } // namespace neko::core::update
\ No newline at end of file
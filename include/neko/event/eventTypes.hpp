@@ -15,10 +15,24 @@
 
 #include <string>
 #include <functional>
+#include <memory>
 #include <vector>
 
 namespace neko::event {
 
+    /**
+     * @brief Immutable payload shared by the publisher, every subscriber and the UI thread.
+     * Copying an event that holds a Shared<T> only bumps a reference count, so large
+     * messages cross the bus and the Qt boundary without deep copies.
+     */
+    template <typename T>
+    using Shared = std::shared_ptr<const T>;
+
+    template <typename T>
+    Shared<T> makeShared(T value) {
+        return std::make_shared<const T>(std::move(value));
+    }
+
     /*****************/
     /** App Events **/
     /*****************/
@@ -36,8 +50,12 @@ namespace neko::event {
         bool success = false;
     };
 
+    /**
+     * @brief Published after a config load or update that changed at least one field.
+     * Subscribers check `change->contains(section, key)` and react only to the fields they own.
+     */
     struct ConfigUpdatedEvent {
-        neko::ClientConfig config;
+        Shared<neko::ConfigChange> change = makeShared(neko::ConfigChange{});
     };
 
     /*****************/
@@ -47,14 +65,20 @@ namespace neko::event {
     struct CurrentPageChangeEvent {
         ui::Page page;
     };
-    struct ShowNoticeEvent : public neko::ui::NoticeMsg {
-        ShowNoticeEvent(const neko::ui::NoticeMsg &msg) : neko::ui::NoticeMsg(msg) {}
+    struct ShowNoticeEvent {
+        Shared<neko::ui::NoticeMsg> notice;
+        ShowNoticeEvent(neko::ui::NoticeMsg msg) : notice(makeShared(std::move(msg))) {}
+        explicit ShowNoticeEvent(Shared<neko::ui::NoticeMsg> msg) : notice(std::move(msg)) {}
     };
-    struct ShowLoadingEvent : public neko::ui::LoadingMsg {
-        ShowLoadingEvent(const neko::ui::LoadingMsg &msg) : neko::ui::LoadingMsg(msg) {}
+    struct ShowLoadingEvent {
+        Shared<neko::ui::LoadingMsg> loading;
+        ShowLoadingEvent(neko::ui::LoadingMsg msg) : loading(makeShared(std::move(msg))) {}
+        explicit ShowLoadingEvent(Shared<neko::ui::LoadingMsg> msg) : loading(std::move(msg)) {}
     };
-    struct ShowInputEvent : public neko::ui::InputMsg {
-        ShowInputEvent(const neko::ui::InputMsg &msg) : neko::ui::InputMsg(msg) {}
+    struct ShowInputEvent {
+        Shared<neko::ui::InputMsg> input;
+        ShowInputEvent(neko::ui::InputMsg msg) : input(makeShared(std::move(msg))) {}
+        explicit ShowInputEvent(Shared<neko::ui::InputMsg> msg) : input(std::move(msg)) {}
     };
     struct LoadingValueChangedEvent {
         neko::uint32 progressValue;
@@ -66,6 +90,12 @@ namespace neko::event {
         LoadingChangedEvent(const std::string &statusMessage, neko::uint32 progressValue)
             : LoadingValueChangedEvent{progressValue}, LoadingStatusChangedEvent{statusMessage} {}
     };
+    /**
+     * @brief User asked to cancel the running foreground operation (install, update, launch preparation).
+     */
+    struct CancelOperationEvent {
+        std::string reason;
+    };
     // Request UI to refresh localized text (e.g., after config or resource updates).
     struct RefreshTextEvent {};
     struct HideInputEvent {};
@@ -99,31 +129,37 @@ namespace neko::event {
         int exitCode = -1;
     };
 
-    struct RestartRequestEvent {
-        std::string reason;
-        std::string command;
-    };
-
 
     /*****************/
     /** Core Events **/
     /*****************/
 
-    struct MaintenanceEvent : public neko::ui::NoticeMsg {
+    struct MaintenanceEvent {
+        Shared<neko::ui::NoticeMsg> notice = makeShared(neko::ui::NoticeMsg{});
         MaintenanceEvent() = default;
-        MaintenanceEvent(const neko::ui::NoticeMsg &msg) : neko::ui::NoticeMsg(msg) {}
+        MaintenanceEvent(neko::ui::NoticeMsg msg) : notice(makeShared(std::move(msg))) {}
     };
-    struct UpdateAvailableEvent : api::UpdateResponse {
+    // The maintenance window announced by `notice` is over; close the notice if it is still open.
+    struct MaintenanceEndedEvent {
+        Shared<neko::ui::NoticeMsg> notice;
+    };
+    struct UpdateAvailableEvent {
+        Shared<api::UpdateResponse> update = makeShared(api::UpdateResponse{});
         UpdateAvailableEvent() = default;
-        explicit UpdateAvailableEvent(const api::UpdateResponse &resp) : api::UpdateResponse(resp) {}
+        explicit UpdateAvailableEvent(api::UpdateResponse resp) : update(makeShared(std::move(resp))) {}
+        explicit UpdateAvailableEvent(Shared<api::UpdateResponse> resp) : update(std::move(resp)) {}
+    };
+    struct UpdateCompleteEvent {
+        neko::uint32 unchangedFiles = 0; // already matched their checksum, not downloaded
+        neko::uint64 bytesFetched = 0;
+        neko::uint64 bytesSaved = 0;     // compared with downloading every file whole
     };
-    struct UpdateCompleteEvent {};
     struct UpdateFailedEvent {
         std::string reason;
     };
 
     struct NewsLoadedEvent {
-        std::vector<api::NewsItem> items;
+        Shared<std::vector<api::NewsItem>> items = makeShared(std::vector<api::NewsItem>{});
         bool hasMore = false;
     };
     struct NewsLoadFailedEvent {
@@ -22,13 +22,12 @@ namespace neko::minecraft::auth {
     };
 
     inline bool isLoggedIn() noexcept {
-        auto cfg = bus::config::getClientConfig();
-        return !cfg.minecraft.accessToken.empty() && !cfg.minecraft.uuid.empty() && !cfg.minecraft.playerName.empty();
+        const auto cfg = bus::config::getSnapshot();
+        return !cfg->minecraft.accessToken.empty() && !cfg->minecraft.uuid.empty() && !cfg->minecraft.playerName.empty();
     }
 
     inline std::string getPlayerName() noexcept {
-        auto cfg = bus::config::getClientConfig();
-        return cfg.minecraft.playerName;
+        return bus::config::getSnapshot()->minecraft.playerName;
     }
 
     /**
@@ -13,17 +13,41 @@
 
 #include <nlohmann/json.hpp>
 
+#include <string>
+
 namespace neko::minecraft {
 
+    /**
+     * @brief What an install reused from disk and what it downloaded.
+     *
+     * Libraries, the client jar and asset objects that already match their size and SHA-1 are reused.
+     */
+    struct InstallSummary {
+        neko::uint64 reusedFiles = 0;
+        neko::uint64 reusedBytes = 0;
+        neko::uint64 fetchedFiles = 0;
+        neko::uint64 fetchedBytes = 0;
+    };
+
+    /**
+     * @brief Optional overrides for setupMinecraftDownloads().
+     */
+    struct DownloadOptions {
+        // Asset objects are fetched from `<assetBaseUrl>/<first two hash chars>/<hash>`; empty uses the host of the download source.
+        std::string assetBaseUrl;
+    };
+
     // Should not be called from the main thread, as it will block the incoming thread until completion.
-    void setupMinecraftDownloads(
+    // Every downloaded file must match its listed size and SHA-1, otherwise it is removed and the install fails.
+    InstallSummary setupMinecraftDownloads(
         DownloadSource downloadSource,
         neko::strview versionId,
         const nlohmann::json &versionJson,
-        neko::strview installPath = "./.minecraft");
+        neko::strview installPath = "./.minecraft",
+        const DownloadOptions &options = {});
 
     // Should not be called from the main thread, as it will block the incoming thread until completion.
-    void installMinecraft(
+    InstallSummary installMinecraft(
         neko::strview installPath = "./.minecraft",
         neko::strview targetVersion = "1.16.5",
         DownloadSource downloadSource = DownloadSource::Official);
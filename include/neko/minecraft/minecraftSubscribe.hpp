@@ -56,18 +56,19 @@ namespace neko::minecraft {
                 return;
             }
 
-            const auto cfg = bus::config::getClientConfig();
-            const auto launcherMethod = cfg.main.launcherMethod;
+            const auto launcherMethod = bus::config::getSnapshot()->main.launcherMethod;
 
             ui::LoadingMsg loadingMsg;
             loadingMsg.type = ui::LoadingMsg::Type::OnlyRaw;
+            loadingMsg.cancellable = true;
             bus::event::publish<event::ShowLoadingEvent>(loadingMsg);
             bus::event::publish<event::LoadingStatusChangedEvent>(
                 {lang::tr(lang::keys::loading::category, lang::keys::loading::starting, "Starting...")});
 
             pendingStarts.fetch_add(1, std::memory_order_acq_rel);
 
-            bus::thread::submit([launcherMethod]() {
+            // The launcher blocks until the game process exits; the user is waiting on it.
+            (void)bus::thread::schedule(bus::Executor::io, {.taskClass = bus::TaskClass::interactive}, [launcherMethod]() {
                 try {
                     const bool detach = (launcherMethod == "launchExit");
                     core::launcher(nullptr, nullptr, detach);
@@ -7,6 +7,7 @@
 #include <QtWidgets/QWidget>
 
 #include <deque>
+#include <memory>
 #include <vector>
 
 class QFrame;
@@ -32,7 +33,8 @@ namespace neko::ui::dialog {
         QLabel *msg;
         QWidget *buttonContainer;
         QHBoxLayout *buttonLayout;
-        std::deque<NoticeMsg> noticeQueue;
+        std::deque<std::shared_ptr<const NoticeMsg>> noticeQueue;
+        std::shared_ptr<const NoticeMsg> currentNotice;
         bool showing = false;
 
         void presentNextNotice();
@@ -42,6 +44,9 @@ namespace neko::ui::dialog {
         NoticeDialog(QWidget *parent = nullptr);
 
         void showNotice(const NoticeMsg &m);
+        void showNotice(std::shared_ptr<const NoticeMsg> m);
+        // Close `m` if it is shown, or drop it from the queue, without running its callback.
+        void dismissNotice(std::shared_ptr<const NoticeMsg> m);
 
         void setupFont(QFont font,QFont titleFont);
         void setupTheme(const Theme &theme);
@@ -16,6 +16,7 @@
 class QProgressBar;
 class QMovie;
 class QLabel;
+class QPushButton;
 class QVBoxLayout;
 
 namespace neko::ui::page {
@@ -33,6 +34,7 @@ namespace neko::ui::page {
         QLabel *loadingLabel;
         QMovie *loadingMv;
         QLabel *process;
+        QPushButton *cancelButton;
 
     public:
         LoadingPage(QWidget *parent = nullptr);
@@ -50,5 +52,6 @@ namespace neko::ui::page {
     signals:
         void setLoadingValueD(neko::uint32 val);
         void setLoadingStatusD(const std::string& msg);
+        void cancelRequested();
     };
 } // namespace neko::ui::page
@@ -13,6 +13,7 @@
 #include <QtWidgets/QCheckBox>
 #include <QtWidgets/QComboBox>
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <cstdint>
@@ -65,6 +66,7 @@ namespace neko::ui::page {
         explicit NewsPage(QWidget *parent = nullptr);
 
         void setNews(const std::vector<api::NewsItem> &items);
+        void setNews(std::shared_ptr<const std::vector<api::NewsItem>> items);
         void clearNews();
 
         void setupTheme(const Theme &theme);
@@ -89,7 +91,7 @@ namespace neko::ui::page {
         void updateNewsItems();
 
         Theme currentTheme;
-        std::vector<api::NewsItem> newsItems;
+        std::shared_ptr<const std::vector<api::NewsItem>> newsItems = std::make_shared<const std::vector<api::NewsItem>>();
         std::vector<NewsPageItem*> newsWidgets;
         NewsDismissOption currentDismissOption = NewsDismissOption::None;
 
@@ -112,6 +112,11 @@ namespace neko::ui {
          * @brief Maximum progress value.
          */
         neko::uint32 progressMax = 0;
+
+        /**
+         * @brief Show a Cancel button that cancels the running foreground operation.
+         */
+        bool cancellable = false;
     };
 
     /**
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <QtCore/QCoreApplication>
 #include <QtCore/QMetaObject>
 
 #include <neko/log/nlog.hpp>
@@ -8,11 +7,9 @@
 #include "neko/ui/uiMsg.hpp"
 #include "neko/bus/eventBus.hpp"
 #include "neko/bus/configBus.hpp"
-#include "neko/core/launcherProcess.hpp"
 #include "neko/event/eventTypes.hpp"
 #include "neko/ui/uiEventDispatcher.hpp"
 #include "neko/app/lang.hpp"
-#include "neko/system/platform.hpp"
 
 namespace neko::ui {
 
@@ -21,21 +18,34 @@ namespace neko::ui {
         bus::event::subscribe<event::ShowNoticeEvent>(
             [](const event::ShowNoticeEvent &e) {
                 if (auto nekoWindow = UiEventDispatcher::getNekoWindow()) {
-                    emit nekoWindow->showNoticeD(static_cast<const neko::ui::NoticeMsg &>(e));
+                    emit nekoWindow->showNoticeD(e.notice);
+                }
+            });
+        bus::event::subscribe<event::MaintenanceEndedEvent>(
+            [](const event::MaintenanceEndedEvent &e) {
+                if (auto nekoWindow = UiEventDispatcher::getNekoWindow()) {
+                    emit nekoWindow->dismissNoticeD(e.notice);
                 }
             });
         bus::event::subscribe<event::ShowLoadingEvent>(
             [](const event::ShowLoadingEvent &e) {
                 if (auto nekoWindow = UiEventDispatcher::getNekoWindow()) {
                     emit nekoWindow->switchToPageD(ui::Page::loading);
-                    emit nekoWindow->showLoadingD(static_cast<const neko::ui::LoadingMsg &>(e));
+                    emit nekoWindow->showLoadingD(e.loading);
                 }
             });
         
         bus::event::subscribe<event::ShowInputEvent>(
             [](const event::ShowInputEvent &e) {
                 if (auto nekoWindow = UiEventDispatcher::getNekoWindow()) {
-                    emit nekoWindow->showInputD(static_cast<const neko::ui::InputMsg &>(e));
+                    emit nekoWindow->showInputD(e.input);
+                }
+            });
+
+        bus::event::subscribe<event::ConfigUpdatedEvent>(
+            [](const event::ConfigUpdatedEvent &e) {
+                if (auto nekoWindow = UiEventDispatcher::getNekoWindow()) {
+                    emit nekoWindow->configUpdatedD(e.change);
                 }
             });
 
@@ -55,8 +65,8 @@ namespace neko::ui {
 
         bus::event::subscribe<event::LaunchStartedEvent>(
             [](const event::LaunchStartedEvent &) {
-                const auto cfg = bus::config::getClientConfig();
-                const auto &method = cfg.main.launcherMethod;
+                const auto cfg = bus::config::getSnapshot();
+                const auto &method = cfg->main.launcherMethod;
                 if (auto nekoWindow = UiEventDispatcher::getNekoWindow()) {
                     if (method == "launchExit") {
                         nekoWindow->close();
@@ -73,8 +83,8 @@ namespace neko::ui {
 
         bus::event::subscribe<event::LaunchFinishedEvent>(
             [](const event::LaunchFinishedEvent &) {
-                const auto cfg = bus::config::getClientConfig();
-                const auto &method = cfg.main.launcherMethod;
+                const auto cfg = bus::config::getSnapshot();
+                const auto &method = cfg->main.launcherMethod;
                 if (auto nekoWindow = UiEventDispatcher::getNekoWindow()) {
                     if (method == "launchHideRestore") {
                         emit nekoWindow->showWindowD();
@@ -92,7 +102,7 @@ namespace neko::ui {
                         .title = lang::tr(lang::keys::launcher::category, lang::keys::launcher::launchFailedTitle),
                         .message = lang::tr(lang::keys::launcher::category, lang::keys::launcher::launchFailedMessage) + e.reason,
                         .buttonText = {lang::tr(lang::keys::button::category, lang::keys::button::ok)}};
-                    emit nekoWindow->showNoticeD(notice);
+                    emit nekoWindow->showNoticeD(event::makeShared(std::move(notice)));
                 }
             });
 
@@ -124,26 +134,6 @@ namespace neko::ui {
                 }
             });
 
-        bus::event::subscribe<event::RestartRequestEvent>(
-            [](const event::RestartRequestEvent &e) {
-                log::info("Restart requested: {}", {}, e.reason);
-                try {
-                    core::launcherNewProcess(e.command, system::workPath());
-                } catch (const std::exception &ex) {
-                    log::error("Failed to start updater: {}", {}, ex.what());
-                }
-
-                if (auto nekoWindow = UiEventDispatcher::getNekoWindow()) {
-                    QMetaObject::invokeMethod(nekoWindow, [nekoWindow]() {
-                        emit nekoWindow->quitAppD();
-                    }, Qt::QueuedConnection);
-                } else {
-                    QMetaObject::invokeMethod(QCoreApplication::instance(), []() {
-                        QCoreApplication::quit();
-                    }, Qt::QueuedConnection);
-                }
-            });
-
         bus::event::subscribe<event::LoadingValueChangedEvent>(
             [](const event::LoadingValueChangedEvent &e) {
                 if (auto nekoWindow = UiEventDispatcher::getNekoWindow()) {
@@ -168,10 +158,8 @@ namespace neko::ui {
         bus::event::subscribe<event::NewsLoadedEvent>(
             [](const event::NewsLoadedEvent &e) {
                 if (auto nekoWindow = UiEventDispatcher::getNekoWindow()) {
-                    auto items = e.items;
-                    const bool hasMore = e.hasMore;
-                    QMetaObject::invokeMethod(nekoWindow, [nekoWindow, items = std::move(items), hasMore]() mutable {
-                        nekoWindow->setNews(std::move(items), hasMore);
+                    QMetaObject::invokeMethod(nekoWindow, [nekoWindow, items = e.items, hasMore = e.hasMore]() {
+                        nekoWindow->setNews(items, hasMore);
                     }, Qt::QueuedConnection);
                 }
             });
@@ -24,6 +24,10 @@
 #include <QtGui/QScreen>
 #include <QtWidgets/QMainWindow>
 
+#include <memory>
+#include <set>
+#include <vector>
+
 class QWidget;
 class QGraphicsBlurEffect;
 class QTimer;
@@ -59,6 +63,9 @@ namespace neko::ui::window {
         bool useImageBackground = false;
         bool followSystemTheme = false;
         bool saveImmediately = false;
+        // Config versions written by this window; their changes were already applied live.
+        std::set<neko::uint64> ownConfigVersions;
+        void applyConfigFields(const ClientConfig &config, const ConfigChange *change);
         void applyThemeSelection(const std::string &themeName);
         void applySystemThemeIfNeeded();
         void applyCentralBackground(const Theme &theme);
@@ -82,7 +89,7 @@ namespace neko::ui::window {
         void hideInput();
         std::vector<std::string> getLines();
         void showLoading(const LoadingMsg &m);
-        void setNews(std::vector<api::NewsItem> items, bool hasMore);
+        void setNews(std::shared_ptr<const std::vector<api::NewsItem>> items, bool hasMore);
         void handleNewsLoadFailed(const std::string &reason);
 
     protected:
@@ -91,9 +98,11 @@ namespace neko::ui::window {
         bool event(QEvent *event) override;
 
     signals:
-        void showNoticeD(const NoticeMsg &m);
-        void showInputD(const InputMsg &m);
-        void showLoadingD(const LoadingMsg &m);
+        // Shared, immutable payloads: queued delivery from worker threads copies only the pointer.
+        void showNoticeD(std::shared_ptr<const NoticeMsg> m);
+        void dismissNoticeD(std::shared_ptr<const NoticeMsg> m);
+        void showInputD(std::shared_ptr<const InputMsg> m);
+        void showLoadingD(std::shared_ptr<const LoadingMsg> m);
         void hideInputD();
         std::vector<std::string> getLinesD();
         void resetNoticeStateD();
@@ -105,6 +114,7 @@ namespace neko::ui::window {
         void hideWindowD();
         void showWindowD();
         void quitAppD();
+        void configUpdatedD(std::shared_ptr<const ConfigChange> change);
 
     public slots:
         void onThemeChanged(const QString &themeName);
@@ -120,6 +130,7 @@ namespace neko::ui::window {
         void onWindowSizeEdited(const QString &sizeText);
         void onWindowSizeApplyRequested(const QString &sizeText);
         void onConfigChanged();
+        void onConfigUpdated(std::shared_ptr<const ConfigChange> change);
     };
 
 } // namespace neko::ui::window
@@ -55,7 +55,7 @@ namespace neko::core::crash {
         bus::config::updateClientConfig([](neko::ClientConfig &c) {
             c.other.lastRunUnclean = true;
         });
-        bus::config::save(app::getConfigFileName());
+        bus::config::saveAsync(app::getConfigFileName());
         return previous;
     }
 
@@ -63,6 +63,7 @@ namespace neko::core::crash {
         bus::config::updateClientConfig([](neko::ClientConfig &c) {
             c.other.lastRunUnclean = false;
         });
+        // Last write of the session: synchronous, and it supersedes any pending coalesced save.
         bus::config::save(app::getConfigFileName());
     }
 
@@ -0,0 +1,175 @@
+/**
+ * @file deltaPatch.cpp
+ * @brief Patch selection and zstd patch application
+ */
+
+#include <neko/log/nlog.hpp>
+#include <neko/schema/exception.hpp>
+
+#include "neko/core/deltaPatch.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <zstd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+namespace neko::core::delta {
+
+    namespace {
+
+        // ZSTD_WINDOWLOG_MAX, which zstd.h only exposes to static linking.
+        constexpr int MaxWindowLog = sizeof(std::size_t) == 4 ? 30 : 31;
+
+        struct DCtxDeleter {
+            void operator()(ZSTD_DCtx *ctx) const noexcept {
+                ZSTD_freeDCtx(ctx);
+            }
+        };
+
+        /**
+         * @brief Read-only mapping of the base file; an empty file maps to no bytes.
+         */
+        class MappedBase {
+        private:
+            boost::interprocess::file_mapping mapping;
+            boost::interprocess::mapped_region region;
+
+        public:
+            explicit MappedBase(const std::string &path) {
+                std::error_code ec;
+                const auto size = std::filesystem::file_size(path, ec);
+                if (ec) {
+                    throw ex::FileError("Cannot read patch base " + path + ": " + ec.message());
+                }
+                if (size == 0) {
+                    return;
+                }
+                try {
+                    mapping = boost::interprocess::file_mapping(path.c_str(), boost::interprocess::read_only);
+                    region = boost::interprocess::mapped_region(mapping, boost::interprocess::read_only);
+                } catch (const boost::interprocess::interprocess_exception &e) {
+                    throw ex::FileError("Cannot map patch base " + path + ": " + e.what());
+                }
+            }
+
+            const void *data() const noexcept {
+                return region.get_address();
+            }
+
+            std::size_t size() const noexcept {
+                return region.get_size();
+            }
+        };
+
+        void applyZstd(const std::string &basePath, const std::string &patchPath, const std::string &outPath) {
+            const MappedBase base(basePath);
+
+            std::unique_ptr<ZSTD_DCtx, DCtxDeleter> ctx(ZSTD_createDCtx());
+            if (!ctx) {
+                throw ex::FileError("Cannot create zstd decompression context");
+            }
+            // Patches of large files are made with a window covering the whole base (--long).
+            ZSTD_DCtx_setParameter(ctx.get(), ZSTD_d_windowLogMax, MaxWindowLog);
+            if (const auto rc = ZSTD_DCtx_refPrefix(ctx.get(), base.data(), base.size()); ZSTD_isError(rc)) {
+                throw ex::Parse(std::string("Cannot use patch base: ") + ZSTD_getErrorName(rc));
+            }
+
+            std::ifstream patch(patchPath, std::ios::binary);
+            if (!patch.is_open()) {
+                throw ex::FileError("Cannot open patch " + patchPath);
+            }
+            std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) {
+                throw ex::FileError("Cannot create patched file " + outPath);
+            }
+
+            std::vector<char> inBuffer(ZSTD_DStreamInSize());
+            std::vector<char> outBuffer(ZSTD_DStreamOutSize());
+            std::size_t pending = 0; // non-zero while a frame is incomplete
+            bool sawFrame = false;
+            while (patch) {
+                patch.read(inBuffer.data(), static_cast<std::streamsize>(inBuffer.size()));
+                const auto readBytes = static_cast<std::size_t>(patch.gcount());
+                if (readBytes == 0) {
+                    break;
+                }
+                ZSTD_inBuffer input{inBuffer.data(), readBytes, 0};
+                while (input.pos < input.size) {
+                    ZSTD_outBuffer output{outBuffer.data(), outBuffer.size(), 0};
+                    pending = ZSTD_decompressStream(ctx.get(), &output, &input);
+                    if (ZSTD_isError(pending)) {
+                        throw ex::Parse(std::string("Patch does not apply: ") + ZSTD_getErrorName(pending));
+                    }
+                    sawFrame = true;
+                    if (pending == 0) {
+                        // The prefix is consumed by each frame; patches are a single frame.
+                        ZSTD_DCtx_refPrefix(ctx.get(), base.data(), base.size());
+                    }
+                    if (!out.write(outBuffer.data(), static_cast<std::streamsize>(output.pos))) {
+                        throw ex::FileError("Cannot write patched file " + outPath);
+                    }
+                }
+            }
+            if (!sawFrame || pending != 0) {
+                throw ex::Parse("Patch is truncated: " + patchPath);
+            }
+            out.flush();
+            if (!out) {
+                throw ex::FileError("Cannot write patched file " + outPath);
+            }
+        }
+
+    } // namespace
+
+    Format parseFormat(std::string_view format) noexcept {
+        if (format == "zstd") {
+            return Format::zstd;
+        }
+        return Format::unsupported;
+    }
+
+    std::optional<api::UpdateResponse::Patch> selectPatch(
+        const api::UpdateResponse::File &file,
+        const std::string &localVersion,
+        const std::function<std::string(const std::string &algorithm)> &localHash) {
+        std::optional<std::string> hash;
+        for (const auto &patch : file.patches) {
+            if (parseFormat(patch.format) == Format::unsupported || patch.url.empty() || patch.baseChecksum.empty()) {
+                continue;
+            }
+            if (!patch.fromVersion.empty() && patch.fromVersion != localVersion) {
+                continue;
+            }
+            if (!hash) {
+                hash = localHash(file.hashAlgorithm);
+            }
+            if (hash->empty()) {
+                return std::nullopt;
+            }
+            if (*hash == patch.baseChecksum) {
+                return patch;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void applyPatch(Format format, const std::string &basePath, const std::string &patchPath, const std::string &outPath) {
+        if (format != Format::zstd) {
+            throw ex::ArgumentError("Unsupported patch format");
+        }
+        try {
+            applyZstd(basePath, patchPath, outPath);
+        } catch (...) {
+            std::error_code ec;
+            std::filesystem::remove(outPath, ec);
+            throw;
+        }
+    }
+
+} // namespace neko::core::delta
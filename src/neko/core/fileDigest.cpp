@@ -0,0 +1,75 @@
+/**
+ * @file fileDigest.cpp
+ * @brief Block-wise file digests over OpenSSL EVP
+ */
+
+#include <neko/schema/exception.hpp>
+
+#include "neko/core/fileDigest.hpp"
+
+#include <openssl/evp.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace neko::core::digest {
+
+    std::string digestFile(const std::string &path, const std::string &algorithm,
+                           const std::function<bool()> &isCancelled, neko::uint64 blockSize) {
+        // Manifests write "SHA-256" as often as "sha256"; OpenSSL knows the latter.
+        std::string name;
+        for (unsigned char c : algorithm) {
+            if (c != '-' && c != '_') {
+                name += static_cast<char>(std::tolower(c));
+            }
+        }
+        const EVP_MD *md = EVP_get_digestbyname(name.c_str());
+        if (md == nullptr) {
+            throw ex::ArgumentError("Unknown digest algorithm: " + algorithm);
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw ex::FileError("Cannot open file for hashing: " + path);
+        }
+
+        std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+        if (!ctx || EVP_DigestInit_ex(ctx.get(), md, nullptr) != 1) {
+            throw ex::Runtime("Cannot initialise digest " + algorithm);
+        }
+
+        std::vector<char> block(static_cast<std::size_t>(std::max<neko::uint64>(blockSize, 4096)));
+        while (file) {
+            if (isCancelled && isCancelled()) {
+                throw ex::Runtime("Hashing cancelled: " + path);
+            }
+            file.read(block.data(), static_cast<std::streamsize>(block.size()));
+            const auto got = file.gcount();
+            if (got > 0 && EVP_DigestUpdate(ctx.get(), block.data(), static_cast<std::size_t>(got)) != 1) {
+                throw ex::Runtime("Digest update failed for " + path);
+            }
+        }
+        if (file.bad()) {
+            throw ex::FileError("Cannot read file for hashing: " + path);
+        }
+
+        std::array<unsigned char, EVP_MAX_MD_SIZE> out{};
+        unsigned int length = 0;
+        if (EVP_DigestFinal_ex(ctx.get(), out.data(), &length) != 1) {
+            throw ex::Runtime("Digest final failed for " + path);
+        }
+        constexpr char hex[] = "0123456789abcdef";
+        std::string result;
+        result.reserve(length * 2);
+        for (unsigned int i = 0; i < length; ++i) {
+            result += hex[out[i] >> 4];
+            result += hex[out[i] & 0x0f];
+        }
+        return result;
+    }
+
+} // namespace neko::core::digest
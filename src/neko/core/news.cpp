@@ -15,19 +15,52 @@
 #include "neko/app/nekoLc.hpp"
 
 #include "neko/core/news.hpp"
+#include "neko/core/responseCache.hpp"
 
 #include <nlohmann/json.hpp>
 
 namespace neko::core {
 
+    namespace {
+        /**
+         * @throws ex::ParseError if the response cannot be parsed.
+         */
+        std::optional<api::NewsResponse> parseNews(neko::int32 statusCode, const std::string &content) {
+            if (statusCode == 204) {
+                log::info("No news available (204)");
+                return std::nullopt;
+            }
+
+            log::debug("News response: {}", {}, content);
+
+            try {
+                auto jsonData = nlohmann::json::parse(content);
+                api::NewsResponse response;
+                api::from_json(jsonData, response);
+
+                log::info("Fetched {} news items", {}, std::to_string(response.items.size()));
+                return response;
+
+            } catch (const nlohmann::json::parse_error &e) {
+                std::string errMsg = "Failed to parse news response: " + std::string(e.what());
+                log::error(errMsg);
+                throw ex::ParseError(errMsg);
+            } catch (const nlohmann::json::exception &e) {
+                std::string errMsg = "Failed to parse news response: " + std::string(e.what());
+                log::error(errMsg);
+                throw ex::ParseError(errMsg);
+            }
+        }
+    } // namespace
+
     std::optional<api::NewsResponse> fetchNews(
         const api::LauncherConfigResponse &config,
         neko::int32 limit,
         const std::vector<std::string> &categories,
-        const std::string &lastId) {
+        const std::string &lastId,
+        NewsChangedListener onChanged) {
         
         log::autoLog log;
-        network::Network net;
 
         // Build request JSON
         nlohmann::json newsRequestBody;
@@ -46,10 +79,31 @@ namespace neko::core {
         
         newsRequestBody["preferences"] = app::getPreferences();
 
-        auto url = network::buildUrl(lc::api::news);
+        // The first page is what startup shows; cache it so it renders before the request returns.
+        if (lastId.empty()) {
+            ResponseCache::Listener listener;
+            if (onChanged) {
+                listener = [onChanged](const CachedResponse &changed) {
+                    try {
+                        onChanged(parseNews(changed.statusCode, changed.body));
+                    } catch (const std::exception &e) {
+                        log::warn("Ignoring revalidated news: {}", {}, e.what());
+                    }
+                };
+            }
+            try {
+                auto cached = postApiCached(lc::api::news, newsRequestBody, "newsRequest", config.maxRetryCount,
+                                            std::chrono::seconds(config.retryIntervalSec), std::move(listener));
+                return parseNews(cached.statusCode, cached.body);
+            } catch (const ex::NetworkError &e) {
+                log::error("Failed to fetch news: {}", {}, e.what());
+                throw;
+            }
+        }
 
+        network::Network net;
         network::RequestConfig reqConfig{
-            .url = url,
+            .url = network::buildUrl(lc::api::news),
             .method = network::RequestType::Post,
             .requestId = "news-" + util::random::generateRandomString(6),
             .header = network::header::jsonContentHeader,
@@ -64,8 +118,7 @@ namespace neko::core {
         auto result = net.executeWithRetry(retryConfig);
 
         if (!result.hasError && result.statusCode == 204) {
-            log::info("No news available (204)");
-            return std::nullopt;
+            return parseNews(204, {});
         }
 
         if (!result.isSuccess() || !result.hasContent()) {
@@ -74,25 +127,7 @@ namespace neko::core {
             throw ex::NetworkError(errMsg);
         }
 
-        log::debug("News response: {}", {}, result.content);
-
-        try {
-            auto jsonData = nlohmann::json::parse(result.content);
-            api::NewsResponse response;
-            api::from_json(jsonData, response);
-            
-            log::info("Fetched {} news items", {}, std::to_string(response.items.size()));
-            return response;
-
-        } catch (const nlohmann::json::parse_error &e) {
-            std::string errMsg = "Failed to parse news response: " + std::string(e.what());
-            log::error(errMsg);
-            throw ex::ParseError(errMsg);
-        } catch (const nlohmann::json::exception &e) {
-            std::string errMsg = "Failed to parse news response: " + std::string(e.what());
-            log::error(errMsg);
-            throw ex::ParseError(errMsg);
-        }
+        return parseNews(result.statusCode, result.content);
     }
 
 } // namespace neko::core
@@ -14,17 +14,31 @@
 #include "neko/app/appinfo.hpp"
 #include "neko/app/nekoLc.hpp"
 
+#include "neko/bus/threadBus.hpp"
+
 #include "neko/core/remoteConfig.hpp"
+#include "neko/core/remoteConfigCache.hpp"
+
+#include <algorithm>
+#include <chrono>
 
 namespace neko::core {
 
     namespace {
 
+        RemoteConfigFetch toFetch(api::LauncherConfigResponse config) {
+            RemoteConfigFetch fetch;
+            fetch.etag = config.meta.etag;
+            fetch.maxAge = std::chrono::seconds(std::max<neko::int64>(0, config.meta.maxAgeSec));
+            fetch.config = std::move(config);
+            return fetch;
+        }
+
         /**
          * @throws ex::Parse if the response cannot be parsed
          * @throws ex::NetworkError if the network request fails
          */
-        api::LauncherConfigResponse getStaticRemoteConfig() {
+        RemoteConfigFetch getStaticRemoteConfig() {
             log::autoLog log;
             network::Network net;
             network::RequestConfig reqConfig{
@@ -46,38 +60,51 @@ namespace neko::core {
                 log::error(std::string("Failed to parse remote launcher config: ") + e.what());
                 throw ex::Parse("Failed to parse remote launcher config: " + std::string(e.what()));
             }
-            return response;
+            return toFetch(std::move(response));
         }
 
         /**
+         * @param etag ETag of the cached config; the server answers 304 if it is still current.
          * @throws ex::Parse if the response cannot be parsed
          * @throws ex::NetworkError if the network request fails
          */
-        api::LauncherConfigResponse getDynamicRemoteConfig() {
+        RemoteConfigFetch getDynamicRemoteConfig(const std::string &etag) {
             log::autoLog log;
             network::Network net;
+            nlohmann::json request = app::getRequestJson("launcherConfigRequest");
+            if (!etag.empty()) {
+                request["launcherConfigRequest"]["ifNoneMatch"] = etag;
+            }
             network::RequestConfig reqConfig{
                 .url = network::buildUrl(lc::api::launcherConfig),
                 .method = network::RequestType::Post,
                 .requestId = "launcher-config-" + util::random::generateRandomString(6),
                 .header = network::header::jsonContentHeader,
-                .postData = app::getRequestJson("launcherConfigRequest").dump()
+                .postData = request.dump()
             };
+            network::RetryConfig retryConfig{
+                .config = reqConfig,
+                .successCodes = {200, 304}};
 
-            auto result = net.executeWithRetry({reqConfig});
+            auto result = net.executeWithRetry(retryConfig);
 
             if (!result.isSuccess()) {
                 log::error(std::string("Failed to get remote launcher config: ") + result.errorMessage);
                 log::debug(std::string("Detailed error: ") + result.detailedErrorMessage);
                 throw ex::NetworkError("Failed to get remote launcher config: " + result.errorMessage);
             }
-            
+
+            if (result.statusCode == 304) {
+                log::debug("Remote launcher config not modified, etag: {}", {}, etag);
+                return RemoteConfigFetch{.notModified = true};
+            }
+
             log::debug("Remote launcher config response: {}", {}, result.content);
 
             try {
                 // Parse the response content as JSON
                 nlohmann::json config = nlohmann::json::parse(result.content);
-                return config.get<api::LauncherConfigResponse>();
+                return toFetch(config.get<api::LauncherConfigResponse>());
             } catch (const nlohmann::json::exception &e) {
                 log::error(std::string("Failed to parse remote launcher config: ") + e.what());
                 throw ex::Parse("Failed to parse remote launcher config: " + std::string(e.what()));
@@ -85,19 +112,26 @@ namespace neko::core {
         }
     } // namespace
 
-    /**
-     * @brief Fetches the remote launcher configuration from the launcher config API.
-     * @throws ex::NetworkError if the network request fails
-     * @throws ex::Parse if the response cannot be parsed
-     */
+    RemoteConfigCache &getRemoteConfigCache() {
+        static RemoteConfigCache cache(
+            [](const std::string &etag) {
+                // Use static remote config if enabled
+                if constexpr (lc::EnableStaticDeployment || lc::EnableStaticRemoteConfig) {
+                    return getStaticRemoteConfig();
+                } else {
+                    // If static remote config is not enabled, use the launcher config API
+                    return getDynamicRemoteConfig(etag);
+                }
+            },
+            [](std::function<void()> task) {
+                (void)bus::thread::submitIo(std::move(task));
+            },
+            app::getCacheFolder() + "/remote-config.json");
+        return cache;
+    }
+
     api::LauncherConfigResponse getRemoteLauncherConfig() {
         log::autoLog log;
-        // Use static remote config if enabled
-        if constexpr (lc::EnableStaticDeployment || lc::EnableStaticRemoteConfig) {
-            return getStaticRemoteConfig();
-        } else {
-            // If static remote config is not enabled, use the launcher config API
-            return getDynamicRemoteConfig();
-        }
+        return getRemoteConfigCache().get();
     }
 } // namespace neko::core
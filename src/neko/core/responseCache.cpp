@@ -0,0 +1,126 @@
+/**
+ * @file responseCache.cpp
+ * @brief Process-wide API response cache and its network fetchers
+ */
+
+#include <neko/log/nlog.hpp>
+#include <neko/schema/exception.hpp>
+
+#include <neko/function/utilities.hpp>
+#include <neko/network/network.hpp>
+
+#include "neko/app/appinfo.hpp"
+
+#include "neko/bus/threadBus.hpp"
+
+#include "neko/core/responseCache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace neko::core {
+
+    namespace {
+
+        /**
+         * @brief Validators and lifetime from a launcher API body (`meta` at the root or next to the payload).
+         */
+        void readMeta(const std::string &body, Revalidation &out) {
+            try {
+                const auto root = nlohmann::json::parse(body);
+                if (!root.contains("meta") || !root.at("meta").is_object()) {
+                    return;
+                }
+                const auto &meta = root.at("meta");
+                out.etag = meta.value("etag", "");
+                out.lastModified = meta.value("lastModified", "");
+                out.maxAge = std::chrono::seconds(std::max<neko::int64>(0, meta.value("maxAgeSec", neko::int64(0))));
+            } catch (const nlohmann::json::exception &) {
+                // Not JSON: stored without validators; the caller reports the parse error.
+            }
+        }
+
+    } // namespace
+
+    ResponseCache &getResponseCache() {
+        static ResponseCache cache(
+            app::getCacheFolder() + "/http",
+            [](std::function<void()> task) {
+                (void)bus::thread::submitIo(std::move(task));
+            });
+        return cache;
+    }
+
+    CachedResponse postApiCached(
+        const std::string &apiPath,
+        const nlohmann::json &request,
+        const std::string &section,
+        neko::int32 maxRetries,
+        std::chrono::seconds retryDelay,
+        ResponseCache::Listener onChanged,
+        CachePolicy policy) {
+        const auto postData = request.dump();
+
+        auto fetcher = [apiPath, request, section, maxRetries, retryDelay](const std::string &etag, const std::string &lastModified) {
+            nlohmann::json conditional = request;
+            if (!etag.empty()) {
+                conditional[section]["ifNoneMatch"] = etag;
+            }
+            if (!lastModified.empty()) {
+                conditional[section]["ifModifiedSince"] = lastModified;
+            }
+
+            network::Network net;
+            network::RequestConfig reqConfig{
+                .url = network::buildUrl(apiPath),
+                .method = network::RequestType::Post,
+                .requestId = section + "-" + util::random::generateRandomString(6),
+                .header = network::header::jsonContentHeader,
+                .postData = conditional.dump()};
+            network::RetryConfig retryConfig{
+                .config = reqConfig,
+                .maxRetries = maxRetries,
+                .retryDelay = retryDelay,
+                .successCodes = {200, 204, 304}};
+            auto result = net.executeWithRetry(retryConfig);
+
+            if (!result.isSuccess()) {
+                log::debug("Detailed error: {}", {}, result.detailedErrorMessage);
+                throw ex::NetworkError("Request " + section + " failed: " + result.errorMessage);
+            }
+
+            Revalidation revalidation{.statusCode = result.statusCode};
+            if (result.statusCode == 304) {
+                log::debug("{} not modified, etag: {}", {}, section, etag);
+                revalidation.notModified = true;
+            } else if (result.statusCode != 204) {
+                if (!result.hasContent()) {
+                    throw ex::NetworkError("Request " + section + " returned no content");
+                }
+                revalidation.body = result.content;
+                readMeta(revalidation.body, revalidation);
+            }
+            return revalidation;
+        };
+
+        return getResponseCache().get({.method = "POST", .url = apiPath, .body = postData}, std::move(fetcher), std::move(onChanged), policy);
+    }
+
+    CachedResponse getCached(const std::string &url, const std::string &requestId, CachePolicy policy) {
+        auto fetcher = [url, requestId](const std::string &, const std::string &) {
+            network::Network net;
+            network::RequestConfig reqConfig{
+                .url = url,
+                .method = network::RequestType::Get,
+                .requestId = requestId};
+            auto result = net.executeWithRetry({reqConfig});
+            if (!result.isSuccess() || !result.hasContent()) {
+                throw ex::NetworkError("Failed to get " + url + ", error: " + result.errorMessage);
+            }
+            return Revalidation{.statusCode = result.statusCode, .body = result.content};
+        };
+        return getResponseCache().get({.method = "GET", .url = url}, std::move(fetcher), {}, policy);
+    }
+
+} // namespace neko::core
@@ -0,0 +1,218 @@
+/**
+ * @file startup.cpp
+ * @brief Post-network startup pipeline implementation
+ */
+
+#include <neko/log/nlog.hpp>
+#include <neko/schema/exception.hpp>
+#include <neko/network/network.hpp>
+
+#include "neko/app/appinfo.hpp"
+#include "neko/app/appinit.hpp"
+#include "neko/app/lang.hpp"
+
+#include "neko/bus/configBus.hpp"
+#include "neko/bus/eventBus.hpp"
+#include "neko/bus/threadBus.hpp"
+#include "neko/event/eventTypes.hpp"
+
+#include "neko/core/auth.hpp"
+#include "neko/core/downloadPoster.hpp"
+#include "neko/core/install.hpp"
+#include "neko/core/maintenance.hpp"
+#include "neko/core/news.hpp"
+#include "neko/core/remoteConfig.hpp"
+#include "neko/core/startup.hpp"
+#include "neko/core/startupGraph.hpp"
+#include "neko/core/update.hpp"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace neko::core::startup {
+
+    namespace {
+        constexpr neko::int32 NewsPreloadLimit = 8;
+
+        /**
+         * @brief Results handed from one step to the steps after it.
+         */
+        struct Inputs {
+            api::LauncherConfigResponse config;
+            MaintenanceInfo maintenance;
+            std::optional<std::string> updatePayload;
+            bool updateDone = false;
+            bool showNews = false;
+
+            // The first update-path failure; maintenance and updateCheck may fail concurrently.
+            std::mutex failureMutex;
+            std::optional<std::string> failure;
+
+            void recordFailure(const std::string &prefix, const std::exception &e) {
+                std::string reason = prefix + e.what();
+                log::error(reason);
+                std::lock_guard lock(failureMutex);
+                if (!failure.has_value()) {
+                    failure = std::move(reason);
+                }
+            }
+        };
+
+        /**
+         * @brief Whether the user dismissed news for now or for this version.
+         */
+        bool isNewsDismissed() {
+            const auto clientCfg = bus::config::getSnapshot();
+            if (clientCfg->other.newsDismissUntil > 0) {
+                const auto nowSeconds = std::chrono::duration_cast<std::chrono::seconds>(
+                                            std::chrono::system_clock::now().time_since_epoch())
+                                            .count();
+                if (nowSeconds < clientCfg->other.newsDismissUntil) {
+                    return true;
+                }
+            }
+            const std::string dismissVersion = clientCfg->other.newsDismissVersion;
+            return !dismissVersion.empty() && dismissVersion == std::string(app::getVersion());
+        }
+
+        /**
+         * @brief Run a network step; if it fails on a host taken from the health cache, fall back to
+         * the full host probe and run it once more.
+         * @note The host is read before the step, since the requests resolve it when they are built and
+         *       another step's fallback may replace the hosts while this one is still failing.
+         */
+        template <typename F>
+        void withHostFallback(F &&step) {
+            const auto host = network::config::globalConfig.getAvailableHost();
+            try {
+                step();
+            } catch (const ex::NetworkError &e) {
+                if (!app::init::fallBackToFullProbe(host, e.what())) {
+                    throw;
+                }
+                log::info("Retrying startup request after the host fallback");
+                step();
+            }
+        }
+    } // namespace
+
+    void runPostNetworkTasks() {
+        log::autoLog log;
+        auto inputs = std::make_shared<Inputs>();
+        const bool installing = install::needsInstall();
+
+        StartupGraph graph([](std::function<void()> task) {
+            // The page switch waits on these steps; run them ahead of queued bulk work.
+            (void)bus::thread::schedule(bus::Executor::io, {.taskClass = bus::TaskClass::interactive}, std::move(task));
+        });
+
+        graph.add("config", {}, [inputs]() {
+            try {
+                withHostFallback([&]() { inputs->config = getRemoteLauncherConfig(); });
+            } catch (const std::exception &e) {
+                inputs->recordFailure("Auto-update failed: ", e);
+                throw;
+            }
+        });
+
+        graph.add("maintenance", {"config"}, [inputs]() {
+            try {
+                withHostFallback([&]() { inputs->maintenance = checkMaintenance(inputs->config); });
+            } catch (const std::exception &e) {
+                inputs->recordFailure("Auto-update failed: ", e);
+                throw;
+            }
+        });
+
+        graph.add("updateCheck", {"config"}, [inputs]() {
+            try {
+                withHostFallback([&]() { inputs->updatePayload = update::checkUpdate(inputs->config); });
+            } catch (const std::exception &e) {
+                inputs->recordFailure("Auto-update failed: ", e);
+                throw;
+            }
+        });
+
+        // The only ordering constraint: resources are replaced after both checks and before the UI uses them.
+        graph.add("update", {"maintenance", "updateCheck"}, [inputs, installing]() {
+            if (inputs->maintenance.isMaintenance) {
+                log::info("Maintenance mode active: {}", {}, inputs->maintenance.message);
+                // Maintenance notice is already shown; halt update without forcing exit
+                inputs->updateDone = true;
+                return;
+            }
+            if (!inputs->updatePayload.has_value()) {
+                inputs->updateDone = true;
+                return;
+            }
+            if (installing) {
+                auto status = lang::tr(lang::keys::update::category, lang::keys::update::startingUpdate, "Installing resources...");
+                bus::event::publish(event::LoadingStatusChangedEvent{.statusMessage = status});
+                log::info("Resource version missing; starting resource install pipeline");
+            }
+            try {
+                update::applyUpdate(*inputs->updatePayload);
+                inputs->updateDone = true;
+            } catch (const std::exception &e) {
+                inputs->recordFailure(installing ? "Auto-install failed: " : "Auto-update failed: ", e);
+                throw;
+            }
+        });
+
+        // News is published as soon as it arrives so the page is filled before it is shown.
+        graph.add("news", {"config"}, [inputs]() {
+            try {
+                std::optional<api::NewsResponse> newsResponse;
+                // A cached page is shown at once; if the server has a newer one, replace it.
+                auto onChanged = [](std::optional<api::NewsResponse> changed) {
+                    if (changed.has_value() && !changed->items.empty()) {
+                        bus::event::publish(event::NewsLoadedEvent{
+                            .items = event::makeShared(std::move(changed->items)),
+                            .hasMore = changed->hasMore});
+                    }
+                };
+                withHostFallback([&]() { newsResponse = fetchNews(inputs->config, NewsPreloadLimit, {}, "", onChanged); });
+                if (newsResponse.has_value() && !newsResponse->items.empty()) {
+                    bus::event::publish(event::NewsLoadedEvent{
+                        .items = event::makeShared(std::move(newsResponse->items)),
+                        .hasMore = newsResponse->hasMore});
+                    inputs->showNews = !isNewsDismissed();
+                } else {
+                    bus::event::publish(event::NewsLoadedEvent{});
+                }
+            } catch (const std::exception &e) {
+                log::warn("News preload failed: {}", {}, e.what());
+                bus::event::publish(event::NewsLoadFailedEvent{.reason = e.what()});
+                throw;
+            }
+        });
+
+        // Fetched now so the first launch does not wait for it; the result is cached in the client config.
+        graph.add("authPrefetch", {}, []() {
+            auth::validAndRefreshLogin();
+        });
+
+        // Runs whatever happened to its inputs: a failed update or news still lands on home.
+        // Every step is finished here, so a failure is reported once however many steps it took down.
+        // During maintenance the notice is already shown and no update is applied, so an updateCheck
+        // failure (the only one possible then) is not reported on top of it.
+        graph.add(
+            "page", {"update", "news"}, [inputs]() {
+                if (inputs->failure.has_value() && !inputs->maintenance.isMaintenance) {
+                    bus::event::publish(event::UpdateFailedEvent{.reason = *inputs->failure});
+                }
+                const auto page = inputs->updateDone && inputs->showNews ? ui::Page::news : ui::Page::home;
+                bus::event::publish(event::CurrentPageChangeEvent{.page = page});
+            },
+            StartupGraph::Policy::afterCompletion);
+
+        graph.run();
+
+        // Posters now live in the image cache; clear the copies older versions left in temp.
+        (void)bus::thread::submitBackground([]() { removeLegacyPosters(); });
+    }
+
+} // namespace neko::core::startup
@@ -0,0 +1,446 @@
+/**
+ * @file unzip.cpp
+ * @brief Parallel zip extraction over a memory-mapped archive
+ */
+
+#include <neko/log/nlog.hpp>
+#include <neko/schema/exception.hpp>
+
+#include "neko/bus/taskGroup.hpp"
+#include "neko/bus/threadBus.hpp"
+
+#include "neko/core/unzip.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace neko::core::unzip {
+
+    namespace {
+
+        constexpr neko::uint32 EndOfCentralDirectorySig = 0x06054b50;
+        constexpr neko::uint32 Zip64EndOfCentralDirectorySig = 0x06064b50;
+        constexpr neko::uint32 Zip64LocatorSig = 0x07064b50;
+        constexpr neko::uint32 CentralFileHeaderSig = 0x02014b50;
+        constexpr neko::uint32 LocalFileHeaderSig = 0x04034b50;
+
+        constexpr neko::uint16 MethodStored = 0;
+        constexpr neko::uint16 MethodDeflated = 8;
+        constexpr neko::uint16 FlagEncrypted = 0x0001;
+        constexpr neko::uint16 HostUnix = 3;
+
+        // Per-worker output buffer; also the largest slice handed to zlib at once.
+        constexpr std::size_t BufferSize = 256 * 1024;
+
+        struct Entry {
+            std::string name;
+            neko::uint64 localHeaderOffset = 0;
+            neko::uint64 compressedSize = 0;
+            neko::uint64 size = 0;
+            neko::uint32 crc = 0;
+            neko::uint16 method = 0;
+            neko::uint16 flags = 0;
+            neko::uint32 mode = 0; // Unix st_mode, 0 if the archive was not made on Unix
+            bool directory = false;
+        };
+
+        /**
+         * @brief Read-only mapping of the whole archive.
+         */
+        class MappedArchive {
+        private:
+            boost::interprocess::file_mapping mapping;
+            boost::interprocess::mapped_region region;
+
+        public:
+            explicit MappedArchive(const std::string &path) {
+                std::error_code ec;
+                const auto size = std::filesystem::file_size(path, ec);
+                if (ec) {
+                    throw ex::FileError("Cannot read archive " + path + ": " + ec.message());
+                }
+                if (size == 0) {
+                    throw ex::Parse("Archive is empty: " + path);
+                }
+                try {
+                    mapping = boost::interprocess::file_mapping(path.c_str(), boost::interprocess::read_only);
+                    region = boost::interprocess::mapped_region(mapping, boost::interprocess::read_only);
+                } catch (const boost::interprocess::interprocess_exception &e) {
+                    throw ex::FileError("Cannot map archive " + path + ": " + e.what());
+                }
+            }
+
+            const unsigned char *data() const noexcept {
+                return static_cast<const unsigned char *>(region.get_address());
+            }
+
+            std::size_t size() const noexcept {
+                return region.get_size();
+            }
+        };
+
+        /**
+         * @brief Bounds-checked little-endian field access.
+         */
+        class Reader {
+        private:
+            const unsigned char *bytes;
+            neko::uint64 length;
+
+            void require(neko::uint64 pos, neko::uint64 count) const {
+                if (pos > length || count > length - pos) {
+                    throw ex::Parse("Truncated zip archive");
+                }
+            }
+
+        public:
+            Reader(const unsigned char *bytes, neko::uint64 length)
+                : bytes(bytes), length(length) {}
+
+            neko::uint64 size() const noexcept {
+                return length;
+            }
+
+            template <typename T>
+            T read(neko::uint64 pos) const {
+                require(pos, sizeof(T));
+                T value = 0;
+                for (std::size_t i = 0; i < sizeof(T); ++i) {
+                    value |= static_cast<T>(static_cast<T>(bytes[pos + i]) << (8 * i));
+                }
+                return value;
+            }
+
+            std::string string(neko::uint64 pos, neko::uint64 count) const {
+                require(pos, count);
+                return std::string(reinterpret_cast<const char *>(bytes + pos), static_cast<std::size_t>(count));
+            }
+
+            const unsigned char *span(neko::uint64 pos, neko::uint64 count) const {
+                require(pos, count);
+                return bytes + pos;
+            }
+        };
+
+        std::vector<Entry> readCentralDirectory(const Reader &reader) {
+            constexpr neko::uint64 EndRecordSize = 22;
+            if (reader.size() < EndRecordSize) {
+                throw ex::Parse("Not a zip archive");
+            }
+            // The end record sits before a comment of at most 64 KiB.
+            neko::uint64 endPos = reader.size() - EndRecordSize;
+            const neko::uint64 lowest = endPos > 0xFFFF ? endPos - 0xFFFF : 0;
+            while (reader.read<neko::uint32>(endPos) != EndOfCentralDirectorySig) {
+                if (endPos == lowest) {
+                    throw ex::Parse("Not a zip archive");
+                }
+                --endPos;
+            }
+
+            neko::uint64 count = reader.read<neko::uint16>(endPos + 10);
+            neko::uint64 directoryOffset = reader.read<neko::uint32>(endPos + 16);
+            if (count == 0xFFFF || directoryOffset == 0xFFFFFFFF) {
+                if (endPos < 20 || reader.read<neko::uint32>(endPos - 20) != Zip64LocatorSig) {
+                    throw ex::Parse("Zip64 locator missing");
+                }
+                const auto zip64End = reader.read<neko::uint64>(endPos - 20 + 8);
+                if (reader.read<neko::uint32>(zip64End) != Zip64EndOfCentralDirectorySig) {
+                    throw ex::Parse("Zip64 end record missing");
+                }
+                count = reader.read<neko::uint64>(zip64End + 32);
+                directoryOffset = reader.read<neko::uint64>(zip64End + 48);
+            }
+
+            std::vector<Entry> entries;
+            entries.reserve(static_cast<std::size_t>(std::min<neko::uint64>(count, reader.size() / 46)));
+            neko::uint64 pos = directoryOffset;
+            for (neko::uint64 i = 0; i < count; ++i) {
+                if (reader.read<neko::uint32>(pos) != CentralFileHeaderSig) {
+                    throw ex::Parse("Corrupt zip central directory");
+                }
+                Entry entry;
+                const auto madeBy = reader.read<neko::uint16>(pos + 4);
+                entry.flags = reader.read<neko::uint16>(pos + 8);
+                entry.method = reader.read<neko::uint16>(pos + 10);
+                entry.crc = reader.read<neko::uint32>(pos + 16);
+                entry.compressedSize = reader.read<neko::uint32>(pos + 20);
+                entry.size = reader.read<neko::uint32>(pos + 24);
+                const auto nameLength = reader.read<neko::uint16>(pos + 28);
+                const auto extraLength = reader.read<neko::uint16>(pos + 30);
+                const auto commentLength = reader.read<neko::uint16>(pos + 32);
+                const auto externalAttributes = reader.read<neko::uint32>(pos + 38);
+                entry.localHeaderOffset = reader.read<neko::uint32>(pos + 42);
+                entry.name = reader.string(pos + 46, nameLength);
+
+                // Zip64 extra field: only the fields saturated in the header are present, in this order.
+                neko::uint64 extra = pos + 46 + nameLength;
+                const neko::uint64 extraEnd = extra + extraLength;
+                while (extra + 4 <= extraEnd) {
+                    const auto id = reader.read<neko::uint16>(extra);
+                    const auto length = reader.read<neko::uint16>(extra + 2);
+                    if (id == 0x0001) {
+                        neko::uint64 field = extra + 4;
+                        if (entry.size == 0xFFFFFFFF) {
+                            entry.size = reader.read<neko::uint64>(field);
+                            field += 8;
+                        }
+                        if (entry.compressedSize == 0xFFFFFFFF) {
+                            entry.compressedSize = reader.read<neko::uint64>(field);
+                            field += 8;
+                        }
+                        if (entry.localHeaderOffset == 0xFFFFFFFF) {
+                            entry.localHeaderOffset = reader.read<neko::uint64>(field);
+                        }
+                    }
+                    extra += 4 + length;
+                }
+
+                if ((madeBy >> 8) == HostUnix) {
+                    entry.mode = externalAttributes >> 16;
+                }
+                entry.directory = !entry.name.empty() && (entry.name.back() == '/' || entry.name.back() == '\\');
+                entries.push_back(std::move(entry));
+                pos = extraEnd + commentLength;
+            }
+            return entries;
+        }
+
+        bool isSymlink(const Entry &entry) {
+            return (entry.mode & 0170000) == 0120000;
+        }
+
+        bool isSupportedEntry(const Entry &entry) {
+            return !(entry.flags & FlagEncrypted) &&
+                   (entry.method == MethodStored || entry.method == MethodDeflated) &&
+                   !isSymlink(entry);
+        }
+
+        /**
+         * @brief Where an entry goes under `destDir`.
+         * @throws ex::ArgumentError for absolute paths or paths escaping `destDir`
+         */
+        std::filesystem::path resolvePath(const std::filesystem::path &destDir, const std::string &name) {
+            std::string normalized = name;
+            std::replace(normalized.begin(), normalized.end(), '\\', '/');
+            const auto relative = std::filesystem::path(normalized).lexically_normal();
+            bool unsafe = normalized.empty() || normalized.front() == '/' || relative.has_root_name() || relative.has_root_directory();
+            for (const auto &part : relative) {
+                unsafe = unsafe || part == "..";
+            }
+            if (unsafe) {
+                throw ex::ArgumentError("Unsafe path in zip archive: " + name);
+            }
+            return destDir / relative;
+        }
+
+        neko::uint64 dataOffset(const Reader &reader, const Entry &entry) {
+            const auto header = entry.localHeaderOffset;
+            if (reader.read<neko::uint32>(header) != LocalFileHeaderSig) {
+                throw ex::Parse("Corrupt zip local header: " + entry.name);
+            }
+            return header + 30 + reader.read<neko::uint16>(header + 26) + reader.read<neko::uint16>(header + 28);
+        }
+
+        /**
+         * @brief One extraction thread's state, reused for every entry it handles.
+         */
+        class Worker {
+        private:
+            z_stream stream{};
+            std::vector<char> buffer;
+
+        public:
+            Worker()
+                : buffer(BufferSize) {
+                if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+                    throw ex::FileError("Cannot create inflate stream");
+                }
+            }
+
+            ~Worker() {
+                inflateEnd(&stream);
+            }
+
+            Worker(const Worker &) = delete;
+            Worker &operator=(const Worker &) = delete;
+
+            template <typename OnBlock>
+            void extract(const Reader &reader, const Entry &entry, const std::filesystem::path &target, OnBlock &&onBlock) {
+                const auto offset = dataOffset(reader, entry);
+                const unsigned char *source = reader.span(offset, entry.compressedSize);
+
+                std::ofstream out(target, std::ios::binary | std::ios::trunc);
+                if (!out.is_open()) {
+                    throw ex::FileError("Cannot create " + target.string());
+                }
+                try {
+                    uLong crc = crc32(0, nullptr, 0);
+                    neko::uint64 written = 0;
+                    auto emit = [&](const char *data, std::size_t length) {
+                        crc = crc32(crc, reinterpret_cast<const Bytef *>(data), static_cast<uInt>(length));
+                        if (!out.write(data, static_cast<std::streamsize>(length))) {
+                            throw ex::FileError("Cannot write " + target.string());
+                        }
+                        written += length;
+                        onBlock(length);
+                    };
+
+                    if (entry.method == MethodStored) {
+                        for (neko::uint64 pos = 0; pos < entry.compressedSize; pos += BufferSize) {
+                            const auto length = static_cast<std::size_t>(std::min<neko::uint64>(BufferSize, entry.compressedSize - pos));
+                            emit(reinterpret_cast<const char *>(source + pos), length);
+                        }
+                    } else {
+                        inflateReset(&stream);
+                        neko::uint64 consumed = 0;
+                        int rc = Z_OK;
+                        while (rc != Z_STREAM_END) {
+                            if (stream.avail_in == 0 && consumed < entry.compressedSize) {
+                                const auto length = std::min<neko::uint64>(BufferSize, entry.compressedSize - consumed);
+                                stream.next_in = const_cast<Bytef *>(source + consumed);
+                                stream.avail_in = static_cast<uInt>(length);
+                                consumed += length;
+                            }
+                            stream.next_out = reinterpret_cast<Bytef *>(buffer.data());
+                            stream.avail_out = static_cast<uInt>(buffer.size());
+                            rc = inflate(&stream, Z_NO_FLUSH);
+                            if (rc != Z_OK && rc != Z_STREAM_END) {
+                                throw ex::Parse("Corrupt zip entry " + entry.name + ": " + (stream.msg ? stream.msg : "truncated data"));
+                            }
+                            emit(buffer.data(), buffer.size() - stream.avail_out);
+                        }
+                        stream.avail_in = 0;
+                    }
+
+                    out.flush();
+                    if (!out) {
+                        throw ex::FileError("Cannot write " + target.string());
+                    }
+                    if (written != entry.size || crc != entry.crc) {
+                        throw ex::Parse("CRC mismatch for zip entry " + entry.name);
+                    }
+                } catch (...) {
+                    out.close();
+                    std::error_code ec;
+                    std::filesystem::remove(target, ec);
+                    throw;
+                }
+                out.close();
+
+                if (const auto permissions = entry.mode & 0777; permissions != 0) {
+                    std::error_code ec;
+                    std::filesystem::permissions(target, static_cast<std::filesystem::perms>(permissions), std::filesystem::perm_options::replace, ec);
+                }
+            }
+        };
+
+    } // namespace
+
+    bool isSupported(const std::string &archivePath) noexcept {
+        try {
+            const MappedArchive archive(archivePath);
+            const Reader reader(archive.data(), archive.size());
+            const auto entries = readCentralDirectory(reader);
+            return std::all_of(entries.begin(), entries.end(), isSupportedEntry);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    ExtractResult extract(const std::string &archivePath, const std::string &destDir, const ExtractOptions &options) {
+        const MappedArchive archive(archivePath);
+        const Reader reader(archive.data(), archive.size());
+        const auto entries = readCentralDirectory(reader);
+
+        // Resolve and validate every entry before writing anything.
+        const std::filesystem::path dest(destDir);
+        std::vector<std::filesystem::path> targets;
+        std::set<std::filesystem::path> seen;
+        targets.reserve(entries.size());
+        for (const auto &entry : entries) {
+            if (!isSupportedEntry(entry)) {
+                throw ex::ArgumentError("Unsupported zip entry " + entry.name + " in " + archivePath);
+            }
+            targets.push_back(resolvePath(dest, entry.name));
+            // Two workers would write the same file at once, and which copy wins would be arbitrary.
+            if (!seen.insert(targets.back()).second) {
+                throw ex::ArgumentError("Duplicate zip entry " + entry.name + " in " + archivePath);
+            }
+        }
+
+        // Directories are created up front, so workers only ever create files.
+        std::vector<std::size_t> files;
+        neko::uint64 totalBytes = 0;
+        std::error_code ec;
+        std::filesystem::create_directories(dest, ec);
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            const auto &directory = entries[i].directory ? targets[i] : targets[i].parent_path();
+            std::filesystem::create_directories(directory, ec);
+            if (ec) {
+                throw ex::FileError("Cannot create directory " + directory.string() + ": " + ec.message());
+            }
+            if (entries[i].directory || (!options.overwrite && std::filesystem::exists(targets[i], ec))) {
+                continue;
+            }
+            files.push_back(i);
+            totalBytes += entries[i].size;
+        }
+        // Largest first, so one big entry does not start last and leave the other workers idle.
+        std::sort(files.begin(), files.end(), [&entries](std::size_t a, std::size_t b) {
+            return entries[a].size > entries[b].size;
+        });
+
+        std::atomic<std::size_t> next{0};
+        std::atomic<neko::uint64> doneBytes{0};
+
+        // Each task keeps one inflate stream and takes entries until none are left. The group is
+        // fail-fast: the first error cancels its token and the other tasks stop at their next block.
+        auto run = [&](const bus::thread::CancellationToken &token) {
+            Worker worker;
+            auto onBlock = [&](std::size_t length) {
+                const auto done = doneBytes.fetch_add(length) + length;
+                if (options.onProgress) {
+                    options.onProgress(done, totalBytes);
+                }
+                token.throwIfCancelled();
+                if (options.isCancelled && options.isCancelled()) {
+                    throw ex::Runtime("Extraction cancelled: " + archivePath);
+                }
+            };
+            while (!token.isCancelled()) {
+                const auto index = next.fetch_add(1);
+                if (index >= files.size()) {
+                    break;
+                }
+                worker.extract(reader, entries[files[index]], targets[files[index]], onBlock);
+            }
+        };
+
+        std::size_t threads = options.threads != 0 ? options.threads : bus::thread::getThreadCount();
+        threads = std::max<std::size_t>(1, std::min(threads, files.size()));
+        {
+            bus::thread::TaskGroup group(bus::Executor::cpu, {}, bus::TaskClass::bulk);
+            for (std::size_t i = 0; i < threads; ++i) {
+                (void)group.spawn(run);
+            }
+            group.waitAll();
+            group.rethrowIfFailed();
+        }
+
+        log::debug("Extracted {} entries ({} bytes) from {} with {} tasks", {}, std::to_string(entries.size()),
+                   std::to_string(totalBytes), archivePath, std::to_string(threads));
+        return {entries.size(), totalBytes};
+    }
+
+} // namespace neko::core::unzip
@@ -24,6 +24,12 @@
 #include "neko/app/app.hpp"
 #include "neko/app/appinfo.hpp"
 #include "neko/core/update.hpp"
+#include "neko/core/chunkStore.hpp"
+#include "neko/core/deltaPatch.hpp"
+#include "neko/core/fileDigest.hpp"
+#include "neko/core/integrityIndex.hpp"
+#include "neko/core/releaseStore.hpp"
+#include "neko/core/unzip.hpp"
 #include "neko/core/remoteConfig.hpp"
 #include "neko/core/downloadPoster.hpp"
 #include "neko/core/launcherProcess.hpp"
@@ -32,6 +38,7 @@
 #include "neko/bus/configBus.hpp"
 #include "neko/bus/eventBus.hpp"
 #include "neko/bus/threadBus.hpp"
+#include "neko/bus/taskGroup.hpp"
 
 #include "neko/ui/uiMsg.hpp"
 
@@ -41,10 +48,16 @@
 
 // STL
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <mutex>
+#include <thread>
 
 #include <algorithm>
+#include <cctype>
+#include <map>
+#include <memory>
 #include <optional>
 
 #include <filesystem>
@@ -54,9 +67,80 @@
 
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <vector>
 
 namespace neko::core::update {
 
+    namespace {
+
+        // Whole-file downloads: attempts per file and the pause between them.
+        constexpr neko::uint32 DownloadAttempts = 3;
+        constexpr std::chrono::milliseconds DownloadRetryDelay{1000};
+        constexpr std::chrono::milliseconds CancelPollInterval{50};
+
+        /**
+         * @brief Moves staged trees into place and can undo those moves.
+         *
+         * A file that would be replaced is first renamed into `backupDir` (same filesystem, so both
+         * renames are cheap); rollback() removes the moved files and puts the replaced ones back,
+         * newest first. Directories created on the way are left in place.
+         */
+        class TreeMover {
+        private:
+            std::filesystem::path backupDir;
+            // Each moved file and, if it replaced one, where that one was kept; in move order.
+            std::vector<std::pair<std::filesystem::path, std::optional<std::filesystem::path>>> moved;
+
+        public:
+            explicit TreeMover(std::filesystem::path backupDir)
+                : backupDir(std::move(backupDir)) {}
+
+            /**
+             * @brief Move every file under `from` into `to`, replacing files that exist there.
+             * @throws std::filesystem::filesystem_error
+             */
+            void move(const std::filesystem::path &from, const std::filesystem::path &to) {
+                std::filesystem::create_directories(backupDir);
+                for (const auto &item : std::filesystem::recursive_directory_iterator(from)) {
+                    const auto target = to / item.path().lexically_relative(from);
+                    if (item.is_directory()) {
+                        std::filesystem::create_directories(target);
+                        continue;
+                    }
+                    std::filesystem::create_directories(target.parent_path());
+                    std::optional<std::filesystem::path> kept;
+                    if (std::filesystem::exists(target)) {
+                        kept = backupDir / std::to_string(moved.size());
+                        std::filesystem::rename(target, *kept);
+                    }
+                    // Recorded before the move, so a failed rename still gets its replaced file back.
+                    moved.emplace_back(target, kept);
+                    std::filesystem::rename(item.path(), target);
+                }
+            }
+
+            /**
+             * @brief Undo every move; failures are logged and the remaining moves still undone.
+             */
+            void rollback() noexcept {
+                for (auto it = moved.rbegin(); it != moved.rend(); ++it) {
+                    const auto &[target, kept] = *it;
+                    std::error_code ec;
+                    std::filesystem::remove(target, ec);
+                    if (kept) {
+                        std::filesystem::rename(*kept, target, ec);
+                    }
+                    if (ec) {
+                        log::error("Cannot restore {} after a failed update: {}", {}, target.string(), ec.message());
+                    }
+                }
+                moved.clear();
+            }
+        };
+
+    } // namespace
+
     /**
      * @brief Check for updates from the update server.
      * @return Optional JSON payload containing update info when available. nullopt if no update is available.
@@ -151,6 +235,15 @@ namespace neko::core::update {
                     .isCoreFile = meta.value("isCoreFile", false),
                     .isAbsoluteUrl = meta.value("isAbsoluteUrl", true)};
 
+                if (const auto patchesIt = it.find("patches"); patchesIt != it.end() && patchesIt->is_array()) {
+                    file.patches = patchesIt->get<std::vector<api::UpdateResponse::Patch>>();
+                }
+
+                file.chunked = meta.value("chunked", false);
+                if (const auto chunksIt = it.find("chunks"); chunksIt != it.end() && chunksIt->is_object()) {
+                    file.chunks = chunksIt->get<api::UpdateResponse::ChunkManifest>();
+                }
+
                 updateInfo.files.push_back(std::move(file));
             }
             if (!updateInfo.files.empty()) {
@@ -197,52 +290,152 @@ namespace neko::core::update {
         std::string infoMsg = "Update available: " + data.title + " - " + data.description + " , resource version: " + data.resourceVersion;
         log::info(infoMsg);
 
+        // Installed copies that patches apply to; core files are downloaded to temp and staged as a release.
+        std::vector<std::string> basePaths;
+        basePaths.reserve(data.files.size());
+        const std::string localVersion = app::getResourceVersion();
+
         // Prepare file URLs and paths
         for (auto &it : data.files) {
+            basePaths.push_back(system::workPath() + "/" + it.fileName);
             it.fileName = (it.isCoreFile ? system::tempFolder() : system::workPath()) + "/" + it.fileName;
 
             if (!it.isAbsoluteUrl) {
                 it.url = network::buildUrl(it.url);
             }
+            if (it.chunked && !it.chunks.isAbsoluteUrl && !it.chunks.baseUrl.empty()) {
+                it.chunks.baseUrl = network::buildUrl(it.chunks.baseUrl);
+            }
         }
 
+        // Chunks downloaded so far survive an interrupted update, so a retry only fetches the rest.
+        // One store per chunk hash algorithm; created on first use.
+        std::mutex chunkStoresMutex;
+        std::map<std::string, std::unique_ptr<chunk::ChunkStore>> chunkStores;
+        auto chunkStoreFor = [&](const std::string &hashAlgorithm) -> chunk::ChunkStore & {
+            if (hashAlgorithm.empty() || !std::all_of(hashAlgorithm.begin(), hashAlgorithm.end(), [](unsigned char c) { return std::isalnum(c) != 0; })) {
+                throw ex::ArgumentError("Invalid chunk hash algorithm: " + hashAlgorithm);
+            }
+            std::lock_guard lock(chunkStoresMutex);
+            auto &store = chunkStores[hashAlgorithm];
+            if (!store) {
+                const auto algorithm = util::hash::mapAlgorithm(hashAlgorithm);
+                store = std::make_unique<chunk::ChunkStore>(
+                    app::getCacheFolder() + "/chunks/" + hashAlgorithm,
+                    [algorithm](std::string_view bytes) { return util::hash::digest(std::string(bytes), algorithm); });
+            }
+            return *store;
+        };
+
         struct ResultData {
             neko::State state;
             api::UpdateResponse::File fileInfo;
             std::string failureReason;
+            bool verified = false; // checksum already matched (patched files)
         };
 
-        std::vector<std::future<ResultData>> futures;
         std::atomic<int> progress(0);
-        std::atomic<bool> shouldStop(false);
 
-        auto extractArchive = [](const std::string &filePath) -> std::optional<std::string> {
-            if (!archive::isArchiveFile(filePath)) {
-                return std::nullopt;
+        // Each file moves through download -> verify -> extract on its own; progress counts verified
+        // files plus extracted archives, and the status line shows every stage.
+        const auto fileCount = static_cast<neko::uint32>(data.files.size());
+        const auto archiveCount = static_cast<neko::uint32>(std::count_if(data.files.begin(), data.files.end(), [](const auto &file) {
+            return archive::isArchiveFile(file.fileName);
+        }));
+        std::atomic<neko::uint32> downloaded(0), verified(0), extracted(0);
+        auto reportStages = [&]() {
+            bus::event::publishCoalesced(event::LoadingStatusChangedEvent{
+                .statusMessage = lang::trWithReplaced(lang::keys::update::category, lang::keys::update::updateStages,
+                                                      {{"{downloaded}", std::to_string(downloaded.load())},
+                                                       {"{verified}", std::to_string(verified.load())},
+                                                       {"{extracted}", std::to_string(extracted.load())},
+                                                       {"{files}", std::to_string(fileCount)},
+                                                       {"{archives}", std::to_string(archiveCount)}})});
+        };
+        auto completeStage = [&](std::atomic<neko::uint32> &stage) {
+            ++stage;
+            if (&stage != &downloaded) {
+                int currentProgress = ++progress;
+                bus::event::publishCoalesced(event::LoadingValueChangedEvent{.progressValue = static_cast<neko::uint32>(currentProgress)});
             }
+            reportStages();
+        };
+
+        // Observed by every download/verify task; cancelled by the loading page or by the first failure.
+        bus::thread::ForegroundOperation operation;
+        const auto &token = operation.getToken();
+        // Polled between hashed blocks and download attempts, so a cancel does not wait for a whole file.
+        const std::function<bool()> isCancelled = [&token]() { return token.isCancelled(); };
+
+        // Digests of local files by (path, size, mtime): a file that already matches its checksum is
+        // recognised without hashing it again and never hits the network.
+        IntegrityIndex integrity(app::getCacheFolder() + "/integrity.json", [&isCancelled](const std::string &path, const std::string &algorithm) {
+            return digest::digestFile(path, algorithm, isCancelled);
+        });
+        std::atomic<neko::uint32> unchangedFiles(0);
+        std::atomic<neko::uint64> bytesFetched(0), bytesSaved(0);
+        // Core files whose installed copy already matches; the updater leaves them alone.
+        std::vector<char> installedCurrent(data.files.size(), 0);
+        auto sizeOf = [](const std::string &path) -> neko::uint64 {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(path, ec);
+            return ec ? 0 : size;
+        };
+        auto addTransfer = [&](neko::uint64 fileBytes, neko::uint64 fetched) {
+            bytesFetched += fetched;
+            bytesSaved += fileBytes > fetched ? fileBytes - fetched : 0;
+        };
+
+        // Archives are extracted here as soon as they verify and moved into the work path once every
+        // file has succeeded; if moving one fails, the moves already made are undone, so a failed
+        // update never leaves half of its archives applied.
+        const std::string stagingPath = system::workPath() + "/.update-staging";
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(stagingPath, ec);
+        }
+
+        bus::event::publish(event::ShowLoadingEvent(ui::LoadingMsg{
+            .type = ui::LoadingMsg::Type::Progress,
+            .process = lang::tr(lang::keys::update::category, lang::keys::update::startingUpdate),
+            .progressVal = 0,
+            .progressMax = fileCount + archiveCount,
+            .cancellable = true}));
 
-            archive::ExtractConfig cfg{
-                .inputArchivePath = filePath,
-                .destDir = system::workPath(),
-                .overwrite = true};
+        // Lambda: Extraction into the staging folder; entries are inflated in parallel when possible.
+        auto extractTask = [&](neko::uint64 id, const api::UpdateResponse::File &info) -> ResultData {
+            if (!archive::isArchiveFile(info.fileName)) {
+                return {neko::types::State::Completed, info, ""};
+            }
+            if (installedCurrent[id]) {
+                completeStage(extracted);
+                return {neko::types::State::Completed, info, ""};
+            }
+            if (token.isCancelled())
+                return {neko::types::State::Failed, info, "Update aborted: " + token.getReason()};
 
+            const std::string destDir = stagingPath + "/" + std::to_string(id);
             try {
-                if (archive::zip::isZipArchiveFile(filePath)) {
-                    archive::zip::extract(cfg);
-                    return std::nullopt;
+                if (unzip::isSupported(info.fileName)) {
+                    // Runs its inflate tasks on the cpu executor and waits for them here, on the io thread.
+                    auto result = unzip::extract(info.fileName, destDir, {.isCancelled = isCancelled});
+                    log::info("Extracted {} entries ({} bytes) from {}", {}, std::to_string(result.entries), std::to_string(result.bytes), info.fileName);
+                } else if (archive::zip::isZipArchiveFile(info.fileName)) {
+                    archive::zip::extract({.inputArchivePath = info.fileName, .destDir = destDir, .overwrite = true});
+                } else {
+                    return {neko::types::State::Failed, info, "Unsupported archive format for " + info.fileName};
                 }
-                return std::string{"Unsupported archive format for "} + filePath;
-            } catch (const ex::Exception &e) {
-                return std::string{"Extract failed for "} + filePath + ": " + e.what();
             } catch (const std::exception &e) {
-                return std::string{"Extract failed for "} + filePath + ": " + e.what();
+                return {neko::types::State::Failed, info, std::string{"Extract failed for "} + info.fileName + ": " + e.what()};
             }
+            completeStage(extracted);
+            return {neko::types::State::Completed, info, ""};
         };
 
         // Lambda: Download task
-        auto downloadTask = [&shouldStop](neko::uint64 id, const api::UpdateResponse::File &info) -> ResultData {
-            if (shouldStop.load(std::memory_order_acquire))
-                return {neko::types::State::Failed, info, "Update aborted"};
+        auto downloadTask = [&](neko::uint64 id, const api::UpdateResponse::File &info) -> ResultData {
+            if (token.isCancelled())
+                return {neko::types::State::Failed, info, "Update aborted: " + token.getReason()};
 
             network::Network net;
             network::RequestConfig reqConfig{
@@ -255,7 +448,26 @@ namespace neko::core::update {
                 if (!net.multiThreadedDownload(network::MultiDownloadConfig(reqConfig)))
                     return {neko::types::State::RetryRequired, info, "Multi-threaded download failed"};
             } else {
-                auto result = net.executeWithRetry({reqConfig});
+                // Attempts run one at a time instead of through executeWithRetry, so a cancel is honoured
+                // between them and during the wait before a retry.
+                network::Result result;
+                for (neko::uint32 attempt = 0; attempt < DownloadAttempts; ++attempt) {
+                    for (auto waited = std::chrono::milliseconds(0); attempt > 0 && waited < DownloadRetryDelay && !token.isCancelled(); waited += CancelPollInterval) {
+                        std::this_thread::sleep_for(CancelPollInterval);
+                    }
+                    if (token.isCancelled()) {
+                        break;
+                    }
+                    result = net.execute(reqConfig);
+                    if (result.isSuccess()) {
+                        break;
+                    }
+                }
+                if (token.isCancelled()) {
+                    std::error_code ec;
+                    std::filesystem::remove(info.fileName, ec);
+                    return {neko::types::State::Failed, info, "Update aborted: " + token.getReason()};
+                }
                 if (!result.isSuccess()) {
                     std::string err = "Download failed for file: " + info.fileName +
                                       ", status code: " + std::to_string(result.statusCode) +
@@ -263,20 +475,28 @@ namespace neko::core::update {
                     return {neko::types::State::RetryRequired, info, err};
                 }
             }
+            completeStage(downloaded);
             return {neko::types::State::Completed, info, ""};
         };
 
         // Lambda: Hash verification
-        auto verifyHash = [&progress](const api::UpdateResponse::File &info) -> ResultData {
-            auto hash = util::hash::digestFile(info.fileName, util::hash::mapAlgorithm(info.hashAlgorithm));
+        auto verifyHash = [&](const api::UpdateResponse::File &info) -> ResultData {
+            if (token.isCancelled())
+                return {neko::types::State::Failed, info, "Update aborted: " + token.getReason()};
+
+            std::string hash;
+            try {
+                hash = digest::digestFile(info.fileName, info.hashAlgorithm, isCancelled);
+            } catch (const ex::Exception &e) {
+                if (token.isCancelled())
+                    return {neko::types::State::Failed, info, "Update aborted: " + token.getReason()};
+                return {neko::types::State::Failed, info, std::string("Cannot hash ") + info.fileName + ": " + e.what()};
+            }
 
             if (hash == info.checksum) {
                 std::string infoMsg = "Hash verification passed: " + info.fileName;
                 log::info(infoMsg);
-
-                int currentProgress = ++progress;
-                bus::event::publish(event::LoadingValueChangedEvent{.progressValue = static_cast<neko::uint32>(currentProgress)});
-
+                completeStage(verified);
                 return {neko::types::State::Completed, info, ""};
             }
 
@@ -287,31 +507,245 @@ namespace neko::core::update {
             return {neko::types::State::Failed, info, err};
         };
 
-        // Lambda: Combined task
-        auto processFile = [&](neko::uint64 i, const api::UpdateResponse::File &info) -> ResultData {
-            if (shouldStop.load(std::memory_order_acquire))
-                return {neko::types::State::Failed, info, "Update aborted"};
+        // Lambda: Patch selection; hashes the installed copy, empty if it is missing
+        auto selectPatch = [&localVersion, &isCancelled](const api::UpdateResponse::File &info, const std::string &basePath) {
+            return delta::selectPatch(info, localVersion, [&basePath, &isCancelled](const std::string &algorithm) -> std::string {
+                std::error_code ec;
+                if (!std::filesystem::is_regular_file(basePath, ec)) {
+                    return {};
+                }
+                return digest::digestFile(basePath, algorithm, isCancelled);
+            });
+        };
+
+        // Lambda: Patch download; nullopt on failure
+        auto downloadPatch = [](neko::uint64 id, const api::UpdateResponse::File &info, const api::UpdateResponse::Patch &patch) -> std::optional<std::string> {
+            std::string patchPath = info.fileName + ".patch-" + util::random::generateRandomString(6);
+            network::Network net;
+            network::RequestConfig reqConfig{
+                .url = patch.isAbsoluteUrl ? patch.url : network::buildUrl(patch.url),
+                .method = network::RequestType::DownloadFile,
+                .requestId = "update-patch-" + std::to_string(id) + "-" + util::random::generateRandomString(6),
+                .fileName = patchPath};
+            auto result = net.executeWithRetry({reqConfig});
+            if (!result.isSuccess()) {
+                log::warn("Patch download failed for {}: {}", {}, info.fileName, result.errorMessage);
+                std::error_code ec;
+                std::filesystem::remove(patchPath, ec);
+                return std::nullopt;
+            }
+            return patchPath;
+        };
+
+        // Lambda: Patch application and verification; false means the whole file has to be downloaded
+        auto applyPatch = [&isCancelled](const api::UpdateResponse::File &info, const api::UpdateResponse::Patch &patch, const std::string &basePath, const std::string &patchPath) -> bool {
+            const std::string outPath = info.fileName + ".new-" + util::random::generateRandomString(6);
+            std::error_code ec;
+            bool applied = false;
+            try {
+                delta::applyPatch(delta::parseFormat(patch.format), basePath, patchPath, outPath);
+                auto hash = digest::digestFile(outPath, info.hashAlgorithm, isCancelled);
+                if (hash == info.checksum) {
+                    std::filesystem::rename(outPath, info.fileName, ec);
+                    applied = !ec;
+                } else {
+                    log::warn("Patched file hash mismatch for {}, expected: {}, actual: {}", {}, info.fileName, info.checksum, hash);
+                }
+            } catch (const std::exception &e) {
+                log::warn("Patch failed for {}: {}", {}, info.fileName, e.what());
+            }
+            std::filesystem::remove(patchPath, ec);
+            if (!applied) {
+                std::filesystem::remove(outPath, ec);
+            }
+            return applied;
+        };
+
+        // Lambda: Local check; the path of a copy (download target, then installed file) that already matches
+        auto findUnchanged = [&](neko::uint64 id, const api::UpdateResponse::File &info) -> std::optional<std::string> {
+            std::vector<std::string> candidates{info.fileName};
+            if (basePaths[id] != info.fileName) {
+                candidates.push_back(basePaths[id]);
+            }
+            for (const auto &path : candidates) {
+                if (integrity.digest(path, info.hashAlgorithm) == info.checksum) {
+                    return path;
+                }
+            }
+            return std::nullopt;
+        };
+
+        // Lambda: Chunked download; reuses chunks of the installed copy and of earlier attempts.
+        // Returns the bytes fetched, nullopt if the whole file has to be downloaded.
+        auto assembleChunks = [&](neko::uint64 id, const api::UpdateResponse::File &info) -> std::optional<neko::uint64> {
+            const auto &manifest = info.chunks;
+            std::vector<chunk::ChunkRef> chunks;
+            chunks.reserve(manifest.list.size());
+            for (const auto &it : manifest.list) {
+                chunks.push_back({it.hash, it.size});
+            }
+
+            const std::string outPath = info.fileName + ".new-" + util::random::generateRandomString(6);
+            try {
+                auto &store = chunkStoreFor(manifest.hashAlgorithm);
+                // Only a manifest cut by our chunker can match chunks of local files.
+                if (manifest.algorithm == chunk::GearV1) {
+                    const chunk::ChunkParams params{manifest.minSize, manifest.avgSize, manifest.maxSize};
+                    store.seed(basePaths[id], params);
+                    // Content moves between files, so every installed file cut the same way seeds too; each is read once.
+                    for (neko::uint64 other = 0; other < data.files.size(); ++other) {
+                        const auto &otherManifest = data.files[other].chunks;
+                        if (other != id && data.files[other].chunked && otherManifest.algorithm == chunk::GearV1 &&
+                            otherManifest.hashAlgorithm == manifest.hashAlgorithm && otherManifest.minSize == manifest.minSize &&
+                            otherManifest.avgSize == manifest.avgSize && otherManifest.maxSize == manifest.maxSize) {
+                            store.seed(basePaths[other], params);
+                        }
+                    }
+                }
+
+                // Throws for a hash that is not hex, so the hashes below are safe in paths and URLs.
+                const auto missing = store.missing(chunks);
+                neko::uint64 fetchedBytes = 0;
+                for (const auto &it : missing) {
+                    if (token.isCancelled()) {
+                        return std::nullopt;
+                    }
+                    const auto partPath = store.downloadPath(it.hash);
+                    network::Network net;
+                    network::RequestConfig reqConfig{
+                        .url = manifest.baseUrl + "/" + it.hash,
+                        .method = network::RequestType::DownloadFile,
+                        .requestId = "update-chunk-" + std::to_string(id) + "-" + util::random::generateRandomString(6),
+                        .fileName = partPath};
+                    auto result = net.executeWithRetry({reqConfig});
+                    if (!result.isSuccess() || !store.adopt(it.hash, partPath)) {
+                        log::warn("Chunk download failed for {}: {}", {}, info.fileName, result.errorMessage);
+                        std::error_code ec;
+                        std::filesystem::remove(partPath, ec);
+                        return std::nullopt;
+                    }
+                    fetchedBytes += it.size;
+                }
+                log::info("Assembling {} from {} chunks, {} fetched ({} bytes)", {}, info.fileName,
+                          std::to_string(chunks.size()), std::to_string(missing.size()), std::to_string(fetchedBytes));
+
+                // A seeded chunk whose file changed meanwhile fails its hash check and throws here.
+                store.assemble(chunks, outPath);
+                auto hash = digest::digestFile(outPath, info.hashAlgorithm, isCancelled);
+                std::error_code ec;
+                if (hash != info.checksum) {
+                    log::warn("Assembled file hash mismatch for {}, expected: {}, actual: {}", {}, info.fileName, info.checksum, hash);
+                    std::filesystem::remove(outPath, ec);
+                    return std::nullopt;
+                }
+                std::filesystem::rename(outPath, info.fileName, ec);
+                if (ec) {
+                    std::filesystem::remove(outPath, ec);
+                    return std::nullopt;
+                }
+                return fetchedBytes;
+            } catch (const std::exception &e) {
+                log::warn("Chunked download failed for {}: {}", {}, info.fileName, e.what());
+                std::error_code ec;
+                std::filesystem::remove(outPath, ec);
+                return std::nullopt;
+            }
+        };
+
+        // Lambda: Download and verify, by patch, chunks or whole file
+        auto fetchFile = [&](neko::uint64 i, const api::UpdateResponse::File &info) -> ResultData {
+            if (token.isCancelled())
+                return {neko::types::State::Failed, info, "Update aborted: " + token.getReason()};
+
+            // Already up to date, e.g. unchanged by this release or fetched by an earlier, failed attempt.
+            if (auto local = findUnchanged(i, info)) {
+                installedCurrent[i] = *local != info.fileName;
+                ++unchangedFiles;
+                addTransfer(sizeOf(*local), 0);
+                log::info("Unchanged, not downloading: {}", {}, *local);
+                completeStage(downloaded);
+                completeStage(verified);
+                return {neko::types::State::Completed, info, "", true};
+            }
+
+            // Patch from the installed copy when possible; any failure falls through to the full download.
+            if (!info.patches.empty()) {
+                const auto &basePath = basePaths[i];
+                auto patch = selectPatch(info, basePath);
+                if (patch.has_value()) {
+                    if (auto patchPath = downloadPatch(i, info, *patch)) {
+                        if (token.isCancelled()) {
+                            std::error_code ec;
+                            std::filesystem::remove(*patchPath, ec);
+                            return {neko::types::State::Failed, info, "Update aborted: " + token.getReason()};
+                        }
+                        const auto patchBytes = sizeOf(*patchPath);
+                        if (applyPatch(info, *patch, basePath, *patchPath)) {
+                            addTransfer(sizeOf(info.fileName), patchBytes);
+                            log::info("Patched {} from resource version {} ({} byte patch)", {}, info.fileName, localVersion, std::to_string(patch->size));
+                            completeStage(downloaded);
+                            completeStage(verified);
+                            return {neko::types::State::Completed, info, "", true};
+                        }
+                    }
+                    log::info("Falling back to a full download of {}", {}, info.fileName);
+                }
+            }
+
+            if (info.chunked && !info.chunks.empty()) {
+                if (auto fetched = assembleChunks(i, info)) {
+                    addTransfer(sizeOf(info.fileName), *fetched);
+                    completeStage(downloaded);
+                    completeStage(verified);
+                    return {neko::types::State::Completed, info, "", true};
+                }
+                if (token.isCancelled())
+                    return {neko::types::State::Failed, info, "Update aborted: " + token.getReason()};
+                log::info("Falling back to a full download of {}", {}, info.fileName);
+            }
 
             auto downloadResult = downloadTask(i, info);
             if (downloadResult.state != neko::types::State::Completed)
                 return downloadResult;
 
-            return verifyHash(info);
+            auto verifyResult = verifyHash(info);
+            if (verifyResult.state == neko::types::State::Completed) {
+                bytesFetched += sizeOf(info.fileName);
+            }
+            return verifyResult;
         };
 
-        // Submit all tasks
+        // Lambda: Combined task; a verified archive is extracted while other files are still downloading.
+        // Hashing, patching and extraction run inline on this io task: blocking it on a cpu future could
+        // starve the pool once every io thread is waiting.
+        auto processFile = [&](neko::uint64 i, const api::UpdateResponse::File &info) -> ResultData {
+            auto result = fetchFile(i, info);
+            if (result.state != neko::types::State::Completed)
+                return result;
+            return extractTask(i, info);
+        };
+
+        // Submit all tasks; declared after the lambdas so the group drains before they go out of scope.
+        bus::thread::TaskGroup group(bus::Executor::io, token, bus::TaskClass::bulk);
+        std::vector<std::shared_future<ResultData>> futures;
         futures.reserve(data.files.size());
         for (size_t i = 0; i < data.files.size(); ++i) {
-            futures.push_back(bus::thread::submit(processFile, i, data.files[i]));
+            futures.push_back(group.spawn([&processFile, i, &info = data.files[i]]() { return processFile(i, info); }));
         }
 
-        // Collect results with early exit; drain remaining futures to avoid stray work
+        // Collect results with early exit; cancel the group so queued and in-flight work stops
         neko::types::State failureState = neko::types::State::Completed;
         std::string failureReason;
         for (auto &future : futures) {
-            auto result = future.get();
+            ResultData result;
+            try {
+                result = future.get();
+            } catch (const std::exception &e) {
+                // Skipped because the group was cancelled before the task started.
+                result = {neko::types::State::Failed, {}, e.what()};
+            }
             if (result.state != neko::types::State::Completed) {
-                shouldStop.store(true, std::memory_order_release);
+                group.cancelAll(result.failureReason.empty() ? "Update failed" : result.failureReason);
                 failureState = result.state;
                 failureReason = !result.failureReason.empty()
                                    ? result.failureReason
@@ -323,11 +757,11 @@ namespace neko::core::update {
         }
 
         if (failureState != neko::types::State::Completed) {
-            for (auto &future : futures) {
-                if (future.valid()) {
-                    future.wait();
-                }
-            }
+            group.waitAll();
+            integrity.save();
+            bus::event::flushCoalesced();
+            std::error_code ec;
+            std::filesystem::remove_all(stagingPath, ec);
 
             bus::event::publish(event::UpdateFailedEvent{.reason = failureReason});
             if (failureState == neko::types::State::RetryRequired) {
@@ -336,129 +770,184 @@ namespace neko::core::update {
             throw ex::Exception(failureReason);
         }
 
-        // Extract compressed archives into work path
-        for (const auto &file : data.files) {
-            if (!archive::isArchiveFile(file.fileName)) {
-                continue;
-            }
-            if (auto err = extractArchive(file.fileName)) {
-                bus::event::publish(event::UpdateFailedEvent{.reason = *err});
-                throw ex::FileError(*err);
+        integrity.save();
+        bus::event::flushCoalesced();
+
+        // Last point where a cancel is honoured; past here files are applied.
+        if (token.isCancelled()) {
+            std::error_code ec;
+            std::filesystem::remove_all(stagingPath, ec);
+            std::string reason = "Update cancelled: " + token.getReason();
+            bus::event::publish(event::UpdateFailedEvent{.reason = reason});
+            throw ex::Exception(reason);
+        }
+
+        // Move extracted archives into the work path, in file order so later archives win as before;
+        // core archives are part of the staged release instead.
+        bus::event::publish(event::LoadingStatusChangedEvent{.statusMessage = lang::tr(lang::keys::update::category, lang::keys::update::applyingUpdate)});
+        TreeMover mover(stagingPath + "/.replaced");
+        try {
+            for (size_t i = 0; i < data.files.size(); ++i) {
+                const std::filesystem::path staged = stagingPath + "/" + std::to_string(i);
+                if (data.files[i].isCoreFile || !std::filesystem::exists(staged)) {
+                    continue;
+                }
+                bus::thread::yieldPoint();
+                mover.move(staged, system::workPath());
+                log::info("Extracted archive during update: " + data.files[i].fileName + " -> " + system::workPath());
             }
-            log::info("Extracted archive during update: " + file.fileName + " -> " + system::workPath());
+        } catch (const std::filesystem::filesystem_error &e) {
+            std::string err = std::string("Failed to apply extracted files: ") + e.what();
+            mover.rollback();
+            std::error_code ec;
+            std::filesystem::remove_all(stagingPath, ec);
+            bus::event::publish(event::UpdateFailedEvent{.reason = err});
+            throw ex::FileError(err);
         }
 
         log::info("All files downloaded and verified successfully");
 
-        // Prepare update command
-        std::vector<std::string> coreFiles;
-        for (const auto &file : data.files) {
-            if (file.isCoreFile)
-                coreFiles.push_back(file.fileName);
+        const event::UpdateCompleteEvent summary{
+            .unchangedFiles = unchangedFiles.load(),
+            .bytesFetched = bytesFetched.load(),
+            .bytesSaved = bytesSaved.load()};
+        log::info("Update summary: {} of {} files unchanged, {} bytes downloaded, {} bytes saved, {} files hashed", {},
+                  std::to_string(summary.unchangedFiles), std::to_string(data.files.size()), std::to_string(summary.bytesFetched),
+                  std::to_string(summary.bytesSaved), std::to_string(integrity.getHashedCount()));
+
+        // The installed files seed the next update; chunks kept for resuming are no longer needed.
+        for (auto &[algorithm, store] : chunkStores) {
+            store->clear();
+        }
+
+        // Core files in use by the running launcher: an extracted core archive contributes its tree,
+        // any other core file lands next to the executable.
+        std::vector<std::pair<std::string, std::string>> coreFiles;
+        try {
+            for (size_t i = 0; i < data.files.size(); ++i) {
+                if (!data.files[i].isCoreFile || installedCurrent[i])
+                    continue;
+                const std::filesystem::path staged = stagingPath + "/" + std::to_string(i);
+                if (!archive::isArchiveFile(data.files[i].fileName)) {
+                    coreFiles.emplace_back(data.files[i].fileName, std::filesystem::path(data.files[i].fileName).filename().string());
+                    continue;
+                }
+                for (const auto &item : std::filesystem::recursive_directory_iterator(staged)) {
+                    if (item.is_regular_file()) {
+                        coreFiles.emplace_back(item.path().string(), item.path().lexically_relative(staged).generic_string());
+                    }
+                }
+            }
+        } catch (const std::filesystem::filesystem_error &e) {
+            std::string err = std::string("Failed to collect core files: ") + e.what();
+            std::error_code ec;
+            std::filesystem::remove_all(stagingPath, ec);
+            bus::event::publish(event::UpdateFailedEvent{.reason = err});
+            throw ex::FileError(err);
+        }
+
+        // Stage core files as a release next to the installed ones; the launcher keeps running and
+        // switches to it at the next start (see switchStagedRelease).
+        // A release whose core files are not staged is not installed; its version is not recorded.
+        bool coreStaged = true;
+        if (!coreFiles.empty()) {
+            ReleaseStore releases(system::workPath());
+            if (releases.isRejected(data.resourceVersion)) {
+                log::warn("Release {} was rolled back after a failed start; its core files are not staged again", {}, data.resourceVersion);
+                coreStaged = false;
+            } else {
+                try {
+                    releases.stage(data.resourceVersion, coreFiles, std::string(bus::config::getSnapshot()->main.resourceVersion));
+                    log::info("Core files of {} are staged and take effect at the next start", {}, data.resourceVersion);
+                } catch (const std::exception &e) {
+                    std::string err = std::string("Failed to stage core files: ") + e.what();
+                    log::error(err);
+                    std::error_code ec;
+                    std::filesystem::remove_all(stagingPath, ec);
+                    bus::event::publish(event::UpdateFailedEvent{.reason = err});
+                    throw ex::FileError(err);
+                }
+            }
+        }
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(stagingPath, ec);
         }
 
         // Save resource version
-        if (!data.resourceVersion.empty()) {
+        if (!coreStaged) {
+            log::warn("Resource version not saved: release {} is only partly installed", {}, data.resourceVersion);
+        } else if (!data.resourceVersion.empty()) {
             bus::config::updateClientConfig([&data](neko::ClientConfig &cfg) {
                 cfg.main.resourceVersion = data.resourceVersion.c_str();
             });
             std::string infoMsg = "Saved resource version: " + data.resourceVersion;
             log::info(infoMsg);
-            bus::config::save(app::getConfigFileName());
+            bus::config::saveAsync(app::getConfigFileName());
         }
 
-        // Execute update if core files need replacement
-        if (!coreFiles.empty()) {
-            try {
-                std::string updateExecPath = system::tempFolder() + "/update_" + util::random::generateRandomString(10);
+        bus::event::publish(summary);
+    }
 
-                std::filesystem::path updateSourcePath = system::workPath() + "/update";
-                if (!std::filesystem::exists(updateSourcePath)) {
-                    std::string err = "Update executable not found: " + updateSourcePath.string();
-                    bus::event::publish(event::UpdateFailedEvent{.reason = err});
-                    throw ex::FileError(err);
-                }
+    void applyUpdate(const std::string &payload) {
+        // Parse update data
+        std::string process = lang::tr(lang::keys::update::category, lang::keys::update::parsingUpdateData);
+        bus::event::publish(event::LoadingStatusChangedEvent{.statusMessage = process});
 
-                std::filesystem::create_directories(updateExecPath);
-                std::filesystem::copy(updateSourcePath,
-                                      updateExecPath + "/update",
-                                      std::filesystem::copy_options::overwrite_existing);
+        auto data = parseUpdate(payload);
+        if (data.empty()) {
+            std::string error = "Failed to parse update data";
+            bus::event::publish(event::UpdateFailedEvent{.reason = error});
+            throw ex::Exception(error);
+        }
 
-                std::string cmd = updateExecPath + "/update " + system::workPath();
-                for (const auto &file : coreFiles) {
-                    cmd += " " + file;
-                }
+        bus::event::publish(event::UpdateAvailableEvent{data});
 
-                std::string infoMsg = "Executing update command: " + cmd;
-                log::info(infoMsg);
+        // Perform update
+        update(std::move(data));
+    }
 
-                bus::event::publish(event::UpdateCompleteEvent{});
-                bus::event::publish(event::RestartRequestEvent{.reason = "Update applied", .command = cmd});
-                return;
-            } catch (const std::filesystem::filesystem_error &e) {
-                std::string error = std::string("Filesystem error: ") + e.what();
-                log::error(error);
-                bus::event::publish(event::UpdateFailedEvent{.reason = error});
-                throw ex::FileError(error);
+    bool switchStagedRelease() {
+        ReleaseStore releases(system::workPath());
+        try {
+            switch (releases.onStartup()) {
+                case ReleaseStore::StartAction::switched:
+                    log::info("Switched to staged release {}, restarting", {}, releases.getState().version);
+                    return true;
+                case ReleaseStore::StartAction::rolledBack:
+                    log::warn("Release {} failed its trial start and was rolled back, restarting", {}, releases.getState().rejected);
+                    return true;
+                default:
+                    return false;
             }
+        } catch (const ex::Exception &e) {
+            log::error("Cannot switch staged release: {}", {}, e.what());
+            return false;
         }
-
-        bus::event::publish(event::UpdateCompleteEvent{});
     }
 
-    /**
-     * @brief Perform the auto-update process.
-     * @note This function publishes events to the event bus and may quit the application if maintenance mode is active.
-     */
-    void autoUpdate() {
-        log::autoLog log;
-
+    void restoreRolledBackVersion() {
         try {
-            MaintenanceInfo maintenanceState = checkMaintenance();
-
-            if (maintenanceState.isMaintenance) {
-                std::string infoMsg = "Maintenance mode active: " + maintenanceState.message;
-                log::info(infoMsg);
-
-                // Maintenance notice is already shown; halt update without forcing exit
-                return;
-            }
-
-            // Notify progress
-            std::string process = lang::tr(lang::keys::update::category, lang::keys::update::checkingForUpdates);
-            bus::event::publish(event::LoadingStatusChangedEvent{.statusMessage = process});
-
-            // Check for updates
-            auto updatePayload = checkUpdate();
-            if (!updatePayload.has_value()) {
+            auto version = ReleaseStore(system::workPath()).takeRestoreVersion();
+            if (!version.has_value()) {
                 return;
             }
+            bus::config::updateClientConfig([&version](neko::ClientConfig &cfg) {
+                cfg.main.resourceVersion = version->c_str();
+            });
+            bus::config::save(app::getConfigFileName());
+            log::info("Restored resource version {} after a rollback", {}, *version);
+        } catch (const ex::Exception &e) {
+            log::error("Cannot restore resource version: {}", {}, e.what());
+        }
+    }
 
-            // Parse update data
-            process = lang::tr(lang::keys::update::category, lang::keys::update::parsingUpdateData);
-
-            auto data = parseUpdate(*updatePayload);
-            if (data.empty()) {
-                std::string error = "Failed to parse update data";
-                bus::event::publish(event::UpdateFailedEvent{.reason = error});
-                throw ex::Exception(error);
-            }
-
-            bus::event::publish(event::UpdateAvailableEvent{data});
-
-            // Perform update
-            update(std::move(data));
+    void confirmStartup() {
+        try {
+            ReleaseStore(system::workPath()).confirm();
         } catch (const ex::Exception &e) {
-            std::string reason = std::string("Auto-update failed: ") + e.what();
-            log::error(reason);
-            bus::event::publish(event::UpdateFailedEvent{.reason = reason});
-            throw;
-        } catch (const std::exception &e) {
-            std::string reason = std::string("Unexpected error during auto-update: ") + e.what();
-            log::error(reason);
-            bus::event::publish(event::UpdateFailedEvent{.reason = reason});
-            throw ex::Exception(reason);
+            log::error("Cannot confirm release: {}", {}, e.what());
         }
     }
 
-} // namespace neko::core::update
\ No newline at end of file
+} // namespace neko::core::update
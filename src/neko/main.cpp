@@ -12,10 +12,9 @@
 
 #include "neko/core/bgm.hpp"
 #include "neko/core/crashReporter.hpp"
-#include "neko/core/install.hpp"
+#include "neko/core/launcherProcess.hpp"
 #include "neko/core/logFileWatcher.hpp"
-#include "neko/core/news.hpp"
-#include "neko/core/remoteConfig.hpp"
+#include "neko/core/startup.hpp"
 #include "neko/core/update.hpp"
 
 #include "neko/ui/themeIO.hpp"
@@ -23,6 +22,7 @@
 #include "neko/ui/windows/logViewerWindow.hpp"
 #include "neko/ui/windows/nekoWindow.hpp"
 
+#include <QtCore/QTimer>
 #include <QtGui/QGuiApplication>
 #include <QtWidgets/QApplication>
 
@@ -71,85 +71,6 @@ namespace {
         bus::event::publish(event::ShowNoticeEvent(notice));
     }
 
-    /**
-     * @brief Execute post-network initialization tasks (auto-install, update, news).
-     */
-    void executePostNetworkTasks() {
-        bus::thread::submit([]() {
-            try {
-                const bool installed = core::install::autoInstall();
-                if (!installed) {
-                    core::update::autoUpdate();
-                }
-
-                // Preload launcher news once network and updates are ready.
-                try {
-                    const auto launcherConfig = core::getRemoteLauncherConfig();
-                    const auto newsResponse = core::fetchNews(launcherConfig, 8);
-                    if (newsResponse.has_value() && !newsResponse->items.empty()) {
-                        bus::event::publish(event::NewsLoadedEvent{
-                            .items = newsResponse->items,
-                            .hasMore = newsResponse->hasMore});
-                        
-                        // Check if news should be shown based on dismiss settings
-                        const auto clientCfg = bus::config::getClientConfig();
-                        bool showNews = true;
-                        
-                        // Check time-based dismiss
-                        if (clientCfg.other.newsDismissUntil > 0) {
-                            auto now = std::chrono::system_clock::now();
-                            auto nowSeconds = std::chrono::duration_cast<std::chrono::seconds>(
-                                now.time_since_epoch()).count();
-                            if (nowSeconds < clientCfg.other.newsDismissUntil) {
-                                showNews = false;
-                            }
-                        }
-                        
-                        // Check version-based dismiss
-                        if (!clientCfg.other.newsDismissVersion.empty()) {
-                            if (clientCfg.other.newsDismissVersion == std::string(app::getVersion())) {
-                                showNews = false;
-                            }
-                        }
-                        
-                        if (showNews) {
-                            // Switch to news page to display news
-                            bus::event::publish(event::CurrentPageChangeEvent{
-                                .page = ui::Page::news});
-                        } else {
-                            // News dismissed, go directly to home
-                            bus::event::publish(event::CurrentPageChangeEvent{
-                                .page = ui::Page::home});
-                        }
-                    } else {
-                        bus::event::publish(event::NewsLoadedEvent{});
-                        // No news, go directly to home
-                        bus::event::publish(event::CurrentPageChangeEvent{
-                            .page = ui::Page::home});
-                    }
-                } catch (const ex::Exception &e) {
-                    log::warn("News preload failed: {}", {}, e.what());
-                    bus::event::publish(event::NewsLoadFailedEvent{.reason = e.what()});
-                    // On failure, go to home
-                    bus::event::publish(event::CurrentPageChangeEvent{
-                        .page = ui::Page::home});
-                } catch (const std::exception &e) {
-                    log::warn("News preload failed (std): {}", {}, e.what());
-                    bus::event::publish(event::NewsLoadFailedEvent{.reason = e.what()});
-                    // On failure, go to home
-                    bus::event::publish(event::CurrentPageChangeEvent{
-                        .page = ui::Page::home});
-                }
-            } catch (const ex::Exception &e) {
-                std::string reason = std::string("Auto-update/install failed: ") + e.what();
-                log::error(reason);
-                bus::event::publish(event::UpdateFailedEvent{.reason = reason});
-                bus::event::publish(event::CurrentPageChangeEvent{
-                    .page = ui::Page::home});
-            }
-        });
-    }
-
     /**
      * @brief Handle network initialization completion.
      * Checks if hosts are available and shows error dialog if not.
@@ -171,7 +92,7 @@ namespace {
             }
             
             // Network is ready, proceed with post-network tasks
-            executePostNetworkTasks();
+            core::startup::runPostNetworkTasks();
             
         } catch (const ex::Exception &e) {
             log::error("Network initialization failed: {}", {}, e.what());
@@ -212,8 +133,8 @@ namespace {
             }));
             bus::event::publish(event::CurrentPageChangeEvent{.page = ui::Page::loading});
             
-            // Retry network initialization in background thread
-            bus::thread::submit([]() {
+            // Retry network initialization in background thread; the user is watching the loading page
+            (void)bus::thread::schedule(bus::Executor::cpu, {.taskClass = bus::TaskClass::interactive}, []() {
                 auto retryFuture = app::init::retryNetworkInit();
                 handleNetworkInitCompletion(retryFuture);
             });
@@ -239,6 +160,13 @@ int main(int argc, char *argv[]) {
 
         // Initialize Application
         QApplication qtApp(argc, argv);
+
+        // Core files of an update are switched in (or a failed release rolled back) before anything uses them.
+        if (core::update::switchStagedRelease()) {
+            core::launcherNewProcess("\"" + QCoreApplication::applicationFilePath().toStdString() + "\"", system::workPath());
+            return 0;
+        }
+
         auto networkReady = app::init::initialize();
         auto runingInfo = app::run();
 
@@ -255,6 +183,8 @@ int main(int argc, char *argv[]) {
         ui::UiEventDispatcher::setNekoWindow(&window);
         window.show();
         log::info("main: window shown");
+        // Reaching the event loop with the window up is the health check for a release on trial.
+        QTimer::singleShot(0, []() { core::update::confirmStartup(); });
 
         // Initialize BGM system from JSON config
         {
@@ -285,6 +215,7 @@ int main(int argc, char *argv[]) {
         // Start Qt event loop
         qtApp.exec();
 
+        app::init::stopHostProbing();
         app::shutdown();
         runingInfo.eventLoopFuture.get();
         ui::UiEventDispatcher::clearNekoWindow();
@@ -63,7 +63,7 @@ namespace neko::minecraft::auth {
         bus::config::updateClientConfig([&authlibPrefetched](neko::ClientConfig &clientConfig) {
             clientConfig.minecraft.authlibPrefetched = authlibPrefetched.c_str();
         });
-        bus::config::save(app::getConfigFileName());
+        bus::config::saveAsync(app::getConfigFileName());
     }
 
     /**
@@ -155,7 +155,7 @@ namespace neko::minecraft::auth {
             bus::config::updateClientConfig([accessToken](neko::ClientConfig &clientConfig) {
                 clientConfig.minecraft.accessToken = accessToken.c_str();
             });
-            bus::config::save(app::getConfigFileName());
+            bus::config::saveAsync(app::getConfigFileName());
 
         } else {
             log::error("Unsupported auth mode for token refresh");
@@ -182,7 +182,7 @@ namespace neko::minecraft::auth {
                 clientConfig.minecraft.uuid = uuid.c_str();
                 clientConfig.minecraft.accessToken = "OfflineToken";
             });
-            bus::config::save(app::getConfigFileName());
+            bus::config::saveAsync(app::getConfigFileName());
             result.name = inData[0];
             return result;
         }
@@ -249,7 +249,7 @@ namespace neko::minecraft::auth {
                 clientConfig.minecraft.playerName = name;
                 clientConfig.minecraft.account = inData[0];
             });
-            bus::config::save(app::getConfigFileName());
+            bus::config::saveAsync(app::getConfigFileName());
 
             result.name = name;
 
@@ -271,7 +271,7 @@ namespace neko::minecraft::auth {
                 clientConfig.minecraft.uuid = "";
                 clientConfig.minecraft.accessToken = "";
             });
-            bus::config::save(app::getConfigFileName());
+            bus::config::saveAsync(app::getConfigFileName());
         };
 
         if (authMode == AuthMode::Offline) {
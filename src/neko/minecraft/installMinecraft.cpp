@@ -4,16 +4,20 @@
 #include <neko/log/nlog.hpp>
 #include <neko/network/network.hpp>
 #include <neko/function/utilities.hpp>
+#include <neko/function/hash.hpp>
 #include <neko/schema/exception.hpp>
 
 // NekoLc project
+#include "neko/app/appinfo.hpp"
 #include "neko/app/clientConfig.hpp"
 #include "neko/app/lang.hpp"
 #include "neko/ui/uiMsg.hpp"
 #include "neko/minecraft/downloadSource.hpp"
 #include "neko/minecraft/installMinecraft.hpp"
+#include "neko/core/integrityIndex.hpp"
 #include "neko/bus/eventBus.hpp"
 #include "neko/bus/threadBus.hpp"
+#include "neko/bus/taskGroup.hpp"
 #include "neko/event/eventTypes.hpp"
 
 #include <nlohmann/json.hpp>
@@ -25,30 +29,65 @@
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <unordered_set>
 #include <vector>
 
 namespace neko::minecraft {
 
     // Should not be called from the main thread, as it will block the incoming thread until completion.
-    void setupMinecraftDownloads(
+    InstallSummary setupMinecraftDownloads(
         DownloadSource downloadSource,
         neko::strview versionId,
         const nlohmann::json &versionJson,
-        neko::strview installPath) {
+        neko::strview installPath,
+        const DownloadOptions &options) {
 
         log::autoLog log;
 
         const std::filesystem::path basePath(installPath);
 
-        // Ensure we have enough workers for thousands of download tasks; keep original to restore.
-        const auto originalThreads = bus::thread::getThreadCount();
-        if (originalThreads < 64) {
-            bus::thread::setThreadCount(64);
-            log::info("MC install: bump thread pool from {} to 64 for download parallelism", {}, originalThreads);
-        }
+        // One file of the install: where it comes from, where it goes and what it should be.
+        struct Download {
+            std::string url;
+            std::filesystem::path dest;
+            std::string prefix;
+            std::string status;
+            neko::uint64 size = 0;
+            std::string sha1;
+        };
+
+        // SHA-1 of installed files by (path, size, mtime), so an unchanged file is only hashed once.
+        core::IntegrityIndex integrity(app::getCacheFolder() + "/minecraft-integrity.json", [](const std::string &path, const std::string &algorithm) {
+            return util::hash::digestFile(path, util::hash::mapAlgorithm(algorithm));
+        });
 
+        // Size first, since a partial or foreign file usually differs in size; only then the SHA-1.
+        auto matchesListing = [&integrity](const Download &download) {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(download.dest, ec);
+            if (ec || (download.size != 0 && size != download.size)) {
+                return false;
+            }
+            return download.sha1.empty() || integrity.digest(download.dest.string(), "sha1") == download.sha1;
+        };
+        // Without a SHA-1 there is nothing to trust an existing file by.
+        auto isInstalled = [&matchesListing](const Download &download) {
+            return !download.sha1.empty() && matchesListing(download);
+        };
+        auto sizeOf = [](const std::filesystem::path &path) -> neko::uint64 {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(path, ec);
+            return ec ? 0 : size;
+        };
+
+        // Shared with the loading page Cancel button and with every download task below.
+        bus::thread::ForegroundOperation operation;
+        const auto &token = operation.getToken();
+
+        // Status text is state-like; coalesce so thousands of per-file updates collapse into the latest one.
         auto sendStatus = [](const std::string &msg) {
-            bus::event::publish(event::LoadingStatusChangedEvent{.statusMessage = msg});
+            bus::event::publishCoalesced(event::LoadingStatusChangedEvent{.statusMessage = msg});
         };
 
         auto ensureDirectoryExists = [](const std::filesystem::path &path) {
@@ -57,17 +96,29 @@ namespace neko::minecraft {
             }
         };
 
-        auto downloadFile = [&](const std::string &url, const std::filesystem::path &dest, const std::string &prefix) {
+        /**
+         * @throws ex::NetworkError if the transfer fails
+         * @throws ex::FileError if the downloaded file does not match its listed size or SHA-1; the file is removed
+         */
+        auto downloadFile = [&](const Download &download) {
+            // An in-flight transfer cannot be interrupted, but no new one starts after a cancel.
+            token.throwIfCancelled();
+            bus::thread::yieldPoint();
             network::Network net;
             network::RequestConfig reqConfig{
-                .url = url,
+                .url = download.url,
                 .method = network::RequestType::DownloadFile,
-                .requestId = prefix + util::random::generateRandomString(6),
-                .fileName = dest.string()};
+                .requestId = download.prefix + util::random::generateRandomString(6),
+                .fileName = download.dest.string()};
 
             auto res = net.executeWithRetry({reqConfig});
             if (!res.isSuccess()) {
-                throw ex::NetworkError("Download failed: " + url);
+                throw ex::NetworkError("Download failed: " + download.url);
+            }
+            if (!matchesListing(download)) {
+                std::error_code ec;
+                std::filesystem::remove(download.dest, ec);
+                throw ex::FileError("Downloaded file does not match its size or SHA-1: " + download.url);
             }
         };
 
@@ -81,8 +132,17 @@ namespace neko::minecraft {
         const std::filesystem::path assetIndexPath = basePath / "assets" / "indexes" / (assetIndex.at("id").get<std::string>() + ".json");
         ensureDirectoryExists(assetIndexPath.parent_path());
 
-        sendStatus(lang::tr(lang::keys::minecraft::category, lang::keys::minecraft::downloadingAssetIndex, "Downloading asset index..."));
-        downloadFile(assetIndexUrl, assetIndexPath, "assetIndex-");
+        const Download assetIndexDownload{
+            .url = assetIndexUrl,
+            .dest = assetIndexPath,
+            .prefix = "assetIndex-",
+            .status = lang::tr(lang::keys::minecraft::category, lang::keys::minecraft::downloadingAssetIndex, "Downloading asset index..."),
+            .size = assetIndex.value("size", neko::uint64(0)),
+            .sha1 = assetIndex.value("sha1", "")};
+        if (!isInstalled(assetIndexDownload)) {
+            sendStatus(assetIndexDownload.status);
+            downloadFile(assetIndexDownload);
+        }
 
         nlohmann::json assetIndexJson;
         {
@@ -93,16 +153,70 @@ namespace neko::minecraft {
             assetIndexJson = nlohmann::json::parse(ifs, nullptr, true, true);
         }
 
-        // Prepare progress display
         const auto &assetsObj = assetIndexJson.at("objects");
-        const neko::uint32 progressMax = static_cast<neko::uint32>(libraries.size() + assetsObj.size() + 1); // +1 for client jar
+        const auto &client = versionJson.at("downloads").at("client");
+        std::filesystem::path versionDir = basePath / "versions" / (std::string("NekoServer_") + std::string(versionId));
+        ensureDirectoryExists(versionDir);
+        std::filesystem::path clientJarPath = versionDir / (std::string("NekoServer_") + std::string(versionId) + ".jar");
+
+        // Everything to install, once per destination: asset objects that share a hash share a file.
+        std::vector<Download> files;
+        files.reserve(libraries.size() + assetsObj.size() + 1);
+        std::unordered_set<std::string> seen;
+        auto addFile = [&](Download download) {
+            if (seen.insert(download.dest.string()).second) {
+                files.push_back(std::move(download));
+            }
+        };
+
+        for (const auto &library : libraries) {
+            const auto &artifact = library.at("downloads").at("artifact");
+            addFile({.url = (downloadSource == DownloadSource::BMCLAPI)
+                                ? replaceWithBMCLAPI(artifact.at("url").get<std::string>())
+                                : artifact.at("url").get<std::string>(),
+                     .dest = basePath / "libraries" / artifact.at("path").get<std::string>(),
+                     .prefix = "library-",
+                     .status = lang::tr(lang::keys::minecraft::category, lang::keys::minecraft::downloadingLibrary, "Downloading library...") + " " + library.value("name", ""),
+                     .size = artifact.value("size", neko::uint64(0)),
+                     .sha1 = artifact.value("sha1", "")});
+        }
+
+        addFile({.url = (downloadSource == DownloadSource::BMCLAPI)
+                            ? replaceWithBMCLAPI(client.at("url").get<std::string>())
+                            : client.at("url").get<std::string>(),
+                 .dest = clientJarPath,
+                 .prefix = "client-",
+                 .status = lang::tr(lang::keys::minecraft::category, lang::keys::minecraft::downloadingClient, "Downloading client jar..."),
+                 .size = client.value("size", neko::uint64(0)),
+                 .sha1 = client.value("sha1", "")});
+
+        // An asset object is stored under its own SHA-1.
+        std::string assetBase = options.assetBaseUrl;
+        if (assetBase.empty()) {
+            assetBase = (downloadSource == DownloadSource::BMCLAPI)
+                            ? "https://bmclapi2.bangbang93.com/assets"
+                            : "https://resources.download.minecraft.net";
+        }
+        for (const auto &[_, asset] : assetsObj.items()) {
+            std::string assetHash = asset.at("hash").get<std::string>();
+            addFile({.url = assetBase + "/" + assetHash.substr(0, 2) + "/" + assetHash,
+                     .dest = basePath / "assets" / "objects" / assetHash.substr(0, 2) / assetHash,
+                     .prefix = "asset-",
+                     .status = lang::tr(lang::keys::minecraft::category, lang::keys::minecraft::downloadingAssets, "Downloading assets..."),
+                     .size = asset.value("size", neko::uint64(0)),
+                     .sha1 = assetHash});
+        }
+
+        // Prepare progress display
+        const neko::uint32 progressMax = static_cast<neko::uint32>(files.size());
 
         // Notify UI to show progress bar
         bus::event::publish(event::ShowLoadingEvent(neko::ui::LoadingMsg{
             .type = neko::ui::LoadingMsg::Type::Progress,
             .process = lang::tr(lang::keys::minecraft::category, lang::keys::minecraft::installing, "Installing Minecraft"),
             .progressVal = 0,
-            .progressMax = progressMax}));
+            .progressMax = progressMax,
+            .cancellable = true}));
 
         std::atomic<neko::uint32> progress{0};
         std::atomic<neko::uint32> lastPublished{0};
@@ -115,94 +229,78 @@ namespace neko::minecraft {
                 // observed is updated with the latest published value; loop until we either win or see a newer value.
             }
             if (val > observed) {
-                bus::event::publish(event::LoadingValueChangedEvent{.progressValue = val});
+                bus::event::publishCoalesced(event::LoadingValueChangedEvent{.progressValue = val});
             }
         };
 
-        std::mutex errorMutex;
-        std::string firstError;
-        std::atomic<bool> failed{false};
-
-        auto recordFailure = [&](const std::string &msg) {
-            failed.store(true, std::memory_order_release);
-            std::scoped_lock lock(errorMutex);
-            if (firstError.empty()) {
-                firstError = msg;
+        // Pre-pass: files already installed from an earlier run or a version sharing them are kept.
+        sendStatus(lang::tr(lang::keys::minecraft::category, lang::keys::minecraft::checkingFiles, "Checking installed files..."));
+        std::vector<char> installed(files.size(), 0);
+        InstallSummary summary;
+        {
+            bus::thread::TaskGroup checks(bus::Executor::cpu, token, bus::TaskClass::bulk);
+            for (std::size_t i = 0; i < files.size(); ++i) {
+                (void)checks.spawn([&, i]() {
+                    installed[i] = isInstalled(files[i]) ? 1 : 0;
+                });
             }
-        };
+            checks.waitAll();
+            if (checks.isCancelled()) {
+                throw ex::Exception("Minecraft install cancelled: " + token.getReason());
+            }
+        }
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            if (installed[i]) {
+                ++summary.reusedFiles;
+                summary.reusedBytes += sizeOf(files[i].dest);
+                bumpProgress();
+            }
+        }
 
-        std::vector<std::future<void>> tasks;
-        tasks.reserve(libraries.size() + assetsObj.size());
+        // Fail-fast: the first failed download cancels the rest, queued ones are skipped.
+        bus::thread::TaskGroup downloads(bus::Executor::io, token, bus::TaskClass::bulk);
+        std::atomic<neko::uint64> fetchedBytes{0};
 
-        auto scheduleDownload = [&](const std::string &url, const std::filesystem::path &dest, const std::string &prefix, const std::string &statusMsg) {
-            tasks.push_back(bus::thread::submit([=, &recordFailure, &bumpProgress, &failed, &sendStatus, &downloadFile]() {
-                if (failed.load(std::memory_order_acquire)) {
-                    return;
-                }
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            if (installed[i]) {
+                continue;
+            }
+            ensureDirectoryExists(files[i].dest.parent_path());
+            ++summary.fetchedFiles;
+            (void)downloads.spawn([&, i]() {
+                const auto &file = files[i];
                 try {
-                    log::info("MC install downloading: {} -> {}", {}, url, dest.string());
-                    sendStatus(statusMsg);
-                    downloadFile(url, dest, prefix);
-                    log::info("MC install downloaded: {}", {}, dest.string());
+                    log::info("MC install downloading: {} -> {}", {}, file.url, file.dest.string());
+                    sendStatus(file.status);
+                    downloadFile(file);
+                    log::info("MC install downloaded: {}", {}, file.dest.string());
+                    fetchedBytes += sizeOf(file.dest);
                     bumpProgress();
                 } catch (const std::exception &e) {
-                    log::error("MC install download failed: {} -> {} : {}", {}, url, dest.string(), e.what());
-                    recordFailure(e.what());
+                    log::error("MC install download failed: {} -> {} : {}", {}, file.url, file.dest.string(), e.what());
+                    throw;
                 }
-            }));
-        };
-
-        // Download libraries
-        for (const auto &library : libraries) {
-            const auto &artifact = library.at("downloads").at("artifact");
-            std::string libraryUrl = (downloadSource == DownloadSource::BMCLAPI)
-                                         ? replaceWithBMCLAPI(artifact.at("url").get<std::string>())
-                                         : artifact.at("url").get<std::string>();
-            std::filesystem::path libraryPath = basePath / "libraries" / artifact.at("path").get<std::string>();
-            ensureDirectoryExists(libraryPath.parent_path());
-
-            std::string status = lang::tr(lang::keys::minecraft::category, lang::keys::minecraft::downloadingLibrary, "Downloading library...") + " " + library.value("name", "");
-            scheduleDownload(libraryUrl, libraryPath, "library-", status);
-        }
-
-        // Download client jar
-        const auto &client = versionJson.at("downloads").at("client");
-        std::string clientUrl = (downloadSource == DownloadSource::BMCLAPI)
-                                    ? replaceWithBMCLAPI(client.at("url").get<std::string>())
-                                    : client.at("url").get<std::string>();
-        std::filesystem::path versionDir = basePath / "versions" / (std::string("NekoServer_") + std::string(versionId));
-        ensureDirectoryExists(versionDir);
-        std::filesystem::path clientJarPath = versionDir / (std::string("NekoServer_") + std::string(versionId) + ".jar");
-
-        sendStatus(lang::tr(lang::keys::minecraft::category, lang::keys::minecraft::downloadingClient, "Downloading client jar..."));
-        downloadFile(clientUrl, clientJarPath, "client-");
-        bumpProgress();
-
-        // Download assets
-        for (const auto &[_, asset] : assetsObj.items()) {
-            std::string assetHash = asset.at("hash").get<std::string>();
-            std::string assetUrl = ((downloadSource == DownloadSource::BMCLAPI)
-                                        ? "https://bmclapi2.bangbang93.com/assets/"
-                                        : "https://resources.download.minecraft.net/") +
-                                    assetHash.substr(0, 2) + "/" + assetHash;
-
-            std::filesystem::path assetPath = basePath / "assets" / "objects" / assetHash.substr(0, 2) / assetHash;
-            ensureDirectoryExists(assetPath.parent_path());
-
-            std::string status = lang::tr(lang::keys::minecraft::category, lang::keys::minecraft::downloadingAssets, "Downloading assets...");
-            scheduleDownload(assetUrl, assetPath, "asset-", status);
+            });
         }
 
-        for (auto &task : tasks) {
-            task.wait();
-        }
-        if (originalThreads < 64) {
-            bus::thread::setThreadCount(originalThreads);
-            log::info("MC install: restored thread pool size to {}", {}, originalThreads);
+        downloads.waitAll();
+        // Deliver the last coalesced progress/status before the result is reported.
+        bus::event::flushCoalesced();
+        const auto ioStats = bus::thread::getExecutorStats(bus::Executor::io);
+        const auto bulkStats = bus::thread::getTaskClassStats(bus::Executor::io, bus::TaskClass::bulk);
+        log::info("MC install: io executor threads={}, pending={}, completed={}, rejected={}, bulk wait avg={}ms max={}ms", {},
+                  ioStats.threadCount, ioStats.pendingTasks, ioStats.completed, ioStats.rejected, bulkStats.averageWaitMs, bulkStats.maxWaitMs);
+        if (auto error = downloads.getFirstError()) {
+            throw ex::Exception("Minecraft install failed: " + *error);
         }
-        if (failed.load(std::memory_order_acquire)) {
-            throw ex::Exception("Minecraft install failed: " + firstError);
+        if (downloads.isCancelled()) {
+            throw ex::Exception("Minecraft install cancelled: " + token.getReason());
         }
+        summary.fetchedBytes = fetchedBytes.load();
+        integrity.save();
+        log::info("MC install: {} of {} files already installed ({} bytes reused), {} downloaded ({} bytes fetched)", {},
+                  std::to_string(summary.reusedFiles), std::to_string(files.size()), std::to_string(summary.reusedBytes),
+                  std::to_string(summary.fetchedFiles), std::to_string(summary.fetchedBytes));
 
         // Save version manifest
         auto saveJson = versionJson;
@@ -217,11 +315,13 @@ namespace neko::minecraft {
             throw ex::FileError("Failed to save version json: " + versionJsonPath.string());
         }
         saveFile << saveJson.dump(4);
-        bus::event::publish(event::LoadingStatusChangedEvent{.statusMessage = lang::tr(lang::keys::minecraft::category, lang::keys::minecraft::completed, "Minecraft install completed")});
+        sendStatus(lang::tr(lang::keys::minecraft::category, lang::keys::minecraft::completed, "Minecraft install completed"));
+        bus::event::flushCoalesced();
+        return summary;
     }
 
     // Should not be called from the main thread, as it will block the incoming thread until completion.
-    void installMinecraft(
+    InstallSummary installMinecraft(
         neko::strview installPath,
         neko::strview targetVersion,
         DownloadSource downloadSource) {
@@ -285,7 +385,7 @@ namespace neko::minecraft {
             throw ex::Parse(std::string("Failed to parse target version json: ") + e.what());
         }
 
-        setupMinecraftDownloads(downloadSource, targetVersion, versionJson, installPath);
+        return setupMinecraftDownloads(downloadSource, targetVersion, versionJson, installPath);
     }
 
 } // namespace neko::minecraft
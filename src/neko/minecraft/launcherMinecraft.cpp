@@ -17,6 +17,8 @@
 #include "neko/app/appinfo.hpp"
 #include "neko/app/clientConfig.hpp"
 #include "neko/core/launcherProcess.hpp"
+#include "neko/core/responseCache.hpp"
+#include "neko/bus/taskGroup.hpp"
 
 #include "neko/minecraft/launcherMinecraft.hpp"
 
@@ -433,11 +435,13 @@ namespace neko::minecraft {
         /**
          * @brief Checks file integrity and attempts to repair incomplete or missing files.
          * @param artifact The artifact map containing information about the archives.
+         * @param token Checked before every download and hash attempt.
          * @param maxRetries The maximum number of retries for each download attempt.
          * @throws ex::NetworkError if the download fails after the maximum number of retries.
          * @throws ex::FileError if the hash of the downloaded file does not match the expected SHA1.
+         * @throws ex::Runtime if the token is cancelled.
          */
-        void checkArchives(const ArtifactMap &artifact, int maxRetries = 5) {
+        void checkArchives(const ArtifactMap &artifact, const bus::thread::CancellationToken &token, int maxRetries = 5) {
 
             std::vector<Classifiers> SingleVector;
 
@@ -460,6 +464,7 @@ namespace neko::minecraft {
 
                 // auto retry task
                 for (neko::uint32 i = 0; i < maxRetries; ++i) {
+                    token.throwIfCancelled();
 
                     // download the file if it does not exist or is not a regular file
                     if (!std::filesystem::is_regular_file(it.path)) {
@@ -481,6 +486,7 @@ namespace neko::minecraft {
                     }
 
                     // check the file hash
+                    token.throwIfCancelled();
                     auto hash = util::hash::digestFile(it.path, util::hash::Algorithm::sha1);
                     if (hash != it.sha1) {
 
@@ -572,6 +578,17 @@ namespace neko::minecraft {
                 }
             }
 
+            struct LibraryEntry {
+                std::string name;
+                std::string nativePath;
+            };
+            std::vector<LibraryEntry> entries;
+
+            // Archives are checked (and repaired) in parallel on the io executor; the group shares
+            // the foreground token so the loading page Cancel button stops it. Non-tolerant mode fails fast.
+            // The user is waiting on the launch, so these run ahead of any bulk install traffic.
+            bus::thread::TaskGroup checks(bus::Executor::io, bus::thread::getForegroundToken(), bus::TaskClass::interactive, !cfg.tolerantMode);
+
             for (const auto &lib : libraries) {
                 if (!isAllowedByRules(lib, cfg))
                     continue;
@@ -615,31 +632,41 @@ namespace neko::minecraft {
                             }
                         }
                     }
-                    try {
-                        checkArchives(artifactMap);
-                    } catch (const ex::Exception &e) {
-                        if (!cfg.tolerantMode) {
-                            throw;
+                    (void)checks.spawn([artifactMap = std::move(artifactMap), tolerant = cfg.tolerantMode](const bus::thread::CancellationToken &token) {
+                        try {
+                            checkArchives(artifactMap, token);
+                        } catch (const ex::Exception &e) {
+                            if (!tolerant || token.isCancelled()) {
+                                throw;
+                            }
+                            log::error("Failed to checkArchives , error : {}", {}, e.what());
                         }
-                        log::error("Failed to checkArchives , error : {}", {}, e.what());
-                    }
+                    });
                 }
 
+                entries.push_back({lib.value("name", ""), std::move(libNativePath)});
+            }
+
+            checks.waitAll();
+            checks.rethrowIfFailed();
+            checks.getToken().throwIfCancelled();
+
+            for (const auto &entry : entries) {
                 // If libNativePath is not empty and the check and repair pass, then decompress it.
-                if (!libNativePath.empty() && std::filesystem::is_directory(nativePath)) {
+                if (!entry.nativePath.empty() && std::filesystem::is_directory(nativePath)) {
                     try {
-                        uncompress(libNativePath, nativePath);
-                        log::info("Extracted natives: {} -> {}", {}, libNativePath, nativePath);
+                        uncompress(entry.nativePath, nativePath);
+                        log::info("Extracted natives: {} -> {}", {}, entry.nativePath, nativePath);
                     } catch (const std::exception &e) {
                         if (!cfg.tolerantMode) {
                             throw;
                         }
-                        log::warn("Failed to extract natives {} : {}", {}, libNativePath, e.what());
+                        log::warn("Failed to extract natives {} : {}", {}, entry.nativePath, e.what());
                     }
                 }
 
                 // Note: Forge may not include fields like "downloads", so it cannot be repaired; just try to add it directly
-                std::string path = librariesPath + "/" + constructPath(lib.value("name", ""));
+                std::string path = librariesPath + "/" + constructPath(entry.name);
                 log::debug("Push path : {}", {}, path);
                 librariesPaths.push_back(path);
             }
@@ -657,23 +684,21 @@ namespace neko::minecraft {
             log::autoLog log;
 
             auto url = network::buildUrl(lc::api::authlib::injector::latest, lc::api::authlib::injector::downloadHost);
-            network::Network net;
-            network::RequestConfig reqConfig{
-                .url = url,
-                .method = network::RequestType::Get,
-                .requestId = "minecraft-authlib-injector-latest"};
-
-            auto res = net.executeWithRetry({reqConfig});
-            if (!res.isSuccess() || !res.hasContent()) {
-                throw ex::NetworkError{"Failed to Get latest Authlib Injector version, error: " + res.errorMessage};
+            // Version metadata changes rarely; a stored copy is reused for an hour and served while it refreshes.
+            core::CachedResponse res;
+            try {
+                res = core::getCached(url, "minecraft-authlib-injector-latest", core::CachePolicy{.defaultMaxAge = std::chrono::hours(1)});
+            } catch (const ex::NetworkError &e) {
+                throw ex::NetworkError{"Failed to Get latest Authlib Injector version, error: " + std::string(e.what())};
             }
+            network::Network net;
 
             nlohmann::json authlibVersionInfo;
             std::string
                 downloadUrl,
                 checksumSha256;
             try {
-                authlibVersionInfo = nlohmann::json::parse(res.content);
+                authlibVersionInfo = nlohmann::json::parse(res.body);
                 downloadUrl = authlibVersionInfo.at("download_url").get<std::string>();
                 checksumSha256 = authlibVersionInfo.at("checksums").at("sha256").get<std::string>();
             } catch (const nlohmann::json::parse_error &e) {
@@ -703,7 +728,7 @@ namespace neko::minecraft {
                 [&](neko::ClientConfig &cfg) {
                     cfg.minecraft.authlibSha256 = checksumSha256.c_str();
                 });
-            bus::config::save(app::getConfigFileName());
+            bus::config::saveAsync(app::getConfigFileName());
             log::info("Authlib Injector downloaded successfully: {} , hash sha256 : {}", {}, authlibPath, checksumSha256);
         }
 
@@ -1057,7 +1082,13 @@ namespace neko::minecraft {
             launcherCfg.resolutionHeight = resolution.value().height;
         }
 
-        auto command = neko::minecraft::getLauncherMinecraftCommand(launcherCfg);
+        std::string command;
+        {
+            // Launch preparation (archive checks and repairs) is cancellable from the loading page.
+            bus::thread::ForegroundOperation preparation;
+            command = neko::minecraft::getLauncherMinecraftCommand(launcherCfg);
+            preparation.getToken().throwIfCancelled();
+        }
         auto workingDir = internal::getAbsoluteMinecraftPath(cfg.minecraft.minecraftFolder);
 
         if (detach) {
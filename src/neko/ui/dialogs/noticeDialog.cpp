@@ -67,7 +67,7 @@ namespace neko::ui::dialog {
         buttonContainer->setFocus();
         buttonContainer->setFocusProxy(this);
 
-        connect(this, &NoticeDialog::showNoticeD, this, &NoticeDialog::showNotice);
+        connect(this, &NoticeDialog::showNoticeD, this, qOverload<const NoticeMsg &>(&NoticeDialog::showNotice));
         connect(this, &NoticeDialog::resetStateD, this, &NoticeDialog::resetState);
         connect(this, &NoticeDialog::resetButtonsD, this, &NoticeDialog::resetButtons);
     }
@@ -106,20 +106,35 @@ namespace neko::ui::dialog {
     }
 
     void NoticeDialog::showNotice(const NoticeMsg &m) {
-        noticeQueue.push_back(m);
+        showNotice(std::make_shared<const NoticeMsg>(m));
+    }
+
+    void NoticeDialog::showNotice(std::shared_ptr<const NoticeMsg> m) {
+        noticeQueue.push_back(std::move(m));
         if (showing) {
             return;
         }
         presentNextNotice();
     }
 
+    void NoticeDialog::dismissNotice(std::shared_ptr<const NoticeMsg> m) {
+        std::erase(noticeQueue, m);
+        if (showing && m && currentNotice == m) {
+            currentNotice.reset();
+            finishCurrent();
+        }
+    }
+
     void NoticeDialog::presentNextNotice() {
         if (noticeQueue.empty()) {
             return;
         }
 
-        const NoticeMsg m = noticeQueue.front();
+        // Keep the shared message alive for the callbacks below instead of copying it into each one.
+        const auto current = noticeQueue.front();
+        const NoticeMsg &m = *current;
         noticeQueue.pop_front();
+        currentNotice = current;
         showing = true;
 
         // Clear any previous UI state so buttons do not accumulate between notices.
@@ -206,9 +221,9 @@ namespace neko::ui::dialog {
 
         // If autoClose is set, start a timer to close the dialog after the specified time
         if (m.autoClose > 0) {
-            QTimer::singleShot(m.autoClose, this, [=]() {
-                if (m.callback && !*did) {
-                    m.callback(m.defaultButtonIndex);
+            QTimer::singleShot(m.autoClose, this, [this, current, did]() {
+                if (current->callback && !*did) {
+                    current->callback(current->defaultButtonIndex);
                     *did = true;
                     finishCurrent();
                 }
@@ -226,16 +241,16 @@ namespace neko::ui::dialog {
         }
 
         for (neko::uint32 i = 0; i < buttons.size(); ++i) {
-            connect(buttons[i], &QPushButton::clicked, this, [this, m, did, i]() {
-                m.callback(i);
+            connect(buttons[i], &QPushButton::clicked, this, [this, current, did, i]() {
+                current->callback(i);
                 *did = true;
                 finishCurrent();
             });
         }
 
-        connect(this, &QWidget::destroyed, this, [this, m, did](QObject *) {
+        connect(this, &QWidget::destroyed, this, [this, current, did](QObject *) {
             if (!*did) {
-                m.callback(m.defaultButtonIndex);
+                current->callback(current->defaultButtonIndex);
                 finishCurrent();
             }
         });
@@ -260,6 +275,7 @@ namespace neko::ui::dialog {
         msg->clear();
         resetButtons();
         disconnect(this, &QWidget::destroyed, nullptr, nullptr);
+        currentNotice.reset();
         showing = false;
     }
     void NoticeDialog::resetButtons() {
@@ -89,7 +89,7 @@ namespace neko::ui::page {
                 + "build: " + app::getBuildId() + "\n";
 
             QPointer<AboutPage> self(this);
-            bus::thread::submit([self, payload]() {
+            bus::thread::submitBackground([self, payload]() {
                 bool ok = false;
                 std::string errMsg;
                 try {
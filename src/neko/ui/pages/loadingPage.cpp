@@ -1,12 +1,14 @@
 
 #include "neko/ui/pages/loadingPage.hpp"
 #include "neko/ui/widgets/pixmapWidget.hpp"
+#include "neko/app/lang.hpp"
 
 #include <QtGui/QMovie>
 #include <QtCore/QFileInfo>
 #include <QtWidgets/QGraphicsDropShadowEffect>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QProgressBar>
+#include <QtWidgets/QPushButton>
 #include <QtWidgets/QVBoxLayout>
 #include <QtWidgets/QWidget>
 
@@ -25,7 +27,8 @@ namespace neko::ui::page {
           text(new QLabel(this)),
           loadingLabel(new QLabel(this)),
           loadingMv(new QMovie("img/loading.gif", QByteArray(), this)),
-          process(new QLabel(this)) {
+          process(new QLabel(this)),
+          cancelButton(new QPushButton(this)) {
 
         this->setAttribute(Qt::WA_TranslucentBackground);
 
@@ -70,6 +73,13 @@ namespace neko::ui::page {
             it->setAlignment(Qt::AlignCenter);
         }
 
+        cancelButton->hide();
+        connect(cancelButton, &QPushButton::clicked, this, [this]() {
+            cancelButton->setEnabled(false);
+            cancelButton->setText(QString::fromStdString(lang::tr(lang::keys::loading::category, lang::keys::loading::cancelling, "Cancelling...")));
+            emit cancelRequested();
+        });
+
         connect(this, &LoadingPage::setLoadingValueD, this, &LoadingPage::setLoadingValue);
         connect(this, &LoadingPage::setLoadingStatusD, this, &LoadingPage::setLoadingStatus);
     }
@@ -115,6 +125,10 @@ namespace neko::ui::page {
         if (loadingMv->speed() != m.speed)
             loadingMv->setSpeed(m.speed);
 
+        cancelButton->setText(QString::fromStdString(lang::tr(lang::keys::button::category, lang::keys::button::cancel, "Cancel")));
+        cancelButton->setEnabled(true);
+        cancelButton->setVisible(m.cancellable);
+
         switch (m.type) {
             case LoadingMsg::Type::Text:
                 progressBar->hide();
@@ -150,6 +164,7 @@ namespace neko::ui::page {
 
         progressBar->hide();
         textLayoutWidget->hide();
+        cancelButton->hide();
     }
 
     void LoadingPage::setLoadingValue(neko::uint32 val) {
@@ -205,6 +220,21 @@ namespace neko::ui::page {
         }
 
         process->setStyleSheet(QString("QLabel { color: %1; background-color: transparent; border: none; font-style: italic; }").arg(theme.colors.text.data()));
+
+        cancelButton->setStyleSheet(
+            QString(
+                "QPushButton {"
+                "background-color: %1;"
+                "color: %2;"
+                "border: none;"
+                "border-radius: 14px;"
+                "}"
+                "QPushButton:hover {"
+                "background-color: %3;"
+                "}")
+                .arg(theme.colors.secondary.data())
+                .arg(theme.colors.text.data())
+                .arg(theme.colors.hover.data()));
     }
 
     void LoadingPage::setupFont(QFont text, QFont h1Font, QFont h2Font) {
@@ -212,6 +242,7 @@ namespace neko::ui::page {
         this->h1Title->setFont(h1Font);
         this->h2Title->setFont(h2Font);
         this->process->setFont(text);
+        this->cancelButton->setFont(text);
     }
 
     void LoadingPage::resizeItems(int windowWidth, int windowHeight) {
@@ -244,6 +275,11 @@ namespace neko::ui::page {
         const int loadingX = processX;
         const int loadingY = processY - loadingSize - 6;
         loadingLabel->setGeometry(loadingX, loadingY, loadingSize, loadingSize);
+
+        // Cancel button mirrors the progress text on the bottom-right
+        const int cancelWidth = static_cast<int>(windowWidth * 0.14);
+        const int cancelX = windowWidth - processX - cancelWidth;
+        cancelButton->setGeometry(cancelX, processY, cancelWidth, processHeight);
     }
 
 } // namespace neko::ui::page
@@ -238,12 +238,16 @@ namespace neko::ui::page {
     }
 
     void NewsPage::setNews(const std::vector<api::NewsItem> &items) {
-        newsItems = items;
+        setNews(std::make_shared<const std::vector<api::NewsItem>>(items));
+    }
+
+    void NewsPage::setNews(std::shared_ptr<const std::vector<api::NewsItem>> items) {
+        newsItems = items ? std::move(items) : std::make_shared<const std::vector<api::NewsItem>>();
         updateNewsItems();
     }
 
     void NewsPage::clearNews() {
-        newsItems.clear();
+        newsItems = std::make_shared<const std::vector<api::NewsItem>>();
         for (auto *widget : newsWidgets) {
             contentLayout->removeWidget(widget);
             widget->deleteLater();
@@ -260,7 +264,7 @@ namespace neko::ui::page {
         newsWidgets.clear();
 
         // Add new items
-        for (const auto &item : newsItems) {
+        for (const auto &item : *newsItems) {
             auto *widget = new NewsPageItem(item, contentWidget);
             widget->setupTheme(currentTheme);
             
@@ -275,7 +279,7 @@ namespace neko::ui::page {
         }
 
         // Show "no news" message if empty
-        if (newsItems.empty()) {
+        if (newsItems->empty()) {
             auto *noNewsLabel = new QLabel(QString::fromStdString(
                 lang::tr(lang::keys::news::category, lang::keys::news::noNews, "No news available")), contentWidget);
             noNewsLabel->setObjectName("newsPageNoNews");
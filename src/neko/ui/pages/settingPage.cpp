@@ -625,8 +625,9 @@ namespace neko::ui::page {
     }
 
     void SettingPage::setupCombos() {
-        const auto tr = [](neko::cstr category, neko::cstr key, const char *fallback) {
-            return QString::fromStdString(lang::tr(category, key, fallback));
+        const auto tr = [](neko::cstr category, const lang::Key &key, const char *fallback) {
+            const auto text = lang::trView(category, key, fallback);
+            return QString::fromUtf8(text.view().data(), static_cast<qsizetype>(text.view().size()));
         };
 
         backgroundTypeCombo->clear();
@@ -683,8 +684,9 @@ namespace neko::ui::page {
     }
 
     void SettingPage::retranslateUi() {
-        const auto tr = [](neko::cstr category, neko::cstr key, const char *fallback) {
-            return QString::fromStdString(lang::tr(category, key, fallback));
+        const auto tr = [](neko::cstr category, const lang::Key &key, const char *fallback) {
+            const auto text = lang::trView(category, key, fallback);
+            return QString::fromUtf8(text.view().data(), static_cast<qsizetype>(text.view().size()));
         };
 
         tabWidget->setTabText(tabWidget->indexOf(authScroll), tr(lang::keys::setting::category, lang::keys::setting::tabAccount, "Account"));
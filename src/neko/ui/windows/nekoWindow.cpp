@@ -216,12 +216,12 @@ namespace neko::ui::window {
 
     void NekoWindow::showLoading(const LoadingMsg &m) {
         switchToPage(Page::loading);
-        emit showLoadingD(m);
+        loadingPage->showLoading(m);
     }
 
-    void NekoWindow::setNews(std::vector<api::NewsItem> items, bool hasMore) {
+    void NekoWindow::setNews(std::shared_ptr<const std::vector<api::NewsItem>> items, bool hasMore) {
         Q_UNUSED(hasMore);
-        newsPage->setNews(items);
+        newsPage->setNews(std::move(items));
     }
 
     void NekoWindow::handleNewsLoadFailed(const std::string &reason) {
@@ -231,9 +231,14 @@ namespace neko::ui::window {
     }
 
     void NekoWindow::setupConnections() {
-        connect(this, &NekoWindow::showNoticeD, noticeDialog, &dialog::NoticeDialog::showNotice);
-        connect(this, &NekoWindow::showInputD, inputDialog, &dialog::InputDialog::showInput);
-        connect(this, &NekoWindow::showLoadingD, loadingPage, &page::LoadingPage::showLoading);
+        connect(this, &NekoWindow::showNoticeD, noticeDialog, qOverload<std::shared_ptr<const NoticeMsg>>(&dialog::NoticeDialog::showNotice));
+        connect(this, &NekoWindow::dismissNoticeD, noticeDialog, &dialog::NoticeDialog::dismissNotice);
+        connect(this, &NekoWindow::showInputD, inputDialog, [this](std::shared_ptr<const InputMsg> m) {
+            inputDialog->showInput(*m);
+        });
+        connect(this, &NekoWindow::showLoadingD, loadingPage, [this](std::shared_ptr<const LoadingMsg> m) {
+            loadingPage->showLoading(*m);
+        });
         connect(this, &NekoWindow::hideInputD, inputDialog, &dialog::InputDialog::hideInput);
         connect(this, &NekoWindow::getLinesD, inputDialog, &dialog::InputDialog::getLines);
         connect(this, &NekoWindow::resetNoticeStateD, noticeDialog, &dialog::NoticeDialog::resetState);
@@ -242,6 +247,7 @@ namespace neko::ui::window {
         connect(this, &NekoWindow::setLoadingValueD, loadingPage, &page::LoadingPage::setLoadingValue);
         connect(this, &NekoWindow::setLoadingStatusD, loadingPage, &page::LoadingPage::setLoadingStatus);
         connect(this, &NekoWindow::refreshTextD, this, &NekoWindow::setupText);
+        connect(this, &NekoWindow::configUpdatedD, this, &NekoWindow::onConfigUpdated);
         connect(this, &NekoWindow::hideWindowD, this, &QWidget::hide);
         connect(this, &NekoWindow::showWindowD, this, [this]() {
             this->show();
@@ -288,7 +294,7 @@ namespace neko::ui::window {
                         break;
                 }
             });
-            bus::config::save(app::getConfigFileName());
+            bus::config::saveAsync(app::getConfigFileName());
             switchToPage(Page::home);
         });
         connect(this, &NekoWindow::quitAppD, this, [this]() {
@@ -311,6 +317,10 @@ namespace neko::ui::window {
             switchToPage(Page::about);
         });
 
+        connect(loadingPage, &page::LoadingPage::cancelRequested, this, []() {
+            bus::event::publish(event::CancelOperationEvent{.reason = "Cancelled by user"});
+        });
+
         connect(aboutPage, &page::AboutPage::backRequested, this, [this]() {
             switchToPage(Page::home);
         });
@@ -429,11 +439,14 @@ namespace neko::ui::window {
     }
 
     void NekoWindow::persistConfigFromUi(bool saveToFile) {
-        bus::config::updateClientConfig([this](ClientConfig &cfg) {
+        auto change = bus::config::updateClientConfig([this](ClientConfig &cfg) {
             settingPage->writeToConfig(cfg);
         });
+        if (change && !change->empty()) {
+            ownConfigVersions.insert(change->version);
+        }
         if (saveToFile) {
-            bus::config::save(app::getConfigFileName());
+            bus::config::saveAsync(app::getConfigFileName());
         }
     }
 
@@ -582,6 +595,17 @@ namespace neko::ui::window {
         persistConfigFromUi(saveNow);
     }
 
+    void NekoWindow::onConfigUpdated(std::shared_ptr<const ConfigChange> change) {
+        if (!change || change->empty()) {
+            return;
+        }
+        // Edits made through the settings page were applied by its live handlers already.
+        if (ownConfigVersions.erase(change->version) > 0) {
+            return;
+        }
+        applyConfigFields(*change->current, change.get());
+    }
+
     void NekoWindow::applyPendingWindowSize() {
         if (pendingWindowSizeText.isEmpty()) {
             return;
@@ -609,69 +633,96 @@ namespace neko::ui::window {
     }
 
     void NekoWindow::settingFromConfig(const ClientConfig &config) {
+        applyConfigFields(config, nullptr);
+    }
+
+    void NekoWindow::applyConfigFields(const ClientConfig &config, const ConfigChange *change) {
+        // Without a change everything is applied (initial load); otherwise only the groups whose fields changed,
+        // so an unrelated update does not re-polish fonts, theme and blur.
+        const bool full = (change == nullptr);
+        auto changed = [change](neko::strview section, neko::strview key) {
+            return change == nullptr || change->contains(section, key);
+        };
 
         // Main
 
-        useImageBackground = (neko::strview("image") == config.main.backgroundType);
-        if (useImageBackground) {
-            pixmapWidget->setPixmap(config.main.background);
-        } else {
-            pixmapWidget->clearPixmap();
+        if (changed("main", "backgroundType") || changed("main", "background")) {
+            useImageBackground = (neko::strview("image") == config.main.backgroundType);
+            if (useImageBackground) {
+                pixmapWidget->setPixmap(config.main.background);
+            } else {
+                pixmapWidget->clearPixmap();
+            }
+            applyCentralBackground(ui::getCurrentTheme());
         }
-        applyCentralBackground(ui::getCurrentTheme());
 
-        auto resolution = util::check::matchResolution(config.main.windowSize);
-        if (resolution) {
-            this->resize(std::stoi(resolution->width), std::stoi(resolution->height));
+        if (changed("main", "windowSize")) {
+            auto resolution = util::check::matchResolution(config.main.windowSize);
+            if (resolution) {
+                this->resize(std::stoi(resolution->width), std::stoi(resolution->height));
+            }
         }
 
-        saveImmediately = config.other.immediateSave;
+        if (changed("other", "immediateSave")) {
+            saveImmediately = config.other.immediateSave;
+        }
 
         // Style
-        QFont textFont(QString::fromStdString(config.style.fontFamilies));
-        if (config.style.fontPointSize > 0) {
-            textFont.setPointSize(static_cast<int>(config.style.fontPointSize));
-        } else {
-            textFont.setPointSize(10);
+        if (changed("style", "fontFamilies") || changed("style", "fontPointSize")) {
+            QFont textFont(QString::fromStdString(config.style.fontFamilies));
+            if (config.style.fontPointSize > 0) {
+                textFont.setPointSize(static_cast<int>(config.style.fontPointSize));
+            } else {
+                textFont.setPointSize(10);
+            }
+
+            auto [h1Font, h2Font] = ui::computeTitleFonts(textFont);
+            setupFont(textFont, h1Font, h2Font);
         }
 
-        auto [h1Font, h2Font] = ui::computeTitleFonts(textFont);
-        setupFont(textFont, h1Font, h2Font);
-        settingPage->settingFromConfig(config);
-        setupText();
+        if (full) {
+            settingPage->settingFromConfig(config);
+            setupText();
+        } else if (changed("main", "language")) {
+            onLanguageChanged(QString::fromStdString(config.main.lang));
+        }
 
-        {
+        if (changed("style", "theme")) {
             std::string lower = config.style.theme;
             for (auto &c : lower) {
                 c = static_cast<char>(::tolower(static_cast<unsigned char>(c)));
             }
             followSystemTheme = (lower == "system");
+            if (!full && !followSystemTheme) {
+                applyThemeSelection(config.style.theme);
+            }
             applySystemThemeIfNeeded();
         }
 
-        const bool logged = minecraft::auth::isLoggedIn();
-        const auto playerName = minecraft::auth::getPlayerName();
-        settingPage->setAuthState(logged, logged ? playerName : std::string{});
+        if (changed("minecraft", "accessToken") || changed("minecraft", "uuid") || changed("minecraft", "playerName")) {
+            const bool logged = !config.minecraft.accessToken.empty() && !config.minecraft.uuid.empty() && !config.minecraft.playerName.empty();
+            settingPage->setAuthState(logged, logged ? config.minecraft.playerName : std::string{});
+        }
 
-        if (config.style.blurRadius > 0 && config.style.blurRadius != 1) {
-            blurEffect->setBlurRadius(static_cast<qreal>(config.style.blurRadius));
-        } else {
-            blurEffect->setBlurRadius(0);
+        if (changed("style", "blurRadius")) {
+            if (config.style.blurRadius > 0 && config.style.blurRadius != 1) {
+                blurEffect->setBlurRadius(static_cast<qreal>(config.style.blurRadius));
+            } else {
+                blurEffect->setBlurRadius(0);
+            }
         }
 
-        if (config.style.blurEffect == "performance") {
-            blurEffect->setBlurHints(QGraphicsBlurEffect::PerformanceHint);
-        } else if (config.style.blurEffect == "quality") {
-            blurEffect->setBlurHints(QGraphicsBlurEffect::QualityHint);
-        } else {
-            blurEffect->setBlurHints(QGraphicsBlurEffect::AnimationHint);
+        if (changed("style", "blurEffect")) {
+            onBlurEffectChanged(QString::fromStdString(config.style.blurEffect));
         }
 
         // Show/hide music widget based on dev settings
-        if (config.dev.showMusicControl) {
-            musicWidget->show();
-        } else {
-            musicWidget->hide();
+        if (changed("dev", "showMusicControl")) {
+            if (config.dev.showMusicControl) {
+                musicWidget->show();
+            } else {
+                musicWidget->hide();
+            }
         }
     }
 
@@ -776,6 +827,7 @@ namespace neko::ui::window {
         bus::config::updateClientConfig([this](ClientConfig &cfg) {
             settingPage->writeToConfig(cfg);
         });
+        // Written before quitting: a deferred save could still be pending when the process exits.
         bus::config::save(app::getConfigFileName());
         QMainWindow::closeEvent(event);
         app::quit();
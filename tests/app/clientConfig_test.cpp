@@ -4,6 +4,10 @@
 #include <SimpleIni.h>
 #include <filesystem>
 #include <fstream>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace neko;
 
@@ -294,3 +298,67 @@ TEST_F(ClientConfigTest, MemoryLimits) {
     EXPECT_EQ(ini2.GetLongValue("minecraft", "minMemoryLimit"), 2048);
     EXPECT_EQ(ini2.GetLongValue("minecraft", "needMemoryLimit"), 4096);
 }
+
+// Test diff of identical configurations is empty
+TEST_F(ClientConfigTest, DiffIdenticalIsEmpty) {
+    CSimpleIniA ini;
+    ClientConfig a(ini);
+    ClientConfig b(ini);
+    EXPECT_TRUE(a.diff(b).empty());
+}
+
+// Test diff reports exactly the modified fields, keyed by INI section/key
+TEST_F(ClientConfigTest, DiffReportsChangedFields) {
+    CSimpleIniA ini;
+    ClientConfig before(ini);
+    ClientConfig after = before;
+    after.main.lang = "ja";
+    after.style.blurRadius = before.style.blurRadius + 5;
+    after.other.tempFolder = "/tmp/neko";
+
+    const auto keys = before.diff(after);
+    ASSERT_EQ(keys.size(), 3u);
+    EXPECT_EQ(keys[0], (ConfigKey{"main", "language"}));
+    EXPECT_EQ(keys[1], (ConfigKey{"style", "blurRadius"}));
+    EXPECT_EQ(keys[2], (ConfigKey{"other", "customTempDir"}));
+}
+
+// Test every key written to the INI file is one forEachField visits, and no other
+TEST_F(ClientConfigTest, SavedKeysMatchVisitedFields) {
+    CSimpleIniA ini;
+    ClientConfig config(ini);
+    CSimpleIniA saved;
+    config.setToConfig(saved);
+
+    std::vector<std::pair<std::string, std::string>> written;
+    CSimpleIniA::TNamesDepend sections;
+    saved.GetAllSections(sections);
+    for (const auto &section : sections) {
+        CSimpleIniA::TNamesDepend keys;
+        saved.GetAllKeys(section.pItem, keys);
+        for (const auto &key : keys) {
+            written.emplace_back(section.pItem, key.pItem);
+        }
+    }
+
+    std::vector<std::pair<std::string, std::string>> visited;
+    ClientConfig::forEachField(config, config, [&visited](const ConfigKey &key, const auto &, const auto &) {
+        visited.emplace_back(std::string(key.section), std::string(key.key));
+    });
+
+    std::sort(written.begin(), written.end());
+    std::sort(visited.begin(), visited.end());
+    EXPECT_EQ(written, visited);
+}
+
+// Test ConfigChange lookup helpers
+TEST_F(ClientConfigTest, ConfigChangeContains) {
+    ConfigChange change;
+    change.keys = {{"style", "theme"}, {"minecraft", "accessToken"}};
+
+    EXPECT_FALSE(change.empty());
+    EXPECT_TRUE(change.contains("style", "theme"));
+    EXPECT_FALSE(change.contains("style", "blurRadius"));
+    EXPECT_TRUE(change.containsSection("minecraft"));
+    EXPECT_FALSE(change.containsSection("net"));
+}
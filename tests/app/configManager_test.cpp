@@ -1,6 +1,8 @@
 
 #include "neko/app/configManager.hpp"
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <thread>
@@ -302,3 +304,216 @@ TEST_F(ConfigManagerTest, UpdateDoesntAffectPreviousConfigs) {
     // New config should have updated value
     EXPECT_EQ(newConfig.main.lang, "es");
 }
+
+// Test snapshots are shared between reads and immutable across updates
+TEST_F(ConfigManagerTest, SnapshotIsSharedAndImmutable) {
+    createTestConfigFile();
+    manager.load(testConfigFile);
+
+    auto first = manager.getSnapshot();
+    auto second = manager.getSnapshot();
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first.get(), second.get());
+
+    manager.updateClientConfig([](neko::ClientConfig &cfg) {
+        cfg.main.lang = "de";
+    });
+
+    auto third = manager.getSnapshot();
+    EXPECT_NE(first.get(), third.get());
+    EXPECT_EQ(first->main.lang, "en");
+    EXPECT_EQ(third->main.lang, "de");
+    EXPECT_EQ(third->main.resourceVersion, "1.0.0");
+}
+
+// Test version counter advances on load and on every update
+TEST_F(ConfigManagerTest, VersionAdvancesOnPublish) {
+    createTestConfigFile();
+    const auto initial = manager.getVersion();
+
+    manager.load(testConfigFile);
+    const auto loaded = manager.getVersion();
+    EXPECT_GT(loaded, initial);
+
+    manager.updateClientConfig([](neko::ClientConfig &cfg) {
+        cfg.net.thread = 8;
+    });
+    EXPECT_EQ(manager.getVersion(), loaded + 1);
+    EXPECT_EQ(manager.getSnapshot()->net.thread, 8);
+}
+
+// Test defaults are readable before any file is loaded
+TEST_F(ConfigManagerTest, SnapshotBeforeLoad) {
+    auto snapshot = manager.getSnapshot();
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->main.lang, "en");
+    EXPECT_EQ(snapshot->minecraft.maxMemoryLimit, 2048);
+}
+
+// Test readers always see a complete snapshot while writers publish
+TEST_F(ConfigManagerTest, ConcurrentSnapshotReads) {
+    createTestConfigFile();
+    manager.load(testConfigFile);
+
+    std::atomic<bool> stop{false};
+    std::atomic<bool> torn{false};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([this, &stop, &torn]() {
+            while (!stop.load()) {
+                auto snapshot = manager.getSnapshot();
+                // Writer keeps both fields equal, so a mismatch would mean a partially built snapshot.
+                if (snapshot->style.blurRadius != snapshot->style.fontPointSize) {
+                    torn = true;
+                }
+            }
+        });
+    }
+
+    manager.updateClientConfig([](neko::ClientConfig &cfg) {
+        cfg.style.fontPointSize = cfg.style.blurRadius;
+    });
+    for (int j = 0; j < 500; ++j) {
+        manager.updateClientConfig([j](neko::ClientConfig &cfg) {
+            cfg.style.blurRadius = j;
+            cfg.style.fontPointSize = j;
+        });
+    }
+    stop = true;
+    for (auto &thread : readers) {
+        thread.join();
+    }
+
+    EXPECT_FALSE(torn);
+}
+
+// Test async saves within the delay are coalesced into one write
+TEST_F(ConfigManagerTest, SaveAsyncCoalesces) {
+    createTestConfigFile();
+    manager.load(testConfigFile);
+    manager.setSaveDelay(std::chrono::milliseconds(200));
+
+    std::string saveFile = (std::filesystem::temp_directory_path() / "test_save_async.ini").string();
+    const auto writesBefore = manager.getWriteCount();
+    for (int i = 0; i < 20; ++i) {
+        manager.updateClientConfig([i](neko::ClientConfig &cfg) {
+            cfg.net.thread = i;
+        });
+        manager.saveAsync(saveFile);
+    }
+    EXPECT_TRUE(manager.flush());
+    EXPECT_EQ(manager.getWriteCount(), writesBefore + 1);
+
+    ConfigManager newManager;
+    newManager.load(saveFile);
+    EXPECT_EQ(newManager.getSnapshot()->net.thread, 19);
+
+    std::filesystem::remove(saveFile);
+}
+
+// Test the writer thread persists without an explicit flush
+TEST_F(ConfigManagerTest, SaveAsyncWritesAfterDelay) {
+    createTestConfigFile();
+    manager.load(testConfigFile);
+    manager.setSaveDelay(std::chrono::milliseconds(20));
+
+    std::string saveFile = (std::filesystem::temp_directory_path() / "test_save_delayed.ini").string();
+    std::filesystem::remove(saveFile);
+    manager.updateClientConfig([](neko::ClientConfig &cfg) {
+        cfg.main.lang = "ko";
+    });
+    manager.saveAsync(saveFile);
+
+    for (int i = 0; i < 200 && !std::filesystem::exists(saveFile); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    manager.flush();
+    ASSERT_TRUE(std::filesystem::exists(saveFile));
+    EXPECT_FALSE(std::filesystem::exists(saveFile + ".tmp"));
+
+    ConfigManager newManager;
+    newManager.load(saveFile);
+    EXPECT_EQ(newManager.getSnapshot()->main.lang, "ko");
+
+    std::filesystem::remove(saveFile);
+}
+
+// Test a synchronous save replaces the file and leaves no temp file behind
+TEST_F(ConfigManagerTest, SaveReplacesAtomically) {
+    createTestConfigFile();
+    manager.load(testConfigFile);
+
+    manager.updateClientConfig([](neko::ClientConfig &cfg) {
+        cfg.minecraft.playerName = "Replaced";
+    });
+    EXPECT_TRUE(manager.save(testConfigFile));
+    EXPECT_FALSE(std::filesystem::exists(testConfigFile + ".tmp"));
+
+    ConfigManager newManager;
+    newManager.load(testConfigFile);
+    EXPECT_EQ(newManager.getSnapshot()->minecraft.playerName, "Replaced");
+    EXPECT_EQ(newManager.getSnapshot()->main.resourceVersion, "1.0.0");
+}
+
+// Test pending async save is written when the manager is destroyed
+TEST_F(ConfigManagerTest, DestructorFlushesPendingSave) {
+    createTestConfigFile();
+    std::string saveFile = (std::filesystem::temp_directory_path() / "test_save_dtor.ini").string();
+    std::filesystem::remove(saveFile);
+    {
+        ConfigManager scoped;
+        scoped.load(testConfigFile);
+        scoped.setSaveDelay(std::chrono::seconds(60));
+        scoped.updateClientConfig([](neko::ClientConfig &cfg) {
+            cfg.minecraft.maxMemoryLimit = 6144;
+        });
+        scoped.saveAsync(saveFile);
+    }
+    ConfigManager newManager;
+    ASSERT_TRUE(newManager.load(saveFile));
+    EXPECT_EQ(newManager.getSnapshot()->minecraft.maxMemoryLimit, 6144);
+
+    std::filesystem::remove(saveFile);
+}
+
+// Test update returns only the fields that changed
+TEST_F(ConfigManagerTest, UpdateReportsChangedFields) {
+    createTestConfigFile();
+    manager.load(testConfigFile);
+
+    auto change = manager.updateClientConfig([](neko::ClientConfig &cfg) {
+        cfg.style.theme = "light";
+        cfg.net.thread = 4; // unchanged value
+    });
+
+    ASSERT_NE(change, nullptr);
+    EXPECT_EQ(change->version, manager.getVersion());
+    ASSERT_EQ(change->keys.size(), 1u);
+    EXPECT_TRUE(change->contains("style", "theme"));
+    EXPECT_EQ(change->previous->style.theme, "dark");
+    EXPECT_EQ(change->current->style.theme, "light");
+    EXPECT_EQ(change->current, manager.getSnapshot());
+}
+
+// Test the listener sees non-empty changes only, including reloads
+TEST_F(ConfigManagerTest, ChangeListenerSkipsNoOpUpdates) {
+    createTestConfigFile();
+    std::vector<ConfigManager::Change> received;
+    manager.setChangeListener([&received](const ConfigManager::Change &change) {
+        received.push_back(change);
+    });
+
+    manager.load(testConfigFile);
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_TRUE(received[0]->contains("main", "resourceVersion"));
+
+    manager.updateClientConfig([](neko::ClientConfig &) {});
+    EXPECT_EQ(received.size(), 1u);
+
+    manager.updateClientConfig([](neko::ClientConfig &cfg) {
+        cfg.minecraft.playerName = "Listener";
+    });
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_TRUE(received[1]->contains("minecraft", "playerName"));
+    EXPECT_FALSE(received[1]->containsSection("main"));
+}
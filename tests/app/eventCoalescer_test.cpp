@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <neko/event/event.hpp>
+
+#include "neko/bus/eventBus.hpp"
+#include "neko/bus/eventCoalescer.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace neko;
+using namespace std::chrono_literals;
+
+namespace {
+
+    struct ProgressEvent {
+        int value = 0;
+    };
+
+    struct StatusEvent {
+        std::string text;
+    };
+
+    // Collects delivered values in order; waitFor() blocks until enough arrived.
+    template <typename T>
+    class Recorder {
+    private:
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<std::pair<T, std::chrono::steady_clock::time_point>> received;
+
+    public:
+        void add(T value) {
+            {
+                std::lock_guard lock(mutex);
+                received.emplace_back(std::move(value), std::chrono::steady_clock::now());
+            }
+            cv.notify_all();
+        }
+
+        bool waitFor(std::size_t count, std::chrono::milliseconds timeout = 5s) {
+            std::unique_lock lock(mutex);
+            return cv.wait_for(lock, timeout, [&] { return received.size() >= count; });
+        }
+
+        std::vector<T> values() {
+            std::lock_guard lock(mutex);
+            std::vector<T> result;
+            for (const auto &[value, at] : received) {
+                result.push_back(value);
+            }
+            return result;
+        }
+
+        std::chrono::steady_clock::time_point timeOf(std::size_t i) {
+            std::lock_guard lock(mutex);
+            return received.at(i).second;
+        }
+    };
+
+} // namespace
+
+class EventCoalescerTest : public ::testing::Test {
+protected:
+    event::EventLoop loop;
+    bus::EventCoalescer coalescer{loop};
+    Recorder<int> progress;
+    Recorder<std::string> status;
+    std::thread runner;
+
+    void SetUp() override {
+        loop.subscribe<ProgressEvent>([this](const ProgressEvent &evt) { progress.add(evt.value); });
+        loop.subscribe<StatusEvent>([this](const StatusEvent &evt) { status.add(evt.text); });
+        runner = std::thread([this] { loop.run(); });
+    }
+
+    void TearDown() override {
+        loop.stopLoop();
+        runner.join();
+    }
+};
+
+// Test publishing again into a pending slot replaces the value instead of queueing another
+TEST_F(EventCoalescerTest, ReplacesPendingValueInSlot) {
+    coalescer.setRate(1); // the first flush is immediate; keep later ones out of the way
+    coalescer.flush();
+
+    for (int i = 1; i <= 100; ++i) {
+        coalescer.publish(ProgressEvent{.value = i});
+    }
+    EXPECT_EQ(coalescer.getPendingCount(), 1u);
+
+    coalescer.flush();
+    EXPECT_EQ(coalescer.getPendingCount(), 0u);
+    ASSERT_TRUE(progress.waitFor(1));
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(progress.values(), std::vector<int>{100});
+}
+
+// Test each (type, key) pair is its own slot and slots are delivered in first-published order
+TEST_F(EventCoalescerTest, KeepsSeparateSlotsPerTypeAndKey) {
+    coalescer.setRate(1);
+    coalescer.flush();
+
+    coalescer.publish(StatusEvent{.text = "a1"}, "a");
+    coalescer.publish(StatusEvent{.text = "b1"}, "b");
+    coalescer.publish(ProgressEvent{.value = 1});
+    coalescer.publish(StatusEvent{.text = "a2"}, "a");
+    EXPECT_EQ(coalescer.getPendingCount(), 3u);
+
+    coalescer.flush();
+    ASSERT_TRUE(status.waitFor(2));
+    ASSERT_TRUE(progress.waitFor(1));
+    EXPECT_EQ(status.values(), (std::vector<std::string>{"a2", "b1"}));
+    EXPECT_EQ(progress.values(), std::vector<int>{1});
+}
+
+// Test deliveries are at least one interval apart at the configured rate
+TEST_F(EventCoalescerTest, CapsDeliveryRate) {
+    coalescer.setRate(10); // 100 ms interval
+
+    coalescer.publish(ProgressEvent{.value = 1});
+    ASSERT_TRUE(progress.waitFor(1));
+    coalescer.publish(ProgressEvent{.value = 2});
+    coalescer.publish(ProgressEvent{.value = 3});
+    ASSERT_TRUE(progress.waitFor(2));
+
+    EXPECT_EQ(progress.values(), (std::vector<int>{1, 3}));
+    EXPECT_GE(progress.timeOf(1) - progress.timeOf(0), 90ms);
+    EXPECT_EQ(coalescer.getPendingCount(), 0u);
+}
+
+// Test a flush scheduled before a manual flush is skipped, so the next batch still waits a full interval
+TEST_F(EventCoalescerTest, SkipsFlushOvertakenByManualFlush) {
+    coalescer.setRate(10); // 100 ms interval
+    coalescer.flush();
+
+    coalescer.publish(ProgressEvent{.value = 1}); // schedules a flush 100 ms from now
+    std::this_thread::sleep_for(60ms);
+    coalescer.flush();
+    ASSERT_TRUE(progress.waitFor(1));
+
+    // Without the generation check, the first scheduled flush would deliver this ~40 ms later.
+    coalescer.publish(ProgressEvent{.value = 2});
+    ASSERT_TRUE(progress.waitFor(2));
+
+    EXPECT_EQ(progress.values(), (std::vector<int>{1, 2}));
+    EXPECT_GE(progress.timeOf(1) - progress.timeOf(0), 90ms);
+}
+
+// Test rate 0 turns coalescing off
+TEST_F(EventCoalescerTest, ZeroRatePublishesEveryEvent) {
+    coalescer.setRate(0);
+    for (int i = 1; i <= 5; ++i) {
+        coalescer.publish(ProgressEvent{.value = i});
+    }
+    EXPECT_EQ(coalescer.getPendingCount(), 0u);
+    ASSERT_TRUE(progress.waitFor(5));
+    EXPECT_EQ(progress.values(), (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+// Test flushCoalesced delivers the pending value at once and the scheduled flush has nothing left
+TEST(EventCoalescerBusTest, FlushCoalescedDeliversPendingNow) {
+    Recorder<int> received;
+    bus::event::subscribe<ProgressEvent>([&received](const ProgressEvent &evt) { received.add(evt.value); });
+    std::thread runner([] { bus::event::run(); });
+
+    bus::event::setCoalesceRate(2); // 500 ms interval
+    bus::event::flushCoalesced();
+    bus::event::publishCoalesced(ProgressEvent{.value = 7});
+    EXPECT_EQ(bus::getEventCoalescer().getPendingCount(), 1u);
+
+    bus::event::flushCoalesced();
+    EXPECT_EQ(bus::getEventCoalescer().getPendingCount(), 0u);
+    ASSERT_TRUE(received.waitFor(1));
+
+    // The flush scheduled by the publish was overtaken and delivers nothing.
+    std::this_thread::sleep_for(700ms);
+    EXPECT_EQ(received.values(), std::vector<int>{7});
+
+    bus::event::setCoalesceRate(30);
+    bus::event::stopLoop();
+    runner.join();
+}
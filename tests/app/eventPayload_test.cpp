@@ -0,0 +1,73 @@
+#include "neko/event/eventTypes.hpp"
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace neko;
+
+namespace {
+    std::vector<api::NewsItem> makeNewsItems(std::size_t count) {
+        std::vector<api::NewsItem> items(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            items[i].id = "news-" + std::to_string(i);
+            items[i].title = "Title of the news entry number " + std::to_string(i);
+            items[i].summary = std::string(256, 'x');
+            items[i].link = "https://example.com/news/" + std::to_string(i);
+        }
+        return items;
+    }
+} // namespace
+
+class EventPayloadTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(EventPayloadTest, CopySharesPayload) {
+    event::NewsLoadedEvent evt{.items = event::makeShared(makeNewsItems(8)), .hasMore = true};
+    const event::NewsLoadedEvent copy = evt;
+
+    EXPECT_EQ(copy.items.get(), evt.items.get());
+    EXPECT_EQ(copy.items->size(), 8u);
+    EXPECT_TRUE(copy.hasMore);
+}
+
+TEST_F(EventPayloadTest, DefaultNewsEventHasEmptyPayload) {
+    event::NewsLoadedEvent evt;
+    ASSERT_NE(evt.items, nullptr);
+    EXPECT_TRUE(evt.items->empty());
+}
+
+TEST_F(EventPayloadTest, ValueConstructorMovesMessage) {
+    ui::NoticeMsg notice{.title = "Title", .message = std::string(1024, 'm')};
+    event::ShowNoticeEvent evt(std::move(notice));
+    const event::ShowNoticeEvent copy = evt;
+
+    EXPECT_EQ(copy.notice.get(), evt.notice.get());
+    EXPECT_EQ(copy.notice->title, "Title");
+    EXPECT_EQ(copy.notice->message.size(), 1024u);
+}
+
+// Test fanning one payload out to many subscribers copies no items: every copy holds the same allocation
+TEST_F(EventPayloadTest, FanOutSharesOneAllocation) {
+    constexpr std::size_t itemCount = 4000;
+    constexpr std::size_t copies = 64;
+
+    auto items = makeNewsItems(itemCount);
+    const auto *itemData = items.data();
+    const event::NewsLoadedEvent shared{.items = event::makeShared(std::move(items))};
+    // makeShared moves the vector in, so the items themselves were never copied.
+    EXPECT_EQ(shared.items->data(), itemData);
+
+    std::vector<event::NewsLoadedEvent> delivered(copies, shared);
+    EXPECT_EQ(shared.items.use_count(), static_cast<long>(copies + 1));
+    for (const auto &copy : delivered) {
+        EXPECT_EQ(copy.items.get(), shared.items.get());
+    }
+
+    delivered.clear();
+    EXPECT_EQ(shared.items.use_count(), 1);
+    EXPECT_EQ(shared.items->size(), itemCount);
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+#include "neko/app/hostProbe.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace neko;
+using namespace std::chrono_literals;
+
+class HostProbeTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        joinAll();
+    }
+
+    // Runs each probe on a plain thread joined by the test.
+    app::hosts::HostProber::Spawner spawner() {
+        return [this](std::function<void()> task) {
+            std::lock_guard lock(threadsMutex);
+            threads.emplace_back(std::move(task));
+        };
+    }
+
+    void joinAll() {
+        std::vector<std::thread> pending;
+        {
+            std::lock_guard lock(threadsMutex);
+            pending.swap(threads);
+        }
+        for (auto &thread : pending) {
+            thread.join();
+        }
+    }
+
+    // A host answers after `delay`, or fails after it when `healthy` is false.
+    struct FakeHost {
+        std::chrono::milliseconds delay{0};
+        bool healthy = true;
+    };
+
+    app::hosts::HostProber::Probe fakeProbe(std::map<std::string, FakeHost> hosts) {
+        return [hosts = std::move(hosts)](const std::string &host) {
+            const auto &fake = hosts.at(host);
+            std::this_thread::sleep_for(fake.delay);
+            if (!fake.healthy) {
+                throw std::runtime_error("connection refused");
+            }
+            return app::hosts::ProbeResult{.host = host, .healthy = true};
+        };
+    }
+
+    std::mutex threadsMutex;
+    std::vector<std::thread> threads;
+};
+
+// Test probeAll returns with the first healthy host while slower probes keep running
+TEST_F(HostProbeTest, ReleasesOnFirstHealthyHost) {
+    app::hosts::HostProber prober({"slow", "fast", "dead"},
+                                  fakeProbe({{"slow", {200ms, true}}, {"fast", {10ms, true}}, {"dead", {250ms, false}}}),
+                                  spawner());
+
+    const auto begin = std::chrono::steady_clock::now();
+    const auto ranked = prober.probeAll();
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, 150ms);
+    EXPECT_EQ(ranked, (std::vector<std::string>{"fast"}));
+
+    joinAll();
+    EXPECT_EQ(prober.getRanking().getRanked(), (std::vector<std::string>{"fast", "slow"}));
+}
+
+// Test the listener re-ranks when late probes finish
+TEST_F(HostProbeTest, LateProbesNotifyListener) {
+    app::hosts::HostProber prober({"a", "b"}, fakeProbe({{"a", {80ms, true}}, {"b", {5ms, true}}}), spawner());
+    std::atomic<int> changes{0};
+    prober.getRanking().setListener([&]() { ++changes; });
+
+    (void)prober.probeAll();
+    joinAll();
+    EXPECT_EQ(changes.load(), 2);
+    EXPECT_EQ(prober.getRanking().getRanked(), (std::vector<std::string>{"b", "a"}));
+}
+
+// Test the deadline bounds the wait when no host answers in time
+TEST_F(HostProbeTest, DeadlineBoundsTheWait) {
+    app::hosts::HostProber prober({"hung"}, fakeProbe({{"hung", {300ms, true}}}), spawner(), {},
+                                  app::hosts::HostProber::Options{.deadline = 50ms});
+
+    const auto begin = std::chrono::steady_clock::now();
+    EXPECT_TRUE(prober.probeAll().empty());
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, 200ms);
+
+    // A probe still in flight is not started twice.
+    EXPECT_TRUE(prober.probeAll().empty());
+    joinAll();
+    EXPECT_EQ(prober.getRanking().getRanked(), (std::vector<std::string>{"hung"}));
+}
+
+// Test smoothing keeps one slow sample from reordering hosts, and failures drop a host
+TEST_F(HostProbeTest, RankingSmoothsAndDropsFailures) {
+    app::hosts::HostRanking ranking({"a", "b"});
+    ranking.record({.host = "a", .healthy = true, .rtt = 20ms});
+    ranking.record({.host = "b", .healthy = true, .rtt = 40ms});
+    EXPECT_EQ(ranking.getRanked(), (std::vector<std::string>{"a", "b"}));
+
+    ranking.record({.host = "a", .healthy = true, .rtt = 60ms}); // 0.7 * 20 + 0.3 * 60 = 32
+    EXPECT_EQ(ranking.getRtt("a"), 32ms);
+    EXPECT_EQ(ranking.getRanked(), (std::vector<std::string>{"a", "b"}));
+
+    ranking.record({.host = "a", .healthy = false});
+    EXPECT_EQ(ranking.getRanked(), (std::vector<std::string>{"b"}));
+    ranking.record({.host = "unknown", .healthy = true, .rtt = 1ms});
+    EXPECT_EQ(ranking.getRanked(), (std::vector<std::string>{"b"}));
+}
+
+// Test periodic re-probing runs until stopped
+TEST_F(HostProbeTest, PeriodicReprobeUntilStopped) {
+    std::atomic<int> probes{0};
+    auto probe = [&](const std::string &host) {
+        ++probes;
+        return app::hosts::ProbeResult{.host = host, .healthy = true};
+    };
+    app::hosts::HostProber prober({"a"}, probe, spawner(), {}, app::hosts::HostProber::Options{.deadline = 100ms, .interval = 10ms});
+
+    prober.startPeriodic();
+    std::this_thread::sleep_for(100ms);
+    prober.stop();
+    joinAll();
+    const int afterStop = probes.load();
+    EXPECT_GE(afterStop, 2);
+
+    std::this_thread::sleep_for(30ms);
+    EXPECT_EQ(probes.load(), afterStop);
+}
+
+// Test health persisted by one launch lets the next start from the cached ranking
+TEST_F(HostProbeTest, WarmStartFromPersistedHealth) {
+    const auto dir = std::filesystem::temp_directory_path() / "neko_host_probe_test";
+    std::filesystem::remove_all(dir);
+    const auto cacheFile = (dir / "host-health.json").string();
+
+    {
+        app::hosts::HostProber prober({"a", "b", "c"}, fakeProbe({{"a", {60ms, true}}, {"b", {5ms, true}}, {"c", {5ms, false}}}), spawner(), cacheFile);
+        EXPECT_TRUE(prober.warmStart().empty());
+        (void)prober.probeAll();
+        joinAll();
+    }
+    ASSERT_TRUE(std::filesystem::exists(cacheFile));
+
+    std::atomic<int> probes{0};
+    auto probe = [&](const std::string &host) {
+        ++probes;
+        return app::hosts::ProbeResult{.host = host, .healthy = true};
+    };
+    app::hosts::HostProber restarted({"a", "b", "c"}, probe, spawner(), cacheFile);
+    EXPECT_EQ(restarted.warmStart(), (std::vector<std::string>{"b", "a"}));
+    EXPECT_EQ(probes.load(), 0);
+
+    const auto health = app::hosts::loadHealth(cacheFile);
+    ASSERT_EQ(health.size(), 3u);
+    EXPECT_EQ(health[2].host, "c");
+    EXPECT_EQ(health[2].failureStreak, 1u);
+    EXPECT_EQ(health[2].lastSuccessMs, 0);
+
+    // A failed real request drops the host and is remembered.
+    restarted.markFailed("b", "timeout");
+    EXPECT_EQ(restarted.getRanking().getRanked(), (std::vector<std::string>{"a"}));
+    EXPECT_EQ(app::hosts::loadHealth(cacheFile)[1].failureStreak, 1u);
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test stale or failing cached hosts are not trusted
+TEST_F(HostProbeTest, WarmStartIgnoresStaleHealth) {
+    const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    app::hosts::HostRanking ranking({"old", "flaky", "recent"});
+    ranking.restore({{.host = "old", .lastSuccessMs = now - 2 * 3600 * 1000, .rttMs = 5},
+                     {.host = "flaky", .lastSuccessMs = now, .rttMs = 5, .failureStreak = 2},
+                     {.host = "recent", .lastSuccessMs = now, .rttMs = 50}},
+                    std::chrono::hours(1));
+    EXPECT_EQ(ranking.getRanked(), (std::vector<std::string>{"recent"}));
+}
+
+// Test refresh reports the first healthy answer once, and not at all when every host fails
+TEST_F(HostProbeTest, RefreshReportsFirstHealthyHost) {
+    app::hosts::HostProber prober({"a", "b", "dead"}, fakeProbe({{"a", {20ms, true}}, {"b", {5ms, true}}, {"dead", {5ms, false}}}), spawner());
+    std::atomic<int> confirmed{0};
+    prober.refresh([&]() {
+        EXPECT_FALSE(prober.getRanking().getRanked().empty());
+        ++confirmed;
+    });
+    joinAll();
+    EXPECT_EQ(confirmed.load(), 1);
+
+    app::hosts::HostProber offline({"dead"}, fakeProbe({{"dead", {5ms, false}}}), spawner());
+    offline.refresh([&]() { ++confirmed; });
+    joinAll();
+    EXPECT_EQ(confirmed.load(), 1);
+}
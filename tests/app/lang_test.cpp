@@ -2,8 +2,12 @@
 #include "neko/app/lang.hpp"
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 using namespace neko::lang;
 
@@ -306,3 +310,226 @@ TEST_F(LangTest, CompleteTranslationWorkflow) {
     });
     EXPECT_EQ(result, "Hello TestName, welcome to TestPlace ZH!");
 }
+
+// Test flat table lookups, including top-level strings and misses
+TEST_F(LangTest, TranslationTableLookup) {
+    auto table = TranslationTable::fromJson(loadTranslations("en", testLangDir), "en");
+
+    EXPECT_EQ(table.getLanguageCode(), "en");
+    EXPECT_EQ(table.size(), 7u);
+    EXPECT_EQ(table.find("test", "greeting").value_or(""), "Hello");
+    EXPECT_EQ(table.find("maintenance", "title").value_or(""), "Maintenance");
+    EXPECT_EQ(table.find("", "language").value_or(""), "English");
+    EXPECT_FALSE(table.find("test", "missing").has_value());
+    EXPECT_FALSE(table.find("missing", "greeting").has_value());
+}
+
+// Test identical strings are stored once in the pool
+TEST_F(LangTest, TranslationTableInternsStrings) {
+    nlohmann::json json = {
+        {"a", {{"ok", "OK"}, {"cancel", "Cancel"}}},
+        {"b", {{"ok", "OK"}, {"cancel", "Cancel"}}}};
+    auto table = TranslationTable::fromJson(json);
+
+    EXPECT_EQ(table.size(), 4u);
+    // "a", "b", "ok", "OK", "cancel", "Cancel"
+    EXPECT_EQ(table.getPoolSize(), std::string("abokOKcancelCancel").size());
+    EXPECT_EQ(table.find("b", "cancel").value_or(""), "Cancel");
+}
+
+// Test the current table follows language() and reloadTranslations()
+TEST_F(LangTest, CurrentTableFollowsLanguage) {
+    reloadTranslations(testLangDir);
+    language("en");
+    EXPECT_EQ(tr("test", "greeting", "Not found"), "Hello");
+
+    auto english = getTranslations();
+    language("zh_tw");
+    EXPECT_EQ(tr("test", "greeting", "Not found"), "Hello ZH");
+    // A table handed out earlier is unaffected by the switch.
+    EXPECT_EQ(english->find("test", "greeting").value_or(""), "Hello");
+
+    auto handle = trView("maintenance", "title", "Not found");
+    EXPECT_TRUE(handle.found());
+    EXPECT_EQ(handle.view(), "Maintenance ZH");
+
+    auto missing = trView("test", "missing", std::string("Fallback"));
+    EXPECT_FALSE(missing.found());
+    EXPECT_EQ(missing.view(), "Fallback");
+
+    reloadTranslations();
+}
+
+// Test the key registry assigns dense IDs in declaration order
+TEST_F(LangTest, KeyRegistryIsDense) {
+    static_assert(keys::language.id == 0);
+    static_assert(keys::setting::tabAccount.id == 1);
+    static_assert(keys::loading::starting.id == keys::setting::close.id + 1);
+    static_assert(keys::all[keys::maintenance::title.id].id == keys::maintenance::title.id);
+
+    EXPECT_STREQ(keys::all[keys::maintenance::title.id].category, "maintenance");
+    EXPECT_STREQ(keys::all[keys::maintenance::title.id].name, "title");
+    EXPECT_STREQ(keys::news::continueBtn, "continue");
+    EXPECT_EQ(keys::all.back().id, keys::network::skip.id);
+}
+
+// Test registered keys resolve by ID and missing ones are reported at load
+TEST_F(LangTest, KeyLookupResolvesById) {
+    auto table = TranslationTable::fromJson(loadTranslations("en", testLangDir), "en", keys::all);
+
+    EXPECT_EQ(table.find(keys::maintenance::title).value_or(""), "Maintenance");
+    EXPECT_EQ(table.find(keys::language).value_or(""), "English");
+    EXPECT_FALSE(table.find(keys::maintenance::checkingStatus).has_value());
+
+    // language, maintenance.title and maintenance.message are the only registered keys present.
+    const auto &missing = table.getMissingKeys();
+    EXPECT_EQ(missing.size(), keys::all.size() - 3);
+    EXPECT_NE(std::find_if(missing.begin(), missing.end(), [](const Key &key) { return key.id == keys::maintenance::downloadPoster.id; }), missing.end());
+
+    // Keys outside the registry use the hash path.
+    EXPECT_EQ(table.find(Key{"test", "greeting", static_cast<neko::uint32>(keys::all.size())}).value_or(""), "Hello");
+
+    // An ad-hoc key without an ID must not resolve through ID 0 (keys::language).
+    EXPECT_EQ(Key{}.id, Key::invalidId);
+    EXPECT_EQ(table.find(Key{.category = "test", .name = "greeting"}).value_or(""), "Hello");
+    EXPECT_FALSE(table.find(Key{.category = "test", .name = "absent"}).has_value());
+}
+
+// Test tr() with registered keys, including a category that differs from the key's own
+TEST_F(LangTest, TrWithRegisteredKeys) {
+    reloadTranslations(testLangDir);
+    language("zh_tw");
+
+    EXPECT_EQ(tr(keys::maintenance::category, keys::maintenance::title, "Not found"), "Maintenance ZH");
+    EXPECT_EQ(tr(keys::maintenance::category, keys::maintenance::parseIng, "Not found"), "Not found");
+    EXPECT_EQ(trView(keys::maintenance::category, keys::maintenance::message).view(), "System maintenance ZH");
+    // Same key name looked up in another category goes through the hash lookup.
+    EXPECT_EQ(tr("maintenance", keys::about::title, "Not found"), "Maintenance ZH");
+    EXPECT_EQ(trWithReplaced(keys::maintenance::category, keys::maintenance::title, {{"ZH", "TW"}}), "Maintenance TW");
+
+    reloadTranslations();
+}
+
+// Test a compiled pack round-trips through its header and mapping
+TEST_F(LangTest, LanguagePackRoundTrip) {
+    const std::string packPath = pack::getPackPath("en", testLangDir);
+    const auto source = pack::getSourceStamp(pack::getSourcePath("en", testLangDir));
+    ASSERT_TRUE(source.has_value());
+    ASSERT_TRUE(pack::write(packPath, pack::compile(loadTranslations("en", testLangDir), *source)));
+
+    auto info = pack::readInfo(packPath);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->displayName, "English");
+    EXPECT_EQ(info->keyCount, 7u);
+    EXPECT_EQ(info->source, *source);
+
+    auto table = pack::open(packPath, "en", keys::all);
+    ASSERT_TRUE(table.has_value());
+    EXPECT_EQ(table->size(), 7u);
+    EXPECT_EQ(table->find("test", "greeting").value_or(""), "Hello");
+    EXPECT_EQ(table->find(keys::maintenance::title).value_or(""), "Maintenance");
+    EXPECT_EQ(table->getLanguageCode(), "en");
+
+    // A copy keeps the mapping alive.
+    TranslationTable copy = *table;
+    table.reset();
+    EXPECT_EQ(copy.find("test", "farewell").value_or(""), "Goodbye");
+}
+
+// Test malformed packs are rejected
+TEST_F(LangTest, LanguagePackRejectsGarbage) {
+    const std::string packPath = pack::getPackPath("fr", testLangDir);
+    std::ofstream(packPath, std::ios::binary) << "not a language pack at all, just some bytes padding the header";
+
+    EXPECT_FALSE(pack::readInfo(packPath).has_value());
+    EXPECT_FALSE(pack::open(packPath).has_value());
+    EXPECT_FALSE(pack::open(pack::getPackPath("missing", testLangDir)).has_value());
+}
+
+// Test the language list compiles packs once and follows JSON changes
+TEST_F(LangTest, GetLanguagesUsesPacks) {
+    auto languages = getLanguages(testLangDir);
+    ASSERT_EQ(languages.size(), 2u);
+    EXPECT_TRUE(std::filesystem::exists(pack::getPackPath("en", testLangDir)));
+    EXPECT_TRUE(std::filesystem::exists(pack::getPackPath("zh_tw", testLangDir)));
+
+    // A changed JSON recompiles its pack.
+    createTestLanguageFile("en", {{"language", "English (United States)"}, {"test", {{"greeting", "Hi"}}}});
+    languages = getLanguages(testLangDir);
+    const auto en = std::find_if(languages.begin(), languages.end(), [](const auto &lang) { return lang.first == "en"; });
+    ASSERT_NE(en, languages.end());
+    EXPECT_EQ(en->second, "English (United States)");
+
+    // A pack without its JSON is still listed and loadable.
+    std::filesystem::remove(pack::getSourcePath("zh_tw", testLangDir));
+    languages = getLanguages(testLangDir);
+    const auto zh = std::find_if(languages.begin(), languages.end(), [](const auto &lang) { return lang.first == "zh_tw"; });
+    ASSERT_NE(zh, languages.end());
+    EXPECT_EQ(zh->second, "Traditional Chinese");
+    EXPECT_EQ(loadTranslationTable("zh_tw", testLangDir).find("test", "greeting").value_or(""), "Hello ZH");
+}
+
+// Test a fallback table is labelled with the language actually loaded
+TEST_F(LangTest, FallbackTableIsLabelledEnglish) {
+    auto table = loadTranslationTable("fr", testLangDir);
+    EXPECT_EQ(table.getLanguageCode(), "en");
+    EXPECT_EQ(table.find("test", "greeting").value_or(""), "Hello");
+    EXPECT_NE(lastLoadError().find("Falling back"), std::string::npos);
+
+    EXPECT_EQ(loadTranslationTable("zh_tw", testLangDir).getLanguageCode(), "zh_tw");
+}
+
+// Test concurrent compiles of one pack neither collide on the temp file nor leave a broken pack
+TEST_F(LangTest, ConcurrentPackRefresh) {
+    for (int round = 0; round < 5; ++round) {
+        createTestLanguageFile("en", {{"language", "English " + std::to_string(round)}, {"test", {{"greeting", "Hello " + std::to_string(round)}}}});
+        std::filesystem::remove(pack::getPackPath("en", testLangDir));
+
+        std::vector<std::thread> threads;
+        std::atomic<int> loaded{0};
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back([&, i] {
+                if (i % 2 == 0) {
+                    (void)getLanguages(testLangDir);
+                } else if (loadTranslationTable("en", testLangDir).find("test", "greeting") == "Hello " + std::to_string(round)) {
+                    ++loaded;
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        EXPECT_EQ(loaded.load(), 2);
+        EXPECT_FALSE(std::filesystem::exists(pack::getPackPath("en", testLangDir) + ".tmp"));
+        EXPECT_EQ(loadTranslationTable("en", testLangDir).find("", "language").value_or(""), "English " + std::to_string(round));
+    }
+}
+
+// Test table lookups view the shared string pool: no per-call copy, equal texts interned once, same answers as the JSON path
+TEST_F(LangTest, TableLookupViewsPool) {
+    nlohmann::json json;
+    for (int c = 0; c < 20; ++c) {
+        for (int k = 0; k < 40; ++k) {
+            json["category" + std::to_string(c)]["key" + std::to_string(k)] = "Translated text number " + std::to_string(c * 40 + k);
+        }
+    }
+    json["category0"]["duplicate"] = "Translated text number 13";
+    auto table = TranslationTable::fromJson(json);
+    EXPECT_EQ(table.size(), 801u);
+
+    const auto first = table.find("category7", "key13");
+    ASSERT_TRUE(first.has_value());
+    for (int i = 0; i < 100; ++i) {
+        const auto again = table.find("category7", "key13");
+        ASSERT_TRUE(again.has_value());
+        EXPECT_EQ(again->data(), first->data());
+    }
+    EXPECT_EQ(table.find("category0", "duplicate")->data(), table.find("category0", "key13")->data());
+
+    for (const auto &[category, values] : json.items()) {
+        for (const auto &[key, value] : values.items()) {
+            EXPECT_EQ(table.find(category, key).value_or("Not found"), tr(category, key, "Not found", json));
+        }
+    }
+    EXPECT_FALSE(table.find("category7", "missing").has_value());
+}
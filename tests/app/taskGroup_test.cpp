@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <neko/schema/exception.hpp>
+
+#include "neko/bus/taskGroup.hpp"
+#include "neko/bus/threadBus.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace neko;
+using namespace std::chrono_literals;
+using bus::thread::CancellationToken;
+using bus::thread::TaskGroup;
+
+class TaskGroupTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        bus::thread::setThreadCount(bus::Executor::cpu, 2);
+    }
+
+    // Occupies every cpu worker until release() so later tasks stay queued.
+    struct Blocker {
+        std::promise<void> gate;
+        std::shared_future<void> opened = gate.get_future().share();
+        std::vector<std::future<void>> running;
+
+        explicit Blocker(neko::uint64 workers) {
+            std::atomic<neko::uint64> started{0};
+            for (neko::uint64 i = 0; i < workers; ++i) {
+                running.push_back(bus::thread::submit([this, &started] {
+                    ++started;
+                    opened.wait();
+                }));
+            }
+            while (started.load() < workers) {
+                std::this_thread::yield();
+            }
+        }
+
+        void release() {
+            gate.set_value();
+            for (auto &f : running) {
+                f.get();
+            }
+        }
+    };
+};
+
+// Test the first failure cancels the token seen by the other running tasks
+TEST_F(TaskGroupTest, FailFastCancelsRunningTasks) {
+    TaskGroup group;
+    std::atomic<bool> waiting{false}, sawCancel{false};
+    auto waiter = group.spawn([&](const CancellationToken &token) {
+        waiting = true;
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (!token.isCancelled() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+        sawCancel = token.isCancelled();
+    });
+    auto failing = group.spawn([&waiting]() {
+        while (!waiting) {
+            std::this_thread::yield();
+        }
+        throw std::runtime_error("boom");
+    });
+    group.waitAll();
+
+    EXPECT_TRUE(sawCancel);
+    EXPECT_TRUE(group.isCancelled());
+    EXPECT_TRUE(group.hasFailed());
+    EXPECT_EQ(group.getFirstError(), "boom");
+    EXPECT_EQ(group.getToken().getReason(), "boom");
+    EXPECT_THROW(failing.get(), std::runtime_error);
+    EXPECT_NO_THROW(waiter.get());
+}
+
+// Test tasks still queued at cancel time never run and do not count as failures
+TEST_F(TaskGroupTest, SkipsQueuedTasksAfterCancel) {
+    Blocker blocker(bus::thread::getThreadCount());
+    TaskGroup group;
+    std::atomic<int> ran{0};
+    std::vector<std::shared_future<void>> futures;
+    for (int i = 0; i < 5; ++i) {
+        futures.push_back(group.spawn([&ran]() { ++ran; }));
+    }
+
+    EXPECT_TRUE(group.getToken().getReason().empty());
+    group.cancelAll("user cancelled");
+    blocker.release();
+    group.waitAll();
+
+    EXPECT_EQ(ran.load(), 0);
+    EXPECT_FALSE(group.hasFailed());
+    EXPECT_EQ(group.getToken().getReason(), "user cancelled");
+    for (auto &future : futures) {
+        EXPECT_THROW(future.get(), ex::Runtime);
+    }
+}
+
+// Test rethrowIfFailed rethrows the first failure with its original type
+TEST_F(TaskGroupTest, RethrowIfFailedKeepsExceptionType) {
+    {
+        TaskGroup group(bus::Executor::cpu, {}, bus::TaskClass::normal, false);
+        (void)group.spawn([]() { throw ex::FileError("missing file"); });
+        group.waitAll();
+        EXPECT_FALSE(group.isCancelled()); // not fail-fast
+        EXPECT_THROW(group.rethrowIfFailed(), ex::FileError);
+    }
+    {
+        TaskGroup group;
+        (void)group.spawn([]() { return 1; });
+        group.waitAll();
+        EXPECT_NO_THROW(group.rethrowIfFailed());
+    }
+}
+
+// Test the destructor waits for running tasks, and cancels queued ones while unwinding
+TEST_F(TaskGroupTest, DestructorWaitsForTasks) {
+    std::atomic<bool> finished{false};
+    {
+        TaskGroup group;
+        (void)group.spawn([&finished]() {
+            std::this_thread::sleep_for(100ms);
+            finished = true;
+        });
+    }
+    EXPECT_TRUE(finished);
+
+    std::atomic<int> ran{0};
+    Blocker blocker(bus::thread::getThreadCount());
+    std::thread releaser;
+    try {
+        TaskGroup group;
+        for (int i = 0; i < 3; ++i) {
+            (void)group.spawn([&ran]() { ++ran; });
+        }
+        // The workers are only freed once the destructor is already waiting.
+        releaser = std::thread([&blocker] {
+            std::this_thread::sleep_for(50ms);
+            blocker.release();
+        });
+        throw std::runtime_error("scope failed");
+    } catch (const std::runtime_error &) {
+    }
+    releaser.join();
+    EXPECT_EQ(ran.load(), 0);
+}
+
+// Test nested foreground operations share one token that the Cancel button reaches
+TEST_F(TaskGroupTest, ForegroundOperationSharesToken) {
+    EXPECT_FALSE(bus::thread::cancelForeground("nothing running"));
+    {
+        bus::thread::ForegroundOperation outer;
+        {
+            bus::thread::ForegroundOperation inner;
+            EXPECT_TRUE(bus::thread::cancelForeground("cancel button"));
+            EXPECT_TRUE(inner.getToken().isCancelled());
+        }
+        EXPECT_TRUE(outer.getToken().isCancelled());
+        EXPECT_EQ(outer.getToken().getReason(), "cancel button");
+        EXPECT_THROW(outer.getToken().throwIfCancelled(), ex::Runtime);
+        EXPECT_FALSE(bus::thread::cancelForeground("again"));
+    }
+    EXPECT_FALSE(bus::thread::getForegroundToken().isCancelled());
+
+    bus::thread::ForegroundOperation next;
+    EXPECT_FALSE(next.getToken().isCancelled());
+}
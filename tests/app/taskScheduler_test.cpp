@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <neko/schema/exception.hpp>
+#include <neko/thread/threadPool.hpp>
+
+#include "neko/bus/taskScheduler.hpp"
+#include "neko/bus/threadBus.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace neko;
+using namespace std::chrono_literals;
+using bus::TaskClass;
+
+class TaskSchedulerTest : public ::testing::Test {
+protected:
+    thread::ThreadPool pool;
+    std::unique_ptr<bus::TaskScheduler> scheduler;
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+
+    std::promise<void> gate;
+    std::future<void> blocker;
+
+    void SetUp() override {
+        // One worker, so the dispatch order is fully determined by the scheduler.
+        pool.setThreadCount(1);
+        scheduler = std::make_unique<bus::TaskScheduler>(pool);
+        scheduler->setAgingStep(1h);
+    }
+
+    void TearDown() override {
+        pool.waitForGlobalTasks();
+    }
+
+    void record(const std::string &name) {
+        std::lock_guard lock(mutex);
+        order.push_back(name);
+    }
+
+    auto recorder(const std::string &name) {
+        return [this, name]() { record(name); };
+    }
+
+    // Occupy the worker so that everything submitted next stays queued until release().
+    void block() {
+        std::atomic<bool> started{false};
+        auto opened = gate.get_future().share();
+        blocker = scheduler->submit({}, [&started, opened]() {
+            started = true;
+            opened.wait();
+        });
+        while (!started) {
+            std::this_thread::yield();
+        }
+    }
+
+    void release() {
+        gate.set_value();
+        blocker.get();
+    }
+};
+
+// Test queued tasks are dispatched most urgent class first, FIFO within a class
+TEST_F(TaskSchedulerTest, DispatchesByClass) {
+    block();
+    std::vector<std::future<void>> futures;
+    futures.push_back(scheduler->submit({.taskClass = TaskClass::idle}, recorder("idle")));
+    futures.push_back(scheduler->submit({.taskClass = TaskClass::bulk}, recorder("bulk")));
+    futures.push_back(scheduler->submit({.taskClass = TaskClass::normal}, recorder("normal")));
+    futures.push_back(scheduler->submit({.taskClass = TaskClass::interactive}, recorder("interactive-1")));
+    futures.push_back(scheduler->submit({.taskClass = TaskClass::interactive}, recorder("interactive-2")));
+    EXPECT_EQ(scheduler->getStats(TaskClass::interactive).queued, 2u);
+    release();
+    for (auto &future : futures) {
+        future.get();
+    }
+
+    EXPECT_EQ(order, (std::vector<std::string>{"interactive-1", "interactive-2", "normal", "bulk", "idle"}));
+    EXPECT_EQ(scheduler->getStats(TaskClass::interactive).dispatched, 2u);
+    EXPECT_EQ(scheduler->getStats(TaskClass::bulk).dispatched, 1u);
+    EXPECT_EQ(scheduler->getStats(TaskClass::bulk).queued, 0u);
+}
+
+// Test bulk work that waited several aging steps overtakes newly queued interactive work
+TEST_F(TaskSchedulerTest, AgingPromotesStarvedWork) {
+    scheduler->setAgingStep(10ms);
+    block();
+    auto bulk = scheduler->submit({.taskClass = TaskClass::bulk}, recorder("bulk"));
+    std::this_thread::sleep_for(60ms); // well over the two steps that separate bulk from interactive
+    auto interactive = scheduler->submit({.taskClass = TaskClass::interactive}, recorder("interactive"));
+    release();
+    bulk.get();
+    interactive.get();
+
+    EXPECT_EQ(order, (std::vector<std::string>{"bulk", "interactive"}));
+    EXPECT_GE(scheduler->getStats(TaskClass::bulk).maxWaitMs, 60.0);
+}
+
+// Test a task still queued at its deadline is dropped and its future reports ex::Runtime
+TEST_F(TaskSchedulerTest, ExpiresTasksPastDeadline) {
+    block();
+    auto late = scheduler->submit({.deadline = std::chrono::steady_clock::now() + 10ms}, [this]() {
+        record("late");
+        return 1;
+    });
+    auto onTime = scheduler->submit({.deadline = std::chrono::steady_clock::now() + 1h}, [this]() {
+        record("on time");
+        return 2;
+    });
+    std::this_thread::sleep_for(30ms);
+    release();
+
+    EXPECT_THROW(late.get(), ex::Runtime);
+    EXPECT_EQ(onTime.get(), 2);
+    EXPECT_EQ(order, std::vector<std::string>{"on time"});
+    EXPECT_EQ(scheduler->getStats(TaskClass::normal).expired, 1u);
+}
+
+// Test yieldPoint hands more urgent work to the standby worker, never runs it on the yielding thread, and only that class
+TEST_F(TaskSchedulerTest, YieldPointHandsOffMoreUrgentWork) {
+    EXPECT_FALSE(bus::thread::yieldPoint()); // not inside a scheduled task
+
+    std::atomic<bool> started{false}, queued{false}, interactiveDone{false};
+    std::thread::id bulkThread, interactiveThread;
+    auto bulk = scheduler->submit({.taskClass = TaskClass::bulk}, [&]() {
+        bulkThread = std::this_thread::get_id();
+        started = true;
+        while (!queued) {
+            std::this_thread::yield();
+        }
+        record("bulk before yield");
+        const bool yielded = bus::thread::yieldPoint(); // hands the interactive task over
+        while (!interactiveDone) {
+            std::this_thread::yield();
+        }
+        const bool again = bus::thread::yieldPoint(); // only idle work is left
+        record("bulk after yield");
+        return std::make_pair(yielded, again);
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+    auto idle = scheduler->submit({.taskClass = TaskClass::idle}, recorder("idle"));
+    auto interactive = scheduler->submit({.taskClass = TaskClass::interactive}, [&]() {
+        interactiveThread = std::this_thread::get_id();
+        record("interactive");
+        const bool yielded = bus::thread::yieldPoint(); // interactive work never yields
+        interactiveDone = true;
+        return yielded;
+    });
+    queued = true;
+
+    const auto [yielded, again] = bulk.get();
+    EXPECT_TRUE(yielded);
+    EXPECT_FALSE(again);
+    EXPECT_FALSE(interactive.get());
+    EXPECT_NE(interactiveThread, bulkThread);
+    idle.get();
+    EXPECT_EQ(order, (std::vector<std::string>{"bulk before yield", "interactive", "bulk after yield", "idle"}));
+}
+
+// Test tasks dropped at their deadline are counted as expired, not completed, in the executor stats
+TEST(TaskSchedulerBusTest, CountsExpiredTasks) {
+    bus::thread::setThreadCount(bus::Executor::background, 1);
+    const auto before = bus::thread::getExecutorStats(bus::Executor::background);
+
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+    std::atomic<bool> started{false};
+    auto blocker = bus::thread::schedule(bus::Executor::background, {}, [&started, opened]() {
+        started = true;
+        opened.wait();
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+    auto late = bus::thread::schedule(bus::Executor::background, {.deadline = std::chrono::steady_clock::now() + 10ms}, []() {});
+    std::this_thread::sleep_for(30ms);
+    gate.set_value();
+    blocker.get();
+    EXPECT_THROW(late.get(), ex::Runtime);
+
+    const auto after = bus::thread::getExecutorStats(bus::Executor::background);
+    EXPECT_EQ(after.submitted - before.submitted, 2u);
+    EXPECT_EQ(after.completed - before.completed, 1u);
+    EXPECT_EQ(after.expired - before.expired, 1u);
+}
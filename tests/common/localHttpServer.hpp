@@ -0,0 +1,524 @@
+/**
+ * @file localHttpServer.hpp
+ * @brief Local HTTP/1.1 stand-in for the launcher's hosts, with injectable faults, for tests and benchmarks.
+ */
+
+#pragma once
+
+#include <neko/schema/types.hpp>
+
+#include <nlohmann/json.hpp>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace neko::test {
+
+    struct HttpRequest {
+        std::string method;
+        std::string path; ///< without the query string
+        std::map<std::string, std::string> headers; ///< names in lower case
+        std::string body;
+    };
+
+    struct HttpResponse {
+        int status = 200;
+        std::string body;
+        std::string contentType = "application/octet-stream";
+    };
+
+    /**
+     * @brief Faults applied to every response. Rates are probabilities in [0, 1].
+     */
+    struct HttpFaults {
+        std::chrono::milliseconds latency{0}; ///< before the status line
+        neko::uint64 bytesPerSecond = 0;      ///< body rate per response; 0 = unlimited
+        double errorRate = 0.0;               ///< answer 503 instead of the route
+        double stallRate = 0.0;               ///< pause once halfway through the body
+        std::chrono::milliseconds stallFor{0};
+        neko::uint32 seed = 1;
+    };
+
+    /**
+     * @brief One answered request, timed from its arrival to the last byte sent.
+     */
+    struct ServedRequest {
+        std::string method;
+        std::string path;
+        int status = 0;
+        neko::uint64 bodyBytes = 0;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+    };
+
+    /**
+     * @brief HTTP/1.1 server on 127.0.0.1 with an ephemeral port, one thread per connection.
+     *
+     * Supports keep-alive, `Content-Length` request bodies, `Expect: 100-continue`, HEAD and single
+     * `Range: bytes=a-b` requests, which is what the launcher's downloads use. Routes match the
+     * path exactly; anything else is a 404.
+     */
+    class LocalHttpServer {
+    public:
+        using Handler = std::function<HttpResponse(const HttpRequest &)>;
+
+    private:
+#if defined(_WIN32)
+        using Socket = SOCKET;
+        static constexpr Socket invalidSocket = INVALID_SOCKET;
+        static constexpr int sendFlags = 0;
+        static void closeSocket(Socket s) { ::closesocket(s); }
+        static void shutdownSocket(Socket s) { ::shutdown(s, SD_BOTH); }
+        static int pollSocket(pollfd *fd, int timeoutMs) { return ::WSAPoll(fd, 1, timeoutMs); }
+#else
+        using Socket = int;
+        static constexpr Socket invalidSocket = -1;
+#if defined(MSG_NOSIGNAL)
+        static constexpr int sendFlags = MSG_NOSIGNAL;
+#else
+        static constexpr int sendFlags = 0;
+#endif
+        static void closeSocket(Socket s) { ::close(s); }
+        static void shutdownSocket(Socket s) { ::shutdown(s, SHUT_RDWR); }
+        static int pollSocket(pollfd *fd, int timeoutMs) { return ::poll(fd, 1, timeoutMs); }
+#endif
+
+        Socket listener = invalidSocket;
+        neko::uint16 port = 0;
+        std::atomic<bool> stopping{false};
+        std::thread acceptThread;
+
+        mutable std::mutex mutex;
+        std::map<std::string, Handler> routes;
+        HttpFaults faults;
+        std::mt19937 random;
+        std::set<Socket> connections;
+        std::vector<std::thread> connectionThreads;
+        std::vector<ServedRequest> served;
+
+        bool roll(double rate) {
+            if (rate <= 0.0) {
+                return false;
+            }
+            std::lock_guard lock(mutex);
+            return std::uniform_real_distribution<double>(0.0, 1.0)(random) < rate;
+        }
+
+        static bool sendAll(Socket s, const char *data, std::size_t size) {
+            while (size > 0) {
+                const auto n = ::send(s, data, static_cast<int>(std::min<std::size_t>(size, 1 << 20)), sendFlags);
+                if (n <= 0) {
+                    return false;
+                }
+                data += n;
+                size -= static_cast<std::size_t>(n);
+            }
+            return true;
+        }
+
+        // Reads one request; false on EOF, error or a malformed request.
+        static bool readRequest(Socket s, std::string &buffer, HttpRequest &request) {
+            std::size_t headerEnd;
+            while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+                char chunk[16384];
+                const auto n = ::recv(s, chunk, sizeof(chunk), 0);
+                if (n <= 0 || buffer.size() > (1 << 20)) {
+                    return false;
+                }
+                buffer.append(chunk, static_cast<std::size_t>(n));
+            }
+            const std::string head = buffer.substr(0, headerEnd);
+            buffer.erase(0, headerEnd + 4);
+
+            std::size_t lineEnd = head.find("\r\n");
+            const std::string requestLine = head.substr(0, lineEnd);
+            const auto firstSpace = requestLine.find(' ');
+            const auto secondSpace = requestLine.find(' ', firstSpace + 1);
+            if (firstSpace == std::string::npos || secondSpace == std::string::npos) {
+                return false;
+            }
+            request = {};
+            request.method = requestLine.substr(0, firstSpace);
+            request.path = requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+            request.path = request.path.substr(0, request.path.find('?'));
+            while (lineEnd != std::string::npos) {
+                const auto start = lineEnd + 2;
+                lineEnd = head.find("\r\n", start);
+                const auto line = head.substr(start, lineEnd == std::string::npos ? std::string::npos : lineEnd - start);
+                const auto colon = line.find(':');
+                if (colon == std::string::npos) {
+                    continue;
+                }
+                std::string name = line.substr(0, colon);
+                std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                const auto valueStart = line.find_first_not_of(' ', colon + 1);
+                request.headers[name] = valueStart == std::string::npos ? "" : line.substr(valueStart);
+            }
+
+            std::size_t length = 0;
+            if (auto it = request.headers.find("content-length"); it != request.headers.end()) {
+                length = std::stoull(it->second);
+            }
+            if (length > 0 && buffer.size() < length) {
+                if (auto it = request.headers.find("expect"); it != request.headers.end() && it->second == "100-continue") {
+                    static constexpr char continueLine[] = "HTTP/1.1 100 Continue\r\n\r\n";
+                    sendAll(s, continueLine, sizeof(continueLine) - 1);
+                }
+            }
+            while (buffer.size() < length) {
+                char chunk[16384];
+                const auto n = ::recv(s, chunk, sizeof(chunk), 0);
+                if (n <= 0) {
+                    return false;
+                }
+                buffer.append(chunk, static_cast<std::size_t>(n));
+            }
+            request.body = buffer.substr(0, length);
+            buffer.erase(0, length);
+            return true;
+        }
+
+        static const char *reason(int status) {
+            switch (status) {
+                case 200:
+                    return "OK";
+                case 204:
+                    return "No Content";
+                case 206:
+                    return "Partial Content";
+                case 404:
+                    return "Not Found";
+                case 416:
+                    return "Range Not Satisfiable";
+                case 503:
+                    return "Service Unavailable";
+                default:
+                    return "Status";
+            }
+        }
+
+        // Sends the response with the configured faults; false if the client went away.
+        bool respond(Socket s, const HttpRequest &request, bool keepAlive, ServedRequest &record) {
+            HttpFaults current;
+            Handler handler;
+            {
+                std::lock_guard lock(mutex);
+                current = faults;
+                if (auto it = routes.find(request.path); it != routes.end()) {
+                    handler = it->second;
+                }
+            }
+            if (current.latency.count() > 0) {
+                std::this_thread::sleep_for(current.latency);
+            }
+
+            HttpResponse response;
+            if (roll(current.errorRate)) {
+                response = {.status = 503, .body = "injected error", .contentType = "text/plain"};
+            } else if (handler) {
+                response = handler(request);
+            } else {
+                response = {.status = 404, .body = "not found", .contentType = "text/plain"};
+            }
+
+            // Single byte ranges only, as sent by segmented downloads.
+            std::string extraHeaders = "Accept-Ranges: bytes\r\n";
+            std::size_t offset = 0;
+            std::size_t length = response.body.size();
+            if (auto it = request.headers.find("range"); it != request.headers.end() && response.status == 200 && it->second.starts_with("bytes=")) {
+                const auto spec = it->second.substr(6);
+                const auto dash = spec.find('-');
+                try {
+                    const std::size_t total = response.body.size();
+                    std::size_t first = dash == 0 ? 0 : std::stoull(spec.substr(0, dash));
+                    std::size_t last = (dash == std::string::npos || dash + 1 == spec.size()) ? total - 1 : std::stoull(spec.substr(dash + 1));
+                    if (dash == 0) { // suffix range: the last N bytes
+                        const auto suffix = std::stoull(spec.substr(1));
+                        first = total > suffix ? total - suffix : 0;
+                        last = total - 1;
+                    }
+                    last = std::min(last, total - 1);
+                    if (total == 0 || first > last) {
+                        response = {.status = 416, .body = "", .contentType = "text/plain"};
+                        extraHeaders += "Content-Range: bytes */" + std::to_string(total) + "\r\n";
+                        length = 0;
+                    } else {
+                        response.status = 206;
+                        offset = first;
+                        length = last - first + 1;
+                        extraHeaders += "Content-Range: bytes " + std::to_string(first) + "-" + std::to_string(last) + "/" + std::to_string(total) + "\r\n";
+                    }
+                } catch (const std::exception &) {
+                    // Malformed range: ignore it and send the whole body.
+                }
+            }
+            const bool sendBody = request.method != "HEAD";
+            const std::string header = "HTTP/1.1 " + std::to_string(response.status) + " " + reason(response.status) + "\r\n" +
+                                       "Content-Type: " + response.contentType + "\r\n" +
+                                       "Content-Length: " + std::to_string(length) + "\r\n" + extraHeaders +
+                                       (keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n") + "\r\n";
+            record.status = response.status;
+            if (!sendAll(s, header.data(), header.size())) {
+                return false;
+            }
+            if (!sendBody) {
+                return true;
+            }
+
+            const bool stall = current.stallFor.count() > 0 && roll(current.stallRate);
+            const auto bodyStart = std::chrono::steady_clock::now();
+            constexpr std::size_t block = 16384;
+            std::size_t sent = 0;
+            while (sent < length) {
+                if (stall && sent >= length / 2 && sent < length / 2 + block) {
+                    std::this_thread::sleep_for(current.stallFor);
+                }
+                const auto n = std::min(block, length - sent);
+                if (!sendAll(s, response.body.data() + offset + sent, n)) {
+                    return false;
+                }
+                sent += n;
+                record.bodyBytes = sent;
+                if (current.bytesPerSecond > 0) {
+                    const auto due = bodyStart + std::chrono::microseconds(sent * 1000000 / current.bytesPerSecond);
+                    std::this_thread::sleep_until(due);
+                }
+            }
+            return true;
+        }
+
+        void serve(Socket s) {
+            std::string buffer;
+            HttpRequest request;
+            while (!stopping.load() && readRequest(s, buffer, request)) {
+                ServedRequest record{.method = request.method, .path = request.path, .start = std::chrono::steady_clock::now()};
+                auto connection = request.headers["connection"];
+                std::transform(connection.begin(), connection.end(), connection.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                const bool keepAlive = connection != "close";
+                const bool ok = respond(s, request, keepAlive, record);
+                record.end = std::chrono::steady_clock::now();
+                {
+                    std::lock_guard lock(mutex);
+                    served.push_back(record);
+                }
+                if (!ok || !keepAlive) {
+                    break;
+                }
+            }
+            std::lock_guard lock(mutex);
+            connections.erase(s);
+            closeSocket(s);
+        }
+
+        void acceptLoop() {
+            while (!stopping.load()) {
+                pollfd fd{};
+                fd.fd = listener;
+                fd.events = POLLIN;
+                if (pollSocket(&fd, 50) <= 0) {
+                    continue;
+                }
+                const Socket client = ::accept(listener, nullptr, nullptr);
+                if (client == invalidSocket) {
+                    continue;
+                }
+                int noDelay = 1;
+                ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&noDelay), sizeof(noDelay));
+                std::lock_guard lock(mutex);
+                if (stopping.load()) {
+                    closeSocket(client);
+                    break;
+                }
+                connections.insert(client);
+                connectionThreads.emplace_back([this, client]() { serve(client); });
+            }
+        }
+
+    public:
+        /**
+         * @throws std::runtime_error if no local port can be bound.
+         */
+        explicit LocalHttpServer(HttpFaults faults = {})
+            : faults(faults), random(faults.seed) {
+#if defined(_WIN32)
+            WSADATA data;
+            ::WSAStartup(MAKEWORD(2, 2), &data);
+#endif
+            listener = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            if (listener == invalidSocket) {
+                throw std::runtime_error("Cannot create listening socket");
+            }
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = 0;
+            socklen_t size = sizeof(address);
+            if (::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+                ::listen(listener, 128) != 0 ||
+                ::getsockname(listener, reinterpret_cast<sockaddr *>(&address), &size) != 0) {
+                closeSocket(listener);
+                throw std::runtime_error("Cannot listen on 127.0.0.1");
+            }
+            port = ntohs(address.sin_port);
+            acceptThread = std::thread([this]() { acceptLoop(); });
+        }
+
+        ~LocalHttpServer() {
+            stop();
+        }
+
+        LocalHttpServer(const LocalHttpServer &) = delete;
+        LocalHttpServer &operator=(const LocalHttpServer &) = delete;
+
+        /**
+         * @brief Stop accepting, close open connections and join every thread.
+         */
+        void stop() {
+            if (stopping.exchange(true)) {
+                return;
+            }
+            if (acceptThread.joinable()) {
+                acceptThread.join();
+            }
+            closeSocket(listener);
+            std::vector<std::thread> threads;
+            {
+                std::lock_guard lock(mutex);
+                for (auto s : connections) {
+                    shutdownSocket(s);
+                }
+                threads.swap(connectionThreads);
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+#if defined(_WIN32)
+            ::WSACleanup();
+#endif
+        }
+
+        neko::uint16 getPort() const {
+            return port;
+        }
+
+        /**
+         * @brief Absolute URL of `path` on this server, e.g. "http://127.0.0.1:40123/files/a.bin".
+         */
+        std::string url(const std::string &path) const {
+            return "http://127.0.0.1:" + std::to_string(port) + path;
+        }
+
+        void route(const std::string &path, Handler handler) {
+            std::lock_guard lock(mutex);
+            routes[path] = std::move(handler);
+        }
+
+        /**
+         * @brief Serve fixed content at `path` for any method.
+         */
+        void serveContent(const std::string &path, std::string content, std::string contentType = "application/octet-stream") {
+            route(path, [content = std::move(content), contentType = std::move(contentType)](const HttpRequest &) {
+                return HttpResponse{.status = 200, .body = content, .contentType = contentType};
+            });
+        }
+
+        void setFaults(const HttpFaults &newFaults) {
+            std::lock_guard lock(mutex);
+            faults = newFaults;
+            random.seed(newFaults.seed);
+        }
+
+        std::vector<ServedRequest> getServed() const {
+            std::lock_guard lock(mutex);
+            return served;
+        }
+
+        void clearServed() {
+            std::lock_guard lock(mutex);
+            served.clear();
+        }
+    };
+
+    struct SyntheticUpdateOptions {
+        neko::uint32 files = 16;
+        neko::uint64 fileSize = 64 * 1024;
+        std::string directory = "synthetic-update"; ///< relative to the work path
+        std::string resourceVersion;                ///< empty: update() does not save a version
+        bool suggestMultiThread = false;
+        neko::uint32 seed = 1;
+    };
+
+    struct SyntheticUpdate {
+        std::string manifest; ///< body of the checkUpdates response
+        std::vector<std::pair<std::string, std::string>> files; ///< fileName relative to the work path, content
+        neko::uint64 totalBytes = 0;
+    };
+
+    /**
+     * @brief Generate files, serve them under `/files/` and answer `checkUpdatesPath` with their manifest.
+     *
+     * The manifest follows the `updateResponse` contract with absolute URLs; `sha256` computes the
+     * checksum of a file's content.
+     */
+    inline SyntheticUpdate serveSyntheticUpdate(LocalHttpServer &server, const std::string &checkUpdatesPath, const SyntheticUpdateOptions &options,
+                                                const std::function<std::string(const std::string &)> &sha256) {
+        SyntheticUpdate update;
+        nlohmann::json files = nlohmann::json::array();
+        std::mt19937_64 random(options.seed);
+        for (neko::uint32 i = 0; i < options.files; ++i) {
+            std::string content(options.fileSize, '\0');
+            for (std::size_t offset = 0; offset < content.size(); offset += sizeof(neko::uint64)) {
+                const auto value = random();
+                std::memcpy(content.data() + offset, &value, std::min(sizeof(value), content.size() - offset));
+            }
+            const auto name = "file-" + std::to_string(i) + ".bin";
+            const auto fileName = options.directory + "/" + name;
+            files.push_back({{"url", server.url("/files/" + name)},
+                             {"fileName", fileName},
+                             {"checksum", sha256(content)},
+                             {"downloadMeta", {{"hashAlgorithm", "sha256"}, {"suggestMultiThread", options.suggestMultiThread}, {"isCoreFile", false}, {"isAbsoluteUrl", true}}}});
+            update.totalBytes += content.size();
+            server.serveContent("/files/" + name, content);
+            update.files.emplace_back(fileName, std::move(content));
+        }
+        update.manifest = nlohmann::json{{"updateResponse", {{"title", "Synthetic update"},
+                                                             {"description", std::to_string(options.files) + " files"},
+                                                             {"posterUrl", ""},
+                                                             {"publishTime", ""},
+                                                             {"resourceVersion", options.resourceVersion},
+                                                             {"isMandatory", false},
+                                                             {"files", files}}}}
+                              .dump();
+        server.serveContent(checkUpdatesPath, update.manifest, "application/json");
+        return update;
+    }
+
+} // namespace neko::test
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include "neko/core/chunkStore.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace neko;
+
+class ChunkStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "neko_chunk_store_test";
+        fs::remove_all(testDir);
+        fs::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    std::string path(const std::string &name) const {
+        return (testDir / name).string();
+    }
+
+    static void writeFile(const std::string &file, const std::string &content) {
+        std::ofstream(file, std::ios::binary) << content;
+    }
+
+    static std::string readFile(const std::string &file) {
+        std::ifstream in(file, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    // Stands in for the manifest hash; only needs to be stable and collision-free in these tests.
+    static std::string hash(std::string_view data) {
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016zx", std::hash<std::string_view>{}(data));
+        return buffer;
+    }
+
+    static std::string makeResource(std::size_t size, unsigned seed) {
+        std::string data(size, '\0');
+        for (auto &c : data) {
+            seed = seed * 1103515245u + 12345u;
+            c = static_cast<char>(seed >> 16);
+        }
+        return data;
+    }
+
+    // What the server publishes for `content`.
+    std::vector<core::chunk::ChunkRef> manifest(const std::string &content) {
+        writeFile(path("manifest.src"), content);
+        std::vector<core::chunk::ChunkRef> refs;
+        for (const auto &chunk : core::chunk::Chunker(params).chunkFile(path("manifest.src"), hash)) {
+            refs.push_back({chunk.hash, chunk.size});
+        }
+        fs::remove(path("manifest.src"));
+        return refs;
+    }
+
+    // Simulates the chunk endpoint: writes the chunk's bytes and hands them to the store.
+    static bool download(core::chunk::ChunkStore &store, const std::string &content,
+                         const std::vector<core::chunk::ChunkRef> &refs, const core::chunk::ChunkRef &wanted) {
+        std::size_t offset = 0;
+        for (const auto &ref : refs) {
+            if (ref.hash == wanted.hash) {
+                const auto part = store.downloadPath(ref.hash);
+                writeFile(part, content.substr(offset, ref.size));
+                return store.adopt(ref.hash, part);
+            }
+            offset += ref.size;
+        }
+        return false;
+    }
+
+    fs::path testDir;
+    core::chunk::ChunkParams params{.minSize = 2 * 1024, .avgSize = 8 * 1024, .maxSize = 32 * 1024};
+};
+
+// Test chunks respect the size bounds and cover the file exactly
+TEST_F(ChunkStoreTest, ChunksCoverFileWithinBounds) {
+    const auto content = makeResource(1 << 20, 1);
+    writeFile(path("file.bin"), content);
+    const auto chunks = core::chunk::Chunker(params).chunkFile(path("file.bin"), hash);
+
+    ASSERT_GT(chunks.size(), 1u);
+    neko::uint64 offset = 0;
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        EXPECT_EQ(chunks[i].offset, offset);
+        EXPECT_LE(chunks[i].size, params.maxSize);
+        if (i + 1 < chunks.size()) {
+            EXPECT_GE(chunks[i].size, params.minSize);
+        }
+        offset += chunks[i].size;
+    }
+    EXPECT_EQ(offset, content.size());
+    // Normalized chunking keeps the mean near the target.
+    const auto mean = content.size() / chunks.size();
+    EXPECT_GT(mean, params.avgSize / 2);
+    EXPECT_LT(mean, params.avgSize * 2);
+
+    EXPECT_THROW(core::chunk::Chunker({.minSize = 64, .avgSize = 32, .maxSize = 128}), ex::ArgumentError);
+}
+
+// Test an insertion only changes the chunks around it
+TEST_F(ChunkStoreTest, InsertionKeepsOtherChunks) {
+    const auto base = makeResource(1 << 20, 1);
+    auto edited = base;
+    edited.insert(400 * 1024, makeResource(3000, 2));
+
+    const auto before = manifest(base);
+    const auto after = manifest(edited);
+    std::set<std::string> known;
+    for (const auto &chunk : before) {
+        known.insert(chunk.hash);
+    }
+    std::size_t changed = 0;
+    for (const auto &chunk : after) {
+        changed += !known.contains(chunk.hash);
+    }
+    EXPECT_LE(changed, 3u);
+}
+
+// Test a file is rebuilt from a seeded local copy plus only the chunks it lacks
+TEST_F(ChunkStoreTest, AssemblesFromSeedAndDownloadedChunks) {
+    const auto base = makeResource(512 * 1024, 1);
+    auto target = base;
+    target.replace(100 * 1024, 4096, makeResource(4096, 2));
+    target += makeResource(10000, 3);
+    writeFile(path("installed.bin"), base);
+    const auto refs = manifest(target);
+
+    core::chunk::ChunkStore store(path("store"), hash);
+    EXPECT_GT(store.seed(path("installed.bin"), params), 0u);
+    EXPECT_EQ(store.seed(path("installed.bin"), params), 0u);
+    const auto missing = store.missing(refs);
+    EXPECT_GT(missing.size(), 0u);
+    EXPECT_LE(missing.size(), 6u);
+    for (const auto &chunk : missing) {
+        ASSERT_TRUE(download(store, target, refs, chunk));
+    }
+    EXPECT_TRUE(store.missing(refs).empty());
+
+    store.assemble(refs, path("out.bin"));
+    EXPECT_EQ(readFile(path("out.bin")), target);
+}
+
+// Test downloaded chunks persist, so a second attempt only fetches what the first one did not
+TEST_F(ChunkStoreTest, ResumesWithStoredChunks) {
+    const auto target = makeResource(256 * 1024, 4);
+    const auto refs = manifest(target);
+    ASSERT_GT(refs.size(), 2u);
+    {
+        core::chunk::ChunkStore store(path("store"), hash);
+        const auto missing = store.missing(refs);
+        ASSERT_EQ(missing.size(), refs.size());
+        // Interrupted halfway.
+        for (std::size_t i = 0; i < missing.size() / 2; ++i) {
+            ASSERT_TRUE(download(store, target, refs, missing[i]));
+        }
+    }
+
+    core::chunk::ChunkStore store(path("store"), hash);
+    const auto missing = store.missing(refs);
+    EXPECT_EQ(missing.size(), refs.size() - refs.size() / 2);
+    for (const auto &chunk : missing) {
+        ASSERT_TRUE(download(store, target, refs, chunk));
+    }
+    store.assemble(refs, path("out.bin"));
+    EXPECT_EQ(readFile(path("out.bin")), target);
+
+    store.clear();
+    EXPECT_FALSE(fs::exists(path("store")));
+}
+
+// Test corrupt downloads and changed seed files are rejected
+TEST_F(ChunkStoreTest, RejectsCorruptChunks) {
+    const auto target = makeResource(128 * 1024, 5);
+    const auto refs = manifest(target);
+    core::chunk::ChunkStore store(path("store"), hash);
+
+    const auto part = store.downloadPath(refs[0].hash);
+    writeFile(part, "garbage");
+    EXPECT_FALSE(store.adopt(refs[0].hash, part));
+    EXPECT_FALSE(fs::exists(part));
+    EXPECT_FALSE(store.contains(refs[0].hash));
+
+    // The seed file changes after it was indexed: assembling must not use stale bytes.
+    writeFile(path("installed.bin"), target);
+    store.seed(path("installed.bin"), params);
+    EXPECT_TRUE(store.missing(refs).empty());
+    writeFile(path("installed.bin"), makeResource(128 * 1024, 6));
+    EXPECT_THROW(store.assemble(refs, path("out.bin")), ex::FileError);
+    EXPECT_FALSE(fs::exists(path("out.bin")));
+}
+
+// Test hashes that are not lowercase hex are refused before they become paths or URLs
+TEST_F(ChunkStoreTest, RejectsInvalidHashes) {
+    const auto refs = manifest(makeResource(64 * 1024, 7));
+    core::chunk::ChunkStore store(path("store"), hash);
+
+    for (const std::string bad : {"../../etc/passwd", "abc", "..\\\\x", "a1b2/../c3", "ABCDEFG1", "ABCDEF01"}) {
+        auto list = refs;
+        list.push_back({bad, 1});
+        EXPECT_THROW((void)store.missing(list), ex::ArgumentError) << bad;
+        EXPECT_THROW(store.assemble(list, path("out.bin")), ex::ArgumentError) << bad;
+        EXPECT_THROW((void)store.contains(bad), ex::ArgumentError) << bad;
+        EXPECT_THROW((void)store.downloadPath(bad), ex::ArgumentError) << bad;
+        EXPECT_FALSE(store.adopt(bad, path("part")));
+    }
+    EXPECT_FALSE(fs::exists(path("out.bin")));
+    EXPECT_EQ(store.missing(refs).size(), refs.size());
+}
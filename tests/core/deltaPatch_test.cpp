@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include "neko/core/deltaPatch.hpp"
+
+#include <zstd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace fs = std::filesystem;
+using namespace neko;
+
+class DeltaPatchTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "neko_delta_patch_test";
+        fs::remove_all(testDir);
+        fs::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    std::string path(const std::string &name) const {
+        return (testDir / name).string();
+    }
+
+    static void writeFile(const std::string &file, const std::string &content) {
+        std::ofstream(file, std::ios::binary) << content;
+    }
+
+    static std::string readFile(const std::string &file) {
+        std::ifstream in(file, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    // Same as `zstd --patch-from=<base> <target>`: the base is the compression prefix.
+    static std::string makePatch(const std::string &base, const std::string &target) {
+        ZSTD_CCtx *ctx = ZSTD_createCCtx();
+        ZSTD_CCtx_setParameter(ctx, ZSTD_c_checksumFlag, 1);
+        ZSTD_CCtx_refPrefix(ctx, base.data(), base.size());
+        std::string patch(ZSTD_compressBound(target.size()), '\0');
+        const auto size = ZSTD_compress2(ctx, patch.data(), patch.size(), target.data(), target.size());
+        ZSTD_freeCCtx(ctx);
+        patch.resize(ZSTD_isError(size) ? 0 : size);
+        return patch;
+    }
+
+    // Pseudo-random bytes so the patch cannot be smaller than the change by compression alone.
+    static std::string makeResource(std::size_t size, unsigned seed) {
+        std::string data(size, '\0');
+        for (auto &c : data) {
+            seed = seed * 1103515245u + 12345u;
+            c = static_cast<char>(seed >> 16);
+        }
+        return data;
+    }
+
+    fs::path testDir;
+};
+
+// Test a patch rebuilds the target from the base and is much smaller than the target
+TEST_F(DeltaPatchTest, AppliesZstdPatch) {
+    const auto base = makeResource(1 << 20, 1);
+    auto target = base;
+    target.replace(4096, 2048, makeResource(2048, 2));
+    target += makeResource(1000, 3);
+
+    const auto patch = makePatch(base, target);
+    ASSERT_FALSE(patch.empty());
+    EXPECT_LT(patch.size(), target.size() / 50);
+
+    writeFile(path("base.bin"), base);
+    writeFile(path("patch.zst"), patch);
+    core::delta::applyPatch(core::delta::Format::zstd, path("base.bin"), path("patch.zst"), path("out.bin"));
+    EXPECT_EQ(readFile(path("out.bin")), target);
+}
+
+// Test a patch made against another base is rejected and leaves no output
+TEST_F(DeltaPatchTest, RejectsWrongBase) {
+    const auto base = makeResource(64 * 1024, 1);
+    const auto patch = makePatch(base, base + "tail");
+
+    writeFile(path("other.bin"), makeResource(64 * 1024, 9));
+    writeFile(path("patch.zst"), patch);
+    EXPECT_THROW(core::delta::applyPatch(core::delta::Format::zstd, path("other.bin"), path("patch.zst"), path("out.bin")), ex::Parse);
+    EXPECT_FALSE(fs::exists(path("out.bin")));
+}
+
+// Test a truncated patch or a missing base is an error
+TEST_F(DeltaPatchTest, RejectsTruncatedPatchAndMissingBase) {
+    const auto base = makeResource(64 * 1024, 1);
+    const auto patch = makePatch(base, base + "tail");
+    writeFile(path("base.bin"), base);
+    writeFile(path("patch.zst"), patch.substr(0, patch.size() / 2));
+    EXPECT_THROW(core::delta::applyPatch(core::delta::Format::zstd, path("base.bin"), path("patch.zst"), path("out.bin")), ex::Parse);
+    EXPECT_FALSE(fs::exists(path("out.bin")));
+
+    EXPECT_THROW(core::delta::applyPatch(core::delta::Format::zstd, path("missing.bin"), path("patch.zst"), path("out.bin")), ex::FileError);
+    EXPECT_THROW(core::delta::applyPatch(core::delta::Format::unsupported, path("base.bin"), path("patch.zst"), path("out.bin")), ex::ArgumentError);
+}
+
+// Test the patch is chosen by version and base hash, hashing the local file once
+TEST_F(DeltaPatchTest, SelectsPatchMatchingLocalFile) {
+    api::UpdateResponse::File file{.url = "https://cdn/pack.zip", .fileName = "pack.zip", .checksum = "new", .hashAlgorithm = "sha256"};
+    file.patches = {
+        {.fromVersion = "1.0.0", .url = "https://cdn/pack-1.0.0.zst", .format = "zstd", .baseChecksum = "v100"},
+        {.fromVersion = "1.1.0", .url = "https://cdn/pack-1.1.0.bsdiff", .format = "bsdiff", .baseChecksum = "v110"},
+        {.fromVersion = "1.1.0", .url = "https://cdn/pack-1.1.0.zst", .format = "zstd", .baseChecksum = "v110"},
+        {.fromVersion = "", .url = "https://cdn/pack-any.zst", .format = "zstd", .baseChecksum = "custom"}};
+
+    int hashes = 0;
+    auto hashAs = [&](std::string value) {
+        return [&hashes, value](const std::string &algorithm) {
+            EXPECT_EQ(algorithm, "sha256");
+            ++hashes;
+            return value;
+        };
+    };
+
+    auto chosen = core::delta::selectPatch(file, "1.1.0", hashAs("v110"));
+    ASSERT_TRUE(chosen.has_value());
+    EXPECT_EQ(chosen->url, "https://cdn/pack-1.1.0.zst");
+    EXPECT_EQ(hashes, 1);
+
+    // The local file was modified: only a version-free patch for that exact content applies.
+    hashes = 0;
+    chosen = core::delta::selectPatch(file, "1.1.0", hashAs("custom"));
+    ASSERT_TRUE(chosen.has_value());
+    EXPECT_EQ(chosen->url, "https://cdn/pack-any.zst");
+    EXPECT_EQ(hashes, 1);
+
+    EXPECT_FALSE(core::delta::selectPatch(file, "0.9.0", hashAs("v100")).has_value());
+    EXPECT_FALSE(core::delta::selectPatch(file, "1.0.0", hashAs("")).has_value());
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "neko/core/fileDigest.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+using namespace neko;
+
+class FileDigestTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = fs::temp_directory_path() / "neko_file_digest_test";
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir);
+    }
+
+    std::string write(const std::string &name, const std::string &content) const {
+        const auto path = (dir / name).string();
+        std::ofstream(path, std::ios::binary) << content;
+        return path;
+    }
+
+    fs::path dir;
+};
+
+// Test known digests, whatever the block size and spelling of the algorithm
+TEST_F(FileDigestTest, MatchesKnownDigests) {
+    const auto abc = write("abc", "abc");
+    EXPECT_EQ(core::digest::digestFile(abc, "sha256"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(core::digest::digestFile(abc, "SHA-256"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(core::digest::digestFile(abc, "sha1"), "a9993e364706816aba3e25717850c26c9cd0d89d");
+
+    const auto empty = write("empty", "");
+    EXPECT_EQ(core::digest::digestFile(empty, "sha256"), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+    // One million 'a' (FIPS 180-2 test vector), read in blocks that do not divide it.
+    const auto million = write("million", std::string(1000000, 'a'));
+    EXPECT_EQ(core::digest::digestFile(million, "sha256", {}, 4096 + 7), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+// Test hashing stops between blocks once cancelled, and bad input is reported
+TEST_F(FileDigestTest, StopsWhenCancelledAndRejectsBadInput) {
+    const auto path = write("big", std::string(64 * 1024, 'x'));
+    int polls = 0;
+    EXPECT_THROW(core::digest::digestFile(path, "sha256", [&polls]() { return ++polls == 3; }, 4096), ex::Runtime);
+    EXPECT_EQ(polls, 3);
+
+    EXPECT_THROW(core::digest::digestFile(path, "nope"), ex::ArgumentError);
+    EXPECT_THROW(core::digest::digestFile((dir / "missing").string(), "sha256"), ex::FileError);
+}
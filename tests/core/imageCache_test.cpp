@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+
+#include "neko/core/imageCache.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace neko;
+using namespace std::chrono_literals;
+
+class ImageCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "neko_image_cache_test";
+        std::filesystem::remove_all(dir);
+    }
+
+    void TearDown() override {
+        joinAll();
+        std::filesystem::remove_all(dir);
+    }
+
+    core::ImageCache::Spawner spawner() {
+        return [this](std::function<void()> task) {
+            std::lock_guard lock(threadsMutex);
+            threads.emplace_back(std::move(task));
+        };
+    }
+
+    void joinAll() {
+        std::vector<std::thread> pending;
+        {
+            std::lock_guard lock(threadsMutex);
+            pending.swap(threads);
+        }
+        for (auto &thread : pending) {
+            thread.join();
+        }
+    }
+
+    // Serves `content[url]`, counting downloads; a missing URL fails.
+    core::ImageCache::Downloader server(std::chrono::milliseconds delay = 0ms) {
+        return [this, delay](const std::string &url, const std::string &path) {
+            ++downloads;
+            std::this_thread::sleep_for(delay);
+            std::lock_guard lock(contentMutex);
+            auto it = content.find(url);
+            if (it == content.end()) {
+                return false;
+            }
+            std::ofstream(path, std::ios::binary) << it->second;
+            return true;
+        };
+    }
+
+    void setContent(const std::string &url, const std::string &body) {
+        std::lock_guard lock(contentMutex);
+        content[url] = body;
+    }
+
+    std::size_t countFiles(const std::string &extension) {
+        std::size_t count = 0;
+        for (const auto &item : std::filesystem::directory_iterator(dir)) {
+            count += item.path().extension() == extension;
+        }
+        return count;
+    }
+
+    std::filesystem::path dir;
+    std::atomic<int> downloads{0};
+    std::mutex contentMutex;
+    std::map<std::string, std::string> content;
+    std::mutex threadsMutex;
+    std::vector<std::thread> threads;
+};
+
+// Test a fresh entry is reused across instances without downloading again
+TEST_F(ImageCacheTest, ReusesFreshEntry) {
+    setContent("https://cdn/poster.jpg", "jpeg-bytes");
+    std::string first;
+    {
+        core::ImageCache cache(dir.string(), server(), spawner());
+        EXPECT_FALSE(cache.peek("https://cdn/poster.jpg").has_value());
+        first = cache.get("https://cdn/poster.jpg").value();
+        EXPECT_EQ(std::filesystem::path(first).extension(), ".jpg");
+    }
+
+    core::ImageCache cache(dir.string(), server(), spawner());
+    EXPECT_EQ(cache.peek("https://cdn/poster.jpg"), first);
+    EXPECT_EQ(cache.get("https://cdn/poster.jpg"), first);
+    EXPECT_EQ(downloads.load(), 1);
+}
+
+// Test identical content behind different URLs is stored once
+TEST_F(ImageCacheTest, SameContentStoredOnce) {
+    setContent("https://a/p.png", "same");
+    setContent("https://b/p.png", "same");
+    core::ImageCache cache(dir.string(), server(), spawner());
+    EXPECT_EQ(cache.get("https://a/p.png"), cache.get("https://b/p.png"));
+    EXPECT_EQ(cache.getEntryCount(), 2u);
+    EXPECT_EQ(cache.getTotalBytes(), 4u);
+    EXPECT_EQ(countFiles(".png"), 1u);
+}
+
+// Test a new validator downloads again and the replaced file is removed
+TEST_F(ImageCacheTest, ValidatorChangeRefetches) {
+    core::ImageCache cache(dir.string(), server(), spawner());
+    setContent("https://cdn/poster.png", "v1");
+    const auto v1 = cache.get("https://cdn/poster.png", "etag-1").value();
+    setContent("https://cdn/poster.png", "v2");
+    EXPECT_EQ(cache.get("https://cdn/poster.png", "etag-1"), v1);
+
+    const auto v2 = cache.get("https://cdn/poster.png", "etag-2").value();
+    EXPECT_NE(v1, v2);
+    EXPECT_FALSE(std::filesystem::exists(v1));
+    EXPECT_EQ(cache.getEntryCount(), 1u);
+    EXPECT_EQ(downloads.load(), 2);
+}
+
+// Test a stale entry is downloaded again, and kept if that fails
+TEST_F(ImageCacheTest, StaleEntryFallsBackWhenOffline) {
+    core::ImageCache cache(dir.string(), server(), spawner(), core::ImageCache::Options{.maxAge = 0ms});
+    setContent("https://cdn/poster.png", "v1");
+    const auto stored = cache.get("https://cdn/poster.png").value();
+    EXPECT_FALSE(cache.peek("https://cdn/poster.png").has_value());
+
+    {
+        std::lock_guard lock(contentMutex);
+        content.clear();
+    }
+    EXPECT_EQ(cache.get("https://cdn/poster.png"), stored);
+    EXPECT_EQ(downloads.load(), 2);
+    EXPECT_FALSE(cache.get("https://cdn/missing.png").has_value());
+}
+
+// Test concurrent requests for one URL share a single download
+TEST_F(ImageCacheTest, ConcurrentRequestsShareDownload) {
+    setContent("https://cdn/poster.png", "bytes");
+    core::ImageCache cache(dir.string(), server(50ms), spawner());
+
+    auto pending = cache.fetch("https://cdn/poster.png");
+    std::vector<std::thread> callers;
+    std::atomic<int> matched{0};
+    for (int i = 0; i < 3; ++i) {
+        callers.emplace_back([&]() {
+            if (cache.get("https://cdn/poster.png").has_value()) {
+                ++matched;
+            }
+        });
+    }
+    for (auto &caller : callers) {
+        caller.join();
+    }
+    EXPECT_TRUE(pending.get().has_value());
+    EXPECT_EQ(matched.load(), 3);
+    EXPECT_EQ(downloads.load(), 1);
+    EXPECT_EQ(countFiles(".part"), 0u);
+}
+
+// Test least recently used images are evicted past the size bound
+TEST_F(ImageCacheTest, EvictsLeastRecentlyUsed) {
+    core::ImageCache cache(dir.string(), server(), spawner(), core::ImageCache::Options{.maxBytes = 250});
+    setContent("https://cdn/a.png", std::string(100, 'a'));
+    setContent("https://cdn/b.png", std::string(100, 'b'));
+    setContent("https://cdn/c.png", std::string(100, 'c'));
+    (void)cache.get("https://cdn/a.png");
+    std::this_thread::sleep_for(2ms);
+    (void)cache.get("https://cdn/b.png");
+    std::this_thread::sleep_for(2ms);
+    (void)cache.peek("https://cdn/a.png"); // a is now more recent than b
+    std::this_thread::sleep_for(2ms);
+    (void)cache.get("https://cdn/c.png");
+
+    EXPECT_LE(cache.getTotalBytes(), 250u);
+    EXPECT_TRUE(cache.peek("https://cdn/a.png").has_value());
+    EXPECT_FALSE(cache.peek("https://cdn/b.png").has_value());
+    EXPECT_TRUE(cache.peek("https://cdn/c.png").has_value());
+    EXPECT_EQ(countFiles(".png"), 2u);
+}
+
+// Test a download that throws still releases its waiters and its key
+TEST_F(ImageCacheTest, ThrowingDownloadReleasesKey) {
+    core::ImageCache cache(dir.string(), [this](const std::string &, const std::string &) -> bool {
+        ++downloads;
+        throw 42; // not a std::exception
+    }, spawner());
+
+    EXPECT_FALSE(cache.get("https://cdn/poster.png").has_value());
+    EXPECT_FALSE(cache.fetch("https://cdn/poster.png").get().has_value());
+    cache.wait();
+    EXPECT_EQ(downloads.load(), 2);
+    EXPECT_EQ(cache.getEntryCount(), 0u);
+}
+
+// Test cache hits do not rewrite the index; the next download persists their last use
+TEST_F(ImageCacheTest, HitsDoNotRewriteIndex) {
+    core::ImageCache cache(dir.string(), server(), spawner());
+    setContent("https://cdn/a.png", "a");
+    setContent("https://cdn/b.png", "b");
+    (void)cache.get("https://cdn/a.png");
+
+    const auto indexPath = dir / "index.json";
+    const auto readIndex = [&]() {
+        std::ifstream file(indexPath);
+        return std::string(std::istreambuf_iterator<char>(file), {});
+    };
+    const auto written = readIndex();
+    std::this_thread::sleep_for(2ms);
+    EXPECT_TRUE(cache.peek("https://cdn/a.png").has_value());
+    EXPECT_TRUE(cache.get("https://cdn/a.png").has_value());
+    EXPECT_EQ(readIndex(), written);
+
+    (void)cache.get("https://cdn/b.png");
+    EXPECT_NE(readIndex(), written);
+    EXPECT_EQ(downloads.load(), 2);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include "neko/core/integrityIndex.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace neko;
+using namespace std::chrono_literals;
+
+class IntegrityIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = fs::temp_directory_path() / "neko_integrity_index_test";
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir);
+    }
+
+    std::string path(const std::string &name) const {
+        return (dir / name).string();
+    }
+
+    std::string indexPath() const {
+        return path("index/integrity.json");
+    }
+
+    // Writes a file that looks an hour old, i.e. outside the racy window.
+    void writeSettled(const std::string &name, const std::string &content, std::chrono::seconds age = 3600s) {
+        std::ofstream(path(name), std::ios::binary) << content;
+        fs::last_write_time(path(name), fs::file_time_type::clock::now() - age);
+    }
+
+    // "Digest" is the content itself, so tests can tell what was hashed.
+    core::IntegrityIndex::Hasher hasher() {
+        return [this](const std::string &file, const std::string &algorithm) {
+            ++hashes;
+            std::ifstream in(file, std::ios::binary);
+            return algorithm + ":" + std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        };
+    }
+
+    fs::path dir;
+    std::atomic<int> hashes{0};
+};
+
+// Test an unchanged file is hashed once, also across instances
+TEST_F(IntegrityIndexTest, ReusesDigestOfUnchangedFile) {
+    writeSettled("a.bin", "v1");
+    {
+        core::IntegrityIndex index(indexPath(), hasher());
+        EXPECT_EQ(index.digest(path("a.bin"), "sha256"), "sha256:v1");
+        EXPECT_EQ(index.digest(path("a.bin"), "sha256"), "sha256:v1");
+        EXPECT_EQ(index.getReusedCount(), 1u);
+        index.save();
+    }
+    core::IntegrityIndex index(indexPath(), hasher());
+    EXPECT_EQ(index.digest(path("a.bin"), "sha256"), "sha256:v1");
+    EXPECT_EQ(hashes.load(), 1);
+    EXPECT_EQ(index.getHashedCount(), 0u);
+
+    // Another algorithm is a different digest.
+    EXPECT_EQ(index.digest(path("a.bin"), "sha1"), "sha1:v1");
+    EXPECT_EQ(hashes.load(), 2);
+}
+
+// Test a changed size or modification time hashes again
+TEST_F(IntegrityIndexTest, RehashesChangedFile) {
+    core::IntegrityIndex index(indexPath(), hasher());
+    writeSettled("a.bin", "v1");
+    EXPECT_EQ(index.digest(path("a.bin"), "sha256"), "sha256:v1");
+
+    writeSettled("a.bin", "v2-longer");
+    EXPECT_EQ(index.digest(path("a.bin"), "sha256"), "sha256:v2-longer");
+
+    writeSettled("a.bin", "v3-longer", 7200s); // same size, different mtime
+    EXPECT_EQ(index.digest(path("a.bin"), "sha256"), "sha256:v3-longer");
+    EXPECT_EQ(hashes.load(), 3);
+}
+
+// Test a file written just now is not trusted on its timestamp
+TEST_F(IntegrityIndexTest, DoesNotRecordRacyFile) {
+    core::IntegrityIndex index(indexPath(), hasher());
+    std::ofstream(path("fresh.bin"), std::ios::binary) << "new";
+    EXPECT_EQ(index.digest(path("fresh.bin"), "sha256"), "sha256:new");
+    EXPECT_EQ(index.digest(path("fresh.bin"), "sha256"), "sha256:new");
+    EXPECT_EQ(hashes.load(), 2);
+
+    core::IntegrityIndex shortWindow(indexPath(), hasher(), 0ns);
+    EXPECT_EQ(shortWindow.digest(path("fresh.bin"), "sha256"), "sha256:new");
+    EXPECT_EQ(shortWindow.digest(path("fresh.bin"), "sha256"), "sha256:new");
+    EXPECT_EQ(hashes.load(), 3);
+}
+
+// Test missing files have no digest and are dropped from the saved index
+TEST_F(IntegrityIndexTest, DropsMissingFiles) {
+    core::IntegrityIndex index(indexPath(), hasher());
+    EXPECT_FALSE(index.digest(path("missing.bin"), "sha256").has_value());
+
+    writeSettled("a.bin", "a");
+    writeSettled("b.bin", "b");
+    (void)index.digest(path("a.bin"), "sha256");
+    (void)index.digest(path("b.bin"), "sha256");
+    fs::remove(path("b.bin"));
+    index.save();
+
+    std::ifstream in(indexPath());
+    const std::string saved((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_NE(saved.find("a.bin"), std::string::npos);
+    EXPECT_EQ(saved.find("b.bin"), std::string::npos);
+}
+
+// Test concurrent lookups of many files from several threads
+TEST_F(IntegrityIndexTest, ConcurrentLookups) {
+    for (int i = 0; i < 32; ++i) {
+        writeSettled("f" + std::to_string(i), std::to_string(i));
+    }
+    core::IntegrityIndex index(indexPath(), hasher());
+    std::vector<std::thread> threads;
+    std::atomic<int> matched{0};
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 32; ++i) {
+                if (index.digest(path("f" + std::to_string(i)), "sha256") == "sha256:" + std::to_string(i)) {
+                    ++matched;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(matched.load(), 128);
+    EXPECT_GE(hashes.load(), 32);
+    EXPECT_LE(hashes.load(), 128);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <neko/function/hash.hpp>
+#include <neko/network/network.hpp>
+
+#include "neko/app/nekoLc.hpp"
+
+#include "localHttpServer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+
+namespace fs = std::filesystem;
+using namespace neko;
+using namespace std::chrono_literals;
+
+class LocalHttpServerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Loopback requests never go through a system proxy.
+        network::config::globalConfig.setProxy("");
+        dir = fs::temp_directory_path() / "neko_local_http_server_test";
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir);
+    }
+
+    static std::string sha256(const std::string &data) {
+        return util::hash::digest(data, util::hash::mapAlgorithm("sha256"));
+    }
+
+    // One GET against the server, with how long it took.
+    static auto fetch(const std::string &url) {
+        network::Network net;
+        const auto start = std::chrono::steady_clock::now();
+        auto result = net.execute(network::RequestConfig{.url = url, .method = network::RequestType::Get, .requestId = "local-http-test"});
+        return std::make_pair(std::move(result), std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start));
+    }
+
+    fs::path dir;
+};
+
+// Test the checkUpdates contract and the files it lists are served
+TEST_F(LocalHttpServerTest, ServesSyntheticUpdate) {
+    test::LocalHttpServer server;
+    auto update = test::serveSyntheticUpdate(server, lc::api::checkUpdates, {.files = 4, .fileSize = 100000}, sha256);
+
+    network::Network net;
+    auto manifest = net.execute(network::RequestConfig{
+        .url = server.url(lc::api::checkUpdates),
+        .method = network::RequestType::Post,
+        .postData = "{}",
+        .requestId = "local-http-test-manifest"});
+    ASSERT_TRUE(manifest.isSuccess());
+    EXPECT_EQ(manifest.content, update.manifest);
+
+    const auto files = nlohmann::json::parse(manifest.content).at("updateResponse").at("files");
+    ASSERT_EQ(files.size(), 4u);
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        const auto target = (dir / ("file-" + std::to_string(i))).string();
+        auto result = net.execute(network::RequestConfig{
+            .url = files[i].at("url").get<std::string>(),
+            .method = network::RequestType::DownloadFile,
+            .requestId = "local-http-test-" + std::to_string(i),
+            .fileName = target});
+        ASSERT_TRUE(result.isSuccess());
+        std::ifstream in(target, std::ios::binary);
+        const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(content, update.files[i].second);
+        EXPECT_EQ(sha256(content), files[i].at("checksum").get<std::string>());
+    }
+    EXPECT_EQ(update.totalBytes, 400000u);
+    EXPECT_EQ(server.getServed().size(), 5u);
+}
+
+// Test injected errors, latency and bandwidth caps
+TEST_F(LocalHttpServerTest, InjectsFaults) {
+    test::LocalHttpServer server;
+    server.serveContent("/data", std::string(200000, 'x'));
+
+    server.setFaults({.errorRate = 1.0});
+    {
+        auto [result, elapsed] = fetch(server.url("/data"));
+        EXPECT_EQ(result.statusCode, 503);
+    }
+
+    server.setFaults({.latency = 200ms});
+    {
+        auto [result, elapsed] = fetch(server.url("/data"));
+        EXPECT_GE(elapsed, 200ms);
+        EXPECT_EQ(result.content.size(), 200000u);
+    }
+
+    server.setFaults({.bytesPerSecond = 1000000}); // 200 KB at 1 MB/s
+    {
+        auto [result, elapsed] = fetch(server.url("/data"));
+        EXPECT_GE(elapsed, 180ms);
+        EXPECT_EQ(result.content.size(), 200000u);
+    }
+
+    server.setFaults({.stallRate = 1.0, .stallFor = 300ms});
+    {
+        auto [result, elapsed] = fetch(server.url("/data"));
+        EXPECT_GE(elapsed, 300ms);
+        EXPECT_EQ(result.content.size(), 200000u);
+    }
+
+    server.setFaults({});
+    auto [result, elapsed] = fetch(server.url("/missing"));
+    EXPECT_EQ(result.statusCode, 404);
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include "neko/core/releaseStore.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace neko;
+using Action = core::ReleaseStore::StartAction;
+using Phase = core::ReleaseStore::Phase;
+
+class ReleaseStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = fs::temp_directory_path() / "neko_release_store_test";
+        fs::remove_all(dir);
+        fs::create_directories(dir / "install");
+        fs::create_directories(dir / "download");
+        write(install("NekoLc"), "launcher-v1");
+        write(install("lib/core.so"), "core-v1");
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir);
+    }
+
+    fs::path install(const std::string &name) const {
+        return dir / "install" / name;
+    }
+
+    static void write(const fs::path &file, const std::string &content) {
+        fs::create_directories(file.parent_path());
+        std::ofstream(file, std::ios::binary) << content;
+    }
+
+    static std::string read(const fs::path &file) {
+        std::ifstream in(file, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    // Downloads the v2 release: a new launcher and core library, plus a file v1 did not have.
+    std::vector<std::pair<std::string, std::string>> downloadV2() {
+        write(dir / "download/NekoLc", "launcher-v2");
+        write(dir / "download/core.so", "core-v2");
+        write(dir / "download/plugin.so", "plugin-v2");
+        return {{(dir / "download/NekoLc").string(), "NekoLc"},
+                {(dir / "download/core.so").string(), "lib/core.so"},
+                {(dir / "download/plugin.so").string(), "lib/plugin.so"}};
+    }
+
+    void expectV1() {
+        EXPECT_EQ(read(install("NekoLc")), "launcher-v1");
+        EXPECT_EQ(read(install("lib/core.so")), "core-v1");
+        EXPECT_FALSE(fs::exists(install("lib/plugin.so")));
+    }
+
+    fs::path dir;
+};
+
+// Test a staged release leaves the install alone until the next start switches it in
+TEST_F(ReleaseStoreTest, SwitchesStagedReleaseAtStart) {
+    core::ReleaseStore store(install("").string());
+    store.stage("2.0", downloadV2());
+    EXPECT_EQ(store.getState().phase, Phase::staged);
+    EXPECT_FALSE(fs::exists(dir / "download/NekoLc"));
+    expectV1();
+
+    EXPECT_EQ(store.onStartup(), Action::switched);
+    EXPECT_EQ(read(install("NekoLc")), "launcher-v2");
+    EXPECT_EQ(read(install("lib/core.so")), "core-v2");
+    EXPECT_EQ(read(install("lib/plugin.so")), "plugin-v2");
+    EXPECT_EQ(store.getState().phase, Phase::trial);
+
+    // The restarted launcher runs its trial start and confirms it.
+    EXPECT_EQ(store.onStartup(), Action::none);
+    store.confirm();
+    EXPECT_EQ(store.getState().phase, Phase::none);
+    EXPECT_FALSE(fs::exists(install(".versions/2.0")));
+    EXPECT_EQ(store.onStartup(), Action::none);
+    EXPECT_EQ(read(install("NekoLc")), "launcher-v2");
+}
+
+// Test a release whose trial start never confirmed is rolled back and not staged again
+TEST_F(ReleaseStoreTest, RollsBackUnconfirmedRelease) {
+    core::ReleaseStore store(install("").string());
+    store.stage("2.0", downloadV2());
+    ASSERT_EQ(store.onStartup(), Action::switched);
+    EXPECT_EQ(store.onStartup(), Action::none); // trial start, crashes before confirm()
+
+    EXPECT_EQ(store.onStartup(), Action::rolledBack);
+    expectV1();
+    EXPECT_EQ(store.getState().phase, Phase::none);
+    EXPECT_TRUE(store.isRejected("2.0"));
+    EXPECT_FALSE(store.isRejected("2.1"));
+    EXPECT_FALSE(fs::exists(install(".versions/2.0")));
+}
+
+// Test a rollback hands back the resource version installed before the release, once
+TEST_F(ReleaseStoreTest, RollbackRestoresPreviousResourceVersion) {
+    core::ReleaseStore store(install("").string());
+    store.stage("2.0", downloadV2(), "1.0");
+    EXPECT_EQ(store.getState().previousVersion, "1.0");
+    ASSERT_EQ(store.onStartup(), Action::switched);
+    EXPECT_EQ(store.takeRestoreVersion(), std::nullopt); // nothing to restore while on trial
+    EXPECT_EQ(store.onStartup(), Action::none);
+
+    EXPECT_EQ(store.onStartup(), Action::rolledBack);
+    EXPECT_EQ(store.takeRestoreVersion(), std::optional<std::string>("1.0"));
+    EXPECT_EQ(store.takeRestoreVersion(), std::nullopt);
+    EXPECT_TRUE(store.isRejected("2.0"));
+
+    // A confirmed release has nothing to restore.
+    store.stage("3.0", downloadV2(), "1.0");
+    ASSERT_EQ(store.onStartup(), Action::switched);
+    store.confirm();
+    EXPECT_EQ(store.takeRestoreVersion(), std::nullopt);
+}
+
+// Test a start that died halfway through the switch is undone by the next start
+TEST_F(ReleaseStoreTest, UndoesInterruptedSwitch) {
+    core::ReleaseStore store(install("").string());
+    store.stage("2.0", downloadV2());
+
+    // Replay the first rename pair of a switch, then "crash" with the journal at `switching`.
+    const auto versionDir = install(".versions/2.0");
+    fs::create_directories(versionDir / "previous");
+    fs::rename(install("NekoLc"), versionDir / "previous/NekoLc");
+    fs::rename(versionDir / "files/NekoLc", install("NekoLc"));
+    auto json = nlohmann::json::parse(read(install(".versions/state.json")));
+    json["phase"] = "switching";
+    write(install(".versions/state.json"), json.dump());
+
+    EXPECT_EQ(store.onStartup(), Action::rolledBack);
+    expectV1();
+    EXPECT_TRUE(store.isRejected("2.0"));
+}
+
+// Test staging again replaces a release that was not switched in yet
+TEST_F(ReleaseStoreTest, RestagingReplacesPendingRelease) {
+    core::ReleaseStore store(install("").string());
+    store.stage("2.0", downloadV2());
+    write(dir / "download/NekoLc", "launcher-v3");
+    store.stage("3.0", {{(dir / "download/NekoLc").string(), "NekoLc"}});
+    EXPECT_FALSE(fs::exists(install(".versions/2.0")));
+
+    EXPECT_EQ(store.onStartup(), Action::switched);
+    EXPECT_EQ(read(install("NekoLc")), "launcher-v3");
+    EXPECT_EQ(read(install("lib/core.so")), "core-v1");
+
+    // Nothing is staged over a release still on trial.
+    write(dir / "download/NekoLc", "launcher-v4");
+    EXPECT_THROW(store.stage("4.0", {{(dir / "download/NekoLc").string(), "NekoLc"}}), ex::Runtime);
+}
+
+// Test unsafe paths and incomplete staged releases are refused
+TEST_F(ReleaseStoreTest, RefusesUnsafeOrIncompleteReleases) {
+    core::ReleaseStore store(install("").string());
+    write(dir / "download/evil", "x");
+    EXPECT_THROW(store.stage("2.0", {{(dir / "download/evil").string(), "../evil"}}), ex::ArgumentError);
+    EXPECT_THROW(store.stage("2.0", {{(dir / "download/evil").string(), "/etc/evil"}}), ex::ArgumentError);
+    EXPECT_EQ(store.getState().phase, Phase::none);
+
+    store.stage("2.0", downloadV2());
+    fs::remove(install(".versions/2.0/files/lib/core.so"));
+    EXPECT_EQ(store.onStartup(), Action::none);
+    expectV1();
+    EXPECT_EQ(store.getState().phase, Phase::none);
+    EXPECT_EQ(core::ReleaseStore::versionName("1.0/../x y"), "1.0_.._x_y");
+}
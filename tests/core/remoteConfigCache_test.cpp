@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include "neko/core/remoteConfigCache.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace neko;
+namespace fs = std::filesystem;
+
+namespace {
+    api::LauncherConfigResponse makeConfig(neko::int32 maxRetryCount) {
+        api::LauncherConfigResponse config{};
+        config.host = {"example.com"};
+        config.maxRetryCount = maxRetryCount;
+        config.retryIntervalSec = 1;
+        return config;
+    }
+} // namespace
+
+class RemoteConfigCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "neko_remote_config_cache_test";
+        fs::remove_all(testDir);
+        fs::create_directories(testDir);
+        cacheFile = (testDir / "remote-config.json").string();
+    }
+
+    void TearDown() override {
+        joinAll();
+        fs::remove_all(testDir);
+    }
+
+    // Runs background revalidations on plain threads joined by the test.
+    core::RemoteConfigCache::Spawner spawner() {
+        return [this](std::function<void()> task) {
+            std::lock_guard lock(threadsMutex);
+            threads.emplace_back(std::move(task));
+        };
+    }
+
+    void joinAll() {
+        std::lock_guard lock(threadsMutex);
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        threads.clear();
+    }
+
+    fs::path testDir;
+    std::string cacheFile;
+    std::mutex threadsMutex;
+    std::vector<std::thread> threads;
+};
+
+// Test a fresh config is served without another request
+TEST_F(RemoteConfigCacheTest, FreshConfigServedWithoutRequest) {
+    std::atomic<int> calls{0};
+    core::RemoteConfigCache cache([&](const std::string &) {
+        ++calls;
+        return core::RemoteConfigFetch{.config = makeConfig(3), .maxAge = std::chrono::minutes(1)};
+    }, spawner());
+
+    EXPECT_EQ(cache.get().maxRetryCount, 3);
+    EXPECT_EQ(cache.get().maxRetryCount, 3);
+    EXPECT_EQ(calls.load(), 1);
+}
+
+// Test concurrent callers share one request
+TEST_F(RemoteConfigCacheTest, ConcurrentCallersShareOneFetch) {
+    std::atomic<int> calls{0};
+    core::RemoteConfigCache cache([&](const std::string &) {
+        ++calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return core::RemoteConfigFetch{.config = makeConfig(5)};
+    }, spawner());
+
+    std::vector<std::thread> callers;
+    std::atomic<int> ok{0};
+    for (int i = 0; i < 8; ++i) {
+        callers.emplace_back([&]() {
+            if (cache.get().maxRetryCount == 5) {
+                ++ok;
+            }
+        });
+    }
+    for (auto &caller : callers) {
+        caller.join();
+    }
+    EXPECT_EQ(ok.load(), 8);
+    EXPECT_EQ(calls.load(), 1);
+}
+
+// Test an expired config is served at once and revalidated with its ETag
+TEST_F(RemoteConfigCacheTest, StaleConfigRevalidatesWithEtag) {
+    std::vector<std::string> seenEtags;
+    std::mutex seenMutex;
+    core::RemoteConfigCache cache([&](const std::string &etag) {
+        std::lock_guard lock(seenMutex);
+        seenEtags.push_back(etag);
+        if (etag == "v1") {
+            return core::RemoteConfigFetch{.notModified = true, .maxAge = std::chrono::minutes(1)};
+        }
+        return core::RemoteConfigFetch{.config = makeConfig(2), .etag = "v1", .maxAge = std::chrono::milliseconds(1)};
+    }, spawner());
+
+    EXPECT_EQ(cache.get().maxRetryCount, 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    EXPECT_EQ(cache.get().maxRetryCount, 2); // stale, served while revalidating
+    cache.wait();
+    joinAll();
+    EXPECT_EQ(cache.get().maxRetryCount, 2); // fresh again after the 304
+
+    std::lock_guard lock(seenMutex);
+    ASSERT_EQ(seenEtags.size(), 2u);
+    EXPECT_EQ(seenEtags[0], "");
+    EXPECT_EQ(seenEtags[1], "v1");
+    EXPECT_EQ(cache.getFetchCount(), 2u);
+}
+
+// Test the last good config is loaded from disk by the next instance
+TEST_F(RemoteConfigCacheTest, PersistsAcrossInstances) {
+    {
+        core::RemoteConfigCache cache([](const std::string &) {
+            return core::RemoteConfigFetch{.config = makeConfig(7), .etag = "abc", .maxAge = std::chrono::minutes(1)};
+        }, spawner(), cacheFile);
+        EXPECT_EQ(cache.get().maxRetryCount, 7);
+    }
+    ASSERT_TRUE(fs::exists(cacheFile));
+
+    std::atomic<int> calls{0};
+    core::RemoteConfigCache restarted([&](const std::string &) -> core::RemoteConfigFetch {
+        ++calls;
+        throw std::runtime_error("offline");
+    }, spawner(), cacheFile);
+    EXPECT_EQ(restarted.get().maxRetryCount, 7);
+    EXPECT_EQ(restarted.getEtag().value_or(""), "abc");
+    EXPECT_EQ(calls.load(), 0);
+
+    // Expired on disk: served immediately, revalidation fails in the background.
+    restarted.invalidate();
+    EXPECT_EQ(restarted.get().maxRetryCount, 7);
+    restarted.wait();
+    joinAll();
+    EXPECT_EQ(calls.load(), 1);
+}
+
+// Test a failed blocking fetch falls back to the last good config, or throws without one
+TEST_F(RemoteConfigCacheTest, FailedFetchFallsBackToLastGood) {
+    std::atomic<bool> fail{false};
+    core::RemoteConfigCache cache([&](const std::string &) {
+        if (fail) {
+            throw std::runtime_error("offline");
+        }
+        return core::RemoteConfigFetch{.config = makeConfig(4), .maxAge = std::chrono::milliseconds(1)};
+    }, spawner(), {}, core::RemoteConfigCache::Options{.maxStale = std::chrono::milliseconds(0)});
+
+    EXPECT_EQ(cache.get().maxRetryCount, 4);
+    fail = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(cache.get().maxRetryCount, 4);
+
+    core::RemoteConfigCache empty([](const std::string &) -> core::RemoteConfigFetch {
+        throw std::runtime_error("offline");
+    }, spawner());
+    EXPECT_THROW(empty.get(), std::runtime_error);
+}
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+
+#include "neko/core/responseCache.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace neko;
+using namespace std::chrono_literals;
+
+class ResponseCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / "neko_response_cache_test";
+        std::filesystem::remove_all(dir);
+    }
+
+    void TearDown() override {
+        joinAll();
+        std::filesystem::remove_all(dir);
+    }
+
+    // Runs each background revalidation on a plain thread joined by the test.
+    core::ResponseCache::Spawner spawner() {
+        return [this](std::function<void()> task) {
+            std::lock_guard lock(threadsMutex);
+            threads.emplace_back(std::move(task));
+        };
+    }
+
+    void joinAll() {
+        std::vector<std::thread> pending;
+        {
+            std::lock_guard lock(threadsMutex);
+            pending.swap(threads);
+        }
+        for (auto &thread : pending) {
+            thread.join();
+        }
+    }
+
+    // Answers with `body` and counts calls.
+    core::ResponseCache::Fetcher answer(std::string body, std::string etag = {}) {
+        return [this, body = std::move(body), etag = std::move(etag)](const std::string &, const std::string &) {
+            ++calls;
+            return core::Revalidation{.body = body, .etag = etag};
+        };
+    }
+
+    const core::CachePolicy expired{.defaultMaxAge = 0ms, .staleWhileRevalidate = 0ms};
+
+    std::filesystem::path dir;
+    std::atomic<int> calls{0};
+    std::mutex threadsMutex;
+    std::vector<std::thread> threads;
+};
+
+// Test a fresh entry is served from disk, also by a new cache instance
+TEST_F(ResponseCacheTest, FreshEntryServedWithoutRequest) {
+    const core::CacheRequest request{.method = "POST", .url = "https://api/news", .body = R"({"limit":8})"};
+    {
+        core::ResponseCache cache(dir.string(), spawner());
+        const auto first = cache.get(request, answer("news-v1"));
+        EXPECT_FALSE(first.fromCache);
+        EXPECT_EQ(first.body, "news-v1");
+    }
+
+    core::ResponseCache cache(dir.string(), spawner());
+    const auto second = cache.get(request, answer("news-v2"));
+    EXPECT_TRUE(second.fromCache);
+    EXPECT_FALSE(second.stale);
+    EXPECT_EQ(second.body, "news-v1");
+    EXPECT_EQ(calls.load(), 1);
+}
+
+// Test key order and volatile fields do not split the key, but other fields do
+TEST_F(ResponseCacheTest, KeyUsesCanonicalBody) {
+    core::ResponseCache cache(dir.string(), spawner());
+    const auto a = cache.makeKey({.method = "POST", .url = "u", .body = R"({"r":{"limit":8,"timestamp":1},"p":"en"})"});
+    const auto b = cache.makeKey({.method = "POST", .url = "u", .body = R"({"p":"en","r":{"timestamp":2,"limit":8}})"});
+    const auto c = cache.makeKey({.method = "POST", .url = "u", .body = R"({"p":"en","r":{"limit":9}})"});
+    const auto d = cache.makeKey({.method = "GET", .url = "u", .body = R"({"p":"en","r":{"limit":8}})"});
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_NE(a, d);
+    EXPECT_EQ(core::ResponseCache::canonicalize("not json", {"timestamp"}), "not json");
+}
+
+// Test an expired entry is revalidated with its validators and a 304 keeps the body
+TEST_F(ResponseCacheTest, ConditionalRevalidationKeepsBody) {
+    core::ResponseCache cache(dir.string(), spawner());
+    const core::CacheRequest request{.method = "POST", .url = "https://api/maintenance"};
+    (void)cache.get(request, answer("status", "\"e1\""), {}, expired);
+
+    std::string seenEtag;
+    const auto result = cache.get(
+        request,
+        [&](const std::string &etag, const std::string &) {
+            seenEtag = etag;
+            return core::Revalidation{.notModified = true, .maxAge = 1h};
+        },
+        {}, expired);
+    EXPECT_EQ(seenEtag, "\"e1\"");
+    EXPECT_EQ(result.body, "status");
+    EXPECT_EQ(result.etag, "\"e1\"");
+
+    // The server's max-age now keeps it fresh.
+    EXPECT_EQ(cache.get(request, answer("changed"), {}, expired).body, "status");
+    EXPECT_EQ(calls.load(), 1);
+}
+
+// Test an expired entry inside the stale window is returned at once and refreshed in the background
+TEST_F(ResponseCacheTest, StaleWhileRevalidateNotifiesChanges) {
+    core::ResponseCache cache(dir.string(), spawner());
+    const core::CacheRequest request{.method = "POST", .url = "https://api/news"};
+    const core::CachePolicy policy{.defaultMaxAge = 0ms, .staleWhileRevalidate = 1h};
+    (void)cache.get(request, answer("v1"), {}, policy);
+
+    std::atomic<bool> release{false};
+    std::string changedBody;
+    const auto begin = std::chrono::steady_clock::now();
+    const auto stale = cache.get(
+        request,
+        [&](const std::string &, const std::string &) {
+            while (!release) {
+                std::this_thread::sleep_for(1ms);
+            }
+            return core::Revalidation{.body = "v2"};
+        },
+        [&](const core::CachedResponse &changed) { changedBody = changed.body; }, policy);
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, 100ms);
+    EXPECT_TRUE(stale.fromCache);
+    EXPECT_TRUE(stale.stale);
+    EXPECT_EQ(stale.body, "v1");
+
+    release = true;
+    cache.wait();
+    joinAll();
+    EXPECT_EQ(changedBody, "v2");
+    EXPECT_EQ(cache.peek(request)->body, "v2");
+}
+
+// Test a failed request falls back to the stored entry, and fails without one
+TEST_F(ResponseCacheTest, FailureFallsBackToStoredEntry) {
+    core::ResponseCache cache(dir.string(), spawner());
+    const core::CacheRequest request{.method = "GET", .url = "https://authlib/latest.json"};
+    auto failing = [](const std::string &, const std::string &) -> core::Revalidation {
+        throw std::runtime_error("offline");
+    };
+    EXPECT_THROW((void)cache.get(request, failing, {}, expired), std::runtime_error);
+
+    (void)cache.get(request, answer("meta"), {}, expired);
+    const auto fallback = cache.get(request, failing, {}, expired);
+    EXPECT_TRUE(fallback.fromCache);
+    EXPECT_TRUE(fallback.stale);
+    EXPECT_EQ(fallback.body, "meta");
+}
+
+// Test an entry older than the staleIfError window does not stand in for a failed request
+TEST_F(ResponseCacheTest, FailureFallbackBoundedByStaleIfError) {
+    core::ResponseCache cache(dir.string(), spawner());
+    const core::CacheRequest request{.method = "POST", .url = "https://api/maintenance"};
+    auto failing = [](const std::string &, const std::string &) -> core::Revalidation {
+        throw std::runtime_error("offline");
+    };
+    (void)cache.get(request, answer("in progress"), {}, expired);
+    std::this_thread::sleep_for(5ms);
+
+    const core::CachePolicy bounded{.defaultMaxAge = 0ms, .staleWhileRevalidate = 0ms, .staleIfError = 1h};
+    EXPECT_EQ(cache.get(request, failing, {}, bounded).body, "in progress");
+    const core::CachePolicy never{.defaultMaxAge = 0ms, .staleWhileRevalidate = 0ms, .staleIfError = 0ms};
+    EXPECT_THROW((void)cache.get(request, failing, {}, never), std::runtime_error);
+}
+
+// Test the least recently used entries are evicted past the size bound
+TEST_F(ResponseCacheTest, EvictsLeastRecentlyUsed) {
+    core::ResponseCache cache(dir.string(), spawner(), core::ResponseCache::Options{.maxBytes = 700});
+    const std::string body(150, 'x');
+    const core::CacheRequest a{.method = "GET", .url = "a"}, b{.method = "GET", .url = "b"}, c{.method = "GET", .url = "c"};
+    (void)cache.get(a, answer(body));
+    (void)cache.get(b, answer(body));
+    std::this_thread::sleep_for(5ms);
+    (void)cache.get(a, answer(body)); // a is now more recent than b
+    std::this_thread::sleep_for(5ms);
+    (void)cache.get(c, answer(body));
+
+    EXPECT_LE(cache.getTotalBytes(), 700u);
+    EXPECT_TRUE(cache.peek(a).has_value());
+    EXPECT_FALSE(cache.peek(b).has_value());
+    EXPECT_TRUE(cache.peek(c).has_value());
+}
+
+// Test concurrent callers of a missing entry share one request
+TEST_F(ResponseCacheTest, ConcurrentMissesShareOneRequest) {
+    core::ResponseCache cache(dir.string(), spawner());
+    const core::CacheRequest request{.method = "POST", .url = "https://api/news"};
+    auto slow = [&](const std::string &, const std::string &) {
+        ++calls;
+        std::this_thread::sleep_for(50ms);
+        return core::Revalidation{.body = "shared"};
+    };
+
+    std::vector<std::thread> callers;
+    std::atomic<int> matched{0};
+    for (int i = 0; i < 4; ++i) {
+        callers.emplace_back([&]() {
+            if (cache.get(request, slow).body == "shared") {
+                ++matched;
+            }
+        });
+    }
+    for (auto &caller : callers) {
+        caller.join();
+    }
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(matched.load(), 4);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include "neko/core/startupGraph.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace neko;
+using State = core::StartupGraph::State;
+
+class StartupGraphTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        joinAll();
+    }
+
+    // Runs each ready step on a plain thread joined by the test.
+    core::StartupGraph::Spawner spawner() {
+        return [this](std::function<void()> task) {
+            std::lock_guard lock(threadsMutex);
+            threads.emplace_back(std::move(task));
+        };
+    }
+
+    void joinAll() {
+        for (;;) {
+            std::vector<std::thread> pending;
+            {
+                std::lock_guard lock(threadsMutex);
+                pending.swap(threads);
+            }
+            if (pending.empty()) {
+                return;
+            }
+            for (auto &thread : pending) {
+                thread.join();
+            }
+        }
+    }
+
+    void record(const std::string &name) {
+        std::lock_guard lock(orderMutex);
+        order.push_back(name);
+    }
+
+    std::size_t position(const std::string &name) {
+        std::lock_guard lock(orderMutex);
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            if (order[i] == name) {
+                return i;
+            }
+        }
+        return order.size();
+    }
+
+    std::mutex threadsMutex;
+    std::vector<std::thread> threads;
+    std::mutex orderMutex;
+    std::vector<std::string> order;
+};
+
+// Test a step runs only after all of its dependencies
+TEST_F(StartupGraphTest, RunsStepsAfterTheirDependencies) {
+    core::StartupGraph graph(spawner());
+    graph.add("config", {}, [this]() { record("config"); });
+    graph.add("maintenance", {"config"}, [this]() { record("maintenance"); });
+    graph.add("updateCheck", {"config"}, [this]() { record("updateCheck"); });
+    graph.add("update", {"maintenance", "updateCheck"}, [this]() { record("update"); });
+    graph.run();
+    graph.wait();
+
+    EXPECT_LT(position("config"), position("maintenance"));
+    EXPECT_LT(position("config"), position("updateCheck"));
+    EXPECT_LT(position("maintenance"), position("update"));
+    EXPECT_LT(position("updateCheck"), position("update"));
+    EXPECT_EQ(graph.getState("update"), State::succeeded);
+}
+
+// Test independent steps overlap instead of running one after another
+TEST_F(StartupGraphTest, IndependentStepsRunConcurrently) {
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    auto step = [&]() {
+        const int now = ++running;
+        int expected = peak.load();
+        while (now > expected && !peak.compare_exchange_weak(expected, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        --running;
+    };
+
+    core::StartupGraph graph(spawner());
+    graph.add("maintenance", {}, step);
+    graph.add("updateCheck", {}, step);
+    graph.add("news", {}, step);
+    graph.add("authPrefetch", {}, step);
+
+    const auto begin = std::chrono::steady_clock::now();
+    graph.run();
+    graph.wait();
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_EQ(peak.load(), 4);
+    EXPECT_LT(elapsed, std::chrono::milliseconds(350));
+}
+
+// Test a failure skips the steps that require it but not unrelated or after-completion steps
+TEST_F(StartupGraphTest, FailureSkipsOnlyDependents) {
+    std::atomic<bool> updateRan{false};
+    std::atomic<bool> pageRan{false};
+    core::StartupGraph graph(spawner());
+    graph.add("updateCheck", {}, []() { throw std::runtime_error("offline"); });
+    graph.add("update", {"updateCheck"}, [&]() { updateRan = true; });
+    graph.add("news", {}, []() {});
+    graph.add("page", {"update", "news"}, [&]() { pageRan = true; }, core::StartupGraph::Policy::afterCompletion);
+    graph.run();
+    graph.wait();
+
+    EXPECT_EQ(graph.getState("updateCheck"), State::failed);
+    EXPECT_EQ(graph.getError("updateCheck"), "offline");
+    EXPECT_EQ(graph.getState("update"), State::skipped);
+    EXPECT_EQ(graph.getState("news"), State::succeeded);
+    EXPECT_EQ(graph.getState("page"), State::succeeded);
+    EXPECT_FALSE(updateRan.load());
+    EXPECT_TRUE(pageRan.load());
+}
+
+// Test unknown dependencies and cycles are rejected before anything runs
+TEST_F(StartupGraphTest, RejectsInvalidGraphs) {
+    std::atomic<int> calls{0};
+    core::StartupGraph unknown(spawner());
+    unknown.add("news", {"config"}, [&]() { ++calls; });
+    EXPECT_THROW(unknown.run(), ex::ArgumentError);
+
+    core::StartupGraph cycle(spawner());
+    cycle.add("root", {}, [&]() { ++calls; });
+    cycle.add("a", {"b"}, [&]() { ++calls; });
+    cycle.add("b", {"a"}, [&]() { ++calls; });
+    EXPECT_THROW(cycle.run(), ex::ArgumentError);
+
+    core::StartupGraph duplicate(spawner());
+    duplicate.add("news", {}, [&]() { ++calls; });
+    EXPECT_THROW(duplicate.add("news", {}, [&]() { ++calls; }), ex::ArgumentError);
+
+    joinAll();
+    EXPECT_EQ(calls.load(), 0);
+}
+
+// Test steps keep running after the graph object is destroyed
+TEST_F(StartupGraphTest, OutlivesTheGraphObject) {
+    std::atomic<bool> done{false};
+    {
+        core::StartupGraph graph(spawner());
+        graph.add("slow", {}, []() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); });
+        graph.add("after", {"slow"}, [&]() { done = true; });
+        graph.run();
+    }
+    joinAll();
+    EXPECT_TRUE(done.load());
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+
+#include "neko/core/unzip.hpp"
+
+#include <zlib.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace neko;
+
+class UnzipTest : public ::testing::Test {
+protected:
+    struct ZipEntry {
+        std::string name;
+        std::string content;
+        bool deflate = true;
+        neko::uint32 mode = 0; // Unix mode; 0 = made on a non-Unix host
+        neko::uint16 flags = 0;
+    };
+
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "neko_unzip_test";
+        fs::remove_all(testDir);
+        fs::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    std::string path(const std::string &name) const {
+        return (testDir / name).string();
+    }
+
+    static std::string readFile(const fs::path &file) {
+        std::ifstream in(file, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    static std::string makeResource(std::size_t size, unsigned seed) {
+        std::string data(size, '\0');
+        for (auto &c : data) {
+            seed = seed * 1103515245u + 12345u;
+            c = static_cast<char>('a' + (seed >> 16) % 8); // compressible but not trivial
+        }
+        return data;
+    }
+
+    static std::string rawDeflate(const std::string &data) {
+        z_stream stream{};
+        deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+        std::string out(deflateBound(&stream, static_cast<uLong>(data.size())), '\0');
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+        stream.avail_in = static_cast<uInt>(data.size());
+        stream.next_out = reinterpret_cast<Bytef *>(out.data());
+        stream.avail_out = static_cast<uInt>(out.size());
+        deflate(&stream, Z_FINISH);
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+        return out;
+    }
+
+    // Minimal zip writer (no zip64, no data descriptors).
+    static void writeZip(const std::string &file, const std::vector<ZipEntry> &entries) {
+        std::string body, directory;
+        auto put16 = [](std::string &s, neko::uint32 v) {
+            s += static_cast<char>(v & 0xFF);
+            s += static_cast<char>((v >> 8) & 0xFF);
+        };
+        auto put32 = [&](std::string &s, neko::uint32 v) {
+            put16(s, v & 0xFFFF);
+            put16(s, v >> 16);
+        };
+        for (const auto &entry : entries) {
+            const bool isDirectory = entry.name.ends_with('/');
+            const auto data = (entry.deflate && !isDirectory) ? rawDeflate(entry.content) : entry.content;
+            const neko::uint16 method = (entry.deflate && !isDirectory) ? 8 : 0;
+            const auto crc = static_cast<neko::uint32>(crc32(0, reinterpret_cast<const Bytef *>(entry.content.data()), static_cast<uInt>(entry.content.size())));
+            const auto offset = static_cast<neko::uint32>(body.size());
+
+            put32(body, 0x04034b50);
+            put16(body, 20);
+            put16(body, entry.flags);
+            put16(body, method);
+            put32(body, 0);
+            put32(body, crc);
+            put32(body, static_cast<neko::uint32>(data.size()));
+            put32(body, static_cast<neko::uint32>(entry.content.size()));
+            put16(body, static_cast<neko::uint32>(entry.name.size()));
+            put16(body, 0);
+            body += entry.name;
+            body += data;
+
+            put32(directory, 0x02014b50);
+            put16(directory, entry.mode != 0 ? (3u << 8) | 20 : 20);
+            put16(directory, 20);
+            put16(directory, entry.flags);
+            put16(directory, method);
+            put32(directory, 0);
+            put32(directory, crc);
+            put32(directory, static_cast<neko::uint32>(data.size()));
+            put32(directory, static_cast<neko::uint32>(entry.content.size()));
+            put16(directory, static_cast<neko::uint32>(entry.name.size()));
+            put16(directory, 0);
+            put16(directory, 0);
+            put16(directory, 0);
+            put16(directory, 0);
+            put32(directory, entry.mode << 16);
+            put32(directory, offset);
+            directory += entry.name;
+        }
+        std::string end;
+        put32(end, 0x06054b50);
+        put16(end, 0);
+        put16(end, 0);
+        put16(end, static_cast<neko::uint32>(entries.size()));
+        put16(end, static_cast<neko::uint32>(entries.size()));
+        put32(end, static_cast<neko::uint32>(directory.size()));
+        put32(end, static_cast<neko::uint32>(body.size()));
+        put16(end, 0);
+        std::ofstream(file, std::ios::binary) << body << directory << end;
+    }
+
+    fs::path testDir;
+};
+
+// Test stored, deflated and directory entries are extracted with several threads
+TEST_F(UnzipTest, ExtractsEntriesInParallel) {
+    std::vector<ZipEntry> entries{{.name = "assets/"}};
+    for (int i = 0; i < 16; ++i) {
+        entries.push_back({.name = "assets/file" + std::to_string(i) + ".bin", .content = makeResource(20000 + i * 5000, i), .deflate = i % 3 != 0});
+    }
+    entries.push_back({.name = "empty.txt", .content = ""});
+    entries.push_back({.name = "big/nested/data.bin", .content = makeResource(3 << 20, 99)});
+    writeZip(path("pack.zip"), entries);
+
+    ASSERT_TRUE(core::unzip::isSupported(path("pack.zip")));
+    std::atomic<neko::uint64> lastDone{0};
+    std::atomic<neko::uint64> total{0};
+    auto result = core::unzip::extract(path("pack.zip"), path("out"), {.threads = 4, .onProgress = [&](neko::uint64 done, neko::uint64 all) {
+        lastDone = std::max(lastDone.load(), done);
+        total = all;
+    }});
+
+    EXPECT_EQ(result.entries, entries.size());
+    for (const auto &entry : entries) {
+        const auto target = testDir / "out" / entry.name;
+        if (entry.name.ends_with('/')) {
+            EXPECT_TRUE(fs::is_directory(target));
+        } else {
+            EXPECT_EQ(readFile(target), entry.content) << entry.name;
+        }
+    }
+    EXPECT_EQ(result.bytes, total.load());
+    EXPECT_EQ(lastDone.load(), total.load());
+}
+
+// Test Unix permission bits survive extraction
+TEST_F(UnzipTest, KeepsExecutableBit) {
+    writeZip(path("pack.zip"), {{.name = "update", .content = "#!/bin/sh\n", .mode = 0100755}});
+    core::unzip::extract(path("pack.zip"), path("out"));
+    const auto perms = fs::status(path("out/update")).permissions();
+    EXPECT_NE(perms & fs::perms::owner_exec, fs::perms::none);
+}
+
+// Test paths escaping the destination are rejected before anything is written
+TEST_F(UnzipTest, RejectsUnsafePaths) {
+    writeZip(path("evil.zip"), {{.name = "ok.txt", .content = "fine"}, {.name = "../escape.txt", .content = "bad"}});
+    EXPECT_THROW(core::unzip::extract(path("evil.zip"), path("out")), ex::ArgumentError);
+    EXPECT_FALSE(fs::exists(path("escape.txt")));
+    EXPECT_FALSE(fs::exists(path("out/ok.txt")));
+
+    writeZip(path("abs.zip"), {{.name = "/etc/owned", .content = "bad"}});
+    EXPECT_THROW(core::unzip::extract(path("abs.zip"), path("out")), ex::ArgumentError);
+}
+
+// Test two entries resolving to the same path are rejected before anything is written
+TEST_F(UnzipTest, RejectsDuplicateEntries) {
+    writeZip(path("dup.zip"), {{.name = "first.txt", .content = "ok"}, {.name = "data/a.txt", .content = "one"}, {.name = "data/./a.txt", .content = "two"}});
+    EXPECT_THROW(core::unzip::extract(path("dup.zip"), path("out")), ex::ArgumentError);
+    EXPECT_FALSE(fs::exists(path("out/first.txt")));
+    EXPECT_FALSE(fs::exists(path("out/data/a.txt")));
+}
+
+// Test corrupt data, encrypted entries and non-zip files are reported
+TEST_F(UnzipTest, RejectsCorruptAndUnsupportedArchives) {
+    const auto content = makeResource(100000, 1);
+    writeZip(path("pack.zip"), {{.name = "data.bin", .content = content}});
+    auto bytes = readFile(path("pack.zip"));
+    bytes[30 + 8 + 1000] ^= 0x55; // inside the deflated data
+    std::ofstream(path("corrupt.zip"), std::ios::binary) << bytes;
+    EXPECT_THROW(core::unzip::extract(path("corrupt.zip"), path("out")), ex::Parse);
+    EXPECT_FALSE(fs::exists(path("out/data.bin")));
+
+    writeZip(path("encrypted.zip"), {{.name = "secret.bin", .content = "x", .deflate = false, .flags = 1}});
+    EXPECT_FALSE(core::unzip::isSupported(path("encrypted.zip")));
+    EXPECT_THROW(core::unzip::extract(path("encrypted.zip"), path("out")), ex::ArgumentError);
+
+    std::ofstream(path("plain.zip"), std::ios::binary) << "not a zip archive at all, just some text";
+    EXPECT_FALSE(core::unzip::isSupported(path("plain.zip")));
+    EXPECT_THROW(core::unzip::extract(path("plain.zip"), path("out")), ex::Parse);
+}
+
+// Test cancellation stops extraction
+TEST_F(UnzipTest, StopsWhenCancelled) {
+    writeZip(path("pack.zip"), {{.name = "a.bin", .content = makeResource(2 << 20, 1)}, {.name = "b.bin", .content = makeResource(2 << 20, 2)}});
+    EXPECT_THROW(core::unzip::extract(path("pack.zip"), path("out"), {.threads = 2, .isCancelled = []() { return true; }}), ex::Runtime);
+}
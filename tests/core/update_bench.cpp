@@ -0,0 +1,191 @@
+/**
+ * @file update_bench.cpp
+ * @brief End-to-end update throughput against the local HTTP stand-in server.
+ *
+ * Not part of ctest; run NekoLcCore_update_bench directly. Each run fetches the manifest through the
+ * checkUpdates contract and applies it with core::update::update into `<workPath>/update-bench`.
+ * Files/s, MB/s and the p99 per-file time (first request to last byte, as served) of each run, and
+ * those of the median run, are recorded as test properties (`--gtest_output=xml` / `json`).
+ * The client config file and resource version that update() writes are restored afterwards.
+ *
+ * Environment (defaults in brackets):
+ * - NEKO_BENCH_FILES [200], NEKO_BENCH_FILE_SIZE bytes [262144], NEKO_BENCH_RUNS [3]
+ * - NEKO_BENCH_MULTI_THREAD 0/1 [0] — segmented (range) downloads
+ * - NEKO_BENCH_LATENCY_MS [0], NEKO_BENCH_BYTES_PER_SEC per response [0 = unlimited]
+ * - NEKO_BENCH_ERROR_RATE [0], NEKO_BENCH_STALL_RATE [0], NEKO_BENCH_STALL_MS [500]
+ */
+
+#include <gtest/gtest.h>
+
+#include <neko/function/hash.hpp>
+#include <neko/network/network.hpp>
+#include <neko/system/platform.hpp>
+
+#include "neko/app/appinfo.hpp"
+#include "neko/app/nekoLc.hpp"
+#include "neko/bus/configBus.hpp"
+#include "neko/bus/threadBus.hpp"
+#include "neko/core/update.hpp"
+
+#include "localHttpServer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace neko;
+
+namespace {
+
+    neko::uint64 envOr(const char *name, neko::uint64 fallback) {
+        const char *value = std::getenv(name);
+        return value != nullptr ? std::stoull(value) : fallback;
+    }
+
+    double envOr(const char *name, double fallback) {
+        const char *value = std::getenv(name);
+        return value != nullptr ? std::stod(value) : fallback;
+    }
+
+    struct RunResult {
+        double seconds = 0;
+        double filesPerSecond = 0;
+        double megabytesPerSecond = 0;
+        double p99FileMs = 0;
+    };
+
+} // namespace
+
+class UpdateBench : public ::testing::Test {
+protected:
+    std::string savedResourceVersion;
+    std::optional<std::string> savedConfigFile;
+
+    void SetUp() override {
+        // update() records the applied resource version and saves the client config; keep both.
+        savedResourceVersion = bus::config::getSnapshot()->main.resourceVersion;
+        if (std::ifstream file(app::getConfigFileName(), std::ios::binary); file.is_open()) {
+            savedConfigFile = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        network::config::globalConfig.setProxy("");
+        // Same pool layout as app::init::initThreads.
+        bus::thread::setThreadCount(std::max(1u, std::thread::hardware_concurrency()));
+        bus::thread::setThreadCount(bus::Executor::io, bus::thread::defaultIoThreadCount);
+        bus::thread::setMaxQueueSize(bus::Executor::io, bus::thread::defaultIoMaxQueueSize);
+    }
+
+    void TearDown() override {
+        bus::config::updateClientConfig([this](neko::ClientConfig &cfg) {
+            cfg.main.resourceVersion = savedResourceVersion;
+        });
+        (void)bus::config::flush();
+        if (savedConfigFile) {
+            std::ofstream(app::getConfigFileName(), std::ios::binary | std::ios::trunc) << *savedConfigFile;
+        } else {
+            std::error_code ec;
+            fs::remove(app::getConfigFileName(), ec);
+        }
+    }
+
+    static std::string sha256(const std::string &data) {
+        return util::hash::digest(data, util::hash::mapAlgorithm("sha256"));
+    }
+
+    // Per-file time: from the first request for the file to the last byte of the last one.
+    static double p99FileMs(const std::vector<test::ServedRequest> &served) {
+        std::map<std::string, std::pair<std::chrono::steady_clock::time_point, std::chrono::steady_clock::time_point>> spans;
+        for (const auto &request : served) {
+            if (!request.path.starts_with("/files/")) {
+                continue;
+            }
+            auto [it, inserted] = spans.try_emplace(request.path, request.start, request.end);
+            if (!inserted) {
+                it->second.first = std::min(it->second.first, request.start);
+                it->second.second = std::max(it->second.second, request.end);
+            }
+        }
+        std::vector<double> times;
+        for (const auto &[path, span] : spans) {
+            times.push_back(std::chrono::duration<double, std::milli>(span.second - span.first).count());
+        }
+        if (times.empty()) {
+            return 0;
+        }
+        std::sort(times.begin(), times.end());
+        return times[std::min(times.size() - 1, static_cast<std::size_t>(times.size() * 0.99))];
+    }
+};
+
+TEST_F(UpdateBench, EndToEnd) {
+    const test::SyntheticUpdateOptions options{
+        .files = static_cast<neko::uint32>(envOr("NEKO_BENCH_FILES", neko::uint64(200))),
+        .fileSize = envOr("NEKO_BENCH_FILE_SIZE", neko::uint64(256 * 1024)),
+        .directory = "update-bench",
+        .suggestMultiThread = envOr("NEKO_BENCH_MULTI_THREAD", neko::uint64(0)) != 0};
+    const test::HttpFaults faults{
+        .latency = std::chrono::milliseconds(envOr("NEKO_BENCH_LATENCY_MS", neko::uint64(0))),
+        .bytesPerSecond = envOr("NEKO_BENCH_BYTES_PER_SEC", neko::uint64(0)),
+        .errorRate = envOr("NEKO_BENCH_ERROR_RATE", 0.0),
+        .stallRate = envOr("NEKO_BENCH_STALL_RATE", 0.0),
+        .stallFor = std::chrono::milliseconds(envOr("NEKO_BENCH_STALL_MS", neko::uint64(500)))};
+    const auto runs = std::max<neko::uint64>(1, envOr("NEKO_BENCH_RUNS", neko::uint64(3)));
+
+    test::LocalHttpServer server(faults);
+    const auto update = test::serveSyntheticUpdate(server, lc::api::checkUpdates, options, sha256);
+    const fs::path target = fs::path(system::workPath()) / options.directory;
+
+    std::vector<RunResult> results;
+    for (neko::uint64 run = 1; run <= runs; ++run) {
+        // Start cold: nothing installed and no digests to reuse.
+        fs::remove_all(target);
+        fs::remove(app::getCacheFolder() + "/integrity.json");
+        server.clearServed();
+
+        const auto start = std::chrono::steady_clock::now();
+        network::Network net;
+        auto manifest = net.executeWithRetry({network::RequestConfig{
+            .url = server.url(lc::api::checkUpdates),
+            .method = network::RequestType::Post,
+            .postData = "{}",
+            .requestId = "update-bench-manifest"}});
+        ASSERT_TRUE(manifest.isSuccess()) << manifest.errorMessage;
+        ASSERT_NO_THROW(core::update::update(core::update::parseUpdate(manifest.content)));
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (const auto &[fileName, content] : update.files) {
+            ASSERT_EQ(fs::file_size(fs::path(system::workPath()) / fileName), content.size()) << fileName;
+        }
+
+        RunResult result{
+            .seconds = seconds,
+            .filesPerSecond = options.files / seconds,
+            .megabytesPerSecond = update.totalBytes / seconds / (1024.0 * 1024.0),
+            .p99FileMs = p99FileMs(server.getServed())};
+        const auto prefix = "run_" + std::to_string(run) + "_";
+        RecordProperty(prefix + "seconds", std::to_string(result.seconds));
+        RecordProperty(prefix + "files_per_sec", std::to_string(result.filesPerSecond));
+        RecordProperty(prefix + "mb_per_sec", std::to_string(result.megabytesPerSecond));
+        RecordProperty(prefix + "p99_file_ms", std::to_string(result.p99FileMs));
+        results.push_back(result);
+    }
+    fs::remove_all(target);
+
+    // The median run is the one recorded for tracking.
+    std::sort(results.begin(), results.end(), [](const RunResult &a, const RunResult &b) { return a.seconds < b.seconds; });
+    const auto &median = results[results.size() / 2];
+    RecordProperty("files", std::to_string(options.files));
+    RecordProperty("file_size", std::to_string(options.fileSize));
+    RecordProperty("files_per_sec", std::to_string(median.filesPerSecond));
+    RecordProperty("mb_per_sec", std::to_string(median.megabytesPerSecond));
+    RecordProperty("p99_file_ms", std::to_string(median.p99FileMs));
+}
@@ -193,3 +193,154 @@ TEST_F(UpdateTest, ParseUpdateMultipleFiles) {
     EXPECT_FALSE(result.files[1].isCoreFile);
     EXPECT_TRUE(result.files[1].isAbsoluteUrl);
 }
+
+// Test parseUpdate reads per-file patches
+TEST_F(UpdateTest, ParseUpdatePatches) {
+    std::string jsonWithPatches = R"({
+        "updateResponse": {
+            "title": "Patch Update",
+            "description": "Update with patches",
+            "posterUrl": "",
+            "publishTime": "2025-12-02",
+            "resourceVersion": "2.1.0",
+            "isMandatory": false,
+            "files": [
+                {
+                    "url": "https://cdn.example.com/pack.zip",
+                    "fileName": "pack.zip",
+                    "checksum": "new",
+                    "patches": [
+                        {
+                            "fromVersion": "2.0.0",
+                            "url": "patches/pack-2.0.0.zst",
+                            "format": "zstd",
+                            "baseChecksum": "old",
+                            "size": 4096,
+                            "isAbsoluteUrl": false
+                        }
+                    ]
+                },
+                {
+                    "url": "https://cdn.example.com/other.zip",
+                    "fileName": "other.zip",
+                    "checksum": "hash"
+                }
+            ]
+        }
+    })";
+
+    auto result = neko::core::update::parseUpdate(jsonWithPatches);
+
+    ASSERT_EQ(result.files.size(), 2);
+    ASSERT_EQ(result.files[0].patches.size(), 1);
+    const auto &patch = result.files[0].patches[0];
+    EXPECT_EQ(patch.fromVersion, "2.0.0");
+    EXPECT_EQ(patch.url, "patches/pack-2.0.0.zst");
+    EXPECT_EQ(patch.format, "zstd");
+    EXPECT_EQ(patch.baseChecksum, "old");
+    EXPECT_EQ(patch.size, 4096u);
+    EXPECT_FALSE(patch.isAbsoluteUrl);
+    EXPECT_TRUE(result.files[1].patches.empty());
+}
+
+// Test parsing chunk manifests behind the downloadMeta.chunked flag
+TEST_F(UpdateTest, ParseUpdateChunks) {
+    std::string jsonWithChunks = R"({
+        "updateResponse": {
+            "title": "Chunked Update",
+            "description": "Update with chunk manifests",
+            "posterUrl": "",
+            "publishTime": "2025-12-02",
+            "resourceVersion": "2.2.0",
+            "isMandatory": false,
+            "files": [
+                {
+                    "url": "https://cdn.example.com/pack.zip",
+                    "fileName": "pack.zip",
+                    "checksum": "whole",
+                    "downloadMeta": {
+                        "chunked": true
+                    },
+                    "chunks": {
+                        "algorithm": "gear-v1",
+                        "hashAlgorithm": "sha256",
+                        "minSize": 16384,
+                        "avgSize": 65536,
+                        "maxSize": 262144,
+                        "baseUrl": "chunks",
+                        "isAbsoluteUrl": false,
+                        "list": [
+                            {"hash": "aaaa", "size": 70000},
+                            {"hash": "bbbb", "size": 1234}
+                        ]
+                    }
+                },
+                {
+                    "url": "https://cdn.example.com/other.zip",
+                    "fileName": "other.zip",
+                    "checksum": "hash"
+                }
+            ]
+        }
+    })";
+
+    auto result = neko::core::update::parseUpdate(jsonWithChunks);
+
+    ASSERT_EQ(result.files.size(), 2);
+    const auto &file = result.files[0];
+    EXPECT_TRUE(file.chunked);
+    EXPECT_EQ(file.chunks.algorithm, "gear-v1");
+    EXPECT_EQ(file.chunks.avgSize, 65536u);
+    EXPECT_EQ(file.chunks.baseUrl, "chunks");
+    EXPECT_FALSE(file.chunks.isAbsoluteUrl);
+    ASSERT_EQ(file.chunks.list.size(), 2);
+    EXPECT_EQ(file.chunks.list[1].hash, "bbbb");
+    EXPECT_EQ(file.chunks.list[1].size, 1234u);
+    EXPECT_FALSE(result.files[1].chunked);
+    EXPECT_TRUE(result.files[1].chunks.empty());
+}
+
+// Test patches and chunk manifests without isAbsoluteUrl are resolved against the API host, like their default values
+TEST_F(UpdateTest, ParseUpdateRelativeUrlsByDefault) {
+    std::string jsonWithoutFlags = R"({
+        "updateResponse": {
+            "title": "Relative Update",
+            "description": "Patch and chunks without isAbsoluteUrl",
+            "posterUrl": "",
+            "publishTime": "2025-12-03",
+            "resourceVersion": "2.3.0",
+            "isMandatory": false,
+            "files": [
+                {
+                    "url": "https://cdn.example.com/pack.zip",
+                    "fileName": "pack.zip",
+                    "checksum": "whole",
+                    "downloadMeta": {
+                        "chunked": true
+                    },
+                    "patches": [
+                        {"fromVersion": "2.2.0", "url": "patches/pack-2.2.0.zst", "format": "zstd", "baseChecksum": "old"}
+                    ],
+                    "chunks": {
+                        "baseUrl": "chunks",
+                        "list": [{"hash": "aaaa", "size": 10}]
+                    }
+                }
+            ]
+        }
+    })";
+
+    auto result = neko::core::update::parseUpdate(jsonWithoutFlags);
+
+    ASSERT_EQ(result.files.size(), 1);
+    ASSERT_EQ(result.files[0].patches.size(), 1);
+    EXPECT_FALSE(result.files[0].patches[0].isAbsoluteUrl);
+    EXPECT_FALSE(result.files[0].chunks.isAbsoluteUrl);
+
+    const neko::api::UpdateResponse::File file;
+    EXPECT_FALSE(file.suggestMultiThread);
+    EXPECT_FALSE(file.isCoreFile);
+    EXPECT_FALSE(file.isAbsoluteUrl);
+    EXPECT_FALSE(neko::api::UpdateResponse::Patch{}.isAbsoluteUrl);
+    EXPECT_FALSE(neko::api::UpdateResponse::ChunkManifest{}.isAbsoluteUrl);
+}
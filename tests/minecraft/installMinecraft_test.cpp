@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <neko/function/hash.hpp>
+#include <neko/network/network.hpp>
+
+#include "neko/bus/threadBus.hpp"
+#include "neko/minecraft/installMinecraft.hpp"
+
+#include "localHttpServer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace neko;
+
+class InstallMinecraftTest : public ::testing::Test {
+protected:
+    fs::path dir;
+    test::LocalHttpServer server;
+
+    void SetUp() override {
+        // Loopback requests never go through a system proxy.
+        network::config::globalConfig.setProxy("");
+        bus::thread::setThreadCount(std::max(2u, std::thread::hardware_concurrency()));
+        bus::thread::setThreadCount(bus::Executor::io, bus::thread::defaultIoThreadCount);
+        dir = fs::temp_directory_path() / "neko_install_minecraft_test";
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir);
+    }
+
+    static std::string sha1(const std::string &data) {
+        return util::hash::digest(data, util::hash::mapAlgorithm("sha1"));
+    }
+
+    // Same size as the original, so only the SHA-1 tells it apart.
+    static std::string corrupted(std::string data) {
+        data.front() ^= 0x5a;
+        return data;
+    }
+
+    static void writeFile(const fs::path &path, const std::string &content) {
+        fs::create_directories(path.parent_path());
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+    }
+
+    static std::string readFile(const fs::path &path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    std::size_t requestsFor(const std::string &path) const {
+        const auto served = server.getServed();
+        return static_cast<std::size_t>(std::count_if(served.begin(), served.end(), [&](const auto &request) { return request.path == path; }));
+    }
+
+    static fs::path assetPath(const fs::path &root, const std::string &hash) {
+        return root / "assets" / "objects" / hash.substr(0, 2) / hash;
+    }
+
+    static std::string assetRoute(const std::string &hash) {
+        return "/assets/" + hash.substr(0, 2) + "/" + hash;
+    }
+};
+
+// Test files matching their SHA-1 are reused, corrupt and missing ones are fetched, and a shared asset hash only once
+TEST_F(InstallMinecraftTest, ReusesValidFilesAndFetchesTheRest) {
+    const std::string goodLibrary(3000, 'g'), badLibrary(5000, 'b'), client(7000, 'c');
+    const std::string goodAsset = "valid asset", badAsset = "corrupt asset", sharedAsset = "asset used by two names";
+
+    server.serveContent("/libraries/good.jar", goodLibrary);
+    server.serveContent("/libraries/bad.jar", badLibrary);
+    server.serveContent("/client.jar", client);
+    for (const auto &asset : {goodAsset, badAsset, sharedAsset}) {
+        server.serveContent(assetRoute(sha1(asset)), asset);
+    }
+
+    nlohmann::json objects;
+    const std::vector<std::pair<std::string, std::string>> assets = {
+        {"good.ogg", goodAsset}, {"bad.ogg", badAsset}, {"one.ogg", sharedAsset}, {"two.ogg", sharedAsset}};
+    for (const auto &[name, asset] : assets) {
+        objects[name] = {{"hash", sha1(asset)}, {"size", asset.size()}};
+    }
+    const std::string assetIndex = nlohmann::json{{"objects", objects}}.dump();
+    server.serveContent("/indexes/test.json", assetIndex, "application/json");
+
+    auto artifact = [this](const std::string &name, const std::string &content) {
+        return nlohmann::json{{"name", name},
+                              {"downloads", {{"artifact", {{"path", "test/" + name + ".jar"}, {"url", server.url("/libraries/" + name + ".jar")}, {"sha1", sha1(content)}, {"size", content.size()}}}}}};
+    };
+    const nlohmann::json versionJson = {
+        {"libraries", {artifact("good", goodLibrary), artifact("bad", badLibrary)}},
+        {"assetIndex", {{"id", "test"}, {"url", server.url("/indexes/test.json")}, {"sha1", sha1(assetIndex)}, {"size", assetIndex.size()}}},
+        {"downloads", {{"client", {{"url", server.url("/client.jar")}, {"sha1", sha1(client)}, {"size", client.size()}}}}}};
+
+    // One valid and one corrupt library and asset already on disk; the client jar and the shared asset are missing.
+    writeFile(dir / "libraries" / "test" / "good.jar", goodLibrary);
+    writeFile(dir / "libraries" / "test" / "bad.jar", corrupted(badLibrary));
+    writeFile(assetPath(dir, sha1(goodAsset)), goodAsset);
+    writeFile(assetPath(dir, sha1(badAsset)), corrupted(badAsset));
+
+    const auto assetBase = server.url("/assets");
+    const auto summary = minecraft::setupMinecraftDownloads(minecraft::DownloadSource::Official, "test", versionJson, dir.string(), {.assetBaseUrl = assetBase});
+
+    EXPECT_EQ(summary.reusedFiles, 2u);
+    EXPECT_EQ(summary.reusedBytes, goodLibrary.size() + goodAsset.size());
+    EXPECT_EQ(summary.fetchedFiles, 4u);
+    EXPECT_EQ(summary.fetchedBytes, badLibrary.size() + client.size() + badAsset.size() + sharedAsset.size());
+
+    EXPECT_EQ(requestsFor("/libraries/good.jar"), 0u);
+    EXPECT_EQ(requestsFor("/libraries/bad.jar"), 1u);
+    EXPECT_EQ(requestsFor(assetRoute(sha1(goodAsset))), 0u);
+    EXPECT_EQ(requestsFor(assetRoute(sha1(badAsset))), 1u);
+    EXPECT_EQ(requestsFor(assetRoute(sha1(sharedAsset))), 1u);
+
+    EXPECT_EQ(readFile(dir / "libraries" / "test" / "bad.jar"), badLibrary);
+    EXPECT_EQ(readFile(assetPath(dir, sha1(badAsset))), badAsset);
+    EXPECT_EQ(readFile(assetPath(dir, sha1(sharedAsset))), sharedAsset);
+    EXPECT_EQ(readFile(dir / "versions" / "NekoServer_test" / "NekoServer_test.jar"), client);
+
+    // A second install finds everything in place.
+    server.clearServed();
+    const auto again = minecraft::setupMinecraftDownloads(minecraft::DownloadSource::Official, "test", versionJson, dir.string(), {.assetBaseUrl = assetBase});
+    EXPECT_EQ(again.reusedFiles, 6u);
+    EXPECT_EQ(again.fetchedFiles, 0u);
+    EXPECT_EQ(again.fetchedBytes, 0u);
+    EXPECT_TRUE(server.getServed().empty());
+}
+
+// Test a download that does not match its listed SHA-1 fails the install and is not left on disk
+TEST_F(InstallMinecraftTest, RejectsDownloadNotMatchingItsHash) {
+    const std::string library(4000, 'l'), client(6000, 'c');
+    const std::string assetIndex = nlohmann::json{{"objects", nlohmann::json::object()}}.dump();
+
+    // Same size as listed, different content.
+    server.serveContent("/libraries/lib.jar", corrupted(library));
+    server.serveContent("/client.jar", client);
+    server.serveContent("/indexes/test.json", assetIndex, "application/json");
+
+    const nlohmann::json versionJson = {
+        {"libraries", {{{"name", "lib"}, {"downloads", {{"artifact", {{"path", "test/lib.jar"}, {"url", server.url("/libraries/lib.jar")}, {"sha1", sha1(library)}, {"size", library.size()}}}}}}}},
+        {"assetIndex", {{"id", "test"}, {"url", server.url("/indexes/test.json")}, {"sha1", sha1(assetIndex)}, {"size", assetIndex.size()}}},
+        {"downloads", {{"client", {{"url", server.url("/client.jar")}, {"sha1", sha1(client)}, {"size", client.size()}}}}}};
+
+    EXPECT_THROW(minecraft::setupMinecraftDownloads(minecraft::DownloadSource::Official, "test", versionJson, dir.string(), {.assetBaseUrl = server.url("/assets")}), ex::Exception);
+    EXPECT_FALSE(fs::exists(dir / "libraries" / "test" / "lib.jar"));
+    EXPECT_FALSE(fs::exists(dir / "versions" / "NekoServer_test" / "NekoServer_test.json"));
+}